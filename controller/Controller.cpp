@@ -227,6 +227,32 @@ bool getJstacks(const utils::net::SocketData& socket_data, std::ostream &out) {
   return true;
 }
 
+nonstd::expected<void, std::string> getProvenance(const utils::net::SocketData& socket_data, std::ostream &out, const std::string& query) {
+  std::unique_ptr<io::BaseStream> connection_stream = std::make_unique<utils::net::AsioSocketConnection>(socket_data);
+  if (connection_stream->initialize() < 0) {
+    return nonstd::make_unexpected("Could not connect to remote host " + socket_data.host + ":" + std::to_string(socket_data.port));
+  }
+  io::BufferStream buffer;
+  auto op = static_cast<uint8_t>(c2::Operation::describe);
+  buffer.write(&op, 1);
+  buffer.write("provenance");
+  buffer.write(query);
+  if (io::isError(connection_stream->write(buffer.getBuffer()))) {
+    return nonstd::make_unexpected("Could not write to connection " + socket_data.host + ":" + std::to_string(socket_data.port));
+  }
+  connection_stream->read(op);
+  bool success = false;
+  std::string response;
+  if (connection_stream->read(success) != 1 || io::isError(connection_stream->read(response, true))) {
+    return nonstd::make_unexpected("Could not read the provenance query response");
+  }
+  if (!success) {
+    return nonstd::make_unexpected(response);
+  }
+  out << response << std::endl;
+  return {};
+}
+
 nonstd::expected<void, std::string> getDebugBundle(const utils::net::SocketData& socket_data, const std::filesystem::path& target_dir) {
   std::unique_ptr<io::BaseStream> connection_stream = std::make_unique<utils::net::AsioSocketConnection>(socket_data);
   if (connection_stream->initialize() < 0) {
@@ -161,6 +161,9 @@ int main(int argc, char **argv) {
 
   argument_parser.add_argument("-d", "--debug").metavar("BUNDLE_OUT_DIR")
     .help("Get debug bundle");
+  argument_parser.add_argument("--provenance").metavar("QUERY")
+    .help("Returns the matching provenance events in JSON, the query is a list of name=value criteria separated by '&': "
+        "flowFileUuid, componentId, eventType, startTime, endTime, maxAge, maxResults");
 
   bool show_headers = true;
 
@@ -264,6 +267,12 @@ int main(int argc, char **argv) {
         std::cout << "Could not connect to remote host " << socket_data.host << ":" << socket_data.port << std::endl;
     }
 
+    if (const auto& query = argument_parser.present("--provenance")) {
+      auto provenance_res = minifi::controller::getProvenance(socket_data, std::cout, *query);
+      if (!provenance_res)
+        std::cout << provenance_res.error() << std::endl;
+    }
+
     if (const auto& debug_path = argument_parser.present("--debug")) {
       auto debug_res = minifi::controller::getDebugBundle(socket_data, std::filesystem::path(*debug_path));
       if (!debug_res)
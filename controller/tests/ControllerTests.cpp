@@ -15,6 +15,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
 #include <vector>
 #include <memory>
 #include <utility>
@@ -22,6 +23,7 @@
 #include <filesystem>
 #include <fstream>
 #include "range/v3/algorithm/find.hpp"
+#include "rapidjson/document.h"
 
 #include "TestBase.h"
 #include "Catch.h"
@@ -34,6 +36,7 @@
 #include "controllers/SSLContextService.h"
 #include "utils/StringUtils.h"
 #include "state/UpdateController.h"
+#include "provenance/ProvenanceQuery.h"
 
 using namespace std::literals::chrono_literals;
 
@@ -178,6 +181,14 @@ class TestUpdateSink : public minifi::state::StateMonitor {
     return 8765309;
   }
 
+  std::optional<minifi::provenance::ProvenanceQueryResult> queryProvenance(const minifi::provenance::ProvenanceQuery& query) override {
+    minifi::provenance::ProvenanceQueryResult result;
+    std::copy_if(provenance_events.begin(), provenance_events.end(), std::back_inserter(result.events), [&](const auto& event) { return query.matches(*event); });
+    return result;
+  }
+
+  std::vector<std::shared_ptr<minifi::provenance::ProvenanceEventRecord>> provenance_events;
+
   std::atomic<bool> is_running;
   std::atomic<uint32_t> clear_calls;
   std::shared_ptr<StateController> controller;
@@ -573,4 +584,27 @@ TEST_CASE_METHOD(ControllerTestFixture, "Debug bundle retrieval fails if target
   REQUIRE(result.error() == "Object specified as the target directory already exists and it is not a directory");
 }
 
+TEST_CASE_METHOD(ControllerTestFixture, "Test provenance query", "[controllerTests]") {
+  setConnectionType(ControllerTestFixture::ConnectionType::UNSECURE);
+  update_sink_->provenance_events.push_back(std::make_shared<minifi::provenance::ProvenanceEventRecord>(minifi::provenance::ProvenanceEventRecord::SEND, "processor1", "PutFile"));
+  update_sink_->provenance_events.push_back(std::make_shared<minifi::provenance::ProvenanceEventRecord>(minifi::provenance::ProvenanceEventRecord::CREATE, "processor2", "GenerateFlowFile"));
+  initalizeControllerSocket();
+
+  std::stringstream provenance_stream;
+  REQUIRE(minifi::controller::getProvenance(controller_socket_data_, provenance_stream, "componentId=processor2&eventType=create"));
+  rapidjson::Document document;
+  REQUIRE_FALSE(document.Parse(provenance_stream.str().c_str()).HasParseError());
+  REQUIRE(document.IsObject());
+  CHECK_FALSE(document["truncated"].GetBool());
+  const auto& events = document["events"];
+  REQUIRE(events.IsArray());
+  REQUIRE(events.Size() == 1);
+  CHECK(std::string{events[0]["componentId"].GetString()} == "processor2");
+  CHECK(std::string{events[0]["eventType"].GetString()} == "CREATE");
+
+  auto invalid_query_result = minifi::controller::getProvenance(controller_socket_data_, provenance_stream, "eventType=UNKNOWN");
+  REQUIRE_FALSE(invalid_query_result);
+  CHECK(invalid_query_result.error() == "Invalid provenance event type: UNKNOWN");
+}
+
 }  // namespace org::apache::nifi::minifi::test
@@ -51,7 +51,9 @@ class PrometheusChecker:
         # Only flowfile and content repositories are using rocksdb by default, so rocksdb specific metrics are only present there
         return all((self.verify_metrics_exist(['minifi_is_running', 'minifi_is_full', 'minifi_repository_size_bytes', 'minifi_max_repository_size_bytes', 'minifi_repository_entry_count'], 'RepositoryMetrics', labels) for labels in label_list)) and \
             all((self.verify_metric_larger_than_zero('minifi_repository_size_bytes', 'RepositoryMetrics', labels) for labels in label_list[1:3])) and \
-            all((self.verify_metrics_exist(['minifi_rocksdb_table_readers_size_bytes', 'minifi_rocksdb_all_memory_tables_size_bytes'], 'RepositoryMetrics', labels) for labels in label_list[1:3]))
+            all((self.verify_metrics_exist(['minifi_rocksdb_table_readers_size_bytes', 'minifi_rocksdb_all_memory_tables_size_bytes'], 'RepositoryMetrics', labels) for labels in label_list[1:3])) and \
+            self.verify_metrics_exist(['minifi_commit_count', 'minifi_write_count', 'minifi_average_write_batch_size', 'minifi_max_write_batch_size',
+                                       'minifi_average_commit_latency_milliseconds', 'minifi_max_commit_latency_milliseconds'], 'RepositoryMetrics', label_list[1])
 
     def verify_queue_metrics(self):
         return self.verify_metrics_exist(['minifi_queue_data_size', 'minifi_queue_data_size_max', 'minifi_queue_size', 'minifi_queue_size_max'], 'QueueMetrics')
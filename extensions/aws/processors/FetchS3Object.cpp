@@ -39,6 +39,14 @@ void FetchS3Object::onSchedule(core::ProcessContext& context, core::ProcessSessi
 
   context.getProperty(RequesterPays, requester_pays_);
   logger_->log_debug("FetchS3Object: RequesterPays [{}]", requester_pays_);
+
+  if (!context.getProperty(ConcurrentRangeFetches, ranged_fetch_.max_concurrent_ranges) || ranged_fetch_.max_concurrent_ranges == 0) {
+    throw Exception(PROCESS_SCHEDULE_EXCEPTION, "Concurrent Range Fetches must be at least 1!");
+  }
+  if (!context.getProperty(RangeFetchSize, ranged_fetch_.range_size) || ranged_fetch_.range_size == 0) {
+    throw Exception(PROCESS_SCHEDULE_EXCEPTION, "Range Fetch Size must be greater than 0!");
+  }
+  logger_->log_debug("FetchS3Object: Concurrent Range Fetches [{}], Range Fetch Size [{}]", ranged_fetch_.max_concurrent_ranges, ranged_fetch_.range_size);
 }
 
 std::optional<aws::s3::GetObjectRequestParameters> FetchS3Object::buildFetchS3RequestParams(
@@ -49,6 +57,7 @@ std::optional<aws::s3::GetObjectRequestParameters> FetchS3Object::buildFetchS3Re
   minifi::aws::s3::GetObjectRequestParameters get_object_params(common_properties.credentials, *client_config_);
   get_object_params.bucket = common_properties.bucket;
   get_object_params.requester_pays = requester_pays_;
+  get_object_params.ranged_fetch = ranged_fetch_;
 
   context.getProperty(ObjectKey, get_object_params.object_key, flow_file);
   if (get_object_params.object_key.empty() && (!flow_file->getAttribute("filename", get_object_params.object_key) || get_object_params.object_key.empty())) {
@@ -56,10 +56,25 @@ class FetchS3Object : public S3Processor {
       .withDescription("If true, indicates that the requester consents to pay any charges associated with retrieving "
           "objects from the S3 bucket. This sets the 'x-amz-request-payer' header to 'requester'.")
       .build();
-  EXTENSIONAPI static constexpr auto Properties = minifi::utils::array_cat(S3Processor::Properties, std::array<core::PropertyReference, 3>{
+  EXTENSIONAPI static constexpr auto ConcurrentRangeFetches = core::PropertyDefinitionBuilder<>::createProperty("Concurrent Range Fetches")
+      .withDescription("Specifies the number of byte ranges of the object that are downloaded at the same time. "
+          "If it is more than 1, objects larger than the Range Fetch Size are fetched in concurrent ranged requests and written to the flow file in order.")
+      .withPropertyType(core::StandardPropertyTypes::UNSIGNED_INT_TYPE)
+      .withDefaultValue("1")
+      .isRequired(true)
+      .build();
+  EXTENSIONAPI static constexpr auto RangeFetchSize = core::PropertyDefinitionBuilder<>::createProperty("Range Fetch Size")
+      .withDescription("The size of the byte ranges fetched concurrently. At most Concurrent Range Fetches ranges are held in memory at a time.")
+      .withPropertyType(core::StandardPropertyTypes::DATA_SIZE_TYPE)
+      .withDefaultValue("8 MB")
+      .isRequired(true)
+      .build();
+  EXTENSIONAPI static constexpr auto Properties = minifi::utils::array_cat(S3Processor::Properties, std::array<core::PropertyReference, 5>{
       ObjectKey,
       Version,
-      RequesterPays
+      RequesterPays,
+      ConcurrentRangeFetches,
+      RangeFetchSize
   });
 
 
@@ -97,6 +112,7 @@ class FetchS3Object : public S3Processor {
     const CommonProperties &common_properties) const;
 
   bool requester_pays_ = false;
+  minifi::utils::ParallelRangedFetchSettings ranged_fetch_;
 };
 
 }  // namespace org::apache::nifi::minifi::aws::processors
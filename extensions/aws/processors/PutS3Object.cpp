@@ -85,7 +85,14 @@ void PutS3Object::onSchedule(core::ProcessContext& context, core::ProcessSession
     throw Exception(PROCESS_SCHEDULE_EXCEPTION, "Multipart Part Size is not between the valid 5MB and 5GB range!");
   }
   logger_->log_debug("PutS3Object: Multipart Size {}", multipart_size_);
-
+  if (!context.getProperty(MultipartUploadConcurrentParts, multipart_concurrent_parts_) || multipart_concurrent_parts_ == 0) {
+    throw Exception(PROCESS_SCHEDULE_EXCEPTION, "Multipart Upload Concurrent Parts must be at least 1!");
+  }
+  logger_->log_debug("PutS3Object: Multipart Upload Concurrent Parts {}", multipart_concurrent_parts_);
+  if (!context.getProperty(MultipartUploadBufferSize, multipart_buffer_size_)) {
+    throw Exception(PROCESS_SCHEDULE_EXCEPTION, "Multipart Upload Buffer Size property missing or invalid");
+  }
+  logger_->log_debug("PutS3Object: Multipart Upload Buffer Size {}", multipart_buffer_size_);
 
   multipart_upload_ageoff_interval_ = minifi::utils::getRequiredPropertyOrThrow<core::TimePeriodValue>(context, MultipartUploadAgeOffInterval.name).getMilliseconds();
   logger_->log_debug("PutS3Object: Multipart Upload Ageoff Interval {}", multipart_upload_ageoff_interval_);
@@ -180,6 +187,8 @@ std::optional<aws::s3::PutObjectRequestParameters> PutS3Object::buildPutS3Reques
   }
 
   params.use_virtual_addressing = use_virtual_addressing_;
+  params.multipart_max_concurrent_parts = multipart_concurrent_parts_;
+  params.multipart_max_buffer_size = multipart_buffer_size_;
   return params;
 }
 
@@ -138,7 +138,21 @@ class PutS3Object : public S3Processor {
       .withDefaultValue("7 days")
       .isRequired(true)
       .build();
-  EXTENSIONAPI static constexpr auto Properties = minifi::utils::array_cat(S3Processor::Properties, std::array<core::PropertyReference, 14>{
+  EXTENSIONAPI static constexpr auto MultipartUploadConcurrentParts = core::PropertyDefinitionBuilder<>::createProperty("Multipart Upload Concurrent Parts")
+      .withDescription("Specifies the number of parts of a multipart upload that are sent at the same time. "
+                        "Sending more parts concurrently increases the throughput of large uploads over high latency links.")
+      .withPropertyType(core::StandardPropertyTypes::UNSIGNED_INT_TYPE)
+      .withDefaultValue("1")
+      .isRequired(true)
+      .build();
+  EXTENSIONAPI static constexpr auto MultipartUploadBufferSize = core::PropertyDefinitionBuilder<>::createProperty("Multipart Upload Buffer Size")
+      .withDescription("Specifies the maximum memory used for buffering the parts of a multipart upload, including the parts being sent and the next part being read from the flow file. "
+                        "It limits the number of concurrent parts, but at least one part is always buffered.")
+      .withPropertyType(core::StandardPropertyTypes::DATA_SIZE_TYPE)
+      .withDefaultValue("100 MB")
+      .isRequired(true)
+      .build();
+  EXTENSIONAPI static constexpr auto Properties = minifi::utils::array_cat(S3Processor::Properties, std::array<core::PropertyReference, 16>{
       ObjectKey,
       ContentType,
       StorageClass,
@@ -152,7 +166,9 @@ class PutS3Object : public S3Processor {
       MultipartThreshold,
       MultipartPartSize,
       MultipartUploadAgeOffInterval,
-      MultipartUploadMaxAgeThreshold
+      MultipartUploadMaxAgeThreshold,
+      MultipartUploadConcurrentParts,
+      MultipartUploadBufferSize
   });
 
 
@@ -217,6 +233,8 @@ class PutS3Object : public S3Processor {
   bool use_virtual_addressing_ = true;
   uint64_t multipart_threshold_{};
   uint64_t multipart_size_{};
+  uint32_t multipart_concurrent_parts_ = 1;
+  uint64_t multipart_buffer_size_{};
   std::chrono::milliseconds multipart_upload_ageoff_interval_;
   std::chrono::milliseconds multipart_upload_max_age_threshold_;
   std::mutex last_ageoff_mutex_;
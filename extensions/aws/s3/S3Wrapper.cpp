@@ -104,6 +104,23 @@ std::optional<PutObjectResult> S3Wrapper::putObject(const PutObjectRequestParame
   return createPutObjectResult(*aws_result);
 }
 
+std::future<std::optional<Aws::S3::Model::UploadPartResult>> S3Wrapper::startUploadPart(const PutObjectRequestParameters& put_object_params, const std::string& upload_id,
+    size_t part_number, const std::shared_ptr<Aws::StringStream>& part_data) {
+  auto upload_part_request = Aws::S3::Model::UploadPartRequest{}
+    .WithBucket(put_object_params.bucket)
+    .WithKey(put_object_params.object_key)
+    .WithPartNumber(gsl::narrow<int>(part_number))
+    .WithUploadId(upload_id);
+  upload_part_request.SetBody(part_data);
+
+  Aws::Utils::ByteBuffer part_md5(Aws::Utils::HashingUtils::CalculateMD5(*part_data));
+  upload_part_request.SetContentMD5(Aws::Utils::HashingUtils::Base64Encode(part_md5));
+
+  return std::async(std::launch::async, [this, &put_object_params, upload_part_request = std::move(upload_part_request)] {
+    return request_sender_->sendUploadPartRequest(upload_part_request, put_object_params.credentials, put_object_params.client_config, put_object_params.use_virtual_addressing);
+  });
+}
+
 std::optional<S3Wrapper::UploadPartsResult> S3Wrapper::uploadParts(const PutObjectRequestParameters& put_object_params, const std::shared_ptr<io::InputStream>& stream,
     MultipartUploadState upload_state) {
   stream->seek(upload_state.uploaded_size);
@@ -119,34 +136,61 @@ std::optional<S3Wrapper::UploadPartsResult> S3Wrapper::uploadParts(const PutObje
   size_t total_read = 0;
   const size_t start_part = upload_state.uploaded_parts + 1;
   const size_t last_part = start_part + part_count - 1;
-  for (size_t part_number = start_part; part_number <= last_part; ++part_number) {
+  const size_t max_parts_in_flight = (std::max)(put_object_params.multipart_max_concurrent_parts, size_t{1});
+  // the part being read from the flow file also counts towards the buffer size limit
+  const size_t max_buffered_parts = gsl::narrow<size_t>((std::max)(put_object_params.multipart_max_buffer_size / upload_state.part_size, uint64_t{1}));
+
+  // The parts are finished in order even if a later one is sent faster, so the stored state always covers the uploaded parts without gaps.
+  // After a failure the parts still in flight are waited for, but not recorded, they are uploaded again when the upload is continued.
+  std::deque<PartUpload> parts_in_flight;
+  bool failed = false;
+  const auto finish_oldest_part = [&] {
+    auto part = std::move(parts_in_flight.front());
+    parts_in_flight.pop_front();
+    auto upload_part_result = part.result.get();
+    if (failed) {
+      return;
+    }
+    if (!upload_part_result) {
+      logger_->log_error("Failed to upload part {} of {} of S3 object with key '{}'", part.part_number, last_part, put_object_params.object_key);
+      failed = true;
+      return;
+    }
+    result.part_etags.push_back(upload_part_result->GetETag());
+    upload_state.uploaded_etags.push_back(upload_part_result->GetETag());
+    upload_state.uploaded_parts += 1;
+    upload_state.uploaded_size += part.size;
+    multipart_upload_storage_->storeState(put_object_params.bucket, put_object_params.object_key, upload_state);
+    logger_->log_info("Uploaded part {} of {} S3 object with key '{}'", part.part_number, last_part, put_object_params.object_key);
+  };
+
+  for (size_t part_number = start_part; part_number <= last_part && !failed; ++part_number) {
+    while (!failed && parts_in_flight.size() >= max_buffered_parts) {
+      finish_oldest_part();
+    }
+    if (failed) {
+      break;
+    }
+    // reading the next part overlaps with sending the previous ones
     uint64_t read_size{};
     const auto remaining = flow_size - total_read;
     const auto next_read_size = std::min(remaining, upload_state.part_size);
     auto stream_ptr = readFlowFileStream(stream, next_read_size, read_size);
     total_read += read_size;
 
-    auto upload_part_request = Aws::S3::Model::UploadPartRequest{}
-      .WithBucket(put_object_params.bucket)
-      .WithKey(put_object_params.object_key)
-      .WithPartNumber(gsl::narrow<int>(part_number))
-      .WithUploadId(upload_state.upload_id);
-    upload_part_request.SetBody(stream_ptr);
-
-    Aws::Utils::ByteBuffer part_md5(Aws::Utils::HashingUtils::CalculateMD5(*stream_ptr));
-    upload_part_request.SetContentMD5(Aws::Utils::HashingUtils::Base64Encode(part_md5));
-
-    auto upload_part_result = request_sender_->sendUploadPartRequest(upload_part_request, put_object_params.credentials, put_object_params.client_config, put_object_params.use_virtual_addressing);
-    if (!upload_part_result) {
-      logger_->log_error("Failed to upload part {} of {} of S3 object with key '{}'", part_number, last_part, put_object_params.object_key);
-      return std::nullopt;
+    while (!failed && parts_in_flight.size() >= max_parts_in_flight) {
+      finish_oldest_part();
     }
-    result.part_etags.push_back(upload_part_result->GetETag());
-    upload_state.uploaded_etags.push_back(upload_part_result->GetETag());
-    upload_state.uploaded_parts += 1;
-    upload_state.uploaded_size += read_size;
-    multipart_upload_storage_->storeState(put_object_params.bucket, put_object_params.object_key, upload_state);
-    logger_->log_info("Uploaded part {} of {} S3 object with key '{}'", part_number, last_part, put_object_params.object_key);
+    if (failed) {
+      break;
+    }
+    parts_in_flight.push_back(PartUpload{part_number, read_size, startUploadPart(put_object_params, upload_state.upload_id, part_number, stream_ptr)});
+  }
+  while (!parts_in_flight.empty()) {
+    finish_oldest_part();
+  }
+  if (failed) {
+    return std::nullopt;
   }
 
   multipart_upload_storage_->removeState(put_object_params.bucket, put_object_params.object_key);
@@ -246,6 +290,9 @@ int64_t S3Wrapper::writeFetchedBody(Aws::IOStream& source, const int64_t data_si
 }
 
 std::optional<GetObjectResult> S3Wrapper::getObject(const GetObjectRequestParameters& get_object_params, io::OutputStream& out_body) {
+  if (get_object_params.ranged_fetch.max_concurrent_ranges > 1) {
+    return getObjectInRanges(get_object_params, out_body);
+  }
   auto request = createFetchObjectRequest<Aws::S3::Model::GetObjectRequest>(get_object_params);
   auto aws_result = request_sender_->sendGetObjectRequest(request, get_object_params.credentials, get_object_params.client_config);
   if (!aws_result) {
@@ -256,6 +303,45 @@ std::optional<GetObjectResult> S3Wrapper::getObject(const GetObjectRequestParame
   return result;
 }
 
+std::optional<GetObjectResult> S3Wrapper::getObjectInRanges(const GetObjectRequestParameters& get_object_params, io::OutputStream& out_body) {
+  auto head_request = createFetchObjectRequest<Aws::S3::Model::HeadObjectRequest>(get_object_params);
+  auto head_result = request_sender_->sendHeadObjectRequest(head_request, get_object_params.credentials, get_object_params.client_config);
+  if (!head_result || head_result->GetContentLength() < 0) {
+    return std::nullopt;
+  }
+  auto result = fillFetchObjectResult<Aws::S3::Model::HeadObjectResult, GetObjectResult>(get_object_params, *head_result);
+  const auto object_size = gsl::narrow<uint64_t>(head_result->GetContentLength());
+  logger_->log_debug("Fetching S3 object '{}' of {} bytes in ranges of {} bytes, {} at a time",
+    get_object_params.object_key, object_size, get_object_params.ranged_fetch.range_size, get_object_params.ranged_fetch.max_concurrent_ranges);
+  const auto write_size = minifi::utils::parallelRangedFetch(object_size, get_object_params.ranged_fetch, [&](uint64_t offset, uint64_t length) {
+    return getObjectRange(get_object_params, head_result->GetETag(), offset, length);
+  }, out_body);
+  if (!write_size) {
+    logger_->log_error("Failed to fetch the ranges of S3 object '{}' from bucket '{}'", get_object_params.object_key, get_object_params.bucket);
+    return std::nullopt;
+  }
+  result.write_size = gsl::narrow<int64_t>(*write_size);
+  return result;
+}
+
+std::optional<std::vector<std::byte>> S3Wrapper::getObjectRange(const GetObjectRequestParameters& get_object_params, const std::string& etag, uint64_t offset, uint64_t length) {
+  auto request = createFetchObjectRequest<Aws::S3::Model::GetObjectRequest>(get_object_params);
+  request.SetRange("bytes=" + std::to_string(offset) + "-" + std::to_string(offset + length - 1));
+  // the ranges must come from the same object, even if it is overwritten during the download
+  if (!etag.empty()) {
+    request.SetIfMatch(etag);
+  }
+  auto aws_result = request_sender_->sendGetObjectRequest(request, get_object_params.credentials, get_object_params.client_config);
+  if (!aws_result || aws_result->GetContentLength() != gsl::narrow<int64_t>(length)) {
+    return std::nullopt;
+  }
+  std::vector<std::byte> range(length);
+  if (!aws_result->GetBody().read(reinterpret_cast<char*>(range.data()), gsl::narrow<std::streamsize>(length))) {
+    return std::nullopt;
+  }
+  return range;
+}
+
 void S3Wrapper::addListResults(const Aws::Vector<Aws::S3::Model::ObjectVersion>& content, const uint64_t min_object_age, std::vector<ListedObjectAttributes>& listed_objects) {
   for (const auto& version : content) {
     if (last_bucket_list_timestamp_ - min_object_age < gsl::narrow<uint64_t>(version.GetLastModified().Millis())) {
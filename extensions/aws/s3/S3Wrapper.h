@@ -20,6 +20,8 @@
 
 #pragma once
 
+#include <deque>
+#include <future>
 #include <map>
 #include <memory>
 #include <optional>
@@ -39,6 +41,7 @@
 #include "utils/OptionalUtils.h"
 #include "utils/StringUtils.h"
 #include "utils/ListingStateManager.h"
+#include "utils/ParallelRangedFetch.h"
 #include "utils/gsl.h"
 #include "S3RequestSender.h"
 #include "Exception.h"
@@ -130,6 +133,10 @@ struct PutObjectRequestParameters : public RequestParameters {
   std::string write_acl_user_list;
   std::string canned_acl;
   bool use_virtual_addressing = true;
+  // the number of parts of a multipart upload sent at the same time
+  size_t multipart_max_concurrent_parts = 1;
+  // the memory used for buffering the parts being read and sent, at least one part is always buffered
+  uint64_t multipart_max_buffer_size = 0;
 };
 
 struct DeleteObjectRequestParameters : public RequestParameters {
@@ -147,6 +154,8 @@ struct GetObjectRequestParameters : public RequestParameters {
   std::string object_key;
   std::string version;
   bool requester_pays = false;
+  // objects larger than one range are fetched in concurrent ranged GET requests if more than one range is allowed at a time
+  minifi::utils::ParallelRangedFetchSettings ranged_fetch;
 };
 
 struct HeadObjectResult {
@@ -252,6 +261,12 @@ class S3Wrapper {
     std::vector<std::string> part_etags;
   };
 
+  struct PartUpload {
+    size_t part_number;
+    uint64_t size;
+    std::future<std::optional<Aws::S3::Model::UploadPartResult>> result;
+  };
+
   static Expiration getExpiration(const std::string& expiration);
 
   template<typename RequestType>
@@ -319,7 +334,11 @@ class S3Wrapper {
   void addListResults(const Aws::Vector<Aws::S3::Model::Object>& content, uint64_t min_object_age, std::vector<ListedObjectAttributes>& listed_objects);
   void addListMultipartUploadResults(const Aws::Vector<Aws::S3::Model::MultipartUpload>& uploads, std::optional<std::chrono::milliseconds> age_off_limit,
     std::vector<MultipartUpload>& filtered_uploads);
+  std::optional<GetObjectResult> getObjectInRanges(const GetObjectRequestParameters& get_object_params, io::OutputStream& out_body);
+  std::optional<std::vector<std::byte>> getObjectRange(const GetObjectRequestParameters& get_object_params, const std::string& etag, uint64_t offset, uint64_t length);
   std::optional<UploadPartsResult> uploadParts(const PutObjectRequestParameters& put_object_params, const std::shared_ptr<io::InputStream>& stream, MultipartUploadState upload_state);
+  std::future<std::optional<Aws::S3::Model::UploadPartResult>> startUploadPart(const PutObjectRequestParameters& put_object_params, const std::string& upload_id,
+    size_t part_number, const std::shared_ptr<Aws::StringStream>& part_data);
   std::optional<Aws::S3::Model::CompleteMultipartUploadResult> completeMultipartUpload(const PutObjectRequestParameters& put_object_params, const UploadPartsResult& upload_parts_result);
   bool multipartUploadExistsInS3(const PutObjectRequestParameters& put_object_params);
   std::optional<MultipartUploadState> getMultipartUploadState(const PutObjectRequestParameters& put_object_params);
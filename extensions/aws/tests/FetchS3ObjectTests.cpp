@@ -16,7 +16,10 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <fstream>
+#include <string>
+#include <vector>
 
 #include "S3TestsFixture.h"
 #include "processors/FetchS3Object.h"
@@ -161,6 +164,28 @@ TEST_CASE_METHOD(FetchS3ObjectTestsFixture, "Test optional values are set in req
   REQUIRE(mock_s3_request_sender_ptr->get_object_request.GetRequestPayer() == Aws::S3::Model::RequestPayer::requester);
 }
 
+TEST_CASE_METHOD(FetchS3ObjectTestsFixture, "Test fetching the object in concurrent ranges", "[awsS3Config]") {
+  setRequiredProperties();
+  plan->setProperty(s3_processor, "Concurrent Range Fetches", "3");
+  plan->setProperty(s3_processor, "Range Fetch Size", "3 B");
+  test_controller.runSession(plan, true);
+  REQUIRE(verifyLogLinePresenceInPollTime(std::chrono::seconds(3), "key:s3.etag value:" + S3_ETAG_UNQUOTED));
+  REQUIRE(verifyLogLinePresenceInPollTime(std::chrono::seconds(3), "key:s3.version value:" + S3_VERSION_1));
+  REQUIRE(get_content(output_dir / INPUT_FILENAME) == S3_CONTENT);
+  auto ranges = mock_s3_request_sender_ptr->get_object_ranges;
+  std::sort(ranges.begin(), ranges.end());
+  REQUIRE(ranges == std::vector<std::string>{"bytes=0-2", "bytes=3-5", "bytes=6-8", "bytes=9-9"});
+  REQUIRE(mock_s3_request_sender_ptr->get_object_request.GetIfMatch() == S3_ETAG);
+}
+
+TEST_CASE_METHOD(FetchS3ObjectTestsFixture, "Test objects smaller than the range size are fetched in a single range", "[awsS3Config]") {
+  setRequiredProperties();
+  plan->setProperty(s3_processor, "Concurrent Range Fetches", "3");
+  test_controller.runSession(plan, true);
+  REQUIRE(get_content(output_dir / INPUT_FILENAME) == S3_CONTENT);
+  REQUIRE(mock_s3_request_sender_ptr->get_object_ranges == std::vector<std::string>{"bytes=0-9"});
+}
+
 TEST_CASE_METHOD(FetchS3ObjectTestsFixture, "Test non-default client configuration values", "[awsS3Config]") {
   setRequiredProperties();
   plan->setProperty(s3_processor, "Region", minifi::aws::processors::region::US_EAST_1);
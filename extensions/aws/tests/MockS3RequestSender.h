@@ -18,10 +18,14 @@
 
 #pragma once
 
+#include <algorithm>
+#include <chrono>
 #include <map>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <sstream>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -126,19 +130,29 @@ class MockS3RequestSender : public minifi::aws::s3::S3RequestSender {
       const Aws::S3::Model::GetObjectRequest& request,
       const Aws::Auth::AWSCredentials& credentials,
       const Aws::Client::ClientConfiguration& client_config) override {
+    std::lock_guard<std::mutex> lock(get_object_mutex_);
     get_object_request = request;
     credentials_ = credentials;
     client_config_ = client_config;
 
     Aws::S3::Model::GetObjectResult get_s3_result;
     if (!return_empty_result_) {
+      auto content = S3_CONTENT;
+      if (request.RangeHasBeenSet()) {
+        get_object_ranges.push_back(request.GetRange());
+        // the ranges used by FetchS3Object are always in the "bytes=<first>-<last>" form
+        const auto separator = request.GetRange().find('-');
+        const auto first = std::stoull(request.GetRange().substr(6, separator - 6));
+        const auto last = std::stoull(request.GetRange().substr(separator + 1));
+        content = S3_CONTENT.substr(first, last - first + 1);
+      }
       get_s3_result.SetVersionId(S3_VERSION_1);
       get_s3_result.SetETag(S3_ETAG);
       get_s3_result.SetExpiration(S3_EXPIRATION);
       get_s3_result.SetServerSideEncryption(S3_SSEALGORITHM);
       get_s3_result.SetContentType(S3_CONTENT_TYPE);
-      get_s3_result.ReplaceBody(new std::stringstream(S3_CONTENT));
-      get_s3_result.SetContentLength(S3_CONTENT.size());
+      get_s3_result.ReplaceBody(new std::stringstream(content));
+      get_s3_result.SetContentLength(content.size());
       get_s3_result.SetMetadata(S3_OBJECT_USER_METADATA);
     }
     return std::make_optional(std::move(get_s3_result));
@@ -264,6 +278,14 @@ class MockS3RequestSender : public minifi::aws::s3::S3RequestSender {
       const Aws::Auth::AWSCredentials& credentials,
       const Aws::Client::ClientConfiguration& client_config,
       bool use_virtual_addressing) override {
+    {
+      std::lock_guard<std::mutex> lock(upload_part_mutex_);
+      ++upload_parts_in_flight_;
+      max_upload_parts_in_flight_ = std::max(max_upload_parts_in_flight_, upload_parts_in_flight_);
+    }
+    std::this_thread::sleep_for(upload_part_latency_);
+    std::lock_guard<std::mutex> lock(upload_part_mutex_);
+    --upload_parts_in_flight_;
     if (etag_counter_ == fail_on_part_) {
       fail_on_part_ = 0;
       return std::nullopt;
@@ -382,9 +404,19 @@ class MockS3RequestSender : public minifi::aws::s3::S3RequestSender {
     fail_on_part_ = fail_on_part;
   }
 
+  // simulates the round trip time of a remote S3 endpoint
+  void setUploadPartLatency(std::chrono::milliseconds latency) {
+    upload_part_latency_ = latency;
+  }
+
+  size_t getMaxUploadPartsInFlight() const {
+    return max_upload_parts_in_flight_;
+  }
+
   Aws::S3::Model::PutObjectRequest put_object_request;
   Aws::S3::Model::DeleteObjectRequest delete_object_request;
   Aws::S3::Model::GetObjectRequest get_object_request;
+  std::vector<std::string> get_object_ranges;
   Aws::S3::Model::ListObjectsV2Request list_object_request;
   Aws::S3::Model::ListObjectVersionsRequest list_version_request;
   Aws::S3::Model::GetObjectTaggingRequest get_object_tagging_request;
@@ -406,4 +438,9 @@ class MockS3RequestSender : public minifi::aws::s3::S3RequestSender {
   bool use_virtual_addressing_ = true;
   uint32_t etag_counter_ = 1;
   uint32_t fail_on_part_ = 0;
+  std::mutex get_object_mutex_;
+  std::mutex upload_part_mutex_;
+  std::chrono::milliseconds upload_part_latency_{0};
+  size_t upload_parts_in_flight_ = 0;
+  size_t max_upload_parts_in_flight_ = 0;
 };
@@ -443,4 +443,86 @@ TEST_CASE_METHOD(PutS3ObjectUploadLimitChangedTestsFixture, "Do not continue mul
   }
 }
 
+TEST_CASE_METHOD(PutS3ObjectUploadLimitChangedTestsFixture, "Multipart upload sends the parts concurrently", "[awsS3MultipartUpload]") {
+  setRequiredProperties();
+  plan->setProperty(s3_processor, "Multipart Threshold", "35 B");
+  plan->setProperty(s3_processor, "Multipart Part Size", "5 B");
+  plan->setProperty(s3_processor, "Multipart Upload Concurrent Parts", "4");
+  auto temp_dir = test_controller.createTempDirectory();
+  plan->setProperty(s3_processor, "Temporary Directory Multipart State", temp_dir.string());
+  mock_s3_request_sender_ptr->setUploadPartLatency(std::chrono::milliseconds(50));
+
+  size_t max_expected_parts_in_flight = 4;
+  SECTION("Concurrent parts are limited by the property") {
+    plan->setProperty(s3_processor, "Multipart Upload Buffer Size", "1 KB");
+  }
+  SECTION("Concurrent parts are limited by the buffer size") {
+    // one part is read while the other is sent
+    plan->setProperty(s3_processor, "Multipart Upload Buffer Size", "10 B");
+    max_expected_parts_in_flight = 2;
+  }
+
+  test_controller.runSession(plan);
+
+  CHECK(verifyLogLinePresenceInPollTime(std::chrono::seconds(3), "key:s3.etag value:" + S3_ETAG_UNQUOTED));
+  CHECK(mock_s3_request_sender_ptr->getMaxUploadPartsInFlight() > 1);
+  CHECK(mock_s3_request_sender_ptr->getMaxUploadPartsInFlight() <= max_expected_parts_in_flight);
+
+  // the etags are given out in the order the part uploads finish
+  const auto& upload_part_requests = mock_s3_request_sender_ptr->upload_part_requests;
+  REQUIRE(upload_part_requests.size() == 8);
+  std::map<int, std::string> etags_by_part_number;
+  for (size_t i = 0; i < upload_part_requests.size(); ++i) {
+    const auto part_number = upload_part_requests[i].GetPartNumber();
+    etags_by_part_number[part_number] = "etag" + std::to_string(i + 1);
+    CHECK(mock_s3_request_sender_ptr->getUploadPartRequestBody(upload_part_requests[i]) == INPUT_DATA.substr((part_number - 1) * 5, 5));
+  }
+  const auto& parts = mock_s3_request_sender_ptr->complete_multipart_upload_request.GetMultipartUpload().GetParts();
+  REQUIRE(parts.size() == 8);
+  for (size_t i = 0; i < parts.size(); ++i) {
+    CHECK(parts[i].GetPartNumber() == static_cast<int>(i + 1));
+    CHECK(parts[i].GetETag() == etags_by_part_number[static_cast<int>(i + 1)]);
+  }
+}
+
+TEST_CASE_METHOD(PutS3ObjectUploadLimitChangedTestsFixture, "Concurrent multipart upload can be continued after a failed part", "[awsS3MultipartUpload]") {
+  setRequiredProperties();
+  plan->setProperty(s3_processor, "Multipart Threshold", "35 B");
+  plan->setProperty(s3_processor, "Multipart Part Size", "5 B");
+  plan->setProperty(s3_processor, "Multipart Upload Concurrent Parts", "3");
+  plan->setProperty(s3_processor, "Object Key", "resumable_key");
+  auto temp_dir = test_controller.createTempDirectory();
+  plan->setProperty(s3_processor, "Temporary Directory Multipart State", temp_dir.string());
+  auto log_failure = plan->addProcessor(
+    "LogAttribute",
+    "LogFailure",
+    core::Relationship("failure", "d"));
+  plan->addConnection(s3_processor, core::Relationship("failure", "d"), log_failure);
+  log_failure->setAutoTerminatedRelationships(std::array{core::Relationship("success", "d")});
+  mock_s3_request_sender_ptr->setUploadPartLatency(std::chrono::milliseconds(10));
+  // at most 3 parts are in flight, so the first two parts have been uploaded before the fifth request
+  mock_s3_request_sender_ptr->failOnPartOnce(5);
+  test_controller.runSession(plan);
+  CHECK(verifyLogLinePresenceInPollTime(std::chrono::seconds(3), "Failed to upload part"));
+  plan->reset();
+  LogTestController::getInstance().clear();
+  test_controller.runSession(plan);
+  CHECK(verifyLogLinePresenceInPollTime(std::chrono::seconds(3), "Found previous multipart upload state for resumable_key"));
+
+  // the parts uploaded after the failed one are sent again, the last upload of each part is the one completed
+  std::map<int, std::string> etags_by_part_number;
+  const auto& upload_part_requests = mock_s3_request_sender_ptr->upload_part_requests;
+  for (size_t i = 0; i < upload_part_requests.size(); ++i) {
+    const auto part_number = upload_part_requests[i].GetPartNumber();
+    etags_by_part_number[part_number] = "etag" + std::to_string(i + 1);
+    CHECK(mock_s3_request_sender_ptr->getUploadPartRequestBody(upload_part_requests[i]) == INPUT_DATA.substr((part_number - 1) * 5, 5));
+  }
+  const auto& parts = mock_s3_request_sender_ptr->complete_multipart_upload_request.GetMultipartUpload().GetParts();
+  REQUIRE(parts.size() == 8);
+  for (size_t i = 0; i < parts.size(); ++i) {
+    CHECK(parts[i].GetPartNumber() == static_cast<int>(i + 1));
+    CHECK(parts[i].GetETag() == etags_by_part_number[static_cast<int>(i + 1)]);
+  }
+}
+
 }  // namespace
@@ -32,6 +32,16 @@ void FetchAzureBlobStorage::initialize() {
   setSupportedRelationships(Relationships);
 }
 
+void FetchAzureBlobStorage::onSchedule(core::ProcessContext& context, core::ProcessSessionFactory& session_factory) {
+  AzureBlobStorageProcessorBase::onSchedule(context, session_factory);
+  if (!context.getProperty(ConcurrentRangeFetches, ranged_fetch_.max_concurrent_ranges) || ranged_fetch_.max_concurrent_ranges == 0) {
+    throw Exception(PROCESS_SCHEDULE_EXCEPTION, "Concurrent Range Fetches must be at least 1");
+  }
+  if (!context.getProperty(RangeFetchSize, ranged_fetch_.range_size) || ranged_fetch_.range_size == 0) {
+    throw Exception(PROCESS_SCHEDULE_EXCEPTION, "Range Fetch Size must be greater than 0");
+  }
+}
+
 std::optional<storage::FetchAzureBlobStorageParameters> FetchAzureBlobStorage::buildFetchAzureBlobStorageParameters(
     core::ProcessContext &context, const std::shared_ptr<core::FlowFile> &flow_file) {
   storage::FetchAzureBlobStorageParameters params;
@@ -50,6 +60,8 @@ std::optional<storage::FetchAzureBlobStorageParameters> FetchAzureBlobStorage::b
     logger_->log_debug("Range Length property set to {}", *params.range_length);
   }
 
+  params.ranged_fetch = ranged_fetch_;
+
   return params;
 }
 
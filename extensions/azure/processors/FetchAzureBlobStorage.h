@@ -51,9 +51,24 @@ class FetchAzureBlobStorage final : public AzureBlobStorageSingleBlobProcessorBa
                         "An empty value or a value that extends beyond the end of the blob will read to the end of the blob.")
       .supportsExpressionLanguage(true)
       .build();
-  EXTENSIONAPI static constexpr auto Properties = utils::array_cat(AzureBlobStorageSingleBlobProcessorBase::Properties, std::array<core::PropertyReference, 2>{
+  EXTENSIONAPI static constexpr auto ConcurrentRangeFetches = core::PropertyDefinitionBuilder<>::createProperty("Concurrent Range Fetches")
+      .withDescription("Specifies the number of byte ranges of the blob that are downloaded at the same time. "
+                        "If it is more than 1, blobs larger than the Range Fetch Size are fetched in concurrent ranged requests and written to the flow file in order.")
+      .withPropertyType(core::StandardPropertyTypes::UNSIGNED_INT_TYPE)
+      .withDefaultValue("1")
+      .isRequired(true)
+      .build();
+  EXTENSIONAPI static constexpr auto RangeFetchSize = core::PropertyDefinitionBuilder<>::createProperty("Range Fetch Size")
+      .withDescription("The size of the byte ranges fetched concurrently. At most Concurrent Range Fetches ranges are held in memory at a time.")
+      .withPropertyType(core::StandardPropertyTypes::DATA_SIZE_TYPE)
+      .withDefaultValue("8 MB")
+      .isRequired(true)
+      .build();
+  EXTENSIONAPI static constexpr auto Properties = utils::array_cat(AzureBlobStorageSingleBlobProcessorBase::Properties, std::array<core::PropertyReference, 4>{
       RangeStart,
-      RangeLength
+      RangeLength,
+      ConcurrentRangeFetches,
+      RangeFetchSize
   });
 
 
@@ -73,6 +88,7 @@ class FetchAzureBlobStorage final : public AzureBlobStorageSingleBlobProcessorBa
   }
 
   void initialize() override;
+  void onSchedule(core::ProcessContext& context, core::ProcessSessionFactory& session_factory) override;
   void onTrigger(core::ProcessContext& context, core::ProcessSession& session) override;
 
  private:
@@ -84,6 +100,8 @@ class FetchAzureBlobStorage final : public AzureBlobStorageSingleBlobProcessorBa
 
   std::optional<storage::FetchAzureBlobStorageParameters> buildFetchAzureBlobStorageParameters(
     core::ProcessContext &context, const std::shared_ptr<core::FlowFile> &flow_file);
+
+  minifi::utils::ParallelRangedFetchSettings ranged_fetch_;
 };
 
 }  // namespace org::apache::nifi::minifi::azure::processors
@@ -20,8 +20,10 @@
 
 #include "AzureBlobStorage.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "azure/identity.hpp"
 #include "AzureBlobStorageClient.h"
@@ -77,6 +79,9 @@ bool AzureBlobStorage::deleteBlob(const DeleteAzureBlobStorageParameters& params
 
 std::optional<uint64_t> AzureBlobStorage::fetchBlob(const FetchAzureBlobStorageParameters& params, io::OutputStream& stream) {
   try {
+    if (params.ranged_fetch.max_concurrent_ranges > 1) {
+      return fetchBlobInRanges(params, stream);
+    }
     auto fetch_res = blob_storage_client_->fetchBlob(params);
     return internal::pipe(*fetch_res, stream);
   } catch (const std::exception& ex) {
@@ -85,6 +90,47 @@ std::optional<uint64_t> AzureBlobStorage::fetchBlob(const FetchAzureBlobStorageP
   }
 }
 
+std::optional<uint64_t> AzureBlobStorage::fetchBlobInRanges(const FetchAzureBlobStorageParameters& params, io::OutputStream& stream) {
+  const auto properties = blob_storage_client_->getBlobProperties(params);
+  const auto blob_size = gsl::narrow<uint64_t>(properties.BlobSize);
+  const auto range_start = (std::min)(params.range_start.value_or(0), blob_size);
+  const auto range_end = params.range_length ? (std::min)(range_start + *params.range_length, blob_size) : blob_size;
+
+  // every range is fetched from the same version of the blob, even if it is overwritten during the download
+  auto range_params = params;
+  range_params.etag = properties.ETag.ToString();
+  logger_->log_debug("Fetching {} bytes of Azure blob '{}' in ranges of {} bytes, {} at a time",
+    range_end - range_start, params.blob_name, params.ranged_fetch.range_size, params.ranged_fetch.max_concurrent_ranges);
+  const auto write_size = minifi::utils::parallelRangedFetch(range_end - range_start, params.ranged_fetch, [&](uint64_t offset, uint64_t length) {
+    return fetchBlobRange(range_params, range_start + offset, length);
+  }, stream);
+  if (!write_size) {
+    logger_->log_error("Failed to fetch the ranges of blob '{}' of container '{}'", params.blob_name, params.container_name);
+  }
+  return write_size;
+}
+
+std::optional<std::vector<std::byte>> AzureBlobStorage::fetchBlobRange(const FetchAzureBlobStorageParameters& params, uint64_t offset, uint64_t length) {
+  try {
+    auto range_params = params;
+    range_params.range_start = offset;
+    range_params.range_length = length;
+    auto fetch_res = blob_storage_client_->fetchBlob(range_params);
+    std::vector<std::byte> range(length);
+    for (size_t read_size = 0; read_size < range.size(); ) {
+      const auto ret = fetch_res->read(std::span(range).subspan(read_size));
+      if (ret == 0 || io::isError(ret)) {
+        return std::nullopt;
+      }
+      read_size += ret;
+    }
+    return range;
+  } catch (const std::exception& ex) {
+    logger_->log_error("An exception occurred while fetching range [{}, {}) of blob '{}': {}", offset, offset + length, params.blob_name, ex.what());
+    return std::nullopt;
+  }
+}
+
 std::optional<ListContainerResult> AzureBlobStorage::listContainer(const ListAzureBlobStorageParameters& params) {
   try {
     ListContainerResult result;
@@ -70,6 +70,9 @@ class AzureBlobStorage {
   std::optional<ListContainerResult> listContainer(const ListAzureBlobStorageParameters& params);
 
  private:
+  std::optional<uint64_t> fetchBlobInRanges(const FetchAzureBlobStorageParameters& params, io::OutputStream& stream);
+  std::optional<std::vector<std::byte>> fetchBlobRange(const FetchAzureBlobStorageParameters& params, uint64_t offset, uint64_t length);
+
   std::shared_ptr<core::logging::Logger> logger_{core::logging::LoggerFactory<AzureBlobStorage>::getLogger()};
   gsl::not_null<std::unique_ptr<BlobStorageClient>> blob_storage_client_;
 };
@@ -110,10 +110,18 @@ std::unique_ptr<io::InputStream> AzureBlobStorageClient::fetchBlob(const FetchAz
     }
     options.Range = range;
   }
+  if (params.etag) {
+    options.AccessConditions.IfMatch = Azure::ETag(*params.etag);
+  }
   auto result = blob_client.Download(options);
   return std::make_unique<AzureBlobStorageInputStream>(std::move(result.Value));
 }
 
+Azure::Storage::Blobs::Models::BlobProperties AzureBlobStorageClient::getBlobProperties(const AzureBlobStorageBlobOperationParameters& params) {
+  auto container_client = createClient(params.credentials, params.container_name);
+  return container_client->GetBlobClient(params.blob_name).GetProperties().Value;
+}
+
 std::vector<Azure::Storage::Blobs::Models::BlobItem> AzureBlobStorageClient::listContainer(const ListAzureBlobStorageParameters& params) {
   std::vector<Azure::Storage::Blobs::Models::BlobItem> result;
   auto container_client = createClient(params.credentials, params.container_name);
@@ -40,6 +40,7 @@ class AzureBlobStorageClient : public BlobStorageClient {
   std::string getUrl(const AzureBlobStorageParameters& params) override;
   bool deleteBlob(const DeleteAzureBlobStorageParameters& params) override;
   std::unique_ptr<io::InputStream> fetchBlob(const FetchAzureBlobStorageParameters& params) override;
+  Azure::Storage::Blobs::Models::BlobProperties getBlobProperties(const AzureBlobStorageBlobOperationParameters& params) override;
   std::vector<Azure::Storage::Blobs::Models::BlobItem> listContainer(const ListAzureBlobStorageParameters& params) override;
 
  private:
@@ -29,6 +29,7 @@
 #include "AzureStorageCredentials.h"
 #include "utils/gsl.h"
 #include "utils/Enum.h"
+#include "utils/ParallelRangedFetch.h"
 #include "io/InputStream.h"
 
 namespace org::apache::nifi::minifi::azure::storage {
@@ -77,6 +78,9 @@ struct DeleteAzureBlobStorageParameters : public AzureBlobStorageBlobOperationPa
 struct FetchAzureBlobStorageParameters : public AzureBlobStorageBlobOperationParameters {
   std::optional<uint64_t> range_start;
   std::optional<uint64_t> range_length;
+  // the blob is only fetched if its ETag still matches
+  std::optional<std::string> etag;
+  minifi::utils::ParallelRangedFetchSettings ranged_fetch;
 };
 
 struct ListAzureBlobStorageParameters : public AzureBlobStorageParameters {
@@ -90,6 +94,7 @@ class BlobStorageClient {
   virtual std::string getUrl(const AzureBlobStorageParameters& params) = 0;
   virtual bool deleteBlob(const DeleteAzureBlobStorageParameters& params) = 0;
   virtual std::unique_ptr<io::InputStream> fetchBlob(const FetchAzureBlobStorageParameters& params) = 0;
+  virtual Azure::Storage::Blobs::Models::BlobProperties getBlobProperties(const AzureBlobStorageBlobOperationParameters& params) = 0;
   virtual std::vector<Azure::Storage::Blobs::Models::BlobItem> listContainer(const ListAzureBlobStorageParameters& params) = 0;
   virtual ~BlobStorageClient() = default;
 };
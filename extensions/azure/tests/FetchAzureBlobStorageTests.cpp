@@ -16,6 +16,11 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "AzureBlobStorageTestsFixture.h"
 #include "processors/FetchAzureBlobStorage.h"
 
@@ -252,6 +257,37 @@ TEST_CASE_METHOD(FetchAzureBlobStorageTestsFixture, "Fetch a range of the blob s
   REQUIRE(success_contents[0] == mock_blob_storage_ptr_->FETCHED_DATA.substr(5, 10));
 }
 
+TEST_CASE_METHOD(FetchAzureBlobStorageTestsFixture, "Fetch the blob in concurrent ranges succeeds", "[azureBlobStorageFetch]") {
+  plan_->setProperty(azure_blob_storage_processor_, minifi::azure::processors::FetchAzureBlobStorage::ContainerName, CONTAINER_NAME);
+  plan_->setProperty(azure_blob_storage_processor_, minifi::azure::processors::FetchAzureBlobStorage::ConcurrentRangeFetches, "3");
+  plan_->setProperty(azure_blob_storage_processor_, minifi::azure::processors::FetchAzureBlobStorage::RangeFetchSize, "4 B");
+  std::string expected_content;
+  std::vector<std::pair<uint64_t, uint64_t>> expected_ranges;
+
+  SECTION("Full blob") {
+    expected_content = mock_blob_storage_ptr_->FETCHED_DATA;
+    expected_ranges = {{0, 4}, {4, 4}, {8, 4}, {12, 4}, {16, 4}, {20, 4}, {24, 2}};
+  }
+
+  SECTION("Range of the blob") {
+    plan_->setProperty(azure_blob_storage_processor_, minifi::azure::processors::FetchAzureBlobStorage::RangeStart, "5");
+    plan_->setProperty(azure_blob_storage_processor_, minifi::azure::processors::FetchAzureBlobStorage::RangeLength, "10");
+    expected_content = mock_blob_storage_ptr_->FETCHED_DATA.substr(5, 10);
+    expected_ranges = {{5, 4}, {9, 4}, {13, 2}};
+  }
+
+  setDefaultCredentials();
+  test_controller_.runSession(plan_, true);
+  CHECK(getFailedFlowFileContents().empty());
+  auto success_contents = getSuccessfulFlowFileContents();
+  REQUIRE(success_contents.size() == 1);
+  REQUIRE(success_contents[0] == expected_content);
+  auto fetched_ranges = mock_blob_storage_ptr_->getFetchedRanges();
+  std::sort(fetched_ranges.begin(), fetched_ranges.end());
+  CHECK(fetched_ranges == expected_ranges);
+  CHECK(mock_blob_storage_ptr_->getPassedFetchParams().etag == mock_blob_storage_ptr_->ETAG);
+}
+
 TEST_CASE_METHOD(FetchAzureBlobStorageTestsFixture, "Fetch full file fails", "[azureBlobStorageFetch]") {
   plan_->setProperty(azure_blob_storage_processor_, minifi::azure::processors::FetchAzureBlobStorage::ContainerName, CONTAINER_NAME);
   setDefaultCredentials();
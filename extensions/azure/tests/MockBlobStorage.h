@@ -20,6 +20,7 @@
 
 #include <string>
 #include <memory>
+#include <mutex>
 #include <utility>
 #include <vector>
 
@@ -75,6 +76,7 @@ class MockBlobStorage : public minifi::azure::storage::BlobStorageClient {
       throw std::runtime_error("error");
     }
 
+    std::lock_guard<std::mutex> lock(fetch_mutex_);
     fetch_params_ = params;
     buffer_.clear();
     uint64_t range_start = 0;
@@ -86,11 +88,19 @@ class MockBlobStorage : public minifi::azure::storage::BlobStorageClient {
     if (params.range_length) {
       size = *params.range_length;
     }
+    fetched_ranges_.emplace_back(range_start, size);
 
     buffer_.assign(FETCHED_DATA.begin() + range_start, FETCHED_DATA.begin() + range_start + size);
     return std::make_unique<org::apache::nifi::minifi::io::BufferStream>(gsl::make_span(buffer_).as_span<const std::byte>());
   }
 
+  Azure::Storage::Blobs::Models::BlobProperties getBlobProperties(const minifi::azure::storage::AzureBlobStorageBlobOperationParameters& /*params*/) override {
+    Azure::Storage::Blobs::Models::BlobProperties properties;
+    properties.BlobSize = gsl::narrow<int64_t>(FETCHED_DATA.size());
+    properties.ETag = Azure::ETag{ETAG};
+    return properties;
+  }
+
   std::vector<Azure::Storage::Blobs::Models::BlobItem> listContainer(const minifi::azure::storage::ListAzureBlobStorageParameters& params) override {
     list_params_ = params;
     std::vector<Azure::Storage::Blobs::Models::BlobItem> result;
@@ -130,6 +140,10 @@ class MockBlobStorage : public minifi::azure::storage::BlobStorageClient {
     return fetch_params_;
   }
 
+  std::vector<std::pair<uint64_t, uint64_t>> getFetchedRanges() const {
+    return fetched_ranges_;
+  }
+
   minifi::azure::storage::ListAzureBlobStorageParameters getPassedListParams() const {
     return list_params_;
   }
@@ -166,4 +180,6 @@ class MockBlobStorage : public minifi::azure::storage::BlobStorageClient {
   bool fetch_fails_ = false;
   std::string input_data_;
   std::vector<uint8_t> buffer_;
+  std::mutex fetch_mutex_;
+  std::vector<std::pair<uint64_t, uint64_t>> fetched_ranges_;
 };
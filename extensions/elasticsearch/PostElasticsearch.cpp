@@ -226,10 +226,7 @@ std::string PostElasticsearch::collectPayload(core::ProcessContext& context,
                                               core::ProcessSession& session,
                                               std::vector<std::shared_ptr<core::FlowFile>>& flowfiles_with_payload) const {
   std::stringstream payload;
-  for (size_t flow_files_processed = 0; flow_files_processed < max_batch_size_; ++flow_files_processed) {
-    auto flow_file = session.get();
-    if (!flow_file)
-      break;
+  for (const auto& flow_file : session.get(max_batch_size_)) {
     auto elastic_payload = ElasticPayload::parse(session, context, flow_file);
     if (!elastic_payload) {
       logger_->log_error("{}", elastic_payload.error());
@@ -21,8 +21,12 @@
 #include <iomanip>
 #include <random>
 #include <algorithm>
+#include <array>
 #include <regex>
 #include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
 #include <string>
 
 #include "rapidjson/reader.h"
@@ -32,7 +36,9 @@
 #include "utils/StringUtils.h"
 #include "utils/OsUtils.h"
 #include "expression/Expression.h"
+#include "expression/Program.h"
 #include "utils/RegexUtils.h"
+#include "utils/LruCache.h"
 
 #ifndef DISABLE_CURL
 #ifdef WIN32
@@ -90,7 +96,7 @@ Expression make_dynamic(const std::function<Value(const Parameters &params, cons
 }
 
 Expression make_dynamic_attr(const std::string &attribute_id) {
-  return make_dynamic([attribute_id](const Parameters &params, const std::vector<Expression>& /*sub_exprs*/) -> Value {
+  auto result = make_dynamic([attribute_id](const Parameters &params, const std::vector<Expression>& /*sub_exprs*/) -> Value {
     std::string result;
     const auto cur_flow_file = params.flow_file.lock();
     if (cur_flow_file && cur_flow_file->getAttribute(attribute_id, result)) {
@@ -103,9 +109,11 @@ Expression make_dynamic_attr(const std::string &attribute_id) {
     }
     return {};
   });
+  result.set_program(Program::makeAttribute(attribute_id));
+  return result;
 }
 
-Value resolve_user_id(const std::vector<Value> &args) {
+Value resolve_user_id(std::span<const Value> args) {
   std::string name;
   if (args.size() == 1) {
     name = args[0].asString();
@@ -117,7 +125,7 @@ Value resolve_user_id(const std::vector<Value> &args) {
   return Value(name);
 }
 
-Value expr_hostname(const std::vector<Value> &args) {
+Value expr_hostname(std::span<const Value> args) {
   std::array<char, 1024> hostname{};
   gethostname(hostname.data(), 1023);
 
@@ -152,7 +160,7 @@ Value expr_hostname(const std::vector<Value> &args) {
   return Value(std::string(hostname.data()));
 }
 
-Value expr_ip(const std::vector<Value>& /*args*/) {
+Value expr_ip(std::span<const Value> /*args*/) {
   std::array<char, 1024> hostname{};
   gethostname(hostname.data(), 1023);
 
@@ -185,7 +193,7 @@ Value expr_ip(const std::vector<Value>& /*args*/) {
   return {};
 }
 
-Value expr_reverseDnsLookup(const std::vector<Value>& args) {
+Value expr_reverseDnsLookup(std::span<const Value> args) {
   std::string ip_address_str = args[0].asString();
 
   std::chrono::steady_clock::duration timeout_duration = 5s;
@@ -205,23 +213,23 @@ Value expr_reverseDnsLookup(const std::vector<Value>& args) {
       });
 }
 
-Value expr_uuid(const std::vector<Value>& /*args*/) {
+Value expr_uuid(std::span<const Value> /*args*/) {
   return Value(utils::IdGenerator::getIdGenerator()->generate().to_string());
 }
 
-Value expr_toUpper(const std::vector<Value> &args) {
+Value expr_toUpper(std::span<const Value> args) {
   std::string result = args[0].asString();
   std::transform(result.begin(), result.end(), result.begin(), ::toupper);
   return Value(result);
 }
 
-Value expr_toLower(const std::vector<Value> &args) {
+Value expr_toLower(std::span<const Value> args) {
   std::string result = args[0].asString();
   std::transform(result.begin(), result.end(), result.begin(), ::tolower);
   return Value(result);
 }
 
-Value expr_substring(const std::vector<Value> &args) {
+Value expr_substring(std::span<const Value> args) {
   if (args.size() < 3) {
     auto offset = gsl::narrow<size_t>(args[1].asUnsignedLong());
     return Value{args[0].asString().substr(offset)};
@@ -232,12 +240,12 @@ Value expr_substring(const std::vector<Value> &args) {
   }
 }
 
-Value expr_substringBefore(const std::vector<Value> &args) {
+Value expr_substringBefore(std::span<const Value> args) {
   const std::string &arg_0 = args[0].asString();
   return Value(arg_0.substr(0, arg_0.find(args[1].asString())));
 }
 
-Value expr_substringBeforeLast(const std::vector<Value> &args) {
+Value expr_substringBeforeLast(std::span<const Value> args) {
   size_t last_pos = 0;
   const std::string &arg_0 = args[0].asString();
   const std::string &arg_1 = args[1].asString();
@@ -247,13 +255,13 @@ Value expr_substringBeforeLast(const std::vector<Value> &args) {
   return Value(arg_0.substr(0, last_pos));
 }
 
-Value expr_substringAfter(const std::vector<Value> &args) {
+Value expr_substringAfter(std::span<const Value> args) {
   const std::string &arg_0 = args[0].asString();
   const std::string &arg_1 = args[1].asString();
   return Value(arg_0.substr(arg_0.find(arg_1) + arg_1.length()));
 }
 
-Value expr_substringAfterLast(const std::vector<Value> &args) {
+Value expr_substringAfterLast(std::span<const Value> args) {
   size_t last_pos = 0;
   const std::string &arg_0 = args[0].asString();
   const std::string &arg_1 = args[1].asString();
@@ -263,7 +271,7 @@ Value expr_substringAfterLast(const std::vector<Value> &args) {
   return Value(arg_0.substr(last_pos + arg_1.length()));
 }
 
-Value expr_getDelimitedField(const std::vector<Value> &args) {
+Value expr_getDelimitedField(std::span<const Value> args) {
   const auto &subject = args[0].asString();
   const auto &index = args[1].asUnsignedLong() - 1;
   char delimiter_ch = ',';
@@ -383,23 +391,23 @@ Value expr_getDelimitedField(const std::vector<Value> &args) {
   return Value(result);
 }
 
-Value expr_startsWith(const std::vector<Value> &args) {
+Value expr_startsWith(std::span<const Value> args) {
   const std::string &arg_0 = args[0].asString();
   const std::string &arg_1 = args[1].asString();
   return Value(arg_0.substr(0, arg_1.length()) == arg_1);
 }
 
-Value expr_endsWith(const std::vector<Value> &args) {
+Value expr_endsWith(std::span<const Value> args) {
   const std::string &arg_0 = args[0].asString();
   const std::string &arg_1 = args[1].asString();
   return Value(arg_0.substr(arg_0.length() - arg_1.length()) == arg_1);
 }
 
-Value expr_contains(const std::vector<Value> &args) {
+Value expr_contains(std::span<const Value> args) {
   return Value(std::string::npos != args[0].asString().find(args[1].asString()));
 }
 
-Value expr_in(const std::vector<Value> &args) {
+Value expr_in(std::span<const Value> args) {
   const std::string &arg_0 = args[0].asString();
   for (size_t i = 1; i < args.size(); i++) {
     if (arg_0 == args[i].asString()) {
@@ -410,7 +418,7 @@ Value expr_in(const std::vector<Value> &args) {
   return Value(false);
 }
 
-Value expr_indexOf(const std::vector<Value> &args) {
+Value expr_indexOf(std::span<const Value> args) {
   auto pos = args[0].asString().find(args[1].asString());
 
   if (pos == std::string::npos) {
@@ -420,7 +428,7 @@ Value expr_indexOf(const std::vector<Value> &args) {
   }
 }
 
-Value expr_lastIndexOf(const std::vector<Value> &args) {
+Value expr_lastIndexOf(std::span<const Value> args) {
   size_t pos = std::string::npos;
   const std::string &arg_0 = args[0].asString();
   const std::string &arg_1 = args[1].asString();
@@ -438,7 +446,7 @@ Value expr_lastIndexOf(const std::vector<Value> &args) {
   }
 }
 
-Value expr_escapeJson(const std::vector<Value> &args) {
+Value expr_escapeJson(std::span<const Value> args) {
   const std::string &arg_0 = args[0].asString();
   rapidjson::StringBuffer buf;
   rapidjson::Writer<rapidjson::StringBuffer> writer(buf);
@@ -447,7 +455,7 @@ Value expr_escapeJson(const std::vector<Value> &args) {
   return Value(result.substr(1, result.length() - 2));
 }
 
-Value expr_unescapeJson(const std::vector<Value> &args) {
+Value expr_unescapeJson(std::span<const Value> args) {
   std::stringstream arg_0_ss;
   arg_0_ss << "[\"" << args[0].asString() << "\"]";
   rapidjson::Reader reader;
@@ -460,7 +468,7 @@ Value expr_unescapeJson(const std::vector<Value> &args) {
   }
 }
 
-Value expr_escapeHtml3(const std::vector<Value> &args) {
+Value expr_escapeHtml3(std::span<const Value> args) {
   return Value(utils::StringUtils::replaceMap(args[0].asString(), { { "!", "&excl;" }, { "\"", "&quot;" }, { "#", "&num;" }, { "$", "&dollar;" }, { "%", "&percnt;" }, { "&", "&amp;" },
                                                   { "'", "&apos;" }, { "(", "&lpar;" }, { ")", "&rpar;" }, { "*", "&ast;" }, { "+", "&plus;" }, { ",", "&comma;" }, { "-", "&minus;" }, { ".",
                                                       "&period;" }, { "/", "&sol;" }, { ":", "&colon;" }, { ";", "&semi;" }, { "<", "&lt;" }, { "=", "&equals;" }, { ">", "&gt;" }, { "?", "&quest;" },
@@ -481,7 +489,7 @@ Value expr_escapeHtml3(const std::vector<Value> &args) {
                                                       "&ugrave;" }, { "ú", "&uacute;" }, { "û", "&ucirc;" }, { "ü", "&uuml;" }, { "ý", "&yacute;" }, { "þ", "&thorn;" }, { "ÿ", "&yuml;" } }));
 }
 
-Value expr_escapeHtml4(const std::vector<Value> &args) {
+Value expr_escapeHtml4(std::span<const Value> args) {
   return Value(utils::StringUtils::replaceMap(args[0].asString(), { { "!", "&excl;" }, { "\"", "&quot;" }, { "#", "&num;" }, { "$", "&dollar;" }, { "%", "&percnt;" }, { "&", "&amp;" },
                                                   { "'", "&apos;" }, { "(", "&lpar;" }, { ")", "&rpar;" }, { "*", "&ast;" }, { "+", "&plus;" }, { ",", "&comma;" }, { "-", "&minus;" }, { ".",
                                                       "&period;" }, { "/", "&sol;" }, { ":", "&colon;" }, { ";", "&semi;" }, { "<", "&lt;" }, { "=", "&equals;" }, { ">", "&gt;" }, { "?", "&quest;" },
@@ -529,7 +537,7 @@ Value expr_escapeHtml4(const std::vector<Value> &args) {
                                                       "&rsaquo;" }, { "\u20AC", "&euro;" } }));
 }
 
-Value expr_unescapeHtml3(const std::vector<Value> &args) {
+Value expr_unescapeHtml3(std::span<const Value> args) {
   return Value(utils::StringUtils::replaceMap(args[0].asString(), { { "&excl;", "!" }, { "&quot;", "\"" }, { "&num;", "#" }, { "&dollar;", "$" }, { "&percnt;", "%" }, { "&amp;", "&" },
                                                   { "&apos;", "'" }, { "&lpar;", "(" }, { "&rpar;", ")" }, { "&ast;", "*" }, { "&plus;", "+" }, { "&comma;", "," }, { "&minus;", "-" }, { "&period;",
                                                       "." }, { "&sol;", "/" }, { "&colon;", ":" }, { "&semi;", ";" }, { "&lt;", "<" }, { "&equals;", "=" }, { "&gt;", ">" }, { "&quest;", "?" }, {
@@ -550,7 +558,7 @@ Value expr_unescapeHtml3(const std::vector<Value> &args) {
                                                       "&uacute;", "ú" }, { "&ucirc;", "û" }, { "&uuml;", "ü" }, { "&yacute;", "ý" }, { "&thorn;", "þ" }, { "&yuml;", "ÿ" } }));
 }
 
-Value expr_unescapeHtml4(const std::vector<Value> &args) {
+Value expr_unescapeHtml4(std::span<const Value> args) {
   return Value(utils::StringUtils::replaceMap(args[0].asString(), { { "&excl;", "!" }, { "&quot;", "\"" }, { "&num;", "#" }, { "&dollar;", "$" }, { "&percnt;", "%" }, { "&amp;", "&" },
                                                   { "&apos;", "'" }, { "&lpar;", "(" }, { "&rpar;", ")" }, { "&ast;", "*" }, { "&plus;", "+" }, { "&comma;", "," }, { "&minus;", "-" }, { "&period;",
                                                       "." }, { "&sol;", "/" }, { "&colon;", ":" }, { "&semi;", ";" }, { "&lt;", "<" }, { "&equals;", "=" }, { "&gt;", ">" }, { "&quest;", "?" }, {
@@ -598,15 +606,15 @@ Value expr_unescapeHtml4(const std::vector<Value> &args) {
                                                       "\u203A" }, { "&euro;", "\u20AC" } }));
 }
 
-Value expr_escapeXml(const std::vector<Value> &args) {
+Value expr_escapeXml(std::span<const Value> args) {
   return Value(utils::StringUtils::replaceMap(args[0].asString(), { { "\"", "&quot;" }, { "'", "&apos;" }, { "<", "&lt;" }, { ">", "&gt;" }, { "&", "&amp;" } }));
 }
 
-Value expr_unescapeXml(const std::vector<Value> &args) {
+Value expr_unescapeXml(std::span<const Value> args) {
   return Value(utils::StringUtils::replaceMap(args[0].asString(), { { "&quot;", "\"" }, { "&apos;", "'" }, { "&lt;", "<" }, { "&gt;", ">" }, { "&amp;", "&" } }));
 }
 
-Value expr_escapeCsv(const std::vector<Value> &args) {
+Value expr_escapeCsv(std::span<const Value> args) {
   auto result = args[0].asString();
   const std::array<char, 4> quote_req_chars = { '"', '\r', '\n', ',' };
   bool quote_required = false;
@@ -628,7 +636,7 @@ Value expr_escapeCsv(const std::vector<Value> &args) {
   return Value(result);
 }
 
-Value expr_format(const std::vector<Value> &args) {
+Value expr_format(std::span<const Value> args) {
   using std::chrono::milliseconds;
 
   date::sys_time<milliseconds> utc_time_point{milliseconds(args[0].asUnsignedLong())};
@@ -641,7 +649,7 @@ Value expr_format(const std::vector<Value> &args) {
   return Value(result_stream.str());
 }
 
-Value expr_toDate(const std::vector<Value> &args) {
+Value expr_toDate(std::span<const Value> args) {
   using std::chrono::milliseconds;
   auto input_string = args[0].asString();
 
@@ -666,12 +674,12 @@ Value expr_toDate(const std::vector<Value> &args) {
   return Value(int64_t{std::chrono::duration_cast<milliseconds>(zoned_time_point.get_sys_time().time_since_epoch()).count()});
 }
 
-Value expr_now(const std::vector<Value>& /*args*/) {
+Value expr_now(std::span<const Value> /*args*/) {
   using std::chrono::milliseconds;
   return Value(int64_t{std::chrono::duration_cast<milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count()});
 }
 
-Value expr_unescapeCsv(const std::vector<Value> &args) {
+Value expr_unescapeCsv(std::span<const Value> args) {
   auto result = args[0].asString();
 
   if (result[0] == '"' && result[result.size() - 1] == '"') {
@@ -700,7 +708,7 @@ Value expr_unescapeCsv(const std::vector<Value> &args) {
   return Value(result);
 }
 
-Value expr_urlEncode(const std::vector<Value> &args) {
+Value expr_urlEncode(std::span<const Value> args) {
 #ifndef DISABLE_CURL
   auto arg_0 = args[0].asString();
   CURL *curl = curl_easy_init();
@@ -723,7 +731,7 @@ Value expr_urlEncode(const std::vector<Value> &args) {
 #endif
 }
 
-Value expr_urlDecode(const std::vector<Value> &args) {
+Value expr_urlDecode(std::span<const Value> args) {
 #ifndef DISABLE_CURL
   auto arg_0 = args[0].asString();
   CURL *curl = curl_easy_init();
@@ -747,15 +755,15 @@ Value expr_urlDecode(const std::vector<Value> &args) {
 #endif
 }
 
-Value expr_base64Encode(const std::vector<Value> &args) {
+Value expr_base64Encode(std::span<const Value> args) {
   return Value(utils::StringUtils::to_base64(args[0].asString()));
 }
 
-Value expr_base64Decode(const std::vector<Value> &args) {
+Value expr_base64Decode(std::span<const Value> args) {
   return Value(utils::StringUtils::from_base64(args[0].asString(), utils::as_string));
 }
 
-Value expr_replace(const std::vector<Value> &args) {
+Value expr_replace(std::span<const Value> args) {
   std::string result = args[0].asString();
   const std::string &find = args[1].asString();
   const std::string &replace = args[2].asString();
@@ -771,21 +779,53 @@ Value expr_replace(const std::vector<Value> &args) {
   return Value(result);
 }
 
-Value expr_replaceFirst(const std::vector<Value> &args) {
+namespace {
+
+// compiling a regex is much more expensive than matching with it, so the regexes of patterns which are only known
+// when the expression is evaluated are cached (the literal patterns are compiled along with the expression)
+template<typename RegexType>
+class RegexCache {
+ public:
+  static constexpr size_t CAPACITY = 256;
+
+  std::shared_ptr<const RegexType> get(const std::string& pattern) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (auto* regex = cache_.get(pattern)) {
+        return *regex;
+      }
+    }
+    auto regex = std::make_shared<const RegexType>(pattern);
+    std::lock_guard<std::mutex> lock(mutex_);
+    return cache_.put(pattern, std::move(regex));
+  }
+
+ private:
+  std::mutex mutex_;
+  utils::LruCache<std::string, std::shared_ptr<const RegexType>> cache_{CAPACITY};
+};
+
+template<typename RegexType>
+std::shared_ptr<const RegexType> getCachedRegex(const std::string& pattern) {
+  static RegexCache<RegexType> cache;
+  return cache.get(pattern);
+}
+
+}  // namespace
+
+Value expr_replaceFirst(std::span<const Value> args, const std::regex &find) {
   std::string result = args[0].asString();
-  const std::regex find(args[1].asString());
   const std::string &replace = args[2].asString();
   return Value(std::regex_replace(result, find, replace, std::regex_constants::format_first_only));
 }
 
-Value expr_replaceAll(const std::vector<Value> &args) {
+Value expr_replaceAll(std::span<const Value> args, const std::regex &find) {
   std::string result = args[0].asString();
-  const std::regex find(args[1].asString());
   const std::string &replace = args[2].asString();
   return Value(std::regex_replace(result, find, replace));
 }
 
-Value expr_replaceNull(const std::vector<Value> &args) {
+Value expr_replaceNull(std::span<const Value> args) {
   if (args[0].isNull()) {
     return args[1];
   } else {
@@ -793,47 +833,45 @@ Value expr_replaceNull(const std::vector<Value> &args) {
   }
 }
 
-Value expr_replaceEmpty(const std::vector<Value> &args) {
+Value expr_replaceEmpty(std::span<const Value> args) {
   std::string result = args[0].asString();
-  const std::regex find("^[ \n\r\t]*$");
+  static const std::regex find("^[ \n\r\t]*$");
   const std::string &replace = args[1].asString();
   return Value(std::regex_replace(result, find, replace));
 }
 
-Value expr_matches(const std::vector<Value> &args) {
+Value expr_matches(std::span<const Value> args, const utils::Regex &expr) {
   const auto &subject = args[0].asString();
-  const auto expr = utils::Regex(args[1].asString());
 
   return Value(utils::regexMatch(subject, expr));
 }
 
-Value expr_find(const std::vector<Value> &args) {
+Value expr_find(std::span<const Value> args, const utils::Regex &expr) {
   const auto &subject = args[0].asString();
-  const auto expr = utils::Regex(args[1].asString());
 
   return Value(utils::regexSearch(subject, expr));
 }
 
-Value expr_trim(const std::vector<Value> &args) {
+Value expr_trim(std::span<const Value> args) {
   return Value{utils::StringUtils::trim(args[0].asString())};
 }
 
-Value expr_append(const std::vector<Value> &args) {
+Value expr_append(std::span<const Value> args) {
   std::string result = args[0].asString();
   return Value(result.append(args[1].asString()));
 }
 
-Value expr_prepend(const std::vector<Value> &args) {
+Value expr_prepend(std::span<const Value> args) {
   std::string result = args[1].asString();
   return Value(result.append(args[0].asString()));
 }
 
-Value expr_length(const std::vector<Value> &args) {
+Value expr_length(std::span<const Value> args) {
   uint64_t len = args[0].asString().length();
   return Value(len);
 }
 
-Value expr_binary_op(const std::vector<Value> &args, long double (*ldop)(long double, long double), int64_t (*iop)(int64_t, int64_t), bool long_only = false) {
+Value expr_binary_op(std::span<const Value> args, long double (*ldop)(long double, long double), int64_t (*iop)(int64_t, int64_t), bool long_only = false) {
   try {
     if (!long_only && !args[0].isDecimal() && !args[1].isDecimal()) {
       return Value(iop(args[0].asSignedLong(), args[1].asSignedLong()));
@@ -845,27 +883,27 @@ Value expr_binary_op(const std::vector<Value> &args, long double (*ldop)(long do
   }
 }
 
-Value expr_plus(const std::vector<Value> &args) {
+Value expr_plus(std::span<const Value> args) {
   return expr_binary_op(args, [](long double a, long double b) {return a + b;}, [](int64_t a, int64_t b) {return a + b;});
 }
 
-Value expr_minus(const std::vector<Value> &args) {
+Value expr_minus(std::span<const Value> args) {
   return expr_binary_op(args, [](long double a, long double b) {return a - b;}, [](int64_t a, int64_t b) {return a - b;});
 }
 
-Value expr_multiply(const std::vector<Value> &args) {
+Value expr_multiply(std::span<const Value> args) {
   return expr_binary_op(args, [](long double a, long double b) {return a * b;}, [](int64_t a, int64_t b) {return a * b;});
 }
 
-Value expr_divide(const std::vector<Value> &args) {
+Value expr_divide(std::span<const Value> args) {
   return expr_binary_op(args, [](long double a, long double b) {return a / b;}, [](int64_t a, int64_t b) {return a / b;}, true);
 }
 
-Value expr_mod(const std::vector<Value> &args) {
+Value expr_mod(std::span<const Value> args) {
   return expr_binary_op(args, [](long double a, long double b) {return std::fmod(a, b);}, [](int64_t a, int64_t b) {return a % b;});
 }
 
-Value expr_toRadix(const std::vector<Value> &args) {
+Value expr_toRadix(std::span<const Value> args) {
   int64_t radix = args[1].asSignedLong();
 
   if (radix < 2 || radix > 36) {
@@ -903,7 +941,7 @@ Value expr_toRadix(const std::vector<Value> &args) {
   return Value(ss.str());
 }
 
-Value expr_fromRadix(const std::vector<Value> &args) {
+Value expr_fromRadix(std::span<const Value> args) {
   int radix = gsl::narrow<int>(args[1].asSignedLong());
 
   if (radix < 2 || radix > 36) {
@@ -913,15 +951,17 @@ Value expr_fromRadix(const std::vector<Value> &args) {
   return Value(std::to_string(std::stoll(args[0].asString(), nullptr, radix)));
 }
 
-Value expr_random(const std::vector<Value>& /*args*/) {
+Value expr_random(std::span<const Value> /*args*/) {
   std::random_device random_device;
   std::mt19937 generator(random_device());
   std::uniform_int_distribution<int64_t> distribution(0, LLONG_MAX);
   return Value(distribution(generator));
 }
 
-template<Value T(const std::vector<Value> &)>
-Expression make_dynamic_function_incomplete(const std::string &function_name, const std::vector<Expression> &args, std::size_t num_args) {
+constexpr size_t MAX_INLINE_ARGUMENT_COUNT = 4;
+
+template<typename Fn>
+Expression make_dynamic_function_incomplete_impl(const std::string &function_name, const std::vector<Expression> &args, std::size_t num_args, Fn fn) {
   if (args.size() < num_args) {
     std::stringstream message_ss;
     message_ss << "Expression language function " << function_name << " called with " << args.size() << " argument(s), but " << num_args << " are required";
@@ -935,10 +975,20 @@ Expression make_dynamic_function_incomplete(const std::string &function_name, co
       multi_args.emplace_back(*it);
     }
 
-    return args[0].compose_multi([=](const std::vector<Value> &args) -> Value {
-      return T(args);
+    return args[0].compose_multi([=](std::span<const Value> args) -> Value {
+      return fn(args);
     },
                                  multi_args);
+  } else if (args.size() <= MAX_INLINE_ARGUMENT_COUNT) {
+    // the arguments of almost all functions fit in a buffer on the stack, so evaluating them does not allocate
+    return make_dynamic([=](const Parameters &params, const std::vector<Expression>& /*sub_exprs*/) -> Value {
+      std::array<Value, MAX_INLINE_ARGUMENT_COUNT> evaluated_args;
+      for (size_t i = 0; i < args.size(); ++i) {
+        evaluated_args[i] = args[i](params);
+      }
+
+      return fn(std::span<const Value>(evaluated_args.data(), args.size()));
+    });
   } else {
     return make_dynamic([=](const Parameters &params, const std::vector<Expression>& /*sub_exprs*/) -> Value {
       std::vector<Value> evaluated_args;
@@ -947,24 +997,54 @@ Expression make_dynamic_function_incomplete(const std::string &function_name, co
         evaluated_args.emplace_back(arg(params));
       }
 
-      return T(evaluated_args);
+      return fn(evaluated_args);
     });
   }
 }
 
-Value expr_literal(const std::vector<Value> &args) {
+template<Value T(std::span<const Value>)>
+Expression make_dynamic_function_incomplete(const std::string &function_name, const std::vector<Expression> &args, std::size_t num_args) {
+  return make_dynamic_function_incomplete_impl(function_name, args, num_args, T);
+}
+
+/**
+ * Creates a function whose first argument after the subject is a regex pattern. Literal patterns are compiled here,
+ * the others are looked up in the regex cache when the function is evaluated.
+ */
+template<typename RegexType, Value T(std::span<const Value>, const RegexType &)>
+Expression make_regex_function_incomplete(const std::string &function_name, const std::vector<Expression> &args, std::size_t num_args) {
+  if (args.size() > 1 && !args[1].is_dynamic()) {
+    std::shared_ptr<const RegexType> regex;
+    try {
+      regex = std::make_shared<const RegexType>(args[1](Parameters{}).asString());
+    } catch (const std::exception&) {
+      // invalid patterns are reported when the expression is evaluated
+    }
+    if (regex) {
+      return make_dynamic_function_incomplete_impl(function_name, args, num_args, [regex](std::span<const Value> evaluated_args) -> Value {
+        return T(evaluated_args, *regex);
+      });
+    }
+  }
+
+  return make_dynamic_function_incomplete_impl(function_name, args, num_args, [](std::span<const Value> evaluated_args) -> Value {
+    return T(evaluated_args, *getCachedRegex<RegexType>(evaluated_args[1].asString()));
+  });
+}
+
+Value expr_literal(std::span<const Value> args) {
   return args[0];
 }
 
-Value expr_isNull(const std::vector<Value> &args) {
+Value expr_isNull(std::span<const Value> args) {
   return Value(args[0].isNull());
 }
 
-Value expr_notNull(const std::vector<Value> &args) {
+Value expr_notNull(std::span<const Value> args) {
   return Value(!args[0].isNull());
 }
 
-Value expr_isEmpty(const std::vector<Value> &args) {
+Value expr_isEmpty(std::span<const Value> args) {
   if (args[0].isNull()) {
     return Value(true);
   }
@@ -980,11 +1060,11 @@ Value expr_isEmpty(const std::vector<Value> &args) {
   return Value(true);
 }
 
-Value expr_equals(const std::vector<Value> &args) {
+Value expr_equals(std::span<const Value> args) {
   return Value(args[0].asString() == args[1].asString());
 }
 
-Value expr_equalsIgnoreCase(const std::vector<Value> &args) {
+Value expr_equalsIgnoreCase(std::span<const Value> args) {
   auto arg_0 = args[0].asString();
   auto arg_1 = args[1].asString();
 
@@ -994,7 +1074,7 @@ Value expr_equalsIgnoreCase(const std::vector<Value> &args) {
   return Value(arg_0 == arg_1);
 }
 
-Value expr_gt(const std::vector<Value> &args) {
+Value expr_gt(std::span<const Value> args) {
   if (args[0].isDecimal() && args[1].isDecimal()) {
     return Value(args[0].asLongDouble() > args[1].asLongDouble());
   } else {
@@ -1002,7 +1082,7 @@ Value expr_gt(const std::vector<Value> &args) {
   }
 }
 
-Value expr_ge(const std::vector<Value> &args) {
+Value expr_ge(std::span<const Value> args) {
   if (args[0].isDecimal() && args[1].isDecimal()) {
     return Value(args[0].asLongDouble() >= args[1].asLongDouble());
   } else {
@@ -1010,7 +1090,7 @@ Value expr_ge(const std::vector<Value> &args) {
   }
 }
 
-Value expr_lt(const std::vector<Value> &args) {
+Value expr_lt(std::span<const Value> args) {
   if (args[0].isDecimal() && args[1].isDecimal()) {
     return Value(args[0].asLongDouble() < args[1].asLongDouble());
   } else {
@@ -1018,7 +1098,7 @@ Value expr_lt(const std::vector<Value> &args) {
   }
 }
 
-Value expr_le(const std::vector<Value> &args) {
+Value expr_le(std::span<const Value> args) {
   if (args[0].isDecimal() && args[1].isDecimal()) {
     return Value(args[0].asLongDouble() <= args[1].asLongDouble());
   } else {
@@ -1026,19 +1106,19 @@ Value expr_le(const std::vector<Value> &args) {
   }
 }
 
-Value expr_and(const std::vector<Value> &args) {
+Value expr_and(std::span<const Value> args) {
   return Value(args[0].asBoolean() && args[1].asBoolean());
 }
 
-Value expr_or(const std::vector<Value> &args) {
+Value expr_or(std::span<const Value> args) {
   return Value(args[0].asBoolean() || args[1].asBoolean());
 }
 
-Value expr_not(const std::vector<Value> &args) {
+Value expr_not(std::span<const Value> args) {
   return Value(!args[0].asBoolean());
 }
 
-Value expr_ifElse(const std::vector<Value> &args) {
+Value expr_ifElse(std::span<const Value> args) {
   if (args[0].asBoolean()) {
     return args[1];
   } else {
@@ -1159,7 +1239,7 @@ Expression make_allMatchingAttributes(const std::string &function_name, const st
     std::vector<Expression> out_exprs;
 
     for (const auto &arg : args) {
-      const auto attr_regex = utils::Regex(arg(params).asString());
+      const auto attr_regex = getCachedRegex<utils::Regex>(arg(params).asString());
       const auto cur_flow_file = params.flow_file.lock();
       std::map<std::string, std::string> attrs;
 
@@ -1168,7 +1248,7 @@ Expression make_allMatchingAttributes(const std::string &function_name, const st
       }
 
       for (const auto &attr : attrs) {
-        if (utils::regexMatch(attr.first, attr_regex)) {
+        if (utils::regexMatch(attr.first, *attr_regex)) {
           out_exprs.emplace_back(make_dynamic([=](const Parameters& /*params*/,
                       const std::vector<Expression>& /*sub_exprs*/) -> Value {
                     std::string attr_val;
@@ -1212,7 +1292,7 @@ Expression make_anyMatchingAttribute(const std::string &function_name, const std
     std::vector<Expression> out_exprs;
 
     for (const auto &arg : args) {
-      const auto attr_regex = utils::Regex(arg(params).asString());
+      const auto attr_regex = getCachedRegex<utils::Regex>(arg(params).asString());
       const auto cur_flow_file = params.flow_file.lock();
       std::map<std::string, std::string> attrs;
 
@@ -1221,7 +1301,7 @@ Expression make_anyMatchingAttribute(const std::string &function_name, const std
       }
 
       for (const auto &attr : attrs) {
-        if (utils::regexMatch(attr.first, attr_regex)) {
+        if (utils::regexMatch(attr.first, *attr_regex)) {
           out_exprs.emplace_back(make_dynamic([=](const Parameters& /*params*/,
                       const std::vector<Expression>& /*sub_exprs*/) -> Value {
                     std::string attr_val;
@@ -1364,7 +1444,7 @@ Expression make_join(const std::string &function_name, const std::vector<Express
   });
 }
 
-Expression make_dynamic_function(const std::string &function_name, const std::vector<Expression> &args) {
+Expression make_function_closure(const std::string &function_name, const std::vector<Expression> &args) {
   if (function_name == "hostname") {
     return make_dynamic_function_incomplete<expr_hostname>(function_name, args, 0);
   } else if (function_name == "resolve_user_id") {
@@ -1434,17 +1514,17 @@ Expression make_dynamic_function(const std::string &function_name, const std::ve
   } else if (function_name == "replace") {
     return make_dynamic_function_incomplete<expr_replace>(function_name, args, 2);
   } else if (function_name == "replaceFirst") {
-    return make_dynamic_function_incomplete<expr_replaceFirst>(function_name, args, 2);
+    return make_regex_function_incomplete<std::regex, expr_replaceFirst>(function_name, args, 2);
   } else if (function_name == "replaceAll") {
-    return make_dynamic_function_incomplete<expr_replaceAll>(function_name, args, 2);
+    return make_regex_function_incomplete<std::regex, expr_replaceAll>(function_name, args, 2);
   } else if (function_name == "replaceNull") {
     return make_dynamic_function_incomplete<expr_replaceNull>(function_name, args, 1);
   } else if (function_name == "replaceEmpty") {
     return make_dynamic_function_incomplete<expr_replaceEmpty>(function_name, args, 1);
   } else if (function_name == "matches") {
-    return make_dynamic_function_incomplete<expr_matches>(function_name, args, 1);
+    return make_regex_function_incomplete<utils::Regex, expr_matches>(function_name, args, 1);
   } else if (function_name == "find") {
-    return make_dynamic_function_incomplete<expr_find>(function_name, args, 1);
+    return make_regex_function_incomplete<utils::Regex, expr_find>(function_name, args, 1);
   } else if (function_name == "allMatchingAttributes") {
     return make_allMatchingAttributes(function_name, args);
   } else if (function_name == "anyMatchingAttribute") {
@@ -1526,6 +1606,13 @@ Expression make_dynamic_function(const std::string &function_name, const std::ve
   }
 }
 
+Expression make_dynamic_function(const std::string &function_name, const std::vector<Expression> &args) {
+  auto result = make_function_closure(function_name, args);
+  // the closure also validates the arguments, the program is only used if every argument could be lowered as well
+  result.set_program(Program::makeFunction(function_name, args));
+  return result;
+}
+
 Expression make_function_composition(const Expression &arg, const std::vector<std::pair<std::string, std::vector<Expression>>> &chain) {
   auto expr = arg;
 
@@ -1543,39 +1630,28 @@ bool Expression::is_dynamic() const {
 }
 
 Expression Expression::operator+(const Expression &other_expr) const {
+  // the parts are evaluated by their programs, if they have one
   if (is_dynamic() && other_expr.is_dynamic()) {
-    auto val_fn = val_fn_;
-    auto other_val_fn = other_expr.val_fn_;
-    auto sub_expr_generator = sub_expr_generator_;
-    auto other_sub_expr_generator = other_expr.sub_expr_generator_;
-    return make_dynamic([val_fn,
-    other_val_fn,
-    sub_expr_generator,
-    other_sub_expr_generator](const Parameters &params,
+    return make_dynamic([expr = *this, other_expr](const Parameters &params,
         const std::vector<Expression>& /*sub_exprs*/) -> Value {
-      Value result = val_fn(params, sub_expr_generator(params));
-      return Value(result.asString().append(other_val_fn(params, other_sub_expr_generator(params)).asString()));
+      return Value(expr(params).asString().append(other_expr(params).asString()));
     });
   } else if (is_dynamic() && !other_expr.is_dynamic()) {
-    auto val_fn = val_fn_;
     auto other_val = other_expr.val_;
-    auto sub_expr_generator = sub_expr_generator_;
-    return make_dynamic([val_fn,
-    other_val,
-    sub_expr_generator](const Parameters &params,
+    return make_dynamic([expr = *this,
+    other_val](const Parameters &params,
         const std::vector<Expression>& /*sub_exprs*/) -> Value {
-      Value result = val_fn(params, sub_expr_generator(params));
-      return Value(result.asString().append(other_val.asString()));
+      return Value(expr(params).asString().append(other_val.asString()));
     });
+  } else if (!is_dynamic() && val_.isNull() && other_expr.program_) {
+    // the parser prepends the expressions with an empty one, the lowered expressions keep the type of their result
+    return other_expr;
   } else if (!is_dynamic() && other_expr.is_dynamic()) {
     auto val = val_;
-    auto other_val_fn = other_expr.val_fn_;
-    auto other_sub_expr_generator = other_expr.sub_expr_generator_;
     return make_dynamic([val,
-    other_val_fn,
-    other_sub_expr_generator](const Parameters &params,
+    other_expr](const Parameters &params,
         const std::vector<Expression>& /*sub_exprs*/) -> Value {
-      return Value(val.asString().append(other_val_fn(params, other_sub_expr_generator(params)).asString()));
+      return Value(val.asString().append(other_expr(params).asString()));
     });
   } else if (!is_dynamic() && !other_expr.is_dynamic()) {
     std::string result(val_.asString());
@@ -1587,14 +1663,16 @@ Expression Expression::operator+(const Expression &other_expr) const {
 }
 
 Value Expression::operator()(const Parameters &params) const {
-  if (is_dynamic()) {
+  if (program_) {
+    return (*program_)(params);
+  } else if (is_dynamic()) {
     return val_fn_(params, sub_expr_generator_(params));
   } else {
     return val_;
   }
 }
 
-Expression Expression::compose_multi(const std::function<Value(const std::vector<Value> &)>& fn, const std::vector<Expression> &args) const {
+Expression Expression::compose_multi(const std::function<Value(std::span<const Value>)>& fn, const std::vector<Expression> &args) const {
   auto result = make_dynamic(val_fn_);
   auto compose_expr_generator = sub_expr_generator_;
 
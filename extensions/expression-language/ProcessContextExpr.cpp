@@ -25,20 +25,20 @@ bool ProcessContextExpr::getProperty(bool supports_expression_language, std::str
   if (!supports_expression_language) {
     return ProcessContext::getProperty(property_name, value);
   }
-  std::string name{property_name};
-  if (expressions_.find(name) == expressions_.end()) {
+  auto it = expressions_.find(property_name);
+  if (it == expressions_.end()) {
     std::string expression_str;
-    if (!ProcessContext::getProperty(name, expression_str)) {
+    if (!ProcessContext::getProperty(property_name, expression_str)) {
       return false;
     }
-    logger_->log_debug("Compiling expression for {}/{}: {}", getProcessorNode()->getName(), name, expression_str);
-    expressions_.emplace(name, expression::compile(expression_str));
-    expression_strs_.insert_or_assign(name, expression_str);
+    logger_->log_debug("Compiling expression for {}/{}: {}", getProcessorNode()->getName(), property_name, expression_str);
+    auto expression = expression::compile(expression_str);
+    it = expressions_.emplace(std::string{property_name}, CompiledExpression{std::move(expression), std::move(expression_str)}).first;
   }
 
   minifi::expression::Parameters p(shared_from_this(), flow_file);
-  value = expressions_[name](p).asString();
-  logger_->log_debug(R"(expression "{}" of property "{}" evaluated to: {})", expression_strs_[name], name, value);
+  value = it->second.expression(p).asString();
+  logger_->log_debug(R"(expression "{}" of property "{}" evaluated to: {})", it->second.expression_str, property_name, value);
   return true;
 }
 
@@ -55,16 +55,17 @@ bool ProcessContextExpr::getDynamicProperty(const Property &property, std::strin
     return ProcessContext::getDynamicProperty(property.getName(), value);
   }
   auto name = property.getName();
-  if (dynamic_property_expressions_.find(name) == dynamic_property_expressions_.end()) {
+  auto it = dynamic_property_expressions_.find(name);
+  if (it == dynamic_property_expressions_.end()) {
     std::string expression_str;
     ProcessContext::getDynamicProperty(name, expression_str);
     logger_->log_debug("Compiling expression for {}/{}: {}", getProcessorNode()->getName(), name, expression_str);
-    dynamic_property_expressions_.emplace(name, expression::compile(expression_str));
-    expression_strs_.insert_or_assign(name, expression_str);
+    auto expression = expression::compile(expression_str);
+    it = dynamic_property_expressions_.emplace(name, CompiledExpression{std::move(expression), std::move(expression_str)}).first;
   }
   minifi::expression::Parameters p(shared_from_this(), flow_file);
-  value = dynamic_property_expressions_[name](p).asString();
-  logger_->log_debug(R"(expression "{}" of dynamic property "{}" evaluated to: {})", expression_strs_[name], name, value);
+  value = it->second.expression(p).asString();
+  logger_->log_debug(R"(expression "{}" of dynamic property "{}" evaluated to: {})", it->second.expression_str, name, value);
   return true;
 }
 
@@ -23,6 +23,7 @@
 
 #include "ProcessContext.h"
 #include "impl/expression/Expression.h"
+#include "utils/Hash.h"
 
 namespace org::apache::nifi::minifi::core {
 
@@ -61,11 +62,16 @@ class ProcessContextExpr final : public core::ProcessContext {
   bool setDynamicProperty(const std::string& property, std::string value) override;
 
  private:
+  struct CompiledExpression {
+    org::apache::nifi::minifi::expression::Expression expression;
+    std::string expression_str;
+  };
+  using CompiledExpressions = std::unordered_map<std::string, CompiledExpression, utils::TransparentStringHash, std::equal_to<>>;
+
   bool getProperty(bool supports_expression_language, std::string_view property_name, std::string& value, const std::shared_ptr<FlowFile>& flow_file);
 
-  std::unordered_map<std::string, org::apache::nifi::minifi::expression::Expression> expressions_;
-  std::unordered_map<std::string, org::apache::nifi::minifi::expression::Expression> dynamic_property_expressions_;
-  std::unordered_map<std::string, std::string> expression_strs_;
+  CompiledExpressions expressions_;
+  CompiledExpressions dynamic_property_expressions_;
   std::shared_ptr<logging::Logger> logger_;
 };
 
@@ -0,0 +1,320 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "expression/Program.h"
+
+#include <algorithm>
+#include <cmath>
+#include <forward_list>
+#include <functional>
+#include <utility>
+#include <variant>
+
+#include "utils/GeneralUtils.h"
+#include "utils/gsl.h"
+#include "utils/StringUtils.h"
+
+namespace org::apache::nifi::minifi::expression {
+
+namespace {
+
+/**
+ * A Value which refers to the strings of the attributes and the literals. The conversions are the same as those of Value,
+ * the strings are converted through a Value, which stores the short strings without allocation.
+ */
+using Register = std::variant<std::monostate, bool, uint64_t, int64_t, long double, std::string_view>;
+
+bool isDecimal(const Register& reg) {
+  return std::visit(utils::overloaded{
+    [](long double) { return true; },
+    [](std::string_view str) { return str.find_first_of(".eE") != std::string_view::npos; },
+    [](const auto&) { return false; }
+  }, reg);
+}
+
+int64_t asSignedLong(const Register& reg) {
+  return std::visit(utils::overloaded{
+    [](int64_t i) { return i; },
+    [](uint64_t i) { return gsl::narrow_cast<int64_t>(i); },
+    [](long double d) { return static_cast<int64_t>(d); },
+    [](std::string_view str) { return Value(std::string{str}).asSignedLong(); },
+    [](auto) { return int64_t{0}; }
+  }, reg);
+}
+
+long double asLongDouble(const Register& reg) {
+  return std::visit(utils::overloaded{
+    [](long double d) { return d; },
+    [](int64_t i) { return static_cast<long double>(i); },
+    [](uint64_t i) { return static_cast<long double>(i); },
+    [](std::string_view str) { return Value(std::string{str}).asLongDouble(); },
+    [](auto) -> long double { return 0.0; }
+  }, reg);
+}
+
+bool asBoolean(const Register& reg) {
+  return std::visit(utils::overloaded{
+    [](bool b) { return b; },
+    [](int64_t i) { return i != 0; },
+    [](uint64_t i) { return i != 0; },
+    [](long double d) { return d != 0.0; },
+    [](std::string_view str) { return utils::StringUtils::toBool(std::string{str}).value_or(false); },
+    [](auto) { return false; }
+  }, reg);
+}
+
+/// the numbers are formatted into the buffer
+std::string_view asString(const Register& reg, std::string& buffer) {
+  return std::visit(utils::overloaded{
+    [](std::string_view str) { return str; },
+    [](std::monostate) { return std::string_view{}; },
+    [](bool b) { return b ? std::string_view{"true"} : std::string_view{"false"}; },
+    [&buffer](auto number) {
+      buffer = Value(number).asString();
+      return std::string_view{buffer};
+    }
+  }, reg);
+}
+
+Value toValue(const Register& reg) {
+  return std::visit(utils::overloaded{
+    [](std::monostate) { return Value{}; },
+    [](std::string_view str) { return Value(std::string{str}); },
+    [](auto value) { return Value(value); }
+  }, reg);
+}
+
+Register arithmetic(const Register& lhs, const Register& rhs, long double (*ldop)(long double, long double), int64_t (*iop)(int64_t, int64_t), bool long_only = false) {
+  try {
+    if (!long_only && !isDecimal(lhs) && !isDecimal(rhs)) {
+      return iop(asSignedLong(lhs), asSignedLong(rhs));
+    } else {
+      return ldop(asLongDouble(lhs), asLongDouble(rhs));
+    }
+  } catch (const std::exception&) {
+    return std::monostate{};
+  }
+}
+
+template<typename Compare>
+bool compare(const Register& lhs, const Register& rhs, Compare compare) {
+  if (isDecimal(lhs) && isDecimal(rhs)) {
+    return compare(asLongDouble(lhs), asLongDouble(rhs));
+  } else {
+    return compare(asSignedLong(lhs), asSignedLong(rhs));
+  }
+}
+
+bool isEmpty(const Register& reg) {
+  if (std::holds_alternative<std::monostate>(reg)) {
+    return true;
+  }
+  std::string buffer;
+  const auto str = asString(reg, buffer);
+  return std::all_of(str.begin(), str.end(), [](char c) {
+    return c == ' ' || c == '\f' || c == '\n' || c == '\r' || c == '\t' || c == '\v';
+  });
+}
+
+}  // namespace
+
+std::shared_ptr<const Program> Program::makeAttribute(const std::string& attribute_id) {
+  auto program = std::make_shared<Program>();
+  program->attributes_.emplace_back(attribute_id);
+  program->instructions_.push_back({OpCode::LoadAttribute, {0, 0, 0}});
+  return program;
+}
+
+std::shared_ptr<const Program> Program::makeConstant(Value value) {
+  auto program = std::make_shared<Program>();
+  program->constants_.push_back(std::move(value));
+  program->instructions_.push_back({OpCode::LoadConstant, {0, 0, 0}});
+  return program;
+}
+
+std::shared_ptr<const Program> Program::makeFunction(std::string_view function_name, std::span<const Expression> args) {
+  struct LoweredFunction {
+    std::string_view name;
+    OpCode op_code;
+    size_t arg_count;
+  };
+  static constexpr std::array<LoweredFunction, 19> LOWERED_FUNCTIONS{{
+    {"literal", OpCode::Copy, 1},
+    {"ifElse", OpCode::IfElse, 3},
+    {"plus", OpCode::Plus, 2},
+    {"minus", OpCode::Minus, 2},
+    {"multiply", OpCode::Multiply, 2},
+    {"divide", OpCode::Divide, 2},
+    {"mod", OpCode::Mod, 2},
+    {"gt", OpCode::Gt, 2},
+    {"ge", OpCode::Ge, 2},
+    {"lt", OpCode::Lt, 2},
+    {"le", OpCode::Le, 2},
+    {"and", OpCode::And, 2},
+    {"or", OpCode::Or, 2},
+    {"not", OpCode::Not, 1},
+    {"isNull", OpCode::IsNull, 1},
+    {"notNull", OpCode::NotNull, 1},
+    {"isEmpty", OpCode::IsEmpty, 1},
+    {"equals", OpCode::Equals, 2},
+    {"length", OpCode::Length, 1}
+  }};
+
+  const auto function = std::find_if(LOWERED_FUNCTIONS.begin(), LOWERED_FUNCTIONS.end(), [&](const auto& lowered_function) { return lowered_function.name == function_name; });
+  // the closures evaluate and ignore the superfluous arguments, those calls and the multi-attribute subjects are not lowered
+  if (function == LOWERED_FUNCTIONS.end() || args.size() != function->arg_count || args[0].is_multi()) {
+    return nullptr;
+  }
+
+  auto program = std::make_shared<Program>();
+  Instruction instruction{function->op_code, {0, 0, 0}};
+  for (size_t i = 0; i < args.size(); ++i) {
+    const auto arg_program = args[i].is_dynamic() ? args[i].program() : makeConstant(args[i](Parameters{}));
+    if (!arg_program || program->size() + arg_program->size() >= MAX_INSTRUCTION_COUNT) {
+      return nullptr;
+    }
+    instruction.operands[i] = program->append(*arg_program);
+  }
+  program->instructions_.push_back(instruction);
+  return program;
+}
+
+uint8_t Program::append(const Program& other) {
+  const auto register_offset = gsl::narrow<uint8_t>(instructions_.size());
+  const auto constant_offset = gsl::narrow<uint8_t>(constants_.size());
+  const auto attribute_offset = gsl::narrow<uint8_t>(attributes_.size());
+  for (auto instruction : other.instructions_) {
+    if (instruction.op_code == OpCode::LoadConstant) {
+      instruction.operands[0] += constant_offset;
+    } else if (instruction.op_code == OpCode::LoadAttribute) {
+      instruction.operands[0] += attribute_offset;
+    } else {
+      for (auto& operand : instruction.operands) {
+        operand += register_offset;
+      }
+    }
+    instructions_.push_back(instruction);
+  }
+  constants_.insert(constants_.end(), other.constants_.begin(), other.constants_.end());
+  attributes_.insert(attributes_.end(), other.attributes_.begin(), other.attributes_.end());
+  return gsl::narrow<uint8_t>(instructions_.size() - 1);
+}
+
+Value Program::operator()(const Parameters& params) const {
+  std::array<Register, MAX_INSTRUCTION_COUNT> registers;
+  const auto flow_file = params.flow_file.lock();
+  // the configuration properties are copied, the registers refer to the copies
+  std::forward_list<std::string> configuration_values;
+
+  for (size_t i = 0; i < instructions_.size(); ++i) {
+    const auto& [op_code, operands] = instructions_[i];
+    const auto& first = registers[operands[0]];
+    const auto& second = registers[operands[1]];
+    auto& result = registers[i];
+    switch (op_code) {
+      case OpCode::LoadConstant:
+        result = constants_[operands[0]].visit(utils::overloaded{
+          [](const std::string& str) -> Register { return std::string_view{str}; },
+          [](const auto& value) -> Register { return value; }
+        });
+        break;
+      case OpCode::LoadAttribute: {
+        const auto& key = attributes_[operands[0]];
+        result = std::monostate{};
+        if (flow_file) {
+          const auto& attributes = flow_file->getAttributeMap();
+          if (const auto it = attributes.find(key); it != attributes.end()) {
+            result = std::string_view{it->second};
+            break;
+          }
+        }
+        std::string value;
+        const auto registry = params.registry_.lock();
+        if (registry && registry->getConfigurationProperty(key.str(), value)) {
+          result = std::string_view{configuration_values.emplace_front(std::move(value))};
+        }
+        break;
+      }
+      case OpCode::Copy:
+        result = first;
+        break;
+      case OpCode::IfElse:
+        result = asBoolean(first) ? second : registers[operands[2]];
+        break;
+      case OpCode::Plus:
+        result = arithmetic(first, second, [](long double a, long double b) {return a + b;}, [](int64_t a, int64_t b) {return a + b;});
+        break;
+      case OpCode::Minus:
+        result = arithmetic(first, second, [](long double a, long double b) {return a - b;}, [](int64_t a, int64_t b) {return a - b;});
+        break;
+      case OpCode::Multiply:
+        result = arithmetic(first, second, [](long double a, long double b) {return a * b;}, [](int64_t a, int64_t b) {return a * b;});
+        break;
+      case OpCode::Divide:
+        result = arithmetic(first, second, [](long double a, long double b) {return a / b;}, [](int64_t a, int64_t b) {return a / b;}, true);
+        break;
+      case OpCode::Mod:
+        result = arithmetic(first, second, [](long double a, long double b) {return std::fmod(a, b);}, [](int64_t a, int64_t b) {return a % b;});
+        break;
+      case OpCode::Gt:
+        result = compare(first, second, std::greater<>{});
+        break;
+      case OpCode::Ge:
+        result = compare(first, second, std::greater_equal<>{});
+        break;
+      case OpCode::Lt:
+        result = compare(first, second, std::less<>{});
+        break;
+      case OpCode::Le:
+        result = compare(first, second, std::less_equal<>{});
+        break;
+      case OpCode::And:
+        result = asBoolean(first) && asBoolean(second);
+        break;
+      case OpCode::Or:
+        result = asBoolean(first) || asBoolean(second);
+        break;
+      case OpCode::Not:
+        result = !asBoolean(first);
+        break;
+      case OpCode::IsNull:
+        result = std::holds_alternative<std::monostate>(first);
+        break;
+      case OpCode::NotNull:
+        result = !std::holds_alternative<std::monostate>(first);
+        break;
+      case OpCode::IsEmpty:
+        result = isEmpty(first);
+        break;
+      case OpCode::Equals: {
+        std::string first_buffer;
+        std::string second_buffer;
+        result = asString(first, first_buffer) == asString(second, second_buffer);
+        break;
+      }
+      case OpCode::Length: {
+        std::string buffer;
+        result = uint64_t{asString(first, buffer).length()};
+        break;
+      }
+    }
+  }
+
+  return toValue(registers[instructions_.size() - 1]);
+}
+
+}  // namespace org::apache::nifi::minifi::expression
@@ -63,7 +63,14 @@ class Value {
   void setBoolean(bool val) { value_ = val; }
   void setString(std::string val) { value_ = std::move(val); }
 
-  [[nodiscard]] std::string asString() const {
+  [[nodiscard]] std::string asString() && {
+    if (auto* str = std::get_if<std::string>(&value_)) {
+      return std::move(*str);
+    }
+    return std::as_const(*this).asString();
+  }
+
+  [[nodiscard]] std::string asString() const & {
     return std::visit<std::string>(utils::overloaded{
       [](const std::string& str) { return str; },
       [](bool b) -> std::string { return b ? "true" : "false"; },
@@ -136,6 +143,12 @@ class Value {
     }, value_);
   }
 
+  /// Calls the visitor with the held alternative, std::monostate for NULL
+  template<typename Visitor>
+  decltype(auto) visit(Visitor&& visitor) const {
+    return std::visit(std::forward<Visitor>(visitor), value_);
+  }
+
  private:
   template<typename T>
   static T strParse(std::regular_invocable<std::string> auto const& conversion_function, T default_value, std::string_view context, const std::string& value) {
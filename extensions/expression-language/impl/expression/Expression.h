@@ -20,6 +20,7 @@
 #include <string>
 #include <memory>
 #include <functional>
+#include <span>
 #include <utility>
 #include <vector>
 
@@ -43,6 +44,7 @@ struct Parameters {
 };
 
 class Expression;
+class Program;
 
 static const std::function<Value(const Parameters &params, const std::vector<Expression> &sub_exprs)> NOOP_FN;
 
@@ -113,16 +115,29 @@ class Expression {
    * @param args function arguments
    * @return composed multi-expression
    */
-  Expression compose_multi(const std::function<Value(const std::vector<Value> &)>& fn, const std::vector<Expression> &args) const;
+  Expression compose_multi(const std::function<Value(std::span<const Value>)>& fn, const std::vector<Expression> &args) const;
 
   Expression make_aggregate(const std::function<Value(const Parameters &params, const std::vector<Expression> &sub_exprs)>& val_fn) const;
 
+  /**
+   * The flat instruction sequence this expression is evaluated with instead of its closures,
+   * or nullptr if the expression uses functions which are not lowered.
+   */
+  [[nodiscard]] const std::shared_ptr<const Program>& program() const {
+    return program_;
+  }
+
+  void set_program(std::shared_ptr<const Program> program) {
+    program_ = std::move(program);
+  }
+
  protected:
   Value val_;
   std::function<Value(const Parameters &params, const std::vector<Expression> &sub_exprs)> val_fn_;
   std::vector<Expression> fn_args_;
   std::function<std::vector<Expression>(const Parameters &params)> sub_expr_generator_;
   bool is_multi_;
+  std::shared_ptr<const Program> program_;
 };
 
 /**
@@ -0,0 +1,110 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "common/Value.h"
+#include "expression/Expression.h"
+#include "FlowFile.h"
+
+namespace org::apache::nifi::minifi::expression {
+
+/**
+ * An expression lowered into a flat sequence of instructions, which is evaluated without the closures of the expression tree.
+ *
+ * Only the attribute references, the literals and the numeric, boolean and comparison functions are lowered, the expressions
+ * using any other function are evaluated by their closures. Every instruction writes the register with its own index, the
+ * registers are typed like a Value, but they refer to the strings of the attributes and the literals instead of copying them,
+ * so the numeric and boolean expressions over short attribute values evaluate without heap allocation.
+ */
+class Program {
+ public:
+  /// the register file is on the stack, the longer expressions are evaluated by their closures
+  static constexpr size_t MAX_INSTRUCTION_COUNT = 32;
+
+  /**
+   * Creates a program which evaluates the given flow file attribute, or the configuration property of the same name.
+   */
+  static std::shared_ptr<const Program> makeAttribute(const std::string& attribute_id);
+
+  /**
+   * Lowers the call of an expression language function. Returns nullptr if the function, or one of the arguments, cannot be lowered.
+   *
+   * @param function_name
+   * @param args the subject and the arguments of the function
+   */
+  static std::shared_ptr<const Program> makeFunction(std::string_view function_name, std::span<const Expression> args);
+
+  /**
+   * Evaluates the program. The result is the same as that of the closures the program was lowered from.
+   */
+  Value operator()(const Parameters& params) const;
+
+  [[nodiscard]] size_t size() const {
+    return instructions_.size();
+  }
+
+ private:
+  enum class OpCode : uint8_t {
+    LoadConstant,
+    LoadAttribute,
+    Copy,
+    IfElse,
+    Plus,
+    Minus,
+    Multiply,
+    Divide,
+    Mod,
+    Gt,
+    Ge,
+    Lt,
+    Le,
+    And,
+    Or,
+    Not,
+    IsNull,
+    NotNull,
+    IsEmpty,
+    Equals,
+    Length
+  };
+
+  /// the operands are register indices, or the index of the constant or the attribute for the loads
+  struct Instruction {
+    OpCode op_code;
+    std::array<uint8_t, 3> operands;
+  };
+
+  static std::shared_ptr<const Program> makeConstant(Value value);
+
+  /// appends the instructions of the other program, returns the register of its result
+  uint8_t append(const Program& other);
+
+  std::vector<Instruction> instructions_;
+  std::vector<Value> constants_;
+  std::vector<core::FlowFile::AttributeKey> attributes_;
+};
+
+}  // namespace org::apache::nifi::minifi::expression
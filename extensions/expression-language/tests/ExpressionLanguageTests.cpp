@@ -19,6 +19,7 @@
 #include <ctime>
 
 #include <memory>
+#include <optional>
 #include <string>
 #ifndef DISABLE_CURL
 #ifdef WIN32
@@ -537,6 +538,34 @@ TEST_CASE("Find 3", "[expressionLanguageFind3]") {
   REQUIRE("true" == expr(expression::Parameters{ flow_file_a }).asString());
 }
 
+TEST_CASE("Regex functions with patterns from attributes", "[expressionLanguageDynamicRegex]") {
+  auto matches = expression::compile("${attr:matches(${pattern})}");
+  auto replace_all = expression::compile("${attr:replaceAll(${pattern}, 'X')}");
+
+  auto flow_file_a = std::make_shared<core::FlowFile>();
+  flow_file_a->addAttribute("attr", "a brand new filename.txt");
+  flow_file_a->addAttribute("pattern", "a.*txt");
+  auto flow_file_b = std::make_shared<core::FlowFile>();
+  flow_file_b->addAttribute("attr", "a brand new filename.txt");
+  flow_file_b->addAttribute("pattern", "[aeiou]");
+
+  for (int i = 0; i < 2; ++i) {
+    REQUIRE("true" == matches(expression::Parameters{ flow_file_a }).asString());
+    REQUIRE("false" == matches(expression::Parameters{ flow_file_b }).asString());
+    REQUIRE("X" == replace_all(expression::Parameters{ flow_file_a }).asString());
+    REQUIRE("X brXnd nXw fXlXnXmX.txt" == replace_all(expression::Parameters{ flow_file_b }).asString());
+  }
+}
+
+TEST_CASE("Invalid literal regex patterns are reported when the expression is evaluated", "[expressionLanguageInvalidRegex]") {
+  std::optional<expression::Expression> expr;
+  REQUIRE_NOTHROW(expr = expression::compile("${attr:replaceAll('(', 'X')}"));
+
+  auto flow_file_a = std::make_shared<core::FlowFile>();
+  flow_file_a->addAttribute("attr", "a brand new filename.txt");
+  REQUIRE_THROWS((*expr)(expression::Parameters{ flow_file_a }));
+}
+
 TEST_CASE("IndexOf", "[expressionLanguageIndexOf]") {
   auto expr = expression::compile("${attr:indexOf('a.*txt')}");
 
@@ -1749,3 +1778,28 @@ TEST_CASE("resolve_user_id_test", "[resolve_user_id tests]") {
   REQUIRE(expr(expression::Parameters{flow_file_a}).asString().empty());
 }
 }
+
+TEST_CASE("Lowered expressions evaluate like their closures", "[expressionLowered]") {
+  auto expr = expression::compile("${attr:plus(2):multiply(3):gt(10):ifElse('big', ${missing:isNull():not()})}");
+  REQUIRE(expr.program());
+
+  auto flow_file_a = std::make_shared<core::FlowFile>();
+
+  SECTION("big") {
+    flow_file_a->addAttribute("attr", "2");
+    REQUIRE("big" == expr(expression::Parameters{ flow_file_a }).asString());
+  }
+
+  SECTION("small") {
+    flow_file_a->addAttribute("attr", "1.5");
+    REQUIRE("false" == expr(expression::Parameters{ flow_file_a }).asString());
+  }
+
+  SECTION("multiple attributes are not lowered") {
+    REQUIRE_FALSE(expression::compile("${allAttributes('a', 'b'):isEmpty()}").program());
+  }
+
+  SECTION("other functions are not lowered") {
+    REQUIRE_FALSE(expression::compile("${attr:toUpper():length()}").program());
+  }
+}
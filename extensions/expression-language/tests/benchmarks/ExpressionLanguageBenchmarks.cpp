@@ -0,0 +1,79 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "impl/expression/Expression.h"
+#include "core/FlowFile.h"
+#include "utils/RegexUtils.h"
+#include "TestBase.h"
+#include "Catch.h"
+
+namespace expression = org::apache::nifi::minifi::expression;
+
+namespace {
+
+std::shared_ptr<core::FlowFile> createFlowFile() {
+  auto flow_file = std::make_shared<core::FlowFile>();
+  flow_file->addAttribute("filename", "a brand new filename.txt");
+  flow_file->addAttribute("path", "/var/log/minifi/");
+  flow_file->addAttribute("pattern", "^a.*\\.txt$");
+  flow_file->addAttribute("count", "42");
+  return flow_file;
+}
+
+}  // namespace
+
+TEST_CASE("Expression language evaluation", "[benchmark]") {
+  const auto flow_file = createFlowFile();
+  const expression::Parameters params{flow_file};
+
+  const std::vector<std::pair<std::string, std::string>> expressions{
+    {"attribute", "${filename}"},
+    {"string functions", "${filename:toUpper():append('.bak'):substringAfter(' ')}"},
+    {"arithmetic", "${count:plus(1):multiply(2)}"},
+    {"comparison", "${count:plus(1):gt(10):and(${count:lt(100)})}"},
+    {"matches with literal pattern", "${filename:matches('^a.*\\\\.txt$')}"},
+    {"matches with pattern from attribute", "${filename:matches(${pattern})}"},
+    {"find with literal pattern", "${filename:find('[Nn]ew')}"},
+    {"replaceAll with literal pattern", "${filename:replaceAll('\\\\..*', '')}"},
+    {"replaceFirst with literal pattern", "${path:replaceFirst('/[a-z]+', '')}"},
+    {"anyMatchingAttribute", "${anyMatchingAttribute('file.*'):contains('brand')}"},
+  };
+
+  for (const auto& [name, expression_string] : expressions) {
+    const auto expr = expression::compile(expression_string);
+    BENCHMARK(name) {
+      return expr(params);
+    };
+  }
+
+  // the cost of the regex compilation, which the literal and cached patterns avoid
+  BENCHMARK("matches compiling the pattern on every evaluation") {
+    const auto regex = utils::Regex(flow_file->getAttribute("pattern").value());
+    return utils::regexMatch(flow_file->getAttribute("filename").value(), regex);
+  };
+}
+
+TEST_CASE("Expression language compilation", "[benchmark]") {
+  BENCHMARK("compile expression with literal pattern") {
+    return expression::compile("${filename:replaceAll('\\\\..*', ''):toUpper()}");
+  };
+}
@@ -17,12 +17,16 @@
 
 #include "FetchGCSObject.h"
 
+#include <mutex>
+#include <optional>
 #include <utility>
+#include <vector>
 
 #include "core/Resource.h"
 #include "core/FlowFile.h"
 #include "core/ProcessContext.h"
 #include "core/ProcessSession.h"
+#include "utils/ParallelRangedFetch.h"
 #include "../GCPAttributes.h"
 
 namespace gcs = ::google::cloud::storage;
@@ -38,6 +42,17 @@ class FetchFromGCSCallback {
   }
 
   int64_t operator()(const std::shared_ptr<io::OutputStream>& stream) {
+    if (ranged_fetch_.max_concurrent_ranges > 1) {
+      auto metadata = client_.GetObjectMetadata(bucket_, key_, generation_);
+      if (!metadata) {
+        status_ = metadata.status();
+        return 0;
+      }
+      // objects stored with gzip content encoding are decompressed by the server, their ranges cannot be fetched separately
+      if (metadata->content_encoding() != "gzip") {
+        return fetchInRanges(*metadata, *stream);
+      }
+    }
     auto reader = client_.ReadObject(bucket_, key_, encryption_key_, generation_, gcs::IfGenerationNotMatch(0));
     auto set_members = gsl::finally([&]{
       status_ = reader.status();
@@ -67,13 +82,54 @@ class FetchFromGCSCallback {
     generation_ = generation;
   }
 
+  void setRangedFetch(const utils::ParallelRangedFetchSettings& ranged_fetch) {
+    ranged_fetch_ = ranged_fetch;
+  }
+
  private:
+  int64_t fetchInRanges(const gcs::ObjectMetadata& metadata, io::OutputStream& stream) {
+    result_generation_ = metadata.generation();
+    meta_generation_ = metadata.metageneration();
+    storage_class_ = metadata.storage_class();
+
+    // every range is read from the generation the metadata belongs to, even if the object is overwritten during the download
+    const auto write_size = utils::parallelRangedFetch(metadata.size(), ranged_fetch_, [this, generation = metadata.generation()](uint64_t offset, uint64_t length) {
+      return readRange(gcs::Generation(generation), offset, length);
+    }, stream);
+    if (!write_size) {
+      std::lock_guard<std::mutex> lock(range_status_mutex_);
+      if (status_.ok()) {
+        status_ = google::cloud::Status(google::cloud::StatusCode::kUnknown, "Failed to write the fetched ranges of the object to the flow file");
+      }
+      return 0;
+    }
+    return gsl::narrow<int64_t>(*write_size);
+  }
+
+  std::optional<std::vector<std::byte>> readRange(const gcs::Generation generation, uint64_t offset, uint64_t length) {
+    auto reader = client_.ReadObject(bucket_, key_, encryption_key_, generation,
+        gcs::ReadRange(gsl::narrow<std::int64_t>(offset), gsl::narrow<std::int64_t>(offset + length)));
+    std::vector<std::byte> range(length);
+    const bool read_successfully = reader && reader.read(reinterpret_cast<char*>(range.data()), gsl::narrow<std::streamsize>(length));
+    if (!read_successfully) {
+      std::lock_guard<std::mutex> lock(range_status_mutex_);
+      if (status_.ok()) {
+        status_ = reader.status().ok() ? google::cloud::Status(google::cloud::StatusCode::kOutOfRange, "The object is shorter than expected") : reader.status();
+      }
+      return std::nullopt;
+    }
+    reader.Close();
+    return range;
+  }
+
   std::string bucket_;
   std::string key_;
   gcs::Client& client_;
 
   gcs::EncryptionKey encryption_key_;
   gcs::Generation generation_;
+  utils::ParallelRangedFetchSettings ranged_fetch_;
+  std::mutex range_status_mutex_;
 
   google::cloud::Status status_;
   std::optional<std::int64_t> result_generation_;
@@ -96,6 +152,12 @@ void FetchGCSObject::onSchedule(core::ProcessContext& context, core::ProcessSess
     } catch (const google::cloud::RuntimeStatusError&) {
       throw minifi::Exception(ExceptionType::PROCESS_SCHEDULE_EXCEPTION, "Could not decode the base64-encoded encryption key from property " + std::string(EncryptionKey.name));    }
   }
+  if (!context.getProperty(ConcurrentRangeFetches, ranged_fetch_.max_concurrent_ranges) || ranged_fetch_.max_concurrent_ranges == 0) {
+    throw minifi::Exception(ExceptionType::PROCESS_SCHEDULE_EXCEPTION, "Concurrent Range Fetches must be at least 1");
+  }
+  if (!context.getProperty(RangeFetchSize, ranged_fetch_.range_size) || ranged_fetch_.range_size == 0) {
+    throw minifi::Exception(ExceptionType::PROCESS_SCHEDULE_EXCEPTION, "Range Fetch Size must be greater than 0");
+  }
 }
 
 void FetchGCSObject::onTrigger(core::ProcessContext& context, core::ProcessSession& session) {
@@ -123,6 +185,7 @@ void FetchGCSObject::onTrigger(core::ProcessContext& context, core::ProcessSessi
   gcs::Client client = getClient();
   FetchFromGCSCallback callback(client, *bucket, *object_name);
   callback.setEncryptionKey(encryption_key_);
+  callback.setRangedFetch(ranged_fetch_);
 
   if (auto gen_str = context.getProperty(ObjectGeneration, flow_file); gen_str && !gen_str->empty()) {
     try {
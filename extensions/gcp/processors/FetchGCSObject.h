@@ -29,6 +29,7 @@
 #include "RelationshipDefinition.h"
 #include "core/logging/LoggerConfiguration.h"
 #include "utils/ArrayUtils.h"
+#include "utils/ParallelRangedFetch.h"
 
 namespace org::apache::nifi::minifi::extensions::gcp {
 
@@ -60,11 +61,26 @@ class FetchGCSObject : public GCSProcessor {
       .withDescription("The generation of the Object to download. If left empty, then it will download the latest generation.")
       .supportsExpressionLanguage(true)
       .build();
-  EXTENSIONAPI static constexpr auto Properties = utils::array_cat(GCSProcessor::Properties, std::array<core::PropertyReference, 4>{
+  EXTENSIONAPI static constexpr auto ConcurrentRangeFetches = core::PropertyDefinitionBuilder<>::createProperty("Concurrent Range Fetches")
+      .withDescription("Specifies the number of byte ranges of the object that are downloaded at the same time. "
+          "If it is more than 1, objects larger than the Range Fetch Size are fetched in concurrent ranged requests and written to the flow file in order.")
+      .withPropertyType(core::StandardPropertyTypes::UNSIGNED_INT_TYPE)
+      .withDefaultValue("1")
+      .isRequired(true)
+      .build();
+  EXTENSIONAPI static constexpr auto RangeFetchSize = core::PropertyDefinitionBuilder<>::createProperty("Range Fetch Size")
+      .withDescription("The size of the byte ranges fetched concurrently. At most Concurrent Range Fetches ranges are held in memory at a time.")
+      .withPropertyType(core::StandardPropertyTypes::DATA_SIZE_TYPE)
+      .withDefaultValue("8 MB")
+      .isRequired(true)
+      .build();
+  EXTENSIONAPI static constexpr auto Properties = utils::array_cat(GCSProcessor::Properties, std::array<core::PropertyReference, 6>{
       Bucket,
       Key,
       EncryptionKey,
-      ObjectGeneration
+      ObjectGeneration,
+      ConcurrentRangeFetches,
+      RangeFetchSize
   });
 
 
@@ -90,6 +106,7 @@ class FetchGCSObject : public GCSProcessor {
 
  private:
   google::cloud::storage::EncryptionKey encryption_key_;
+  utils::ParallelRangedFetchSettings ranged_fetch_;
 };
 
 }  // namespace org::apache::nifi::minifi::extensions::gcp
@@ -14,6 +14,11 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
+#include <mutex>
+#include <utility>
+#include <vector>
+
 #include "../processors/FetchGCSObject.h"
 #include "../controllerservices/GCPCredentialsControllerService.h"
 #include "GCPAttributes.h"
@@ -167,3 +172,56 @@ TEST_F(FetchGCSObjectTests, InvalidGeneration) {
   EXPECT_EQ(1, result.at(FetchGCSObject::Failure).size());
   EXPECT_EQ("hello world", test_controller_.plan->getContent(result.at(FetchGCSObject::Failure)[0]));
 }
+
+TEST_F(FetchGCSObjectTests, ConcurrentRangeFetches) {
+  std::string const text = "stored text fetched in ranges";
+  EXPECT_CALL(*fetch_gcs_object_->mock_client_, GetObjectMetadata)
+      .WillOnce([&](gcs::internal::GetObjectMetadataRequest const& request) {
+        EXPECT_EQ(request.bucket_name(), "bucket-from-attribute") << request;
+        nlohmann::json metadata_json;
+        metadata_json["name"] = request.object_name();
+        metadata_json["bucket"] = request.bucket_name();
+        metadata_json["size"] = text.size();
+        metadata_json["generation"] = 42;
+        metadata_json["metageneration"] = 3;
+        metadata_json["storageClass"] = "STANDARD";
+        return gcs::internal::ObjectMetadataParser::FromJson(metadata_json);
+      });
+  std::mutex ranges_mutex;
+  std::vector<std::pair<std::int64_t, std::int64_t>> requested_ranges;
+  EXPECT_CALL(*fetch_gcs_object_->mock_client_, ReadObject)
+      .Times(3)
+      .WillRepeatedly([&](gcs::internal::ReadObjectRangeRequest const& request) {
+        EXPECT_EQ(42, request.GetOption<gcs::Generation>().value());
+        const auto range = request.GetOption<gcs::ReadRange>().value();
+        {
+          std::lock_guard<std::mutex> lock(ranges_mutex);
+          requested_ranges.emplace_back(range.begin, range.end);
+        }
+        auto simulate_read = [content = text.substr(range.begin, range.end - range.begin)](void* buf, std::size_t n) {
+          auto const l = (std::min)(n, content.size());
+          std::memcpy(buf, content.data(), l);
+          return gcs::internal::ReadSourceResult{
+              l, gcs::internal::HttpResponse{206, {}, {}}};
+        };
+        std::unique_ptr<gcs::testing::MockObjectReadSource> mock_source(new gcs::testing::MockObjectReadSource);
+        ::testing::InSequence seq;
+        EXPECT_CALL(*mock_source, IsOpen()).WillRepeatedly(testing::Return(true));
+        EXPECT_CALL(*mock_source, Read).WillOnce(simulate_read);
+        EXPECT_CALL(*mock_source, IsOpen()).WillRepeatedly(testing::Return(false));
+
+        return google::cloud::make_status_or(
+            std::unique_ptr<gcs::internal::ObjectReadSource>(
+                std::move(mock_source)));
+      });
+  EXPECT_TRUE(test_controller_.plan->setProperty(fetch_gcs_object_, FetchGCSObject::ConcurrentRangeFetches, "2"));
+  EXPECT_TRUE(test_controller_.plan->setProperty(fetch_gcs_object_, FetchGCSObject::RangeFetchSize, "10 B"));
+  const auto& result = test_controller_.trigger("hello world", {{std::string(minifi_gcp::GCS_BUCKET_ATTR), "bucket-from-attribute"}});
+  ASSERT_EQ(1, result.at(FetchGCSObject::Success).size());
+  EXPECT_EQ(0, result.at(FetchGCSObject::Failure).size());
+  EXPECT_EQ("stored text fetched in ranges", test_controller_.plan->getContent(result.at(FetchGCSObject::Success)[0]));
+  EXPECT_EQ("42", result.at(FetchGCSObject::Success)[0]->getAttribute(minifi_gcp::GCS_GENERATION));
+  EXPECT_EQ("3", result.at(FetchGCSObject::Success)[0]->getAttribute(minifi_gcp::GCS_META_GENERATION));
+  std::sort(requested_ranges.begin(), requested_ranges.end());
+  EXPECT_EQ((std::vector<std::pair<std::int64_t, std::int64_t>>{{0, 10}, {10, 20}, {20, 29}}), requested_ranges);
+}
@@ -53,6 +53,9 @@ std::shared_ptr<sitetosite::Transaction> HttpSiteToSiteClient::createTransaction
   client->setContentType("application/json");
   client->setRequestHeader("Accept", "application/json");
   client->setRequestHeader("Transfer-Encoding", "chunked");
+  if (use_compression_) {
+    client->setRequestHeader(USE_COMPRESSION_HEADER, "true");
+  }
   client->setPostFields("");
   client->submit();
   auto http_stream = dynamic_cast<HttpStream*>(peer_->getStream());
@@ -84,6 +87,10 @@ std::shared_ptr<sitetosite::Transaction> HttpSiteToSiteClient::createTransaction
         }
 
         transaction_client->setRequestHeader(PROTOCOL_VERSION_HEADER, "1");
+        if (use_compression_) {
+          // the data packets are framed the same way as in the RAW protocol
+          transaction_client->setRequestHeader(USE_COMPRESSION_HEADER, "true");
+        }
         peer_->setStream(std::unique_ptr<io::BaseStream>(new HttpStream(transaction_client)));
         logger_->log_debug("Created transaction id -{}-", transaction->getUUID().to_string());
         known_transactions_[transaction->getUUID()] = transaction;
@@ -105,6 +112,8 @@ int HttpSiteToSiteClient::readResponse(const std::shared_ptr<sitetosite::Transac
       auto stream = dynamic_cast<HttpStream*>(peer_->getStream());
       if (!stream)
         throw std::runtime_error("Invalid HTTPStream");
+      // the request body has to be complete before the response is awaited
+      peer_->flush();
       stream->close();
       auto client = stream->getClient();
       if (client->getResponseCode() == 202) {
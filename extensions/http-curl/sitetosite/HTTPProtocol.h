@@ -35,6 +35,7 @@ namespace org::apache::nifi::minifi::extensions::curl {
 
 class HttpSiteToSiteClient : public sitetosite::SiteToSiteClient {
   static constexpr char const* PROTOCOL_VERSION_HEADER = "x-nifi-site-to-site-protocol-version";
+  static constexpr char const* USE_COMPRESSION_HEADER = "x-nifi-site-to-site-use-compression";
 
  public:
   explicit HttpSiteToSiteClient(std::string /*name*/, const utils::Identifier& /*uuid*/ = {})
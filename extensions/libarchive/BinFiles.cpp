@@ -224,13 +224,7 @@ bool BinFiles::resurrectFlowFiles(core::ProcessSession &session) {
 }
 
 void BinFiles::assumeOwnershipOfNextBatch(core::ProcessSession &session) {
-  for (size_t i = 0; i < batchSize_; ++i) {
-    auto flow = session.get();
-
-    if (flow == nullptr) {
-      break;
-    }
-
+  for (const auto& flow : session.get(batchSize_)) {
     preprocessFlowFile(flow);
     std::string group_id = getGroupId(flow);
 
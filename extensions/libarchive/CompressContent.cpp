@@ -66,19 +66,15 @@ void CompressContent::onSchedule(core::ProcessContext& context, core::ProcessSes
 }
 
 void CompressContent::onTrigger(core::ProcessContext& context, core::ProcessSession& session) {
-  size_t processedFlowFileCount = 0;
-  for (; processedFlowFileCount < batchSize_; ++processedFlowFileCount) {
-    std::shared_ptr<core::FlowFile> flowFile = session.get();
-    if (!flowFile) {
-      break;
-    }
-    processFlowFile(flowFile, session);
-  }
-  if (processedFlowFileCount == 0) {
+  const auto flowFiles = session.get(batchSize_);
+  if (flowFiles.empty()) {
     // we got no flowFiles
     context.yield();
     return;
   }
+  for (const auto& flowFile : flowFiles) {
+    processFlowFile(flowFile, session);
+  }
 }
 
 void CompressContent::processFlowFile(const std::shared_ptr<core::FlowFile>& flowFile, core::ProcessSession& session) {
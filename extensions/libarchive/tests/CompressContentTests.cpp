@@ -37,6 +37,7 @@
 #include "core/ProcessSession.h"
 #include "core/ProcessorNode.h"
 #include "CompressContent.h"
+#include "cxx/ReflexiveSession.h"
 #include "io/FileStream.h"
 #include "FlowFileRecord.h"
 #include "processors/LogAttribute.h"
@@ -690,6 +691,27 @@ TEST_CASE_METHOD(CompressTestController, "Batch CompressFileGZip", "[compressFil
   }
 }
 
+TEST_CASE_METHOD(CompressTestController, "CompressContent takes its flow files from a ReflexiveSession", "[compressFileReflexiveSessionTest]") {
+  context->setProperty(minifi::processors::CompressContent::CompressMode, magic_enum::enum_name(CompressionMode::compress));
+  context->setProperty(minifi::processors::CompressContent::CompressFormat, magic_enum::enum_name(CompressionFormat::GZIP));
+  context->setProperty(minifi::processors::CompressContent::BatchSize, "3");
+
+  importFlowFileFrom(minifi::io::BufferStream(std::string("queued content")));
+  auto reflexive_flow = helper_session->create();
+  helper_session->importFrom(minifi::io::BufferStream(std::string("reflexive content")), reflexive_flow);
+  helper_session->flushContent();
+
+  auto factory = std::make_shared<core::ProcessSessionFactory>(context);
+  processor->onSchedule(*context, *factory);
+  auto session = std::make_shared<core::ReflexiveSession>(context);
+  session->add(reflexive_flow);
+  processor->onTrigger(*context, *session);
+
+  CHECK(reflexive_flow->isDeleted());
+  CHECK(session->get() == nullptr);
+  CHECK(input->getQueueSize() == 1);
+}
+
 TEST_CASE_METHOD(DecompressTestController, "Invalid archive decompression", "[compressfiletest9]") {
   context->setProperty(minifi::processors::CompressContent::CompressMode, magic_enum::enum_name(CompressionMode::decompress));
   SECTION("GZIP") {
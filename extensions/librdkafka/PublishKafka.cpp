@@ -20,7 +20,9 @@
 #include <algorithm>
 #include <memory>
 #include <string>
+#include <limits>
 #include <map>
+#include <numeric>
 #include <set>
 #include <type_traits>
 #include <vector>
@@ -664,19 +666,10 @@ void PublishKafka::onTrigger(core::ProcessContext& context, core::ProcessSession
   logger_->log_debug("PublishKafka onTrigger");
 
   // Collect FlowFiles to process
-  uint64_t actual_bytes = 0U;
-  std::vector<std::shared_ptr<core::FlowFile>> flowFiles;
-  for (uint32_t i = 0; i < batch_size_; i++) {
-    std::shared_ptr<core::FlowFile> flowFile = session.get();
-    if (flowFile == nullptr) {
-      break;
-    }
-    actual_bytes += flowFile->getSize();
-    flowFiles.emplace_back(std::move(flowFile));
-    if (target_batch_payload_size_ != 0U && actual_bytes >= target_batch_payload_size_) {
-      break;
-    }
-  }
+  std::vector<std::shared_ptr<core::FlowFile>> flowFiles = session.get(batch_size_,
+      target_batch_payload_size_ != 0U ? target_batch_payload_size_ : std::numeric_limits<uint64_t>::max());
+  const uint64_t actual_bytes = std::accumulate(flowFiles.begin(), flowFiles.end(), uint64_t{0},
+      [](uint64_t sum, const auto& flow_file) { return sum + flow_file->getSize(); });
   if (flowFiles.empty()) {
     context.yield();
     return;
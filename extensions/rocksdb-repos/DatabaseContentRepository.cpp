@@ -17,6 +17,7 @@
 
 #include "DatabaseContentRepository.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
@@ -31,6 +32,9 @@
 #include "database/StringAppender.h"
 #include "core/Resource.h"
 #include "core/TypedValues.h"
+#include "io/validation.h"
+#include "utils/OptionalUtils.h"
+#include "utils/StringUtils.h"
 
 namespace org::apache::nifi::minifi::core::repository {
 
@@ -50,6 +54,18 @@ bool DatabaseContentRepository::initialize(const std::shared_ptr<minifi::Configu
     logger_->log_error("Malformed delete period value, expected time format: '{}'", purge_period_str);
     purge_period_ = std::chrono::seconds{1};
   }
+  chunk_size_ = io::ContentChunks::DEFAULT_CHUNK_SIZE;
+  if (auto chunk_size_str = configuration->get(Configure::nifi_dbcontent_repository_chunk_size)) {
+    uint64_t chunk_size = 0;
+    if (core::DataSizeValue::StringToInt(*chunk_size_str, chunk_size) && chunk_size > 0) {
+      chunk_size_ = gsl::narrow<size_t>(chunk_size);
+    } else {
+      logger_->log_error("Invalid value '{}' for {}, using default chunk size of {} bytes",
+          *chunk_size_str, Configure::nifi_dbcontent_repository_chunk_size, io::ContentChunks::DEFAULT_CHUNK_SIZE);
+    }
+  }
+  deduplication_enabled_ = (configuration->get(Configure::nifi_content_repository_deduplication)
+      | utils::andThen(utils::StringUtils::toBool)).value_or(false);
   const auto encrypted_env = createEncryptingEnv(utils::crypto::EncryptionManager{configuration->getHome()}, DbEncryptionOptions{directory_, ENCRYPTION_KEY_NAME});
   logger_->log_info("Using {} DatabaseContentRepository", encrypted_env ? "encrypted" : "plaintext");
 
@@ -78,6 +94,7 @@ bool DatabaseContentRepository::initialize(const std::shared_ptr<minifi::Configu
   if (db_->open()) {
     logger_->log_debug("NiFi Content DB Repository database open {} success", directory_);
     is_valid_ = true;
+    loadAliases();
   } else {
     logger_->log_error("NiFi Content DB Repository database open {} fail", directory_);
     is_valid_ = false;
@@ -139,8 +156,131 @@ void DatabaseContentRepository::stop() {
   }
 }
 
+DatabaseContentRepository::ChunkedContentStream::ChunkedContentStream(std::string path, gsl::not_null<minifi::internal::RocksDatabase*> db, size_t chunk_size, bool hash_content)
+    : path_(std::move(path)),
+      db_(db),
+      chunk_size_(chunk_size) {
+  gsl_Expects(chunk_size_ > 0);
+  if (hash_content) {
+    hasher_.emplace();
+  }
+}
+
+size_t DatabaseContentRepository::ChunkedContentStream::write(const uint8_t* value, size_t size) {
+  if (size != 0 && IsNullOrEmpty(value)) return io::STREAM_ERROR;
+  if (hasher_) {
+    hasher_->update(std::as_bytes(std::span(value, size)));
+  }
+  size_t written = 0;
+  while (written < size) {
+    auto& chunk = current_index_ == 0 ? first_chunk_ : current_chunk_;
+    const auto chunk_write_size = std::min(size - written, chunk_size_ - chunk.size());
+    chunk.append(reinterpret_cast<const char*>(value) + written, chunk_write_size);
+    written += chunk_write_size;
+    size_ += chunk_write_size;
+    if (chunk.size() < chunk_size_) {
+      continue;
+    }
+    if (current_index_ > 0) {
+      auto opendb = db_->open();
+      // no need to sync, the synchronous write of the commit makes the earlier writes durable as well
+      if (!opendb || !opendb->Put(rocksdb::WriteOptions(), io::ContentChunks::key(path_, current_index_), current_chunk_).ok()) {
+        return io::STREAM_ERROR;
+      }
+      current_chunk_.clear();
+    }
+    ++current_index_;
+  }
+  return size;
+}
+
+size_t DatabaseContentRepository::ChunkedContentStream::read(std::span<std::byte> /*buf*/) {
+  // the content of a modified claim can only be read after the session has been committed
+  return io::STREAM_ERROR;
+}
+
+bool DatabaseContentRepository::ChunkedContentStream::commit(minifi::internal::WriteBatch& batch) const {
+  if (!batch.Put(path_, first_chunk_).ok()) {
+    return false;
+  }
+  return current_index_ == 0 || current_chunk_.empty() || batch.Put(io::ContentChunks::key(path_, current_index_), current_chunk_).ok();
+}
+
+void DatabaseContentRepository::ChunkedContentStream::discard() {
+  // the chunks 1 .. current_index_ - 1 have already been written
+  if (current_index_ > 1) {
+    if (auto opendb = db_->open()) {
+      auto batch = opendb->createWriteBatch();
+      discard(batch);
+      // the chunks left behind on failure are removed as orphans on the next startup
+      opendb->Write(rocksdb::WriteOptions(), &batch);
+      return;
+    }
+  }
+  clear();
+}
+
+void DatabaseContentRepository::ChunkedContentStream::discard(minifi::internal::WriteBatch& batch) {
+  for (size_t index = 1; index < current_index_; ++index) {
+    batch.Delete(io::ContentChunks::key(path_, index));
+  }
+  clear();
+}
+
+void DatabaseContentRepository::ChunkedContentStream::clear() {
+  first_chunk_.clear();
+  current_chunk_.clear();
+  current_index_ = 0;
+  size_ = 0;
+  if (hasher_ || hash_) {
+    hasher_.emplace();
+  }
+  hash_.reset();
+}
+
+std::optional<ContentHashIndex::Hash> DatabaseContentRepository::ChunkedContentStream::hash() {
+  if (!hash_ && hasher_) {
+    hash_ = std::exchange(hasher_, std::nullopt)->finish();
+  }
+  return hash_;
+}
+
 DatabaseContentRepository::Session::Session(std::shared_ptr<ContentRepository> repository) : BufferedContentSession(std::move(repository)) {}
 
+std::shared_ptr<DatabaseContentRepository::ChunkedContentStream> DatabaseContentRepository::Session::createStream(const ResourceClaim& claim) const {
+  auto dbContentRepository = std::static_pointer_cast<DatabaseContentRepository>(repository_);
+  return std::make_shared<ChunkedContentStream>(claim.getContentFullPath(), gsl::make_not_null(dbContentRepository->db_.get()), dbContentRepository->chunk_size_,
+      dbContentRepository->deduplication_enabled_);
+}
+
+std::shared_ptr<ResourceClaim> DatabaseContentRepository::Session::create() {
+  auto claim = std::make_shared<ResourceClaim>(repository_);
+  created_resources_[claim] = createStream(*claim);
+  return claim;
+}
+
+std::shared_ptr<io::BaseStream> DatabaseContentRepository::Session::write(const std::shared_ptr<ResourceClaim>& resource_id) {
+  if (auto it = created_resources_.find(resource_id); it != created_resources_.end()) {
+    it->second->discard();
+    return it->second = createStream(*resource_id);
+  }
+  return BufferedContentSession::write(resource_id);
+}
+
+std::shared_ptr<io::BaseStream> DatabaseContentRepository::Session::append(const std::shared_ptr<ResourceClaim>& resource_id) {
+  if (auto it = created_resources_.find(resource_id); it != created_resources_.end()) {
+    return it->second;
+  }
+  return BufferedContentSession::append(resource_id);
+}
+
+std::shared_ptr<io::BaseStream> DatabaseContentRepository::Session::read(const std::shared_ptr<ResourceClaim>& resource_id) {
+  if (created_resources_.contains(resource_id)) {
+    throw Exception(REPOSITORY_EXCEPTION, "Can only read non-modified resource");
+  }
+  return BufferedContentSession::read(resource_id);
+}
+
 std::shared_ptr<ContentSession> DatabaseContentRepository::createSession() {
   return std::make_shared<Session>(sharedFromThis());
 }
@@ -152,23 +292,62 @@ void DatabaseContentRepository::Session::commit() {
     throw Exception(REPOSITORY_EXCEPTION, "Couldn't open rocksdb database to commit content changes");
   }
   auto batch = opendb->createWriteBatch();
-  for (const auto& resource : managed_resources_) {
-    auto outStream = dbContentRepository->write(*resource.first, false, &batch);
-    if (outStream == nullptr) {
-      throw Exception(REPOSITORY_EXCEPTION, "Couldn't open the underlying resource for write: " + resource.first->getContentFullPath());
+  struct Alias {
+    std::string content_path;
+    // the content path of the claim with the same content
+    std::string target_path;
+    uint64_t size;
+  };
+  std::vector<Alias> aliases;
+  std::vector<std::pair<ContentHashIndex::Hash, std::string>> unique_contents;
+  const auto release_aliases = [&] {
+    for (const auto& [content_path, target_path, size] : aliases) {
+      if (auto unreferenced_path = dbContentRepository->releaseContent(target_path)) {
+        dbContentRepository->deleteContents({*unreferenced_path});
+      }
     }
-    const auto size = resource.second->size();
-    if (outStream->write(resource.second->getBuffer()) != size) {
-      throw Exception(REPOSITORY_EXCEPTION, "Failed to write new resource: " + resource.first->getContentFullPath());
+  };
+  // the appends below would modify the content in place before the aliases to it are added
+  std::unordered_set<std::string> extended_paths;
+  for (const auto& resource : extended_resources_) {
+    extended_paths.insert(resource.first->getContentFullPath());
+  }
+  for (const auto& [claim, stream] : created_resources_) {
+    const auto hash = stream->size() > 0 ? stream->hash() : std::nullopt;
+    if (hash) {
+      auto target_path = dbContentRepository->acquireContent(*hash, claim->getContentFullPath());
+      if (target_path && extended_paths.contains(*target_path)) {
+        if (auto unreferenced_path = dbContentRepository->releaseContent(*target_path)) {
+          dbContentRepository->deleteContents({*unreferenced_path});
+        }
+        target_path.reset();
+      }
+      if (target_path) {
+        aliases.push_back(Alias{claim->getContentFullPath(), *target_path, stream->size()});
+        // the chunks already written are not needed, the claim shares the content of target_path
+        stream->discard(batch);
+        if (!batch.Put(aliasKey(claim->getContentFullPath()), *target_path).ok()) {
+          release_aliases();
+          throw Exception(REPOSITORY_EXCEPTION, "Failed to write deduplicated resource: " + claim->getContentFullPath());
+        }
+        continue;
+      }
+      unique_contents.emplace_back(*hash, claim->getContentFullPath());
+    }
+    if (!stream->commit(batch)) {
+      release_aliases();
+      throw Exception(REPOSITORY_EXCEPTION, "Failed to write new resource: " + claim->getContentFullPath());
     }
   }
   for (const auto& resource : extended_resources_) {
     auto outStream = dbContentRepository->write(*resource.first, true, &batch);
     if (outStream == nullptr) {
+      release_aliases();
       throw Exception(REPOSITORY_EXCEPTION, "Couldn't open the underlying resource for append: " + resource.first->getContentFullPath());
     }
     const auto size = resource.second->size();
     if (outStream->write(resource.second->getBuffer()) != size) {
+      release_aliases();
       throw Exception(REPOSITORY_EXCEPTION, "Failed to append to resource: " + resource.first->getContentFullPath());
     }
   }
@@ -177,13 +356,37 @@ void DatabaseContentRepository::Session::commit() {
   options.sync = true;
   rocksdb::Status status = opendb->Write(options, &batch);
   if (!status.ok()) {
+    release_aliases();
     throw Exception(REPOSITORY_EXCEPTION, "Batch write failed: " + status.ToString());
   }
 
-  managed_resources_.clear();
+  for (const auto& [content_path, target_path, size] : aliases) {
+    {
+      std::lock_guard<std::mutex> lock(dbContentRepository->aliases_mutex_);
+      dbContentRepository->addAlias(content_path, target_path);
+    }
+    dbContentRepository->content_hash_index_.recordDuplicateClaim(size);
+  }
+  if (!aliases.empty()) {
+    dbContentRepository->aliases_changed_.notify_all();
+  }
+  for (const auto& [hash, content_path] : unique_contents) {
+    dbContentRepository->content_hash_index_.add(hash, content_path);
+    dbContentRepository->content_hash_index_.recordUniqueClaim();
+  }
+
+  created_resources_.clear();
   extended_resources_.clear();
 }
 
+void DatabaseContentRepository::Session::rollback() {
+  for (const auto& resource : created_resources_) {
+    resource.second->discard();
+  }
+  created_resources_.clear();
+  BufferedContentSession::rollback();
+}
+
 std::shared_ptr<io::BaseStream> DatabaseContentRepository::write(const minifi::ResourceClaim &claim, bool append) {
   return write(claim, append, nullptr);
 }
@@ -193,7 +396,7 @@ std::shared_ptr<io::BaseStream> DatabaseContentRepository::read(const minifi::Re
   // we can simply return a nullptr, which is also valid from the API when this stream is not valid.
   if (!is_valid_ || !db_)
     return nullptr;
-  return std::make_shared<io::RocksDbStream>(claim.getContentFullPath(), gsl::make_not_null<minifi::internal::RocksDatabase*>(db_.get()), false);
+  return std::make_shared<io::RocksDbStream>(resolveAlias(claim.getContentFullPath()), gsl::make_not_null<minifi::internal::RocksDatabase*>(db_.get()), false, nullptr, chunk_size_);
 }
 
 bool DatabaseContentRepository::exists(const minifi::ResourceClaim &streamId) {
@@ -203,7 +406,7 @@ bool DatabaseContentRepository::exists(const minifi::ResourceClaim &streamId) {
   }
   std::string value;
   rocksdb::Status status;
-  status = opendb->Get(rocksdb::ReadOptions(), streamId.getContentFullPath(), &value);
+  status = opendb->Get(rocksdb::ReadOptions(), resolveAlias(streamId.getContentFullPath()), &value);
   if (status.ok()) {
     logger_->log_debug("{} exists", streamId.getContentFullPath());
     return true;
@@ -221,13 +424,15 @@ bool DatabaseContentRepository::removeKeySync(const std::string &content_path) {
   if (!opendb) {
     return false;
   }
-  rocksdb::Status status = opendb->Delete(rocksdb::WriteOptions(), content_path);
+  auto batch = opendb->createWriteBatch();
+  for (const auto& key : io::ContentChunks::keys(*opendb, content_path)) {
+    batch.Delete(key);
+  }
+  batch.Delete(aliasKey(content_path));
+  rocksdb::Status status = opendb->Write(rocksdb::WriteOptions(), &batch);
   if (status.ok()) {
     logger_->log_debug("Deleting resource {}", content_path);
     return true;
-  } else if (status.IsNotFound()) {
-    logger_->log_debug("Resource {} was not found", content_path);
-    return true;
   } else {
     logger_->log_debug("Attempted, but could not delete {}", content_path);
     return false;
@@ -235,13 +440,268 @@ bool DatabaseContentRepository::removeKeySync(const std::string &content_path) {
 }
 
 bool DatabaseContentRepository::removeKey(const std::string& content_path) {
+  return deleteContents(releaseClaim(content_path));
+}
+
+bool DatabaseContentRepository::deleteContents(const std::vector<std::string>& content_paths) {
   if (purge_period_ == std::chrono::seconds(0)) {
-    return removeKeySync(content_path);
+    bool success = true;
+    for (const auto& content_path : content_paths) {
+      success = removeKeySync(content_path) && success;
+    }
+    return success;
   }
   // asynchronous deletion
   std::lock_guard guard(keys_mtx_);
-  logger_->log_debug("Staging resource for deletion {}", content_path);
-  keys_to_delete_.push_back(content_path);
+  for (const auto& content_path : content_paths) {
+    logger_->log_debug("Staging resource for deletion {}", content_path);
+    keys_to_delete_.push_back(content_path);
+  }
+  return true;
+}
+
+std::string DatabaseContentRepository::aliasKey(std::string_view content_path) {
+  return std::string{ALIAS_KEY_PREFIX}.append(content_path);
+}
+
+void DatabaseContentRepository::loadAliases() {
+  auto opendb = db_->open();
+  if (!opendb) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(aliases_mutex_);
+  aliases_.clear();
+  aliases_by_target_.clear();
+  alias_counts_.clear();
+  released_contents_.clear();
+  auto it = opendb->NewIterator(rocksdb::ReadOptions());
+  for (it->Seek(std::string{ALIAS_KEY_PREFIX}); it->Valid(); it->Next()) {
+    const auto key = it->key().ToString();
+    if (!key.starts_with(ALIAS_KEY_PREFIX)) {
+      break;
+    }
+    const auto target_path = it->value().ToString();
+    ++alias_counts_[target_path];
+    addAlias(key.substr(ALIAS_KEY_PREFIX.size()), target_path);
+  }
+  aliases_loaded_ = !aliases_.empty();
+  if (aliases_loaded_) {
+    logger_->log_debug("Loaded {} deduplicated resources", aliases_.size());
+  }
+}
+
+std::string DatabaseContentRepository::resolveAlias(const std::string& content_path) const {
+  std::lock_guard<std::mutex> lock(aliases_mutex_);
+  if (auto it = aliases_.find(content_path); it != aliases_.end()) {
+    return it->second;
+  }
+  return content_path;
+}
+
+void DatabaseContentRepository::addAlias(const std::string& content_path, const std::string& target_path) {
+  aliases_[content_path] = target_path;
+  aliases_by_target_[target_path].insert(content_path);
+}
+
+std::optional<std::string> DatabaseContentRepository::removeAlias(const std::string& content_path) {
+  auto it = aliases_.find(content_path);
+  if (it == aliases_.end()) {
+    return std::nullopt;
+  }
+  auto target_path = std::move(it->second);
+  aliases_.erase(it);
+  if (auto target_it = aliases_by_target_.find(target_path); target_it != aliases_by_target_.end()) {
+    target_it->second.erase(content_path);
+    if (target_it->second.empty()) {
+      aliases_by_target_.erase(target_it);
+    }
+  }
+  return target_path;
+}
+
+std::optional<std::string> DatabaseContentRepository::acquireContent(const ContentHashIndex::Hash& hash, const std::string& content_path) {
+  // the content is removed from the index before it is released, so it cannot be deleted after it has been found
+  std::lock_guard<std::mutex> lock(aliases_mutex_);
+  auto target_path = content_hash_index_.find(hash);
+  if (!target_path || *target_path == content_path) {
+    return std::nullopt;
+  }
+  ++alias_counts_[*target_path];
+  return target_path;
+}
+
+std::optional<std::string> DatabaseContentRepository::releaseContent(const std::string& target_path) {
+  std::lock_guard<std::mutex> lock(aliases_mutex_);
+  auto it = alias_counts_.find(target_path);
+  if (it == alias_counts_.end()) {
+    return std::nullopt;
+  }
+  aliases_changed_.notify_all();
+  if (--it->second > 0) {
+    return std::nullopt;
+  }
+  alias_counts_.erase(it);
+  if (released_contents_.erase(target_path) > 0) {
+    return target_path;
+  }
+  return std::nullopt;
+}
+
+std::vector<std::string> DatabaseContentRepository::releaseClaim(const std::string& content_path) {
+  content_hash_index_.remove(content_path);
+  std::optional<std::string> target_path;
+  {
+    std::lock_guard<std::mutex> lock(aliases_mutex_);
+    if (alias_counts_.contains(content_path)) {
+      logger_->log_debug("Keeping the content of {}, it is shared with deduplicated resources", content_path);
+      released_contents_.insert(content_path);
+      return {};
+    }
+    target_path = removeAlias(content_path);
+  }
+  std::vector<std::string> content_paths{content_path};
+  if (target_path) {
+    if (auto unreferenced_path = releaseContent(*target_path)) {
+      content_paths.push_back(std::move(*unreferenced_path));
+    }
+  }
+  return content_paths;
+}
+
+bool DatabaseContentRepository::unshareContent(const std::string& content_path) {
+  // without deduplication no new content is shared, only the deduplicated claims loaded on startup can be
+  if (!deduplication_enabled_ && !aliases_loaded_) {
+    return true;
+  }
+  // no new references are acquired to the content once it is removed from the index
+  content_hash_index_.remove(content_path);
+  {
+    std::unique_lock<std::mutex> lock(aliases_mutex_);
+    // the claims deduplicated in a commit in progress are only added to the aliases after the commit has been written,
+    // until then they are only counted in alias_counts_
+    const auto has_unregistered_references = [&] {
+      const auto count_it = alias_counts_.find(content_path);
+      if (count_it == alias_counts_.end()) {
+        return false;
+      }
+      const auto target_it = aliases_by_target_.find(content_path);
+      return count_it->second > (target_it == aliases_by_target_.end() ? 0 : target_it->second.size());
+    };
+    if (!aliases_changed_.wait_for(lock, UNREGISTERED_REFERENCE_TIMEOUT, [&] { return !has_unregistered_references(); })) {
+      logger_->log_error("The content of {} is still being deduplicated to, it cannot be modified", content_path);
+      return false;
+    }
+    if (!aliases_.contains(content_path) && !aliases_by_target_.contains(content_path)) {
+      return true;
+    }
+  }
+  // the copies are made outside of aliases_mutex_, concurrent unshares could write the same copy
+  std::lock_guard<std::mutex> unshare_lock(unshare_mutex_);
+  std::string source_path;
+  std::vector<std::string> copy_paths;
+  {
+    std::lock_guard<std::mutex> lock(aliases_mutex_);
+    if (auto it = aliases_.find(content_path); it != aliases_.end()) {
+      source_path = it->second;
+      copy_paths.push_back(content_path);
+    } else if (auto target_it = aliases_by_target_.find(content_path); target_it != aliases_by_target_.end()) {
+      source_path = content_path;
+      copy_paths.assign(target_it->second.begin(), target_it->second.end());
+    } else {
+      // another unshare has already copied the content
+      return true;
+    }
+    // an extra reference keeps the shared content alive while it is copied without holding the lock
+    ++alias_counts_[source_path];
+  }
+
+  bool success = true;
+  std::vector<std::string> copied_paths;
+  std::vector<std::string> unused_paths;
+  for (const auto& copy_path : copy_paths) {
+    if (!copyContent(source_path, copy_path)) {
+      logger_->log_error("Failed to copy the shared content of {} to {}", source_path, copy_path);
+      success = false;
+      break;
+    }
+    copied_paths.push_back(copy_path);
+  }
+
+  std::vector<std::string> unshared_paths;
+  {
+    std::lock_guard<std::mutex> lock(aliases_mutex_);
+    for (const auto& copy_path : copied_paths) {
+      if (auto it = aliases_.find(copy_path); it == aliases_.end() || it->second != source_path) {
+        // the claim has been removed while its copy was written
+        unused_paths.push_back(copy_path);
+        continue;
+      }
+      removeAlias(copy_path);
+      unshared_paths.push_back(copy_path);
+    }
+    // the released references include the one taken for the copy
+    auto count_it = alias_counts_.find(source_path);
+    count_it->second -= unshared_paths.size() + 1;
+    if (count_it->second == 0) {
+      alias_counts_.erase(count_it);
+      if (released_contents_.erase(source_path) > 0) {
+        unused_paths.push_back(source_path);
+      }
+    }
+  }
+  aliases_changed_.notify_all();
+
+  if (!unshared_paths.empty()) {
+    if (auto opendb = db_->open()) {
+      auto batch = opendb->createWriteBatch();
+      for (const auto& copy_path : unshared_paths) {
+        batch.Delete(aliasKey(copy_path));
+      }
+      rocksdb::WriteOptions options;
+      options.sync = true;
+      if (auto status = opendb->Write(options, &batch); !status.ok()) {
+        logger_->log_error("Failed to remove the deduplicated resources of {}: {}", source_path, status.ToString());
+      }
+    }
+    logger_->log_debug("Copied the content of {} shared with {} resources before modifying it", source_path, unshared_paths.size());
+  }
+  if (!unused_paths.empty()) {
+    deleteContents(unused_paths);
+  }
+  return success;
+}
+
+bool DatabaseContentRepository::copyContent(const std::string& source_path, const std::string& copy_path) {
+  auto opendb = db_->open();
+  if (!opendb) {
+    return false;
+  }
+  // removes the chunks of the copy, but not its alias key, the claim keeps sharing the content until the copy is complete
+  const auto remove_copy = [&] {
+    auto batch = opendb->createWriteBatch();
+    for (const auto& key : io::ContentChunks::keys(*opendb, copy_path)) {
+      batch.Delete(key);
+    }
+    return opendb->Write(rocksdb::WriteOptions(), &batch).ok();
+  };
+  // the chunks left behind by an interrupted copy would be merged with the new ones
+  if (!remove_copy()) {
+    return false;
+  }
+
+  io::RocksDbStream source(source_path, gsl::make_not_null<minifi::internal::RocksDatabase*>(db_.get()), false, nullptr, chunk_size_);
+  io::RocksDbStream copy(copy_path, gsl::make_not_null<minifi::internal::RocksDatabase*>(db_.get()), true, nullptr, chunk_size_);
+  std::vector<std::byte> chunk(std::min(chunk_size_, source.size()));
+  size_t copied_size = 0;
+  do {
+    const size_t read_size = chunk.empty() ? 0 : source.read(chunk);
+    if (io::isError(read_size) || (read_size == 0 && copied_size < source.size())
+        || copy.write(reinterpret_cast<const uint8_t*>(chunk.data()), read_size) != read_size) {
+      remove_copy();
+      return false;
+    }
+    copied_size += read_size;
+  } while (copied_size < source.size());
   return true;
 }
 
@@ -261,7 +721,10 @@ void DatabaseContentRepository::runGc() {
     }
     auto batch = opendb->createWriteBatch();
     for (auto& key : keys) {
-      batch.Delete(key);
+      for (const auto& chunk_key : io::ContentChunks::keys(*opendb, key)) {
+        batch.Delete(chunk_key);
+      }
+      batch.Delete(aliasKey(key));
     }
     rocksdb::Status status;
     status = opendb->Write(rocksdb::WriteOptions(), &batch);
@@ -285,8 +748,11 @@ std::shared_ptr<io::BaseStream> DatabaseContentRepository::write(const minifi::R
   // we can simply return a nullptr, which is also valid from the API when this stream is not valid.
   if (!is_valid_ || !db_)
     return nullptr;
+  if (!unshareContent(claim.getContentFullPath())) {
+    return nullptr;
+  }
   // append is already supported in all modes
-  return std::make_shared<io::RocksDbStream>(claim.getContentFullPath(), gsl::make_not_null<minifi::internal::RocksDatabase*>(db_.get()), true, batch);
+  return std::make_shared<io::RocksDbStream>(claim.getContentFullPath(), gsl::make_not_null<minifi::internal::RocksDatabase*>(db_.get()), true, batch, chunk_size_);
 }
 
 void DatabaseContentRepository::clearOrphans() {
@@ -299,13 +765,44 @@ void DatabaseContentRepository::clearOrphans() {
     logger_->log_error("Cannot delete orphan content entries, could not open repository");
     return;
   }
+  const auto is_claimed = [this](const std::string& content_path) {
+    std::lock_guard<std::mutex> lock(count_map_mutex_);
+    auto claim_it = count_map_.find(content_path);
+    return claim_it != count_map_.end() && claim_it->second != 0;
+  };
   std::vector<std::string> keys_to_be_deleted;
   auto it = opendb->NewIterator(rocksdb::ReadOptions());
+  // the deduplicated resources go first, as they keep the content they share alive
+  for (it->Seek(std::string{ALIAS_KEY_PREFIX}); it->Valid(); it->Next()) {
+    auto key = it->key().ToString();
+    if (!key.starts_with(ALIAS_KEY_PREFIX)) {
+      break;
+    }
+    const auto content_path = key.substr(ALIAS_KEY_PREFIX.size());
+    if (!is_claimed(content_path)) {
+      logger_->log_error("Deleting orphan resource {}", content_path);
+      keys_to_be_deleted.push_back(key);
+      std::lock_guard<std::mutex> lock(aliases_mutex_);
+      if (const auto target_path = removeAlias(content_path)) {
+        if (auto count_it = alias_counts_.find(*target_path); count_it != alias_counts_.end() && --count_it->second == 0) {
+          alias_counts_.erase(count_it);
+        }
+      }
+    }
+  }
   for (it->SeekToFirst(); it->Valid(); it->Next()) {
     auto key = it->key().ToString();
-    std::lock_guard<std::mutex> lock(count_map_mutex_);
-    auto claim_it = count_map_.find(key);
-    if (claim_it == count_map_.end() || claim_it->second == 0) {
+    if (key.starts_with(ALIAS_KEY_PREFIX)) {
+      continue;
+    }
+    const std::string content_path{io::ContentChunks::contentPath(key)};
+    if (is_claimed(content_path)) {
+      continue;
+    }
+    std::lock_guard<std::mutex> lock(aliases_mutex_);
+    if (alias_counts_.contains(content_path)) {
+      released_contents_.insert(content_path);
+    } else {
       logger_->log_error("Deleting orphan resource {}", key);
       keys_to_be_deleted.push_back(key);
     }
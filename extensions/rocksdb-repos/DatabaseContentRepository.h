@@ -16,9 +16,14 @@
  */
 #pragma once
 
+#include <condition_variable>
+#include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <thread>
 #include <vector>
@@ -29,19 +34,78 @@
 #include "core/Property.h"
 #include "database/RocksDatabase.h"
 #include "properties/Configure.h"
+#include "RocksDbStream.h"
 #include "utils/StoppableThread.h"
 
 namespace org::apache::nifi::minifi::core::repository {
 
 class DatabaseContentRepository : public core::ContentRepository {
+  /**
+   * Write stream of a claim created in a session. The first chunk and the chunk being written are kept in memory,
+   * the other chunks are written to the database as soon as they are full. The first chunk is only written
+   * on commit, so the claim does not exist until then.
+   */
+  class ChunkedContentStream : public io::BaseStream {
+   public:
+    ChunkedContentStream(std::string path, gsl::not_null<minifi::internal::RocksDatabase*> db, size_t chunk_size, bool hash_content);
+
+    using BaseStream::write;
+    using BaseStream::read;
+
+    size_t write(const uint8_t* value, size_t size) override;
+    size_t read(std::span<std::byte> buf) override;
+
+    size_t size() const override {
+      return size_;
+    }
+
+    // adds the chunks not yet written to the batch
+    bool commit(minifi::internal::WriteBatch& batch) const;
+    // deletes the chunks already written
+    void discard();
+    // adds the deletion of the chunks already written to the batch
+    void discard(minifi::internal::WriteBatch& batch);
+    // the hash of the content written so far, only available if the stream has been created with hash_content
+    std::optional<ContentHashIndex::Hash> hash();
+
+   private:
+    void clear();
+
+    std::string path_;
+    gsl::not_null<minifi::internal::RocksDatabase*> db_;
+    size_t chunk_size_;
+    std::string first_chunk_;
+    std::string current_chunk_;
+    size_t current_index_ = 0;
+    size_t size_ = 0;
+    std::optional<ContentHashIndex::Hasher> hasher_;
+    std::optional<ContentHashIndex::Hash> hash_;
+  };
+
   class Session : public BufferedContentSession {
    public:
     explicit Session(std::shared_ptr<ContentRepository> repository);
 
+    std::shared_ptr<ResourceClaim> create() override;
+    std::shared_ptr<io::BaseStream> write(const std::shared_ptr<ResourceClaim>& resource_id) override;
+    std::shared_ptr<io::BaseStream> append(const std::shared_ptr<ResourceClaim>& resource_id) override;
+    std::shared_ptr<io::BaseStream> read(const std::shared_ptr<ResourceClaim>& resource_id) override;
+
     void commit() override;
+    void rollback() override;
+
+   private:
+    std::shared_ptr<ChunkedContentStream> createStream(const ResourceClaim& claim) const;
+
+    // the content of the claims created in this session, the appends to other claims are buffered by BufferedContentSession
+    std::map<std::shared_ptr<ResourceClaim>, std::shared_ptr<ChunkedContentStream>> created_resources_;
   };
 
   static constexpr std::chrono::milliseconds DEFAULT_COMPACTION_PERIOD = std::chrono::minutes{2};
+  // a deduplicated claim is stored as a key with this prefix, pointing to the content path of the claim with the same content
+  static constexpr std::string_view ALIAS_KEY_PREFIX = "#alias#";
+  // how long a modification waits for the commits deduplicating claims to the modified content
+  static constexpr std::chrono::seconds UNREGISTERED_REFERENCE_TIMEOUT{10};
 
  public:
   static constexpr const char* ENCRYPTION_KEY_NAME = "nifi.database.content.repository.encryption.key";
@@ -83,6 +147,24 @@ class DatabaseContentRepository : public core::ContentRepository {
  private:
   void runGc();
 
+  static std::string aliasKey(std::string_view content_path);
+  void loadAliases();
+  std::string resolveAlias(const std::string& content_path) const;
+  // the alias maps are only changed through these, with aliases_mutex_ held
+  void addAlias(const std::string& content_path, const std::string& target_path);
+  std::optional<std::string> removeAlias(const std::string& content_path);
+  // returns the content path of the committed content with this hash and registers a new reference to it
+  std::optional<std::string> acquireContent(const ContentHashIndex::Hash& hash, const std::string& content_path);
+  // returns the content path whose content has to be deleted, because it was the last reference to it
+  std::optional<std::string> releaseContent(const std::string& target_path);
+  // returns the content paths to be deleted when the claim is removed
+  std::vector<std::string> releaseClaim(const std::string& content_path);
+  // the claims sharing the content get their own copy of it, before the content of the claim is modified
+  bool unshareContent(const std::string& content_path);
+  // copies the content chunk by chunk, the chunks are written one by one instead of a single batch
+  bool copyContent(const std::string& source_path, const std::string& copy_path);
+  bool deleteContents(const std::vector<std::string>& content_paths);
+
  protected:
   bool removeKeySync(const std::string& content_path);
   bool removeKey(const std::string& content_path) override;
@@ -99,6 +181,25 @@ class DatabaseContentRepository : public core::ContentRepository {
   std::chrono::milliseconds compaction_period_{DEFAULT_COMPACTION_PERIOD};
   std::unique_ptr<utils::StoppableThread> compaction_thread_;
 
+  size_t chunk_size_{io::ContentChunks::DEFAULT_CHUNK_SIZE};
+
+  mutable std::mutex aliases_mutex_;
+  // deduplicated claim -> the claim it shares the content with
+  std::unordered_map<std::string, std::string> aliases_;
+  // the reverse of aliases_: claim -> the deduplicated claims sharing its content
+  std::unordered_map<std::string, std::unordered_set<std::string>> aliases_by_target_;
+  // the number of deduplicated claims sharing the content of a claim, including the ones of commits in progress;
+  // kept apart from count_map_, which counts the flow files owning a claim and is rebuilt from the flow file repository,
+  // while this is rebuilt from the persisted alias keys by loadAliases
+  std::unordered_map<std::string, size_t> alias_counts_;
+  // notified when a reference counted in alias_counts_ is added to the aliases or released
+  std::condition_variable aliases_changed_;
+  // removed claims whose content is kept while deduplicated claims share it
+  std::unordered_set<std::string> released_contents_;
+  std::mutex unshare_mutex_;
+  // set once on startup, without deduplication no aliases are added afterwards
+  bool aliases_loaded_{false};
+
   std::chrono::milliseconds purge_period_{std::chrono::seconds{1}};
   std::mutex keys_mtx_;
   std::vector<std::string> keys_to_delete_;
@@ -16,11 +16,16 @@
  */
 #include "FlowFileRepository.h"
 
+#include <algorithm>
 #include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <limits>
 #include <list>
 #include <memory>
 #include <optional>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -31,11 +36,77 @@
 #include "utils/gsl.h"
 #include "core/Resource.h"
 #include "utils/OptionalUtils.h"
+#include "utils/ValueParser.h"
 
 using namespace std::literals::chrono_literals;
 
 namespace org::apache::nifi::minifi::core::repository {
 
+namespace {
+
+constexpr size_t RECOVERY_BATCH_SIZE = 1000;
+constexpr size_t RECOVERY_QUEUE_CAPACITY = 64;
+constexpr auto RECOVERY_PROGRESS_LOG_INTERVAL = 10s;
+
+// The keys are the string representations of the flow file uuids, so they are split into ranges by their first hexadecimal digit.
+// The first range has no lower bound and the last range has no upper bound, so keys of any other format are also recovered.
+std::vector<std::pair<std::optional<std::string>, std::optional<std::string>>> createRecoveryKeyRanges() {
+  constexpr std::string_view hex_digits = "0123456789abcdef";
+  std::vector<std::pair<std::optional<std::string>, std::optional<std::string>>> ranges;
+  for (size_t i = 0; i < hex_digits.size(); ++i) {
+    std::optional<std::string> lower_bound = i == 0 ? std::nullopt : std::make_optional(std::string(1, hex_digits[i]));
+    std::optional<std::string> upper_bound = i + 1 == hex_digits.size() ? std::nullopt : std::make_optional(std::string(1, hex_digits[i + 1]));
+    ranges.emplace_back(std::move(lower_bound), std::move(upper_bound));
+  }
+  return ranges;
+}
+
+// Bounded queue between the threads reading the database and the thread restoring the flow files into their connections
+template<typename T>
+class RecoveryQueue {
+ public:
+  RecoveryQueue(size_t producer_count, size_t capacity)
+    : remaining_producers_(producer_count),
+      capacity_(capacity) {
+  }
+
+  void push(T item) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_full_.wait(lock, [&] { return items_.size() < capacity_; });
+    items_.push_back(std::move(item));
+    not_empty_.notify_one();
+  }
+
+  void producerFinished() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    --remaining_producers_;
+    not_empty_.notify_all();
+  }
+
+  // blocks until an item is available, returns std::nullopt once all producers have finished and the queue is drained
+  std::optional<T> pop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_empty_.wait(lock, [&] { return !items_.empty() || remaining_producers_ == 0; });
+    if (items_.empty()) {
+      return std::nullopt;
+    }
+    T item = std::move(items_.front());
+    items_.pop_front();
+    not_full_.notify_one();
+    return item;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable not_empty_;
+  std::condition_variable not_full_;
+  std::deque<T> items_;
+  size_t remaining_producers_;
+  const size_t capacity_;
+};
+
+}  // namespace
+
 void FlowFileRepository::flush() {
   auto opendb = db_->open();
   if (!opendb) {
@@ -59,7 +130,7 @@ void FlowFileRepository::flush() {
     logger_->log_debug("Issuing batch delete, including {}, Content path {}", ff.key, ff.content ? ff.content->getContentFullPath() : "null");
   }
 
-  auto operation = [&batch, &opendb]() { return opendb->Write(rocksdb::WriteOptions(), &batch); };
+  auto operation = [this, &batch, &opendb]() { return opendb->Write(getWriteOptions(), &batch); };
 
   if (!ExecuteWithRetry(operation)) {
     for (auto&& ff : flow_files) {
@@ -125,44 +196,151 @@ void FlowFileRepository::initialize_repository() {
     logger_->log_trace("Couldn't open database to load existing flow files");
     return;
   }
-  logger_->log_info("Reading existing flow files from database");
 
-  auto it = opendb->NewIterator(rocksdb::ReadOptions());
-  for (it->SeekToFirst(); it->Valid(); it->Next()) {
-    utils::Identifier container_id;
-    auto eventRead = FlowFileRecord::DeSerialize(gsl::make_span(it->value()).as_span<const std::byte>(), content_repo_, container_id);
-    std::string key = it->key().ToString();
-    if (eventRead) {
-      // on behalf of the just resurrected persisted instance
-      auto claim = eventRead->getResourceClaim();
-      if (claim) claim->increaseFlowFileRecordOwnedCount();
-      bool found = false;
-      auto search = containers_.find(container_id.to_string());
-      found = (search != containers_.end());
-      if (!found) {
-        // for backward compatibility
-        search = connection_map_.find(container_id.to_string());
-        found = (search != connection_map_.end());
+  std::string key_count;
+  opendb->GetProperty("rocksdb.estimate-num-keys", &key_count);
+  // the estimate is only reported in the metrics, an unparsable one is not worth failing the recovery for
+  estimated_recovery_entry_count_ = utils::toNumber<uint64_t>(key_count).value_or(0);
+  recovered_entry_count_ = 0;
+  {
+    std::lock_guard<std::mutex> lock(recovery_time_mutex_);
+    recovery_start_ = std::chrono::steady_clock::now();
+    recovery_end_.reset();
+  }
+  recovery_in_progress_ = true;
+
+  const auto key_ranges = createRecoveryKeyRanges();
+  const size_t thread_count = std::min(recovery_thread_count_, key_ranges.size());
+  logger_->log_info("Reading approximately {} existing flow files from database using {} threads", estimated_recovery_entry_count_.load(), thread_count);
+
+  RecoveryQueue<std::vector<RecoveredFlowFile>> recovery_queue(thread_count, RECOVERY_QUEUE_CAPACITY);
+  std::atomic<size_t> next_key_range{0};
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < thread_count; ++i) {
+    threads.emplace_back([&] {
+      for (size_t range_idx = next_key_range++; range_idx < key_ranges.size(); range_idx = next_key_range++) {
+        recoverKeyRange(key_ranges[range_idx].first, key_ranges[range_idx].second, [&recovery_queue] (std::vector<RecoveredFlowFile> batch) {
+          recovery_queue.push(std::move(batch));
+        });
       }
-      if (found) {
-        logger_->log_debug("Found connection for {}, path {} ", container_id.to_string(), eventRead->getContentFullPath());
-        eventRead->setStoredToRepository(true);
-        // we found the connection for the persistent flowFile
-        // even if a processor immediately marks it for deletion, flush only happens after prune_stored_flowfiles
-        search->second->restore(eventRead);
-      } else {
-        logger_->log_warn("Could not find connection for {}, path {} ", container_id.to_string(), eventRead->getContentFullPath());
-        keys_to_delete_.enqueue({.key = key, .content = eventRead->getResourceClaim()});
+      recovery_queue.producerFinished();
+    });
+  }
+
+  auto last_progress_log = std::chrono::steady_clock::now();
+  while (auto batch = recovery_queue.pop()) {
+    for (auto& recovered : *batch) {
+      restoreFlowFile(recovered);
+    }
+    recovered_entry_count_ += batch->size();
+    if (std::chrono::steady_clock::now() - last_progress_log >= RECOVERY_PROGRESS_LOG_INTERVAL) {
+      last_progress_log = std::chrono::steady_clock::now();
+      if (const auto stats = getRecoveryStats()) {
+        logger_->log_info("Recovered {} of approximately {} flow files in {}, estimated time remaining: {}",
+            stats->recovered_entry_count, stats->estimated_entry_count, stats->elapsed, stats->estimated_remaining);
       }
-    } else {
-      // failed to deserialize FlowFile, cannot clear claim
-      keys_to_delete_.enqueue({.key = key});
     }
   }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(recovery_time_mutex_);
+    recovery_end_ = std::chrono::steady_clock::now();
+  }
+  recovery_in_progress_ = false;
+  if (const auto stats = getRecoveryStats()) {
+    logger_->log_info("Recovered {} flow files from database in {}", stats->recovered_entry_count, stats->elapsed);
+  }
+
   flush();
   content_repo_->clearOrphans();
 }
 
+void FlowFileRepository::recoverKeyRange(std::optional<std::string> lower_bound, std::optional<std::string> upper_bound,
+    const std::function<void(std::vector<RecoveredFlowFile>)>& consumer) {
+  auto opendb = db_->open();
+  if (!opendb) {
+    logger_->log_error("Couldn't open database to load existing flow files");
+    return;
+  }
+
+  rocksdb::ReadOptions read_options;
+  std::optional<rocksdb::Slice> upper_bound_slice;
+  if (upper_bound) {
+    upper_bound_slice.emplace(*upper_bound);
+    read_options.iterate_upper_bound = &*upper_bound_slice;
+  }
+  auto it = opendb->NewIterator(read_options);
+  if (lower_bound) {
+    it->Seek(*lower_bound);
+  } else {
+    it->SeekToFirst();
+  }
+
+  std::vector<RecoveredFlowFile> batch;
+  for (; it->Valid(); it->Next()) {
+    RecoveredFlowFile recovered{.key = it->key().ToString()};
+    recovered.flow_file = FlowFileRecord::DeSerialize(gsl::make_span(it->value()).as_span<const std::byte>(), content_repo_, recovered.container_id);
+    batch.push_back(std::move(recovered));
+    if (batch.size() >= RECOVERY_BATCH_SIZE) {
+      consumer(std::exchange(batch, {}));
+    }
+  }
+  if (!batch.empty()) {
+    consumer(std::move(batch));
+  }
+}
+
+void FlowFileRepository::restoreFlowFile(RecoveredFlowFile& recovered) {
+  auto& eventRead = recovered.flow_file;
+  if (!eventRead) {
+    // failed to deserialize FlowFile, cannot clear claim
+    keys_to_delete_.enqueue({.key = recovered.key});
+    return;
+  }
+  // on behalf of the just resurrected persisted instance
+  auto claim = eventRead->getResourceClaim();
+  if (claim) claim->increaseFlowFileRecordOwnedCount();
+  const auto container_id = recovered.container_id.to_string();
+  auto search = containers_.find(container_id);
+  bool found = (search != containers_.end());
+  if (!found) {
+    // for backward compatibility
+    search = connection_map_.find(container_id);
+    found = (search != connection_map_.end());
+  }
+  if (found) {
+    logger_->log_debug("Found connection for {}, path {} ", container_id, eventRead->getContentFullPath());
+    eventRead->setStoredToRepository(true);
+    // we found the connection for the persistent flowFile
+    // even if a processor immediately marks it for deletion, flush only happens after prune_stored_flowfiles
+    search->second->restore(eventRead);
+  } else {
+    logger_->log_warn("Could not find connection for {}, path {} ", container_id, eventRead->getContentFullPath());
+    keys_to_delete_.enqueue({.key = recovered.key, .content = eventRead->getResourceClaim()});
+  }
+}
+
+std::optional<RepositoryMetricsSource::RecoveryStats> FlowFileRepository::getRecoveryStats() const {
+  std::lock_guard<std::mutex> lock(recovery_time_mutex_);
+  if (!recovery_start_) {
+    return std::nullopt;
+  }
+  RecoveryStats stats;
+  stats.in_progress = recovery_in_progress_;
+  stats.recovered_entry_count = recovered_entry_count_;
+  stats.estimated_entry_count = std::max(estimated_recovery_entry_count_.load(), stats.recovered_entry_count);
+  stats.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(recovery_end_.value_or(std::chrono::steady_clock::now()) - *recovery_start_);
+  if (stats.in_progress && stats.recovered_entry_count > 0) {
+    const auto remaining_entry_count = stats.estimated_entry_count - stats.recovered_entry_count;
+    stats.estimated_remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::duration<double, std::milli>{stats.elapsed} * static_cast<double>(remaining_entry_count) / static_cast<double>(stats.recovered_entry_count));
+  }
+  return stats;
+}
+
 void FlowFileRepository::loadComponent(const std::shared_ptr<core::ContentRepository> &content_repo) {
   content_repo_ = content_repo;
   swap_loader_ = std::make_unique<FlowFileLoader>(gsl::make_not_null(db_.get()), content_repo_);
@@ -180,6 +358,8 @@ bool FlowFileRepository::initialize(const std::shared_ptr<Configure> &configure)
   logger_->log_debug("NiFi FlowFile Repository Directory {}", directory_);
 
   setCompactionPeriod(configure);
+  setRecoveryThreadCount(configure);
+  configureCommits(configure, Configure::nifi_flowfile_repository_rocksdb_commit_mode, Configure::nifi_flowfile_repository_rocksdb_sync_writes);
 
   const auto encrypted_env = createEncryptingEnv(utils::crypto::EncryptionManager{configure->getHome()}, DbEncryptionOptions{directory_, ENCRYPTION_KEY_NAME});
   logger_->log_info("Using {} FlowFileRepository", encrypted_env ? "encrypted" : "plaintext");
@@ -236,6 +416,20 @@ void FlowFileRepository::setCompactionPeriod(const std::shared_ptr<Configure> &c
   }
 }
 
+void FlowFileRepository::setRecoveryThreadCount(const std::shared_ptr<Configure> &configure) {
+  recovery_thread_count_ = std::clamp<size_t>(std::thread::hardware_concurrency(), 1, MAX_FLOWFILE_REPOSITORY_RECOVERY_THREADS);
+  if (auto recovery_threads_str = configure->get(Configure::nifi_flowfile_repository_recovery_threads)) {
+    uint64_t recovery_threads = 0;
+    if (core::Property::StringToInt(*recovery_threads_str, recovery_threads) && recovery_threads > 0) {
+      // clamp the thread count, so that a huge configured value does not fail the narrowing conversion on 32-bit platforms
+      recovery_thread_count_ = gsl::narrow<size_t>(std::min<uint64_t>(recovery_threads, std::numeric_limits<uint32_t>::max()));
+    } else {
+      logger_->log_error("Malformed property '{}', expected positive integer, using default", Configure::nifi_flowfile_repository_recovery_threads);
+    }
+  }
+  logger_->log_debug("Using {} threads to recover flow files", recovery_thread_count_);
+}
+
 bool FlowFileRepository::Delete(const std::string& key) {
   keys_to_delete_.enqueue({.key = key});
   return true;
@@ -273,9 +467,12 @@ bool FlowFileRepository::stop() {
   return ThreadedRepository::stop();
 }
 
-void FlowFileRepository::store(std::vector<std::shared_ptr<core::FlowFile>> flow_files) {
+std::future<void> FlowFileRepository::store(std::vector<std::shared_ptr<core::FlowFile>> flow_files) {
   gsl_Expects(ranges::all_of(flow_files, &FlowFile::isStored));
   // pass, flowfiles are already persisted in the repository
+  std::promise<void> stored;
+  stored.set_value();
+  return stored.get_future();
 }
 
 std::future<std::vector<std::shared_ptr<core::FlowFile>>> FlowFileRepository::load(std::vector<SwappedFlowFile> flow_files) {
@@ -16,6 +16,10 @@
  */
 #pragma once
 
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <optional>
 #include <utility>
 #include <vector>
 #include <string>
@@ -30,6 +34,7 @@
 #include "core/Core.h"
 #include "core/logging/LoggerConfiguration.h"
 #include "Connection.h"
+#include "FlowFileRecord.h"
 #include "concurrentqueue.h"
 #include "database/RocksDatabase.h"
 #include "encryption/RocksDbEncryptionProvider.h"
@@ -53,10 +58,14 @@ constexpr auto FLOWFILE_CHECKPOINT_DIRECTORY = "./flowfile_checkpoint";
 constexpr auto MAX_FLOWFILE_REPOSITORY_STORAGE_SIZE = 10_MiB;
 constexpr auto MAX_FLOWFILE_REPOSITORY_ENTRY_LIFE_TIME = std::chrono::minutes(10);
 constexpr auto FLOWFILE_REPOSITORY_PURGE_PERIOD = std::chrono::seconds(2);
+constexpr size_t MAX_FLOWFILE_REPOSITORY_RECOVERY_THREADS = 8;
 
 /**
  * Flow File repository
  * Design: Extends Repository and implements the run function, using rocksdb as the primary substrate.
+ * On startup the persisted flow files are read back by multiple threads, each of them iterating over
+ * a range of the keys and deserializing the flow files, while the loading thread restores the
+ * deserialized flow files into their connections.
  */
 class FlowFileRepository : public RocksDbRepository, public SwapManager {
   static constexpr std::chrono::milliseconds DEFAULT_COMPACTION_PERIOD = std::chrono::minutes{2};
@@ -66,6 +75,12 @@ class FlowFileRepository : public RocksDbRepository, public SwapManager {
     std::shared_ptr<ResourceClaim> content{};
   };
 
+  struct RecoveredFlowFile {
+    std::string key;
+    utils::Identifier container_id;
+    std::shared_ptr<FlowFileRecord> flow_file;
+  };
+
  public:
   static constexpr const char* ENCRYPTION_KEY_NAME = "nifi.flowfile.repository.encryption.key";
 
@@ -102,15 +117,20 @@ class FlowFileRepository : public RocksDbRepository, public SwapManager {
   void loadComponent(const std::shared_ptr<core::ContentRepository> &content_repo) override;
   bool start() override;
   bool stop() override;
-  void store([[maybe_unused]] std::vector<std::shared_ptr<core::FlowFile>> flow_files) override;
+  std::future<void> store([[maybe_unused]] std::vector<std::shared_ptr<core::FlowFile>> flow_files) override;
   std::future<std::vector<std::shared_ptr<core::FlowFile>>> load(std::vector<SwappedFlowFile> flow_files) override;
 
+  std::optional<RecoveryStats> getRecoveryStats() const override;
+
  private:
   void run() override;
   void initialize_repository();
 
   void runCompaction();
   void setCompactionPeriod(const std::shared_ptr<Configure> &configure);
+  void setRecoveryThreadCount(const std::shared_ptr<Configure> &configure);
+  void recoverKeyRange(std::optional<std::string> lower_bound, std::optional<std::string> upper_bound, const std::function<void(std::vector<RecoveredFlowFile>)>& consumer);
+  void restoreFlowFile(RecoveredFlowFile& recovered);
 
   void deserializeFlowFilesWithNoContentClaim(minifi::internal::OpenRocksDb& opendb, std::list<ExpiredFlowFileInfo>& flow_files);
 
@@ -121,6 +141,14 @@ class FlowFileRepository : public RocksDbRepository, public SwapManager {
 
   std::chrono::milliseconds compaction_period_;
   std::unique_ptr<utils::StoppableThread> compaction_thread_;
+
+  size_t recovery_thread_count_ = 1;
+  std::atomic<bool> recovery_in_progress_{false};
+  std::atomic<uint64_t> recovered_entry_count_{0};
+  std::atomic<uint64_t> estimated_recovery_entry_count_{0};
+  mutable std::mutex recovery_time_mutex_;
+  std::optional<std::chrono::steady_clock::time_point> recovery_start_;
+  std::optional<std::chrono::steady_clock::time_point> recovery_end_;
 };
 
 }  // namespace org::apache::nifi::minifi::core::repository
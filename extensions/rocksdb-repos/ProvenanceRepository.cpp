@@ -18,11 +18,55 @@
 #include "ProvenanceRepository.h"
 
 #include <string>
+#include <utility>
 
 #include "core/Resource.h"
+#include "utils/StringUtils.h"
 
 namespace org::apache::nifi::minifi::provenance {
 
+namespace {
+
+constexpr std::string_view FLOW_FILE_INDEX = "flowfile_index";
+constexpr std::string_view COMPONENT_INDEX = "component_index";
+constexpr std::string_view EVENT_TYPE_INDEX = "event_type_index";
+constexpr std::string_view TIME_INDEX = "time_index";
+
+// FIFO compaction limits every column family separately, so the configured storage size is split between them:
+// an index entry is around a hundred bytes, a fraction of a typical event, so 10% each lets the indexes
+// cover at least as many events as the 60% left for the events
+constexpr int64_t INDEX_STORAGE_PERCENT = 10;
+constexpr int64_t INDEX_COUNT = 4;
+
+// the indexes are column families of the database of the repository
+std::string getIndexUri(const std::string& directory, std::string_view index_name) {
+  constexpr std::string_view scheme = "minifidb://";
+  if (utils::StringUtils::startsWith(directory, scheme)) {
+    return directory + "_" + std::string{index_name};
+  }
+  return std::string{scheme} + directory + "/" + std::string{index_name};
+}
+
+// big-endian, so that the keys are ordered by time
+std::string getTimeKey(std::chrono::system_clock::time_point time_point) {
+  const auto milliseconds = std::max<int64_t>(0, std::chrono::duration_cast<std::chrono::milliseconds>(time_point.time_since_epoch()).count());
+  std::string key(8, '\0');
+  for (size_t i = 0; i < key.size(); ++i) {
+    key[i] = static_cast<char>((static_cast<uint64_t>(milliseconds) >> (8 * (key.size() - 1 - i))) & 0xFF);
+  }
+  return key;
+}
+
+std::string getComponentKeyPrefix(const std::string& component_id) {
+  return component_id + '\0';
+}
+
+std::string getEventTypeKeyPrefix(ProvenanceEventRecord::ProvenanceEventType event_type) {
+  return std::string(1, static_cast<char>(event_type));
+}
+
+}  // namespace
+
 bool ProvenanceRepository::initialize(const std::shared_ptr<org::apache::nifi::minifi::Configure> &config) {
   std::string value;
   if (config->get(Configure::nifi_provenance_repository_directory_default, value) && !value.empty()) {
@@ -46,21 +90,26 @@ bool ProvenanceRepository::initialize(const std::shared_ptr<org::apache::nifi::m
   };
 
   // Rocksdb write buffers act as a log of database operation: grow till reaching the limit, serialized after
-  // This shouldn't go above 16MB and the configured total size of the db should cap it as well
-  auto cf_options = [this] (rocksdb::ColumnFamilyOptions& cf_opts) {
-    int64_t max_buffer_size = 16 << 20;
-    cf_opts.write_buffer_size = gsl::narrow<size_t>(std::min(max_buffer_size, max_partition_bytes_));
-    cf_opts.max_write_buffer_number = 4;
-    cf_opts.min_write_buffer_number_to_merge = 1;
-
-    cf_opts.compaction_style = rocksdb::CompactionStyle::kCompactionStyleFIFO;
-    cf_opts.compaction_options_fifo = rocksdb::CompactionOptionsFIFO(max_partition_bytes_, false);
-    if (max_partition_millis_ > std::chrono::milliseconds(0)) {
-      cf_opts.ttl = std::chrono::duration_cast<std::chrono::seconds>(max_partition_millis_).count();
-    }
+  // This shouldn't go above 16MB and the storage size of the column family should cap it as well
+  auto cf_options = [this] (int64_t max_storage_size) {
+    return [this, max_storage_size] (rocksdb::ColumnFamilyOptions& cf_opts) {
+      int64_t max_buffer_size = 16 << 20;
+      cf_opts.write_buffer_size = gsl::narrow<size_t>(std::min(max_buffer_size, max_storage_size));
+      cf_opts.max_write_buffer_number = 4;
+      cf_opts.min_write_buffer_number_to_merge = 1;
+
+      cf_opts.compaction_style = rocksdb::CompactionStyle::kCompactionStyleFIFO;
+      cf_opts.compaction_options_fifo = rocksdb::CompactionOptionsFIFO(gsl::narrow<uint64_t>(max_storage_size), false);
+      if (max_partition_millis_ > std::chrono::milliseconds(0)) {
+        cf_opts.ttl = std::chrono::duration_cast<std::chrono::seconds>(max_partition_millis_).count();
+      }
+    };
   };
+  const int64_t index_storage_size = max_partition_bytes_ / 100 * INDEX_STORAGE_PERCENT;
+  const int64_t event_storage_size = max_partition_bytes_ - INDEX_COUNT * index_storage_size;
+  logger_->log_debug("MiNiFi Provenance storage size of the events {}, of each index {}", event_storage_size, index_storage_size);
 
-  db_ = minifi::internal::RocksDatabase::create(db_options, cf_options, directory_);
+  db_ = minifi::internal::RocksDatabase::create(db_options, cf_options(event_storage_size), directory_);
   if (db_->open()) {
     logger_->log_debug("MiNiFi Provenance Repository database open {} success", directory_);
   } else {
@@ -68,9 +117,120 @@ bool ProvenanceRepository::initialize(const std::shared_ptr<org::apache::nifi::m
     return false;
   }
 
+  for (auto [index, index_name] : {std::pair{&flow_file_index_, FLOW_FILE_INDEX}, std::pair{&component_index_, COMPONENT_INDEX},
+      std::pair{&event_type_index_, EVENT_TYPE_INDEX}, std::pair{&time_index_, TIME_INDEX}}) {
+    *index = minifi::internal::RocksDatabase::create(db_options, cf_options(index_storage_size), getIndexUri(directory_, index_name));
+    if (!*index || !(*index)->open()) {
+      logger_->log_error("MiNiFi Provenance Repository index {} open in {} failed", index_name, directory_);
+      return false;
+    }
+  }
+
   return true;
 }
 
+bool ProvenanceRepository::Put(const std::string& key, const uint8_t *buf, size_t bufLen) {
+  Records records;
+  records.emplace_back(key, std::make_unique<io::BufferStream>(std::span(reinterpret_cast<const std::byte*>(buf), bufLen)));
+  return MultiPut(records);
+}
+
+bool ProvenanceRepository::indexRecords(minifi::internal::WriteBatch& batch, const std::vector<const Records*>& record_sets) {
+  auto flow_file_index = flow_file_index_->open();
+  auto component_index = component_index_->open();
+  auto event_type_index = event_type_index_->open();
+  auto time_index = time_index_->open();
+  if (!flow_file_index || !component_index || !event_type_index || !time_index) {
+    return false;
+  }
+  for (const auto* records : record_sets) {
+    for (const auto& [key, stream] : *records) {
+      const auto read_position = stream->tell();
+      stream->seek(0);
+      const auto fields = ProvenanceEventRecord::readIndexedFields(*stream);
+      stream->seek(read_position);
+      if (!fields) {
+        logger_->log_debug("Could not read the indexed fields of provenance event {}, it is not indexed", key);
+        continue;
+      }
+      const std::string key_suffix = getTimeKey(fields->event_time) + key;
+      if (!batch.Put(*flow_file_index, fields->flow_file_uuid.to_string() + key_suffix, key).ok()
+          || !batch.Put(*component_index, getComponentKeyPrefix(fields->component_id) + key_suffix, key).ok()
+          || !batch.Put(*event_type_index, getEventTypeKeyPrefix(fields->event_type) + key_suffix, key).ok()
+          || !batch.Put(*time_index, key_suffix, key).ok()) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+ProvenanceQueryResult ProvenanceRepository::query(const ProvenanceQuery& query) {
+  ProvenanceQueryResult result;
+  auto& events = result.events;
+  // use the most selective index the query has a value for, the rest of the criteria are checked on the events
+  const auto [index, key_prefix] = [&]() -> std::pair<minifi::internal::RocksDatabase*, std::string> {
+    if (query.flow_file_uuid) {
+      return {flow_file_index_.get(), query.flow_file_uuid->to_string()};
+    }
+    if (query.component_id) {
+      return {component_index_.get(), getComponentKeyPrefix(*query.component_id)};
+    }
+    if (query.event_type) {
+      return {event_type_index_.get(), getEventTypeKeyPrefix(*query.event_type)};
+    }
+    return {time_index_.get(), ""};
+  }();
+  if (!db_ || !index) {
+    return result;
+  }
+  auto opendb = db_->open();
+  auto index_db = index->open();
+  if (!opendb || !index_db) {
+    return result;
+  }
+
+  const std::string lower_bound = key_prefix + getTimeKey(query.start_time.value_or(std::chrono::system_clock::time_point{}));
+  const std::string upper_bound = key_prefix + (query.end_time ? getTimeKey(*query.end_time) : std::string(8, '\xFF'));
+  std::unique_ptr<rocksdb::Iterator> it(index_db->NewIterator(rocksdb::ReadOptions()));
+  // the index entries of events which do not match the rest of the criteria, or which have been dropped, are also counted,
+  // so that a selective query does not walk the whole index
+  const size_t max_scanned = query.maxScannedEvents();
+  size_t scanned = 0;
+  // newest first
+  for (it->SeekForPrev(upper_bound); it->Valid() && it->key().compare(lower_bound) >= 0 && events.size() < query.max_results; it->Prev()) {
+    if (scanned++ == max_scanned) {
+      logger_->log_debug("Provenance query stopped after {} index entries with {} results", max_scanned, events.size());
+      result.truncated = true;
+      break;
+    }
+    std::string value;
+    if (!opendb->Get(rocksdb::ReadOptions(), it->value(), &value).ok()) {
+      // the index entries can outlive the events dropped by the compaction
+      continue;
+    }
+    auto event = std::make_shared<ProvenanceEventRecord>();
+    io::BufferStream stream(value);
+    if (event->deserialize(stream) && query.matches(*event)) {
+      events.push_back(std::move(event));
+    }
+  }
+  return result;
+}
+
+uint64_t ProvenanceRepository::getRepositorySize() const {
+  uint64_t size = RocksDbRepository::getRepositorySize();
+  for (const auto* index : {&flow_file_index_, &component_index_, &event_type_index_, &time_index_}) {
+    if (!*index) {
+      continue;
+    }
+    if (auto index_db = (*index)->open()) {
+      size += index_db->getApproximateSizes().value_or(0);
+    }
+  }
+  return size;
+}
+
 bool ProvenanceRepository::getElements(std::vector<std::shared_ptr<core::SerializableComponent>> &records, size_t &max_size) {
   auto opendb = db_->open();
   if (!opendb) {
@@ -94,6 +254,10 @@ bool ProvenanceRepository::getElements(std::vector<std::shared_ptr<core::Seriali
 }
 
 void ProvenanceRepository::destroy() {
+  flow_file_index_.reset();
+  component_index_.reset();
+  event_type_index_.reset();
+  time_index_.reset();
   db_.reset();
 }
 
@@ -29,6 +29,7 @@
 #include "core/Core.h"
 #include "core/logging/LoggerConfiguration.h"
 #include "provenance/Provenance.h"
+#include "provenance/ProvenanceQuery.h"
 #include "utils/Literals.h"
 #include "RocksDbRepository.h"
 
@@ -39,7 +40,15 @@ constexpr auto MAX_PROVENANCE_STORAGE_SIZE = 10_MiB;
 constexpr auto MAX_PROVENANCE_ENTRY_LIFE_TIME = std::chrono::minutes(1);
 constexpr auto PROVENANCE_PURGE_PERIOD = std::chrono::milliseconds(2500);
 
-class ProvenanceRepository : public core::repository::RocksDbRepository {
+/**
+ * Besides the events, the repository maintains secondary indexes in separate column families of
+ * the same database, by flow file UUID, component id, event type and event time. The index entries
+ * are written in the write batch of the events, so the indexes are always consistent with the events.
+ * An index key is the indexed value followed by the big-endian event time and the event id,
+ * so the events of a given value are sorted by time and can be searched by time ranges.
+ * The configured storage size is shared by the events and the indexes.
+ */
+class ProvenanceRepository : public core::repository::RocksDbRepository, public QueryableProvenanceRepository {
  public:
   ProvenanceRepository(std::string_view name, const utils::Identifier& /*uuid*/)
     : ProvenanceRepository(name) {
@@ -68,12 +77,20 @@ class ProvenanceRepository : public core::repository::RocksDbRepository {
 
   bool initialize(const std::shared_ptr<org::apache::nifi::minifi::Configure> &config) override;
 
+  // the events are indexed in the write batch of MultiPut
+  bool Put(const std::string& key, const uint8_t *buf, size_t bufLen) override;
+
   bool Delete(const std::string& /*key*/) override {
     // The repo is cleaned up by itself, there is no need to delete items.
     return true;
   }
   bool getElements(std::vector<std::shared_ptr<core::SerializableComponent>> &records, size_t &max_size) override;
 
+  // the size of the events and of the indexes
+  uint64_t getRepositorySize() const override;
+
+  ProvenanceQueryResult query(const ProvenanceQuery& query) override;
+
   void destroy();
 
   // Prevent default copy constructor and assignment operation
@@ -82,9 +99,17 @@ class ProvenanceRepository : public core::repository::RocksDbRepository {
 
   ProvenanceRepository &operator=(const ProvenanceRepository &parent) = delete;
 
+ protected:
+  bool indexRecords(minifi::internal::WriteBatch& batch, const std::vector<const Records*>& record_sets) override;
+
  private:
   // Run function for the thread
   void run() override {};
+
+  std::unique_ptr<minifi::internal::RocksDatabase> flow_file_index_;
+  std::unique_ptr<minifi::internal::RocksDatabase> component_index_;
+  std::unique_ptr<minifi::internal::RocksDatabase> event_type_index_;
+  std::unique_ptr<minifi::internal::RocksDatabase> time_index_;
 };
 
 }  // namespace org::apache::nifi::minifi::provenance
@@ -15,7 +15,12 @@
  * limitations under the License.
  */
 #include "RocksDbRepository.h"
+
+#include <algorithm>
+#include <numeric>
+
 #include "utils/span.h"
+#include "utils/StringUtils.h"
 
 using namespace std::literals::chrono_literals;
 
@@ -30,6 +35,62 @@ std::optional<RepositoryMetricsSource::RocksDbStats> RocksDbRepository::getRocks
   return opendb->getStats();
 }
 
+std::optional<RepositoryMetricsSource::CommitStats> RocksDbRepository::getCommitStats() const {
+  std::lock_guard<std::mutex> lock(commit_stats_mutex_);
+  CommitStats stats;
+  stats.commit_count = commit_count_;
+  stats.write_count = write_count_;
+  if (!recent_write_batch_sizes_.empty()) {
+    stats.average_write_batch_size = static_cast<double>(std::accumulate(recent_write_batch_sizes_.begin(), recent_write_batch_sizes_.end(), uint64_t{0}))
+        / static_cast<double>(recent_write_batch_sizes_.size());
+    stats.max_write_batch_size = *std::max_element(recent_write_batch_sizes_.begin(), recent_write_batch_sizes_.end());
+  }
+  if (!recent_commit_latencies_.empty()) {
+    stats.average_commit_latency = std::accumulate(recent_commit_latencies_.begin(), recent_commit_latencies_.end(), std::chrono::steady_clock::duration::zero())
+        / static_cast<double>(recent_commit_latencies_.size());
+    stats.max_commit_latency = *std::max_element(recent_commit_latencies_.begin(), recent_commit_latencies_.end());
+  }
+  return stats;
+}
+
+void RocksDbRepository::configureCommits(const std::shared_ptr<Configure>& configure, std::string_view commit_mode_property, std::string_view sync_writes_property) {
+  commit_mode_ = CommitMode::DIRECT;
+  if (auto commit_mode_str = configure->get(std::string{commit_mode_property})) {
+    if (utils::StringUtils::equalsIgnoreCase(*commit_mode_str, "group")) {
+      commit_mode_ = CommitMode::GROUP;
+    } else if (!utils::StringUtils::equalsIgnoreCase(*commit_mode_str, "direct")) {
+      logger_->log_error("Invalid value '{}' for property {}, falling back to direct commits", *commit_mode_str, commit_mode_property);
+    }
+  }
+  sync_writes_ = (configure->get(std::string{sync_writes_property}) | utils::andThen(utils::StringUtils::toBool)).value_or(false);
+  logger_->log_info("Using {} commits {} syncing the write-ahead log in repository {}",
+      commit_mode_ == CommitMode::GROUP ? "group" : "direct", sync_writes_ ? "with" : "without", getName());
+}
+
+rocksdb::WriteOptions RocksDbRepository::getWriteOptions() const {
+  rocksdb::WriteOptions options;
+  options.sync = sync_writes_;
+  return options;
+}
+
+void RocksDbRepository::recordCommit(std::chrono::steady_clock::duration latency) {
+  std::lock_guard<std::mutex> lock(commit_stats_mutex_);
+  ++commit_count_;
+  recent_commit_latencies_.push_back(latency);
+  if (recent_commit_latencies_.size() > COMMIT_STATS_SAMPLE_SIZE) {
+    recent_commit_latencies_.pop_front();
+  }
+}
+
+void RocksDbRepository::recordWrite(size_t batch_size) {
+  std::lock_guard<std::mutex> lock(commit_stats_mutex_);
+  ++write_count_;
+  recent_write_batch_sizes_.push_back(batch_size);
+  if (recent_write_batch_sizes_.size() > COMMIT_STATS_SAMPLE_SIZE) {
+    recent_write_batch_sizes_.pop_front();
+  }
+}
+
 bool RocksDbRepository::ExecuteWithRetry(const std::function<rocksdb::Status()>& operation) {
   constexpr int RETRY_COUNT = 3;
   std::chrono::milliseconds wait_time = 0ms;
@@ -52,26 +113,78 @@ bool RocksDbRepository::Put(const std::string& key, const uint8_t *buf, size_t b
     return false;
   }
   rocksdb::Slice value(reinterpret_cast<const char *>(buf), bufLen);
-  auto operation = [&key, &value, &opendb]() { return opendb->Put(rocksdb::WriteOptions(), key, value); };
+  auto operation = [this, &key, &value, &opendb]() { return opendb->Put(getWriteOptions(), key, value); };
   return ExecuteWithRetry(operation);
 }
 
 bool RocksDbRepository::MultiPut(const std::vector<std::pair<std::string, std::unique_ptr<minifi::io::BufferStream>>>& data) {
+  const auto start = std::chrono::steady_clock::now();
+  const bool success = commit_mode_ == CommitMode::GROUP ? groupCommit(data) : writeRecords({&data});
+  recordCommit(std::chrono::steady_clock::now() - start);
+  return success;
+}
+
+bool RocksDbRepository::writeRecords(const std::vector<const Records*>& record_sets) {
   auto opendb = db_->open();
   if (!opendb) {
     return false;
   }
   auto batch = opendb->createWriteBatch();
-  for (const auto &item : data) {
-    const auto buf = utils::as_span<const char>(item.second->getBuffer());
-    rocksdb::Slice value(buf.data(), buf.size());
-    if (!batch.Put(item.first, value).ok()) {
-      logger_->log_error("Failed to add item to batch operation");
-      return false;
+  size_t batch_size = 0;
+  for (const auto* records : record_sets) {
+    for (const auto &item : *records) {
+      const auto buf = utils::as_span<const char>(item.second->getBuffer());
+      rocksdb::Slice value(buf.data(), buf.size());
+      if (!batch.Put(item.first, value).ok()) {
+        logger_->log_error("Failed to add item to batch operation");
+        return false;
+      }
     }
+    batch_size += records->size();
   }
-  auto operation = [&batch, &opendb]() { return opendb->Write(rocksdb::WriteOptions(), &batch); };
-  return ExecuteWithRetry(operation);
+  if (!indexRecords(batch, record_sets)) {
+    logger_->log_error("Failed to add the index entries to batch operation");
+    return false;
+  }
+  auto operation = [this, &batch, &opendb]() { return opendb->Write(getWriteOptions(), &batch); };
+  const bool success = ExecuteWithRetry(operation);
+  recordWrite(batch_size);
+  return success;
+}
+
+bool RocksDbRepository::groupCommit(const Records& records) {
+  PendingCommit commit{&records};
+  std::unique_lock<std::mutex> lock(commit_mutex_);
+  pending_commits_.push_back(&commit);
+  commit_cv_.wait(lock, [&] { return commit.done || pending_commits_.front() == &commit; });
+  if (commit.done) {
+    return commit.success;
+  }
+
+  // we are the leader, collect the commits queued behind us until the group gets too large
+  std::vector<const Records*> group;
+  size_t group_size = 0;
+  for (auto* pending : pending_commits_) {
+    const size_t pending_size = std::accumulate(pending->records->begin(), pending->records->end(), size_t{0},
+        [](size_t sum, const auto& item) { return sum + item.first.size() + item.second->size(); });
+    if (!group.empty() && group_size + pending_size > MAX_GROUP_COMMIT_SIZE) {
+      break;
+    }
+    group.push_back(pending->records);
+    group_size += pending_size;
+  }
+
+  lock.unlock();
+  const bool success = writeRecords(group);
+  lock.lock();
+
+  for (size_t i = 0; i < group.size(); ++i) {
+    pending_commits_.front()->done = true;
+    pending_commits_.front()->success = success;
+    pending_commits_.pop_front();
+  }
+  commit_cv_.notify_all();
+  return success;
 }
 
 bool RocksDbRepository::Get(const std::string &key, std::string &value) {
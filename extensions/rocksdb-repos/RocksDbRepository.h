@@ -16,6 +16,9 @@
  */
 #pragma once
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 #include <utility>
 #include <vector>
 #include <string>
@@ -24,13 +27,30 @@
 
 #include "database/RocksDatabase.h"
 #include "core/ThreadedRepository.h"
+#include "properties/Configure.h"
 
 namespace org::apache::nifi::minifi::core::repository {
 
 constexpr auto FLOWFILE_REPOSITORY_RETRY_INTERVAL_INCREMENTS = std::chrono::milliseconds(500);
 
+/**
+ * Base of the repositories persisted to a RocksDB database.
+ *
+ * In group commit mode concurrent MultiPut calls are merged: the first caller in the queue
+ * becomes the leader, writes the records of every caller queued up to that point in a
+ * single write batch (and a single WAL sync if sync writes are enabled), then wakes the
+ * followers, the next of whom becomes the leader of the following group.
+ */
 class RocksDbRepository : public ThreadedRepository {
  public:
+  enum class CommitMode {
+    DIRECT,
+    GROUP
+  };
+
+  static constexpr size_t MAX_GROUP_COMMIT_SIZE = 4_MiB;
+  static constexpr size_t COMMIT_STATS_SAMPLE_SIZE = 100;
+
   RocksDbRepository(std::string_view repo_name,
                     std::string directory,
                     std::chrono::milliseconds max_partition_millis,
@@ -48,9 +68,27 @@ class RocksDbRepository : public ThreadedRepository {
   uint64_t getRepositorySize() const override;
   uint64_t getRepositoryEntryCount() const override;
   std::optional<RocksDbStats> getRocksDbStats() const override;
+  std::optional<CommitStats> getCommitStats() const override;
+
+  CommitMode getCommitMode() const {
+    return commit_mode_;
+  }
 
  protected:
+  using Records = std::vector<std::pair<std::string, std::unique_ptr<minifi::io::BufferStream>>>;
+
   bool ExecuteWithRetry(const std::function<rocksdb::Status()>& operation);
+  void configureCommits(const std::shared_ptr<Configure>& configure, std::string_view commit_mode_property, std::string_view sync_writes_property);
+  rocksdb::WriteOptions getWriteOptions() const;
+
+  /**
+   * Called with the batch of every write before it is committed, so that the
+   * derived repositories can add the index entries of the records to the same batch.
+   * @return false to fail the write
+   */
+  virtual bool indexRecords(minifi::internal::WriteBatch& /*batch*/, const std::vector<const Records*>& /*record_sets*/) {
+    return true;
+  }
 
   std::thread& getThread() override {
     return thread_;
@@ -59,6 +97,31 @@ class RocksDbRepository : public ThreadedRepository {
   std::unique_ptr<minifi::internal::RocksDatabase> db_;
   std::shared_ptr<logging::Logger> logger_;
   std::thread thread_;
+
+ private:
+  struct PendingCommit {
+    const Records* records;
+    bool done = false;
+    bool success = false;
+  };
+
+  bool writeRecords(const std::vector<const Records*>& record_sets);
+  bool groupCommit(const Records& records);
+  void recordCommit(std::chrono::steady_clock::duration latency);
+  void recordWrite(size_t batch_size);
+
+  CommitMode commit_mode_ = CommitMode::DIRECT;
+  bool sync_writes_ = false;
+
+  std::mutex commit_mutex_;
+  std::condition_variable commit_cv_;
+  std::deque<PendingCommit*> pending_commits_;
+
+  mutable std::mutex commit_stats_mutex_;
+  uint64_t commit_count_ = 0;
+  uint64_t write_count_ = 0;
+  std::deque<size_t> recent_write_batch_sizes_;
+  std::deque<std::chrono::steady_clock::duration> recent_commit_latencies_;
 };
 
 }  // namespace org::apache::nifi::minifi::core::repository
@@ -24,22 +24,97 @@
 #include <memory>
 #include <string>
 #include <Exception.h>
+#include "fmt/format.h"
 #include "io/validation.h"
 
 namespace org::apache::nifi::minifi::io {
 
-RocksDbStream::RocksDbStream(std::string path, gsl::not_null<minifi::internal::RocksDatabase*> db, bool write_enable, minifi::internal::WriteBatch* batch)
+namespace {
+constexpr std::string_view CHUNK_KEY_SEPARATOR = "#";
+constexpr size_t CHUNK_INDEX_DIGITS = 10;
+
+std::optional<size_t> parseChunkIndex(std::string_view key) {
+  if (key.size() <= CHUNK_INDEX_DIGITS + CHUNK_KEY_SEPARATOR.size()
+      || key.substr(key.size() - CHUNK_INDEX_DIGITS - CHUNK_KEY_SEPARATOR.size(), CHUNK_KEY_SEPARATOR.size()) != CHUNK_KEY_SEPARATOR) {
+    return std::nullopt;
+  }
+  size_t index = 0;
+  for (const char digit : key.substr(key.size() - CHUNK_INDEX_DIGITS)) {
+    if (digit < '0' || digit > '9') {
+      return std::nullopt;
+    }
+    index = index * 10 + static_cast<size_t>(digit - '0');
+  }
+  return index;
+}
+}  // namespace
+
+std::string ContentChunks::key(std::string_view content_path, size_t index) {
+  if (index == 0) {
+    return std::string{content_path};
+  }
+  return fmt::format("{}{}{:0{}}", content_path, CHUNK_KEY_SEPARATOR, index, CHUNK_INDEX_DIGITS);
+}
+
+std::string_view ContentChunks::contentPath(std::string_view key) {
+  if (parseChunkIndex(key)) {
+    return key.substr(0, key.size() - CHUNK_INDEX_DIGITS - CHUNK_KEY_SEPARATOR.size());
+  }
+  return key;
+}
+
+std::optional<ContentChunks> ContentChunks::find(minifi::internal::OpenRocksDb& opendb, const std::string& content_path) {
+  auto it = opendb.NewIterator(rocksdb::ReadOptions());
+  it->Seek(content_path);
+  if (!it->Valid() || it->key() != content_path) {
+    return std::nullopt;
+  }
+  ContentChunks chunks;
+  chunks.first_chunk_size = it->value().size();
+  chunks.last_chunk_size = chunks.first_chunk_size;
+  // the chunk keys of a content sort right after the content path, in the order of their indices
+  it->SeekForPrev(key(content_path, 9'999'999'999));
+  if (it->Valid()) {
+    const std::string_view last_key{it->key().data(), it->key().size()};
+    if (const auto index = parseChunkIndex(last_key); index && *index > 0 && contentPath(last_key) == content_path) {
+      chunks.last_index = *index;
+      chunks.last_chunk_size = it->value().size();
+    }
+  }
+  return chunks;
+}
+
+std::vector<std::string> ContentChunks::keys(minifi::internal::OpenRocksDb& opendb, const std::string& content_path) {
+  const auto chunks = find(opendb, content_path);
+  const size_t last_index = chunks ? chunks->last_index : 0;
+  std::vector<std::string> keys;
+  for (size_t index = 0; index <= last_index; ++index) {
+    keys.push_back(key(content_path, index));
+  }
+  return keys;
+}
+
+RocksDbStream::RocksDbStream(std::string path, gsl::not_null<minifi::internal::RocksDatabase*> db, bool write_enable, minifi::internal::WriteBatch* batch, size_t chunk_size)
     : BaseStream(),
       path_(std::move(path)),
       write_enable_(write_enable),
       db_(db),
-      exists_([this] {
-        auto opendb = db_->open();
-        return opendb && opendb->Get(rocksdb::ReadOptions(), path_, &value_).ok();
-      }()),
+      exists_(false),
+      chunk_size_(chunk_size),
       offset_(0),
       batch_(batch),
-      size_(value_.size()) {
+      size_(0) {
+  gsl_Expects(chunk_size_ > 0);
+  auto opendb = db_->open();
+  if (!opendb) {
+    return;
+  }
+  if (const auto chunks = ContentChunks::find(*opendb, path_)) {
+    exists_ = true;
+    size_ = chunks->size();
+    // a single chunk content is extended up to the configured chunk size before a new chunk is started
+    chunk_size_ = chunks->last_index > 0 && chunks->first_chunk_size > 0 ? chunks->first_chunk_size : std::max(chunk_size_, chunks->first_chunk_size);
+  }
 }
 
 void RocksDbStream::close() {
@@ -56,37 +131,65 @@ size_t RocksDbStream::tell() const {
 size_t RocksDbStream::write(const uint8_t *value, size_t size) {
   if (!write_enable_) return STREAM_ERROR;
   if (size != 0 && IsNullOrEmpty(value)) return STREAM_ERROR;
+  if (size == 0 && size_ != 0) return 0;
   auto opendb = db_->open();
   if (!opendb) {
     return STREAM_ERROR;
   }
-  rocksdb::Slice slice_value(reinterpret_cast<const char*>(value), size);
-  rocksdb::Status status;
-  size_ += size;
-  if (batch_ != nullptr) {
-    status = batch_->Merge(path_, slice_value);
-  } else {
-    rocksdb::WriteOptions opts;
-    opts.sync = true;
-    status = opendb->Merge(opts, path_, slice_value);
+  rocksdb::WriteOptions opts;
+  opts.sync = true;
+  chunk_index_.reset();
+  size_t written = 0;
+  // writing zero bytes to new content still creates its (empty) first chunk
+  do {
+    const size_t index = size_ / chunk_size_;
+    const size_t chunk_write_size = std::min(size - written, (index + 1) * chunk_size_ - size_);
+    rocksdb::Slice slice_value(reinterpret_cast<const char*>(value) + written, chunk_write_size);
+    const auto key = ContentChunks::key(path_, index);
+    const auto status = batch_ != nullptr ? batch_->Merge(key, slice_value) : opendb->Merge(opts, key, slice_value);
+    if (!status.ok()) {
+      return STREAM_ERROR;
+    }
+    size_ += chunk_write_size;
+    written += chunk_write_size;
+  } while (written < size);
+  return size;
+}
+
+bool RocksDbStream::loadChunk(size_t index) {
+  if (chunk_index_ == index) {
+    return true;
   }
-  if (status.ok()) {
-    return size;
-  } else {
-    return STREAM_ERROR;
+  chunk_index_.reset();
+  auto opendb = db_->open();
+  if (!opendb || !opendb->Get(rocksdb::ReadOptions(), ContentChunks::key(path_, index), &chunk_).ok()) {
+    return false;
   }
+  chunk_index_ = index;
+  return true;
 }
 
 size_t RocksDbStream::read(std::span<std::byte> buf) {
   // The check have to be in this order for RocksDBStreamTest "Read zero bytes" to succeed
   if (!exists_) return STREAM_ERROR;
   if (buf.empty()) return 0;
-  if (offset_ >= value_.size()) return 0;
 
-  const auto amtToRead = std::min(buf.size(), value_.size() - offset_);
-  std::memcpy(buf.data(), value_.data() + offset_, amtToRead);
-  offset_ += amtToRead;
-  return amtToRead;
+  size_t read_size = 0;
+  while (read_size < buf.size() && offset_ < size_) {
+    const size_t index = offset_ / chunk_size_;
+    if (!loadChunk(index)) {
+      return read_size > 0 ? read_size : STREAM_ERROR;
+    }
+    const size_t chunk_offset = offset_ - index * chunk_size_;
+    if (chunk_offset >= chunk_.size()) {
+      break;
+    }
+    const auto amtToRead = std::min(buf.size() - read_size, chunk_.size() - chunk_offset);
+    std::memcpy(buf.data() + read_size, chunk_.data() + chunk_offset, amtToRead);
+    offset_ += amtToRead;
+    read_size += amtToRead;
+  }
+  return read_size;
 }
 
 }  // namespace org::apache::nifi::minifi::io
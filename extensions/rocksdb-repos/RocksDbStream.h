@@ -19,11 +19,15 @@
 
 #include <iostream>
 #include <cstdint>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <memory>
+#include <vector>
 #include "database/RocksDatabase.h"
 #include "io/BaseStream.h"
 #include "core/logging/LoggerConfiguration.h"
+#include "utils/Literals.h"
 
 namespace org {
 namespace apache {
@@ -31,6 +35,40 @@ namespace nifi {
 namespace minifi {
 namespace io {
 
+/**
+ * The content of a claim is stored in chunks: the first chunk under the content path (so content written as a
+ * single value remains readable), the n-th chunk under "<content path>#<n zero padded to 10 digits>".
+ * Every chunk except the last one has the size of the first chunk.
+ */
+struct ContentChunks {
+  static constexpr size_t DEFAULT_CHUNK_SIZE = 1_MiB;
+
+  static std::string key(std::string_view content_path, size_t index);
+
+  /**
+   * Returns the content path the key of a chunk belongs to.
+   */
+  static std::string_view contentPath(std::string_view key);
+
+  /**
+   * Looks up the chunks of the content, returns std::nullopt if the content does not exist.
+   */
+  static std::optional<ContentChunks> find(minifi::internal::OpenRocksDb& opendb, const std::string& content_path);
+
+  /**
+   * Returns the keys of all the chunks of the content, the content path itself even if it does not exist.
+   */
+  static std::vector<std::string> keys(minifi::internal::OpenRocksDb& opendb, const std::string& content_path);
+
+  [[nodiscard]] size_t size() const {
+    return last_index * first_chunk_size + last_chunk_size;
+  }
+
+  size_t first_chunk_size = 0;
+  size_t last_index = 0;
+  size_t last_chunk_size = 0;
+};
+
 /**
  * Purpose: File Stream Base stream extension. This is intended to be a thread safe access to
  * read/write to the local file system.
@@ -43,8 +81,10 @@ class RocksDbStream : public io::BaseStream {
   /**
    * File Stream constructor that accepts an fstream shared pointer.
    * It must already be initialized for read and write.
+   * New content is split into chunks of chunk_size bytes, appending to existing content keeps its chunk size.
    */
-  explicit RocksDbStream(std::string path, gsl::not_null<minifi::internal::RocksDatabase*> db, bool write_enable = false, minifi::internal::WriteBatch* batch = nullptr);
+  explicit RocksDbStream(std::string path, gsl::not_null<minifi::internal::RocksDatabase*> db, bool write_enable = false, minifi::internal::WriteBatch* batch = nullptr,
+      size_t chunk_size = ContentChunks::DEFAULT_CHUNK_SIZE);
 
   ~RocksDbStream() override {
     close();
@@ -81,14 +121,19 @@ class RocksDbStream : public io::BaseStream {
   size_t write(const uint8_t *value, size_t size) override;
 
  protected:
+  bool loadChunk(size_t index);
+
   std::string path_;
   bool write_enable_;
   gsl::not_null<minifi::internal::RocksDatabase*> db_;
-  std::string value_;
   bool exists_;
+  size_t chunk_size_;
   size_t offset_;
   minifi::internal::WriteBatch* batch_;
   size_t size_;
+  // only the chunk being read is kept in memory
+  std::string chunk_;
+  std::optional<size_t> chunk_index_;
 
  private:
   std::shared_ptr<core::logging::Logger> logger_ = core::logging::LoggerFactory<RocksDbStream>::getLogger();
@@ -37,6 +37,7 @@ struct ColumnHandle;
 
 class OpenRocksDb {
   friend class RocksDbInstance;
+  friend class WriteBatch;
 
   OpenRocksDb(RocksDbInstance& db, gsl::not_null<std::shared_ptr<rocksdb::DB>> impl, gsl::not_null<std::shared_ptr<ColumnHandle>> column);
 
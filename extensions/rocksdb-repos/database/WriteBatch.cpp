@@ -17,6 +17,8 @@
  */
 
 #include "WriteBatch.h"
+#include "OpenRocksDb.h"
+#include "ColumnHandle.h"
 
 namespace org {
 namespace apache {
@@ -28,6 +30,10 @@ rocksdb::Status WriteBatch::Put(const rocksdb::Slice &key, const rocksdb::Slice
   return impl_.Put(column_, key, value);
 }
 
+rocksdb::Status WriteBatch::Put(const OpenRocksDb& column, const rocksdb::Slice &key, const rocksdb::Slice &value) {
+  return impl_.Put(column.column_->handle.get(), key, value);
+}
+
 rocksdb::Status WriteBatch::Delete(const rocksdb::Slice &key) {
   return impl_.Delete(column_, key);
 }
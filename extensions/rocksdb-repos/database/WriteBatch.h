@@ -26,11 +26,15 @@ namespace nifi {
 namespace minifi {
 namespace internal {
 
+class OpenRocksDb;
+
 class WriteBatch {
   friend class OpenRocksDb;
   explicit WriteBatch(rocksdb::ColumnFamilyHandle* column) : column_(column) {}
  public:
   rocksdb::Status Put(const rocksdb::Slice &key, const rocksdb::Slice &value);
+  // puts into another column family of the same database, so that the columns are updated atomically
+  rocksdb::Status Put(const OpenRocksDb& column, const rocksdb::Slice &key, const rocksdb::Slice &value);
   rocksdb::Status Delete(const rocksdb::Slice &key);
   rocksdb::Status Merge(const rocksdb::Slice &key, const rocksdb::Slice &value);
  private:
@@ -310,3 +310,181 @@ TEST_CASE("DBContentRepository can clear orphan entries") {
 
   REQUIRE(getDbSize(dir) == 0);
 }
+
+TEST_CASE("DBContentRepository stores large content in chunks") {
+  TestController testController;
+  auto dir = testController.createTempDirectory();
+  auto configuration = std::make_shared<org::apache::nifi::minifi::Configure>();
+  configuration->set(minifi::Configure::nifi_dbcontent_repository_directory_default, dir.string());
+  configuration->set(minifi::Configure::nifi_dbcontent_repository_chunk_size, "4 B");
+  configuration->set(minifi::Configure::nifi_dbcontent_repository_purge_period, "0");
+  const std::string content = "0123456789abcdefghij";
+  {
+    auto content_repo = std::make_shared<TestDatabaseContentRepository>();
+    REQUIRE(content_repo->initialize(configuration));
+
+    auto session = content_repo->createSession();
+    auto claim = session->create();
+    auto stream = session->write(claim);
+    for (char c : content) {
+      REQUIRE(stream->write(reinterpret_cast<const uint8_t*>(&c), 1) == 1);
+    }
+    REQUIRE(stream->size() == content.size());
+    // the full chunks are already written, but the claim only exists after the commit
+    REQUIRE_FALSE(content_repo->exists(*claim));
+
+    SECTION("Commit") {
+      session->commit();
+      REQUIRE(content_repo->exists(*claim));
+
+      auto read_stream = content_repo->read(*claim);
+      REQUIRE(read_stream->size() == content.size());
+      std::string read_content(content.size(), '\0');
+      REQUIRE(read_stream->read(as_writable_bytes(std::span(read_content))) == content.size());
+      REQUIRE(read_content == content);
+
+      read_stream->seek(7);
+      std::string part(6, '\0');
+      REQUIRE(read_stream->read(as_writable_bytes(std::span(part))) == part.size());
+      REQUIRE(part == "789abc");
+
+      REQUIRE(content_repo->remove(*claim));
+      REQUIRE_FALSE(content_repo->exists(*claim));
+    }
+
+    SECTION("Rollback") {
+      session->rollback();
+      REQUIRE_FALSE(content_repo->exists(*claim));
+    }
+    content_repo->invalidate();
+  }
+
+  REQUIRE(getDbSize(dir) == 0);
+}
+
+class DeduplicatingDBContentRepositoryTestFixture : public TestController {
+ protected:
+  DeduplicatingDBContentRepositoryTestFixture() {
+    configuration_->set(minifi::Configure::nifi_dbcontent_repository_directory_default, dir_.string());
+    configuration_->set(minifi::Configure::nifi_dbcontent_repository_chunk_size, "4 B");
+    configuration_->set(minifi::Configure::nifi_dbcontent_repository_purge_period, "0");
+    configuration_->set(minifi::Configure::nifi_content_repository_deduplication, "true");
+  }
+
+  std::shared_ptr<TestDatabaseContentRepository> createRepository() const {
+    auto content_repo = std::make_shared<TestDatabaseContentRepository>();
+    REQUIRE(content_repo->initialize(configuration_));
+    return content_repo;
+  }
+
+  static std::shared_ptr<minifi::ResourceClaim> createClaim(core::ContentRepository& content_repo, const std::string& content) {
+    auto session = content_repo.createSession();
+    auto claim = session->create();
+    REQUIRE(session->write(claim)->write(as_bytes(std::span(content))) == content.size());
+    session->commit();
+    return claim;
+  }
+
+  static std::string readContent(core::ContentRepository& content_repo, const minifi::ResourceClaim& claim) {
+    auto stream = content_repo.read(claim);
+    REQUIRE(stream);
+    std::string result(stream->size(), '\0');
+    REQUIRE(stream->read(as_writable_bytes(std::span(result))) == result.size());
+    return result;
+  }
+
+  std::filesystem::path dir_ = createTempDirectory();
+  std::shared_ptr<minifi::Configure> configuration_ = std::make_shared<minifi::Configure>();
+  const std::string content_ = "0123456789abcdefghij";
+};
+
+TEST_CASE_METHOD(DeduplicatingDBContentRepositoryTestFixture, "DBContentRepository deduplicates claims with identical content") {
+  std::string duplicate_path;
+  {
+    auto content_repo = createRepository();
+    auto first = createClaim(*content_repo, content_);
+    auto second = createClaim(*content_repo, content_);
+    CHECK(readContent(*content_repo, *second) == content_);
+
+    // appending to a deduplicated claim gives it its own copy of the content
+    auto third = createClaim(*content_repo, content_);
+    auto session = content_repo->createSession();
+    session->append(third)->write("!");
+    session->commit();
+    CHECK(readContent(*content_repo, *third) == content_ + "!");
+    CHECK(readContent(*content_repo, *second) == content_);
+    third.reset();
+
+    const auto stats = content_repo->getDeduplicationStats();
+    REQUIRE(stats);
+    CHECK(stats->checked_claim_count == 3);
+    CHECK(stats->deduplicated_claim_count == 2);
+    CHECK(stats->bytes_saved == 2 * content_.size());
+
+    // the content of the removed claim is kept for the deduplicated one
+    first.reset();
+    CHECK(content_repo->exists(*second));
+    CHECK(readContent(*content_repo, *second) == content_);
+
+    duplicate_path = second->getContentFullPath();
+    // ensure that the content is not deleted during resource claim destruction
+    content_repo->incrementStreamCount(*second);
+    second.reset();
+    content_repo->invalidate();
+  }
+
+  {
+    auto content_repo = createRepository();
+    auto claim = std::make_shared<minifi::ResourceClaim>(duplicate_path, content_repo);
+    content_repo->clearOrphans();
+    CHECK(readContent(*content_repo, *claim) == content_);
+    claim.reset();
+    content_repo->invalidate();
+  }
+
+  REQUIRE(getDbSize(dir_) == 0);
+}
+
+TEST_CASE_METHOD(DeduplicatingDBContentRepositoryTestFixture, "DBContentRepository copies the shared content before the original claim is modified") {
+  {
+    auto content_repo = createRepository();
+    auto original = createClaim(*content_repo, content_);
+    auto first_duplicate = createClaim(*content_repo, content_);
+    auto second_duplicate = createClaim(*content_repo, content_);
+
+    // both deduplicated claims get their own copy of the multi-chunk content
+    auto session = content_repo->createSession();
+    session->append(original)->write("!");
+    session->commit();
+    CHECK(readContent(*content_repo, *original) == content_ + "!");
+    CHECK(readContent(*content_repo, *first_duplicate) == content_);
+    CHECK(readContent(*content_repo, *second_duplicate) == content_);
+
+    // the copies are independent of each other
+    session = content_repo->createSession();
+    session->append(first_duplicate)->write("?");
+    session->commit();
+    CHECK(readContent(*content_repo, *first_duplicate) == content_ + "?");
+    CHECK(readContent(*content_repo, *second_duplicate) == content_);
+
+    // the new claim would be deduplicated to the content of the claim appended to in the same commit
+    const std::string other_content = "klmnopqrstuvwxyz";
+    auto appended = createClaim(*content_repo, other_content);
+    session = content_repo->createSession();
+    auto just_deduplicated = session->create();
+    REQUIRE(session->write(just_deduplicated)->write(as_bytes(std::span(other_content))) == other_content.size());
+    session->append(appended)->write("#");
+    session->commit();
+    CHECK(readContent(*content_repo, *appended) == other_content + "#");
+    CHECK(readContent(*content_repo, *just_deduplicated) == other_content);
+
+    original.reset();
+    first_duplicate.reset();
+    second_duplicate.reset();
+    appended.reset();
+    just_deduplicated.reset();
+    content_repo->invalidate();
+  }
+
+  REQUIRE(getDbSize(dir_) == 0);
+}
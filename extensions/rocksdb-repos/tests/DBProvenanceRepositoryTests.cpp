@@ -18,10 +18,12 @@
 
 #include <array>
 #include <chrono>
+#include <filesystem>
 #include <random>
 #include <vector>
 
 #include "ProvenanceRepository.h"
+#include "provenance/ProvenanceQuery.h"
 #include "TestBase.h"
 #include "Catch.h"
 
@@ -114,3 +116,142 @@ TEST_CASE("Test time limit", "[timeLimitTest]") {
 
   verifyMaxKeyCount(provdb, 400);
 }
+
+TEST_CASE("The events and the indexes share the storage size", "[sizeLimitTest]") {
+  TestController testController;
+  auto temp_dir = testController.createTempDirectory();
+  constexpr int64_t max_storage_size = 1_MiB;
+
+  auto provdb = std::make_shared<minifi::provenance::ProvenanceRepository>("TestProvRepo", temp_dir.string(), 1min, max_storage_size, 1s);
+  REQUIRE(provdb->initialize(std::make_shared<minifi::Configure>()));
+
+  // around 4 MB of events and 1 MB of entries in every index, several times the storage size
+  minifi::provenance::ProvenanceReporter reporter(provdb, "generator", "GenerateFlowFile");
+  for (int batch = 0; batch < 40; ++batch) {
+    for (int i = 0; i < 100; ++i) {
+      auto flow_file = std::make_shared<minifi::FlowFileRecord>();
+      std::vector<char> payload(1000);
+      generateData(payload);
+      flow_file->setAttribute("payload", std::string(payload.begin(), payload.end()));
+      reporter.create(flow_file, "");
+    }
+    reporter.commit();
+    reporter.clear();
+  }
+
+  // the events and the indexes are column families of the same database, stored in the same table files
+  const auto table_files_size = [&] {
+    uint64_t size = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(temp_dir)) {
+      if (entry.path().extension() == ".sst") {
+        size += entry.file_size();
+      }
+    }
+    return size;
+  };
+  uint64_t size = table_files_size();
+  for (int i = 0; i < 50 && size > max_storage_size; ++i) {
+    // the oldest table files are dropped by the compaction running in the background
+    std::this_thread::sleep_for(100ms);
+    size = table_files_size();
+  }
+  CHECK(size > 0);
+  CHECK(size <= max_storage_size);
+  CHECK(provdb->query(minifi::provenance::ProvenanceQuery{}).events.size() == minifi::provenance::ProvenanceQuery::DEFAULT_MAX_RESULTS);
+}
+
+TEST_CASE("Provenance events can be queried by the indexed fields", "[provenanceQuery]") {
+  TestController testController;
+  auto temp_dir = testController.createTempDirectory();
+
+  auto provdb = std::make_shared<minifi::provenance::ProvenanceRepository>("TestProvRepo", temp_dir.string(), 1min, TEST_MAX_PROVENANCE_STORAGE_SIZE, 1s);
+  REQUIRE(provdb->initialize(std::make_shared<minifi::Configure>()));
+
+  auto flow_file_1 = std::make_shared<minifi::FlowFileRecord>();
+  auto flow_file_2 = std::make_shared<minifi::FlowFileRecord>();
+
+  minifi::provenance::ProvenanceReporter generator_reporter(provdb, "generator", "GenerateFlowFile");
+  generator_reporter.create(flow_file_1, "");
+  generator_reporter.create(flow_file_2, "");
+  generator_reporter.commit();
+
+  std::this_thread::sleep_for(10ms);
+  const auto between_commits = std::chrono::system_clock::now();
+  std::this_thread::sleep_for(10ms);
+
+  minifi::provenance::ProvenanceReporter sender_reporter(provdb, "sender", "PutFile");
+  sender_reporter.send(flow_file_1, "file:///tmp/out", "", 5ms, false);
+  sender_reporter.commit();
+
+  const auto query = [&](const std::string& query_string) {
+    auto parsed_query = minifi::provenance::ProvenanceQuery::parse(query_string);
+    REQUIRE(parsed_query);
+    return provdb->query(*parsed_query).events;
+  };
+
+  SECTION("by flow file") {
+    const auto events = query("flowFileUuid=" + flow_file_1->getUUIDStr());
+    REQUIRE(events.size() == 2);
+    CHECK(events[0]->getEventType() == minifi::provenance::ProvenanceEventRecord::SEND);
+    CHECK(events[1]->getEventType() == minifi::provenance::ProvenanceEventRecord::CREATE);
+  }
+  SECTION("by component") {
+    const auto events = query("componentId=generator");
+    REQUIRE(events.size() == 2);
+    CHECK(events[0]->getComponentType() == "GenerateFlowFile");
+    CHECK(events[1]->getComponentType() == "GenerateFlowFile");
+  }
+  SECTION("by event type and component") {
+    CHECK(query("eventType=SEND").size() == 1);
+    CHECK(query("eventType=SEND&componentId=generator").empty());
+    CHECK(query("eventType=DROP").empty());
+  }
+  SECTION("by time") {
+    const auto boundary = std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(between_commits.time_since_epoch()).count());
+    const auto newer_events = query("startTime=" + boundary);
+    REQUIRE(newer_events.size() == 1);
+    CHECK(newer_events[0]->getTransitUri() == "file:///tmp/out");
+    CHECK(query("endTime=" + boundary).size() == 2);
+    CHECK(query("maxAge=1 h").size() == 3);
+  }
+  SECTION("limited number of results, newest first") {
+    const auto events = query("maxResults=1");
+    REQUIRE(events.size() == 1);
+    CHECK(events[0]->getEventType() == minifi::provenance::ProvenanceEventRecord::SEND);
+  }
+}
+
+TEST_CASE("A selective provenance query stops scanning the index and reports it", "[queryTest]") {
+  TestController testController;
+  auto temp_dir = testController.createTempDirectory();
+
+  auto provdb = std::make_shared<minifi::provenance::ProvenanceRepository>("TestProvRepo", temp_dir.string(), 1min, TEST_MAX_PROVENANCE_STORAGE_SIZE, 1s);
+  REQUIRE(provdb->initialize(std::make_shared<minifi::Configure>()));
+
+  auto flow_file = std::make_shared<minifi::FlowFileRecord>();
+  minifi::provenance::ProvenanceReporter reporter(provdb, "generator", "GenerateFlowFile");
+  reporter.create(flow_file, "");
+  reporter.commit();
+  reporter.clear();
+  // the newer events of the component are all walked over by a query for the older event type
+  const size_t newer_event_count = minifi::provenance::ProvenanceQuery::SCANNED_EVENTS_PER_RESULT + 50;
+  for (size_t i = 0; i < newer_event_count; ++i) {
+    reporter.send(flow_file, "file:///tmp/out", "", 5ms, false);
+  }
+  reporter.commit();
+
+  const auto query = [&](const std::string& query_string) {
+    auto parsed_query = minifi::provenance::ProvenanceQuery::parse(query_string);
+    REQUIRE(parsed_query);
+    return provdb->query(*parsed_query);
+  };
+
+  const auto truncated_result = query("componentId=generator&eventType=CREATE&maxResults=1");
+  CHECK(truncated_result.events.empty());
+  CHECK(truncated_result.truncated);
+
+  const auto complete_result = query("componentId=generator&eventType=CREATE&maxResults=2");
+  REQUIRE(complete_result.events.size() == 1);
+  CHECK(complete_result.events[0]->getEventType() == minifi::provenance::ProvenanceEventRecord::CREATE);
+  CHECK_FALSE(complete_result.truncated);
+}
@@ -26,6 +26,7 @@
 #include "core/repository/VolatileProvenanceRepository.h"
 #include "core/RepositoryFactory.h"
 #include "FlowFileRecord.h"
+#include "io/BufferStream.h"
 #include "provenance/Provenance.h"
 #include "unit/ProvenanceTestHelper.h"
 #include "TestBase.h"
@@ -160,3 +161,35 @@ TEST_CASE("Test Provenance record serialization NoOp", "[Testprovenance::Provena
   record2->setEventId(eventId);
   REQUIRE(record2->loadFromRepository(testRepository) == false);
 }
+
+TEST_CASE("The standard provenance details are formatted when they are read", "[Testprovenance::ProvenanceEventRecordDetails]") {
+  auto repository = std::make_shared<TestRepository>();
+  provenance::ProvenanceReporter reporter(repository, "processor1", "UpdateAttribute");
+
+  auto flow_file = std::make_shared<minifi::FlowFileRecord>();
+  flow_file->setAttribute("filename", "data.txt");
+  const auto uuid = flow_file->getUUIDStr();
+
+  reporter.modifyAttribute(flow_file, "filename");
+  REQUIRE(reporter.getEvents().size() == 1);
+  const auto event = *reporter.getEvents().begin();
+  CHECK(event->getDetails() == "processor1 modify flow record " + uuid + " attribute filename:data.txt");
+
+  minifi::io::BufferStream stream;
+  REQUIRE(event->serialize(stream));
+  provenance::ProvenanceEventRecord deserialized;
+  REQUIRE(deserialized.deserialize(stream));
+  CHECK(deserialized.getDetails() == event->getDetails());
+
+  const auto details_of = [&](auto report) {
+    provenance::ProvenanceReporter single_reporter(repository, "processor1", "UpdateAttribute");
+    report(single_reporter);
+    REQUIRE(single_reporter.getEvents().size() == 1);
+    return (*single_reporter.getEvents().begin())->getDetails();
+  };
+  CHECK(details_of([&](auto& r) { r.create(flow_file); }) == "processor1 creates flow record " + uuid);
+  CHECK(details_of([&](auto& r) { r.drop(flow_file); }) == "Discard reason: processor1 drop flow record " + uuid);
+  CHECK(details_of([&](auto& r) { r.removeAttribute(flow_file, "path"); }) == "processor1 remove flow record " + uuid + " attribute path");
+  CHECK(details_of([&](auto& r) { r.modifyContent(flow_file, std::chrono::milliseconds{1}); }) == "processor1 modify flow record content " + uuid);
+  CHECK(details_of([&](auto& r) { r.expire(flow_file); }) == "processor1 expire flow record " + uuid);
+}
@@ -16,12 +16,15 @@
  * limitations under the License.
  */
 
+#include <atomic>
 #include <chrono>
 #include <map>
 #include <memory>
 #include <string>
 #include <thread>
 #include <optional>
+#include <set>
+#include <vector>
 
 #include "core/Core.h"
 #include "core/repository/AtomicRepoEntries.h"
@@ -520,6 +523,82 @@ TEST_CASE("FlowFileRepository synchronously pushes existing flow files") {
   }
 }
 
+TEST_CASE("FlowFileRepository recovers flow files on multiple threads") {
+  LogTestController::getInstance().setDebug<core::ContentRepository>();
+  LogTestController::getInstance().setDebug<core::repository::FileSystemRepository>();
+  LogTestController::getInstance().setInfo<core::repository::FlowFileRepository>();
+  TestController testController;
+  auto ff_dir = testController.createTempDirectory();
+  auto content_dir = testController.createTempDirectory();
+
+  auto config = std::make_shared<minifi::Configure>();
+  config->set(minifi::Configure::nifi_flowfile_repository_directory_default, ff_dir.string());
+  config->set(minifi::Configure::nifi_dbcontent_repository_directory_default, content_dir.string());
+  SECTION("Single recovery thread") {
+    config->set(minifi::Configure::nifi_flowfile_repository_recovery_threads, "1");
+  }
+  SECTION("Multiple recovery threads") {
+    config->set(minifi::Configure::nifi_flowfile_repository_recovery_threads, "4");
+  }
+
+  constexpr size_t FLOW_FILE_COUNT = 2500;
+  std::set<utils::Identifier> ff_ids;
+  auto connection_id = utils::IdGenerator::getIdGenerator()->generate();
+  auto orphan_connection_id = utils::IdGenerator::getIdGenerator()->generate();
+
+  {
+    auto ff_repo = std::make_shared<core::repository::FlowFileRepository>();
+    REQUIRE(ff_repo->initialize(config));
+    auto content_repo = std::make_shared<core::repository::FileSystemRepository>();
+    REQUIRE(content_repo->initialize(config));
+    auto conn = std::make_shared<minifi::Connection>(ff_repo, content_repo, "TestConnection", connection_id);
+    auto orphan_conn = std::make_shared<minifi::Connection>(ff_repo, content_repo, "OrphanConnection", orphan_connection_id);
+
+    std::vector<std::pair<std::string, std::unique_ptr<minifi::io::BufferStream>>> flow_data;
+    for (size_t i = 0; i < FLOW_FILE_COUNT; ++i) {
+      auto ff = std::make_shared<minifi::FlowFileRecord>();
+      ff->setConnection(i % 10 == 0 ? orphan_conn.get() : conn.get());
+      if (i % 10 != 0) {
+        ff_ids.insert(ff->getUUID());
+      }
+      auto stream = std::make_unique<minifi::io::BufferStream>();
+      ff->Serialize(*stream);
+      flow_data.emplace_back(ff->getUUIDStr(), std::move(stream));
+    }
+    flow_data.emplace_back("corrupted", std::make_unique<minifi::io::BufferStream>("not a flow file"));
+    REQUIRE(ff_repo->MultiPut(flow_data));
+  }
+
+  auto ff_repo = std::make_shared<core::repository::FlowFileRepository>();
+  REQUIRE(ff_repo->initialize(config));
+  CHECK_FALSE(ff_repo->getRecoveryStats());
+  auto content_repo = std::make_shared<core::repository::FileSystemRepository>();
+  REQUIRE(content_repo->initialize(config));
+  auto conn = std::make_shared<minifi::Connection>(ff_repo, content_repo, "TestConnection", connection_id);
+
+  ff_repo->setConnectionMap({{connection_id.to_string(), conn.get()}});
+  ff_repo->loadComponent(content_repo);
+
+  std::set<utils::Identifier> restored_ff_ids;
+  std::set<std::shared_ptr<core::FlowFile>> expired;
+  while (auto ff = conn->poll(expired)) {
+    restored_ff_ids.insert(ff->getUUID());
+  }
+  REQUIRE(expired.empty());
+  CHECK(restored_ff_ids == ff_ids);
+
+  const auto stats = ff_repo->getRecoveryStats();
+  REQUIRE(stats);
+  CHECK_FALSE(stats->in_progress);
+  CHECK(stats->recovered_entry_count == FLOW_FILE_COUNT + 1);
+  CHECK(stats->estimated_entry_count >= stats->recovered_entry_count);
+  CHECK(stats->estimated_remaining == 0ms);
+
+  // the corrupted flow file is removed from the repository
+  std::string value;
+  CHECK_FALSE(ff_repo->Get("corrupted", value));
+}
+
 TEST_CASE("Test getting flow file repository size properties", "[TestGettingRepositorySize]") {
   LogTestController::getInstance().setDebug<core::repository::FlowFileRepository>();
   LogTestController::getInstance().setDebug<minifi::provenance::ProvenanceRepository>();
@@ -728,6 +807,78 @@ TEST_CASE("Flow file repositories can be stopped", "[TestRepoIsRunning]") {
   REQUIRE(!repository->isRunning());
 }
 
+TEST_CASE("FlowFileRepository commits records directly or in groups", "[TestFFR8]") {
+  LogTestController::getInstance().setDebug<core::repository::FlowFileRepository>();
+  TestController testController;
+  auto dir = testController.createTempDirectory();
+
+  auto config = std::make_shared<minifi::Configure>();
+  bool group_commit = false;
+  SECTION("Direct commits") {
+    config->set(minifi::Configure::nifi_flowfile_repository_rocksdb_commit_mode, "direct");
+  }
+  SECTION("Group commits") {
+    config->set(minifi::Configure::nifi_flowfile_repository_rocksdb_commit_mode, "Group");
+    group_commit = true;
+  }
+  SECTION("Group commits with synchronous writes") {
+    config->set(minifi::Configure::nifi_flowfile_repository_rocksdb_commit_mode, "group");
+    config->set(minifi::Configure::nifi_flowfile_repository_rocksdb_sync_writes, "true");
+    group_commit = true;
+  }
+
+  auto repository = std::make_shared<core::repository::FlowFileRepository>("ff", dir.string(), 0ms, 0, 1ms);
+  REQUIRE(repository->initialize(config));
+  CHECK(repository->getCommitMode() == (group_commit ? core::repository::RocksDbRepository::CommitMode::GROUP : core::repository::RocksDbRepository::CommitMode::DIRECT));
+
+  constexpr size_t THREAD_COUNT = 8;
+  constexpr size_t COMMITS_PER_THREAD = 25;
+  constexpr size_t RECORDS_PER_COMMIT = 4;
+  std::vector<std::thread> threads;
+  std::atomic<size_t> failed_commits{0};
+  for (size_t thread_idx = 0; thread_idx < THREAD_COUNT; ++thread_idx) {
+    threads.emplace_back([&, thread_idx] {
+      for (size_t commit_idx = 0; commit_idx < COMMITS_PER_THREAD; ++commit_idx) {
+        std::vector<std::pair<std::string, std::unique_ptr<minifi::io::BufferStream>>> records;
+        for (size_t record_idx = 0; record_idx < RECORDS_PER_COMMIT; ++record_idx) {
+          auto key = fmt::format("{}-{}-{}", thread_idx, commit_idx, record_idx);
+          records.emplace_back(key, std::make_unique<minifi::io::BufferStream>("value-" + key));
+        }
+        if (!repository->MultiPut(records)) {
+          ++failed_commits;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  CHECK(failed_commits == 0);
+
+  for (size_t thread_idx = 0; thread_idx < THREAD_COUNT; ++thread_idx) {
+    for (size_t commit_idx = 0; commit_idx < COMMITS_PER_THREAD; ++commit_idx) {
+      for (size_t record_idx = 0; record_idx < RECORDS_PER_COMMIT; ++record_idx) {
+        auto key = fmt::format("{}-{}-{}", thread_idx, commit_idx, record_idx);
+        std::string value;
+        REQUIRE(repository->Get(key, value));
+        CHECK(value == "value-" + key);
+      }
+    }
+  }
+
+  const auto stats = repository->getCommitStats();
+  REQUIRE(stats);
+  CHECK(stats->commit_count == THREAD_COUNT * COMMITS_PER_THREAD);
+  if (group_commit) {
+    CHECK(stats->write_count <= stats->commit_count);
+    CHECK(stats->average_write_batch_size >= static_cast<double>(RECORDS_PER_COMMIT));
+  } else {
+    CHECK(stats->write_count == stats->commit_count);
+    CHECK(stats->max_write_batch_size == RECORDS_PER_COMMIT);
+  }
+  CHECK(stats->max_commit_latency >= stats->average_commit_latency);
+}
+
 TEST_CASE("Content repositories are always running", "[TestRepoIsRunning]") {
   LogTestController::getInstance().setDebug<core::ContentRepository>();
   LogTestController::getInstance().setDebug<core::repository::FileSystemRepository>();
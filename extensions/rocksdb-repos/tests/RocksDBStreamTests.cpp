@@ -81,3 +81,54 @@ TEST_CASE_METHOD(RocksDBStreamTest, "Read zero bytes") {
 
   REQUIRE(minifi::io::isError(nonExistingStream.read(std::span(fake_buffer).subspan(0, 0))));
 }
+
+TEST_CASE_METHOD(RocksDBStreamTest, "Content is stored in chunks") {
+  minifi::io::RocksDbStream outStream("one", gsl::make_not_null(db.get()), true, nullptr, 4);
+  REQUIRE(outStream.write(reinterpret_cast<const uint8_t*>("0123456"), 7) == 7);
+
+  // appending keeps the chunk size of the existing content
+  minifi::io::RocksDbStream appendStream("one", gsl::make_not_null(db.get()), true, nullptr, 100);
+  REQUIRE(appendStream.size() == 7);
+  REQUIRE(appendStream.write(reinterpret_cast<const uint8_t*>("789ab"), 5) == 5);
+
+  auto opendb = db->open();
+  REQUIRE(opendb);
+  std::string value;
+  REQUIRE(opendb->Get(rocksdb::ReadOptions(), "one", &value).ok());
+  REQUIRE(value == "0123");
+  REQUIRE(opendb->Get(rocksdb::ReadOptions(), minifi::io::ContentChunks::key("one", 2), &value).ok());
+  REQUIRE(value == "89ab");
+  REQUIRE(minifi::io::ContentChunks::keys(*opendb, "one").size() == 3);
+  REQUIRE(minifi::io::ContentChunks::contentPath(minifi::io::ContentChunks::key("one", 2)) == "one");
+
+  minifi::io::RocksDbStream inStream("one", gsl::make_not_null(db.get()));
+  REQUIRE(inStream.size() == 12);
+  std::string content(12, '\0');
+  REQUIRE(inStream.read(as_writable_bytes(std::span(content))) == 12);
+  REQUIRE(content == "0123456789ab");
+
+  inStream.seek(6);
+  std::string part(3, '\0');
+  REQUIRE(inStream.read(as_writable_bytes(std::span(part))) == 3);
+  REQUIRE(part == "678");
+}
+
+TEST_CASE_METHOD(RocksDBStreamTest, "Content stored as a single value is extended up to the chunk size") {
+  auto opendb = db->open();
+  REQUIRE(opendb);
+  REQUIRE(opendb->Put(rocksdb::WriteOptions(), "one", "abc").ok());
+
+  minifi::io::RocksDbStream outStream("one", gsl::make_not_null(db.get()), true, nullptr, 5);
+  REQUIRE(outStream.write(reinterpret_cast<const uint8_t*>("defgh"), 5) == 5);
+
+  std::string value;
+  REQUIRE(opendb->Get(rocksdb::ReadOptions(), "one", &value).ok());
+  REQUIRE(value == "abcde");
+  REQUIRE(opendb->Get(rocksdb::ReadOptions(), minifi::io::ContentChunks::key("one", 1), &value).ok());
+  REQUIRE(value == "fgh");
+
+  minifi::io::RocksDbStream inStream("one", gsl::make_not_null(db.get()));
+  std::string content(8, '\0');
+  REQUIRE(inStream.read(as_writable_bytes(std::span(content))) == 8);
+  REQUIRE(content == "abcdefgh");
+}
@@ -50,10 +50,7 @@ struct FlowFileWithIndexStatus {
 std::unordered_map<uint64_t, FlowFileWithIndexStatus> getUndeterminedFlowFiles(core::ProcessSession& session, size_t batch_size) {
   std::unordered_map<uint64_t, FlowFileWithIndexStatus> undetermined_flow_files;
   std::unordered_set<uint64_t> duplicate_ack_ids;
-  for (size_t i = 0; i < batch_size; ++i) {
-    auto flow = session.get();
-    if (flow == nullptr)
-      break;
+  for (auto& flow : session.get(batch_size)) {
     std::optional<std::string> splunk_ack_id_str = flow->getAttribute(SPLUNK_ACK_ID);
     if (!splunk_ack_id_str.has_value()) {
       session.transfer(flow, QuerySplunkIndexingStatus::Failure);
@@ -67,8 +67,8 @@ std::optional<std::unordered_set<std::string>> AttributesToJSON::getAttributesTo
 
   if (attributes_regular_expression_) {
     for (const auto& [key, value] : flowfile_attributes) {
-      if (utils::regexMatch(key, attributes_regular_expression_.value())) {
-        attributes.insert(key);
+      if (utils::regexMatch(key.str(), attributes_regular_expression_.value())) {
+        attributes.insert(key.str());
       }
     }
   }
@@ -113,7 +113,7 @@ void AttributesToJSON::onTrigger(core::ProcessContext&, core::ProcessSession& se
     return;
   }
 
-  auto json_data = buildAttributeJsonData(*flow_file->getAttributesPtr());
+  auto json_data = buildAttributeJsonData(flow_file->getAttributeMap());
   if (write_destination_ == attributes_to_json::WriteDestination::FLOWFILE_ATTRIBUTE) {
     logger_->log_debug("Writing the following attribute data to JSONAttributes attribute: {}", json_data);
     session.putAttribute(flow_file, "JSONAttributes", json_data);
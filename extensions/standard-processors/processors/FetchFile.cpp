@@ -142,8 +142,12 @@ void FetchFile::onTrigger(core::ProcessContext& context, core::ProcessSession& s
   }
 
   try {
-    utils::FileReaderCallback callback(file_to_fetch_path);
-    session.write(flow_file, std::move(callback));
+    // a moved file may still be in use, so it is only linked into the content repository if it is deleted afterwards
+    const bool keep_source = completion_strategy_ != fetch_file::CompletionStrategyOption::DELETE_FILE;
+    if (!session.tryKernelImport(file_to_fetch_path, flow_file, keep_source)) {
+      utils::FileReaderCallback callback(file_to_fetch_path);
+      session.write(flow_file, std::move(callback));
+    }
     logger_->log_debug("Fetching file '{}' successful!", file_to_fetch_path);
     session.transfer(flow_file, Success);
   } catch (const utils::FileReaderCallbackIOError& io_error) {
@@ -122,7 +122,9 @@ void GetFile::getSingleFile(core::ProcessSession& session, const std::filesystem
   flow_file->setAttribute(core::SpecialFlowAttribute::PATH, (relative_path / "").string());
 
   try {
-    session.write(flow_file, utils::FileReaderCallback{file_path});
+    if (!session.tryKernelImport(file_path, flow_file, request_.keepSourceFile)) {
+      session.write(flow_file, utils::FileReaderCallback{file_path});
+    }
     session.transfer(flow_file, Success);
     if (!request_.keepSourceFile) {
       std::error_code remove_error;
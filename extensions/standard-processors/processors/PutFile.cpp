@@ -124,8 +124,10 @@ void PutFile::putFile(core::ProcessSession& session,
   bool success = false;
 
   utils::FileWriterCallback file_writer_callback(dest_file);
-  auto read_result = session.read(flow_file, std::ref(file_writer_callback));
-  if (io::isError(read_result)) {
+  if (session.tryKernelExport(flow_file, file_writer_callback.getTempPath())) {
+    file_writer_callback.setWriteSucceeded();
+    success = file_writer_callback.commit();
+  } else if (const auto read_result = session.read(flow_file, std::ref(file_writer_callback)); io::isError(read_result)) {
     logger_->log_error("Failed to write to {}", dest_file);
     success = false;
   } else {
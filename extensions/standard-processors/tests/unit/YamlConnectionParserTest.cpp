@@ -79,6 +79,37 @@ TEST_CASE("Connections components are parsed from yaml", "[YamlConfiguration]")
     StructuredConnectionParser yaml_connection_parser(connection_node, "test_node", parent_ptr, logger);
     REQUIRE(231 == yaml_connection_parser.getSwapThreshold());
   }
+  SECTION("Queue swap threshold memory size is read") {
+    YAML::Node yaml_node = YAML::Load(std::string {
+        "swap threshold memory size: 10 MB\n" });
+    flow::Node connection_node{std::make_shared<YamlNode>(yaml_node)};
+    StructuredConnectionParser yaml_connection_parser(connection_node, "test_node", parent_ptr, logger);
+    REQUIRE(10_MiB == yaml_connection_parser.getSwapThresholdMemorySize());
+  }
+  SECTION("Prioritizer is read") {
+    SECTION("As a single prioritizer name") {
+      YAML::Node yaml_node = YAML::Load(std::string {
+          "prioritizers: PriorityAttributePrioritizer\n" });
+      flow::Node connection_node{std::make_shared<YamlNode>(yaml_node)};
+      StructuredConnectionParser yaml_connection_parser(connection_node, "test_node", parent_ptr, logger);
+      REQUIRE(yaml_connection_parser.getPrioritizer()->getName() == minifi::core::PriorityAttributePrioritizer::Name);
+    }
+    SECTION("As a list of NiFi class names") {
+      YAML::Node yaml_node = YAML::Load(std::string {
+          "prioritizers:\n"
+          "  - org.apache.nifi.prioritizer.OldestFlowFileFirstPrioritizer\n" });
+      flow::Node connection_node{std::make_shared<YamlNode>(yaml_node)};
+      StructuredConnectionParser yaml_connection_parser(connection_node, "test_node", parent_ptr, logger);
+      REQUIRE(yaml_connection_parser.getPrioritizer()->getName() == minifi::core::OldestFlowFileFirstPrioritizer::Name);
+    }
+    SECTION("Unknown prioritizers are rejected") {
+      YAML::Node yaml_node = YAML::Load(std::string {
+          "prioritizers: RandomPrioritizer\n" });
+      flow::Node connection_node{std::make_shared<YamlNode>(yaml_node)};
+      StructuredConnectionParser yaml_connection_parser(connection_node, "test_node", parent_ptr, logger);
+      REQUIRE_THROWS(yaml_connection_parser.getPrioritizer());
+    }
+  }
   SECTION("Source and destination names and uuids are read") {
     const utils::Identifier expected_source_id = utils::generateUUID();
     const utils::Identifier expected_destination_id = utils::generateUUID();
@@ -179,15 +210,19 @@ TEST_CASE("Connections components are parsed from yaml", "[YamlConfiguration]")
             "max work queue size: \n"
             "max work queue data size: \n"
             "swap threshold: \n"
+            "swap threshold memory size: \n"
             "flowfile expiration: \n"
-            "drop empty: \n"});
+            "drop empty: \n"
+            "prioritizers: \n"});
         flow::Node connection_node{std::make_shared<YamlNode>(yaml_node)};
         StructuredConnectionParser yaml_connection_parser(connection_node, "test_node", parent_ptr, logger);
         CHECK(minifi::Connection::DEFAULT_BACKPRESSURE_THRESHOLD_COUNT == yaml_connection_parser.getWorkQueueSize());
         CHECK(minifi::Connection::DEFAULT_BACKPRESSURE_THRESHOLD_DATA_SIZE == yaml_connection_parser.getWorkQueueDataSize());
         CHECK(0 == yaml_connection_parser.getSwapThreshold());
+        CHECK(0 == yaml_connection_parser.getSwapThresholdMemorySize());
         CHECK(0s == yaml_connection_parser.getFlowFileExpiration());
         CHECK(0 == yaml_connection_parser.getDropEmpty());
+        CHECK_FALSE(yaml_connection_parser.getPrioritizer());
       }
     }
     SECTION("With a configuration that has values of incorrect format") {
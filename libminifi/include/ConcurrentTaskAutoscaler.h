@@ -0,0 +1,59 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string_view>
+
+#include "core/Processor.h"
+
+namespace org::apache::nifi::minifi {
+
+/**
+ * Decides the number of concurrent tasks of a processor from the state of its connections and the time its tasks spent
+ * in onTrigger during the last sampling interval: a processor gets one more task if its input is backlogged and its tasks
+ * are busy, and gives one back if it has nothing queued and its tasks are mostly idle, or if its output is backpressured.
+ */
+class ConcurrentTaskAutoscaler {
+ public:
+  struct Sample {
+    std::chrono::steady_clock::time_point time;
+    uint64_t queued_flow_files = 0;
+    bool incoming_queue_full = false;
+    bool outgoing_queue_full = false;
+    // total time spent in onTrigger and session commit
+    std::chrono::nanoseconds busy_time{0};
+
+    static Sample of(const core::Processor& processor, std::chrono::steady_clock::time_point time = std::chrono::steady_clock::now());
+  };
+
+  struct Decision {
+    int task_count;
+    // why the task count changed, empty if it did not
+    std::string_view reason;
+  };
+
+  // tasks busier than this are saturated, new flow files would wait for them
+  static constexpr double SATURATED_BUSY_RATIO = 0.75;
+  // tasks less busy than this can be given back
+  static constexpr double IDLE_BUSY_RATIO = 0.25;
+
+  static Decision decide(const Sample& previous, const Sample& current, int task_count, int min_task_count, int max_task_count);
+};
+
+}  // namespace org::apache::nifi::minifi
@@ -28,11 +28,13 @@
 #include <atomic>
 #include <algorithm>
 #include <utility>
+#include <limits>
 #include "core/Core.h"
 #include "core/Connectable.h"
 #include "core/logging/Logger.h"
 #include "core/Relationship.h"
 #include "core/FlowFile.h"
+#include "core/FlowFilePrioritizer.h"
 #include "core/Repository.h"
 #include "utils/FlowFileQueue.h"
 
@@ -123,6 +125,25 @@ class Connection : public core::Connectable {
     queue_.setMaxSize(size * 3 / 2);
   }
 
+  /**
+   * Limits the estimated memory usage of the queued flow files (not including their content),
+   * the ones beyond this limit are swapped out to the flow file repository.
+   */
+  void setSwapThresholdMemorySize(uint64_t size) {
+    queue_.setTargetMemorySize(size);
+    queue_.setMinMemorySize(size / 2);
+    queue_.setMaxMemorySize(size * 3 / 2);
+  }
+
+  /**
+   * Sets the order in which the queued flow files are processed, by default it is the order they arrived in.
+   * Can only be set while the connection is empty.
+   */
+  void setPrioritizer(std::shared_ptr<core::FlowFilePrioritizer> prioritizer) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queue_.setPrioritizer(std::move(prioritizer));
+  }
+
   void setFlowExpirationDuration(std::chrono::milliseconds duration) {
     expired_duration_ = duration;
   }
@@ -152,12 +173,34 @@ class Connection : public core::Connectable {
     return queued_data_size_;
   }
 
+  uint64_t getSwappedQueueSize() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_.swappedCount();
+  }
+
+  uint64_t getSwappedQueueMemorySize() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_.swappedMemorySize();
+  }
+
   void put(const std::shared_ptr<core::FlowFile>& flow) override;
 
   void multiPut(std::vector<std::shared_ptr<core::FlowFile>>& flows);
 
   std::shared_ptr<core::FlowFile> poll(std::set<std::shared_ptr<core::FlowFile>> &expiredFlowRecords);
 
+  /**
+   * Polls up to max_count flow files while holding the lock of the connection only once.
+   * @param max_count maximum number of flow files to return
+   * @param max_bytes polling stops once the total size of the returned flow files reaches this limit
+   * @param expiredFlowRecords the flow files found to be expired are added to this set
+   */
+  std::vector<std::shared_ptr<core::FlowFile>> pollBatch(size_t max_count, uint64_t max_bytes, std::set<std::shared_ptr<core::FlowFile>> &expiredFlowRecords);
+
+  std::vector<std::shared_ptr<core::FlowFile>> pollBatch(size_t max_count, std::set<std::shared_ptr<core::FlowFile>> &expiredFlowRecords) {
+    return pollBatch(max_count, std::numeric_limits<uint64_t>::max(), expiredFlowRecords);
+  }
+
   void drain(bool delete_permanently);
 
   void yield() override {}
@@ -184,6 +227,9 @@ class Connection : public core::Connectable {
   std::shared_ptr<core::ContentRepository> content_repo_;
 
  private:
+  // the caller must hold mutex_
+  std::shared_ptr<core::FlowFile> pollLocked(std::set<std::shared_ptr<core::FlowFile>> &expiredFlowRecords);
+
   bool drop_empty_ = false;
   mutable std::mutex mutex_;
   std::atomic<uint64_t> queued_data_size_ = 0;
@@ -51,6 +51,7 @@ class EventDrivenSchedulingAgent : public ThreadedSchedulingAgent {
   }
 
   void schedule(core::Processor* processor) override;
+  void unschedule(core::Processor* processor) override;
 
   utils::TaskRescheduleInfo run(core::Processor* processor, const std::shared_ptr<core::ProcessContext> &processContext,
       const std::shared_ptr<core::ProcessSessionFactory> &sessionFactory) override;
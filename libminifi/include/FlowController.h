@@ -52,6 +52,7 @@
 #include "EventDrivenSchedulingAgent.h"
 #include "FlowFileRecord.h"
 #include "properties/Configure.h"
+#include "ThreadPartition.h"
 #include "TimerDrivenSchedulingAgent.h"
 #include "utils/Id.h"
 #include "utils/file/FileSystem.h"
@@ -147,6 +148,10 @@ class FlowController : public core::controller::ForwardingControllerServiceProvi
 
   std::map<std::string, std::unique_ptr<io::InputStream>> getDebugInfo() override;
 
+  std::vector<ThreadPartitionUtilization> getThreadPartitionUtilizations() override;
+
+  std::optional<provenance::ProvenanceQueryResult> queryProvenance(const provenance::ProvenanceQuery& query) override;
+
  private:
   class UpdateState {
    public:
@@ -168,6 +173,7 @@ class FlowController : public core::controller::ForwardingControllerServiceProvi
   std::unique_ptr<core::ProcessGroup> loadInitialFlow();
 
   void loadFlowRepo();
+  void loadThreadPartitions();
   std::vector<state::StateController*> getAllComponents();
   state::StateController* getComponent(const std::string& id_or_name);
   gsl::not_null<std::unique_ptr<state::ProcessorController>> createController(core::Processor& processor);
@@ -201,6 +207,9 @@ class FlowController : public core::controller::ForwardingControllerServiceProvi
 
   // Thread pool for schedulers
   utils::ThreadPool thread_pool_;
+  std::vector<ThreadPartition> thread_partitions_;
+  // pools of the thread partitions, they are kept (shut down) when a partition is removed, as the schedulers may still refer to them
+  std::map<std::string, std::unique_ptr<utils::ThreadPool>> thread_partition_pools_;
 };
 
 }  // namespace org::apache::nifi::minifi
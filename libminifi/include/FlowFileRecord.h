@@ -36,6 +36,7 @@
 #include "core/logging/LoggerFactory.h"
 #include "ResourceClaim.h"
 #include "Connection.h"
+#include "io/CompactEncoding.h"
 #include "io/OutputStream.h"
 #include "io/StreamPipe.h"
 
@@ -51,9 +52,16 @@ class FlowFileRecord : public core::FlowFile {
   friend class core::ProcessSession;
 
  public:
+  // the version of the compact layout, written after the compact record marker
+  static constexpr uint8_t COMPACT_FORMAT_VERSION = 1;
+
   FlowFileRecord();
 
-  bool Serialize(io::OutputStream &outStream);
+  // DeSerialize reads the records of both formats
+  bool Serialize(io::OutputStream &outStream, io::RecordFormat format = io::RecordFormat::COMPACT);
+
+  // appends the compact record to the buffer, so that a single buffer can be reused for serializing many flow files
+  void Serialize(std::vector<std::byte>& buffer) const;
 
   //! Serialize and Persistent to the repository
   bool Persist(const std::shared_ptr<core::Repository>& flowRepository);
@@ -75,6 +83,11 @@ class FlowFileRecord : public core::FlowFile {
   static std::atomic<uint64_t> local_flow_seq_number_;
 
  private:
+  bool SerializeLegacy(io::OutputStream &outStream);
+  static std::shared_ptr<FlowFileRecord> DeSerializeLegacy(io::InputStream &stream, uint8_t first_byte, const std::shared_ptr<core::ContentRepository> &content_repo,
+      utils::Identifier &container);
+  static std::shared_ptr<FlowFileRecord> DeSerializeCompact(io::InputStream &stream, const std::shared_ptr<core::ContentRepository> &content_repo, utils::Identifier &container);
+
   static std::shared_ptr<core::logging::Logger> logger_;
 };
 
@@ -19,7 +19,10 @@
  */
 #pragma once
 
+#include <chrono>
+#include <deque>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 #include <mutex>
@@ -27,13 +30,13 @@
 #include <stack>
 
 #include "utils/BaseHTTPClient.h"
-#include "concurrentqueue.h"
 #include "FlowFileRecord.h"
 #include "core/Processor.h"
 #include "core/ProcessSession.h"
 #include "core/PropertyDefinition.h"
 #include "core/PropertyDefinitionBuilder.h"
 #include "core/RelationshipDefinition.h"
+#include "sitetosite/PeerSelector.h"
 #include "sitetosite/SiteToSiteClient.h"
 #include "controllers/SSLContextService.h"
 #include "core/logging/LoggerFactory.h"
@@ -88,7 +91,6 @@ class RemoteProcessorGroupPort : public core::Processor {
     client_type_ = sitetosite::CLIENT_TYPE::RAW;
     protocol_uuid_ = uuid;
     site2site_secure_ = false;
-    peer_index_ = -1;
     // REST API port and host
     setURL(std::move(url));
   }
@@ -112,12 +114,19 @@ class RemoteProcessorGroupPort : public core::Processor {
     .withPropertyType(core::StandardPropertyTypes::TIME_PERIOD_TYPE)
     .withDefaultValue("15 s")
     .build();
-  MINIFIAPI static constexpr auto Properties = std::array<core::PropertyReference, 5>{
+  MINIFIAPI static constexpr auto useCompression = core::PropertyDefinitionBuilder<>::createProperty("Use Compression")
+    .withDescription("Whether the data packets sent to or received from the remote port are compressed")
+    .isRequired(false)
+    .withPropertyType(core::StandardPropertyTypes::BOOLEAN_TYPE)
+    .withDefaultValue("false")
+    .build();
+  MINIFIAPI static constexpr auto Properties = std::array<core::PropertyReference, 6>{
       hostName,
       SSLContext,
       port,
       portUUID,
-      idleTimeout
+      idleTimeout,
+      useCompression
   };
 
 
@@ -186,7 +195,7 @@ class RemoteProcessorGroupPort : public core::Processor {
   // refresh remoteSite2SiteInfo via nifi rest api
   std::pair<std::string, int> refreshRemoteSite2SiteInfo();
 
-  // refresh site2site peer list
+  // refresh site2site peer list, fetches it without holding peer_mutex_
   void refreshPeerList();
 
   void notifyStop() override;
@@ -209,10 +218,26 @@ class RemoteProcessorGroupPort : public core::Processor {
     }
   }
 
+  // the peer list is re-queried periodically so that the peer selection follows the load of the peers
+  static constexpr auto PEER_REFRESH_INTERVAL = std::chrono::minutes(1);
+
+  struct IdleClient {
+    std::unique_ptr<sitetosite::SiteToSiteClient> client;
+    std::chrono::steady_clock::time_point idle_since;
+  };
+
+  /**
+   * Selects a peer weighted by its reported load and hands out an idle client connected to it,
+   * or creates a new one if there is none.
+   */
   std::unique_ptr<sitetosite::SiteToSiteClient> getNextProtocol(bool create);
   void returnProtocol(std::unique_ptr<sitetosite::SiteToSiteClient> protocol);
+  std::unique_ptr<sitetosite::SiteToSiteClient> takeIdleClient(const std::string& peer_key);
+  void removeIdleClientsOfUnknownPeers();
 
-  moodycamel::ConcurrentQueue<std::unique_ptr<sitetosite::SiteToSiteClient>> available_protocols_;
+  // the clients kept alive between the triggers, keyed by the peer they are connected to
+  std::unordered_map<std::string, std::deque<IdleClient>> idle_clients_;
+  std::mutex idle_clients_mutex_;
 
   std::shared_ptr<Configure> configure_;
   // Transaction Direction
@@ -228,6 +253,8 @@ class RemoteProcessorGroupPort : public core::Processor {
 
   std::chrono::milliseconds idle_timeout_ = std::chrono::seconds(15);
 
+  bool use_compression_ = false;
+
   // rest API end point info
   std::vector<struct RPG> nifi_instances_;
 
@@ -240,9 +267,11 @@ class RemoteProcessorGroupPort : public core::Processor {
 
   // Remote Site2Site Info
   bool site2site_secure_;
-  std::vector<sitetosite::PeerStatus> peers_;
-  std::atomic<int> peer_index_;
+  sitetosite::PeerSelector peer_selector_;
+  std::chrono::steady_clock::time_point last_peer_refresh_;
   std::mutex peer_mutex_;
+  // only one trigger fetches the peer list at a time
+  std::mutex peer_refresh_mutex_;
   std::string rest_user_name_;
   std::string rest_password_;
 
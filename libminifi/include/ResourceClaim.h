@@ -27,6 +27,8 @@
 #include <memory>
 #include <mutex>
 #include <atomic>
+#include <optional>
+#include <string_view>
 #include "core/Core.h"
 #include "core/StreamManager.h"
 #include "properties/Configure.h"
@@ -78,6 +80,15 @@ class ResourceClaim {
     return _contentFullPath;
   }
 
+  /**
+   * The name of the claim within the content directory of its manager, which the compact flow file
+   * records store instead of the full path. Nullopt if the content is not in that directory.
+   */
+  std::optional<std::string_view> getClaimId() const;
+
+  // the inverse of getClaimId
+  static Path getContentFullPathFromClaimId(const std::shared_ptr<core::StreamManager<ResourceClaim>>& claim_manager, std::string_view claim_id);
+
   bool exists() {
     if (claim_manager_ == nullptr) {
       return false;
@@ -109,6 +120,8 @@ class ResourceClaim {
   ResourceClaim(const ResourceClaim &parent);
   ResourceClaim &operator=(const ResourceClaim &parent);
 
+  static std::string getContentDirectory(const core::StreamManager<ResourceClaim>* claim_manager);
+
   static utils::NonRepeatingStringGenerator non_repeating_string_generator_;
 };
 
@@ -65,6 +65,7 @@ class RootProcessGroupWrapper {
 
   void getConnections(std::map<std::string, core::Connectable*>& connectionMap);
   void getFlowFileContainers(std::map<std::string, core::Connectable*>& containers) const;
+  void assignThreadPartitions(const std::map<std::string, std::string>& partition_by_process_group);
   bool startProcessing(TimerDrivenSchedulingAgent& timer_scheduler,
                        EventDrivenSchedulingAgent& event_scheduler,
                        CronDrivenSchedulingAgent& cron_scheduler);
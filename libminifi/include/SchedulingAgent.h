@@ -111,7 +111,19 @@ class SchedulingAgent {
 
   std::chrono::milliseconds getAdminYieldDuration() const { return admin_yield_duration_; }
 
+  /**
+   * Sets the thread pools of the named thread partitions, processors assigned to a partition are run on its pool.
+   * The pools must outlive the scheduling agent.
+   */
+  void setThreadPartitionPools(std::map<std::string, utils::ThreadPool*> thread_partition_pools) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    thread_partition_pools_ = std::move(thread_partition_pools);
+  }
+
  protected:
+  // the pool of the processor's thread partition, or the default pool; the caller has to hold mutex_
+  utils::ThreadPool& getThreadPool(const core::Processor& processor);
+
   std::mutex mutex_;
   std::atomic<bool> running_;
   std::chrono::milliseconds admin_yield_duration_;
@@ -125,6 +137,7 @@ class SchedulingAgent {
 
   std::shared_ptr<core::ContentRepository> content_repo_;
   utils::ThreadPool& thread_pool_;
+  std::map<std::string, utils::ThreadPool*> thread_partition_pools_;
   gsl::not_null<core::controller::ControllerServiceProvider*> controller_service_provider_;
 
  private:
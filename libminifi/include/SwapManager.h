@@ -29,11 +29,19 @@ namespace org::apache::nifi::minifi {
 struct SwappedFlowFile {
   utils::Identifier id;
   std::chrono::steady_clock::time_point to_be_processed_after;
+  // the key of the prioritizer of the queue, so that swapped flow files can be ordered without loading them
+  int64_t priority_key = 0;
+  // the estimated memory usage of the flow file (see FlowFile::getEstimatedMemoryUsage)
+  uint64_t memory_size = 0;
 };
 
 class SwapManager {
  public:
-  virtual void store(std::vector<std::shared_ptr<core::FlowFile>> flow_files) = 0;
+  /**
+   * Persists the flow files so that they can be loaded later, possibly in the background.
+   * The returned future is ready once the flow files can be loaded.
+   */
+  virtual std::future<void> store(std::vector<std::shared_ptr<core::FlowFile>> flow_files) = 0;
   virtual std::future<std::vector<std::shared_ptr<core::FlowFile>>> load(std::vector<SwappedFlowFile> flow_files) = 0;
   virtual ~SwapManager() = default;
 };
@@ -0,0 +1,47 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "properties/Configure.h"
+
+namespace org::apache::nifi::minifi {
+
+/**
+ * A named set of flow threads, optionally pinned to a set of CPUs, or to the CPUs and the memory of a NUMA node,
+ * which runs the processors of the process groups assigned to it.
+ */
+struct ThreadPartition {
+  std::string name;
+  // empty if the threads can run on any CPU
+  std::vector<unsigned> cpus;
+  // the NUMA node the memory allocations of the threads are bound to, besides pinning them to its CPUs
+  std::optional<unsigned> numa_node;
+  int thread_count = 0;
+  // names or ids of the assigned process groups, their child groups are also assigned unless they are assigned to another partition
+  std::vector<std::string> process_groups;
+
+  /**
+   * Reads the partitions listed in nifi.flow.engine.thread.partitions, invalid partitions are logged and skipped.
+   */
+  static std::vector<ThreadPartition> fromConfiguration(const Configure& configuration);
+};
+
+}  // namespace org::apache::nifi::minifi
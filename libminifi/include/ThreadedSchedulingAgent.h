@@ -19,8 +19,9 @@
  */
 #pragma once
 
+#include <atomic>
+#include <map>
 #include <memory>
-#include <set>
 #include <string>
 #include <chrono>
 #include "properties/Configure.h"
@@ -28,6 +29,7 @@
 #include "core/Processor.h"
 #include "core/Repository.h"
 #include "core/ProcessContext.h"
+#include "ConcurrentTaskAutoscaler.h"
 #include "SchedulingAgent.h"
 
 namespace org::apache::nifi::minifi {
@@ -42,8 +44,12 @@ class ThreadedSchedulingAgent : public SchedulingAgent {
         std::shared_ptr<core::Repository> flow_repo, std::shared_ptr<core::ContentRepository> content_repo,
         std::shared_ptr<Configure> configuration,  utils::ThreadPool &thread_pool)
       : SchedulingAgent(controller_service_provider, repo, flow_repo, content_repo, configuration, thread_pool) {
+    initializeAutoscaling();
+  }
+  ~ThreadedSchedulingAgent() override {
+    // the autoscaling callback uses the members, it has to be stopped first
+    autoscaling_timer_.reset();
   }
-  ~ThreadedSchedulingAgent() override = default;
 
   virtual utils::TaskRescheduleInfo run(core::Processor* processor, const std::shared_ptr<core::ProcessContext> &processContext,
                        const std::shared_ptr<core::ProcessSessionFactory> &sessionFactory) = 0;
@@ -54,10 +60,42 @@ class ThreadedSchedulingAgent : public SchedulingAgent {
 
   void stop() override;
 
+  // Adjusts the number of concurrent tasks of the running processors, called periodically if autoscaling is enabled
+  void autoscale();
+
  private:
+  // the number of tasks a processor should have and the number of its tasks in the thread pool, shared with the tasks
+  struct ConcurrentTasks {
+    std::atomic<int> target_count{0};
+    std::atomic<int> running_count{0};
+
+    // a task is retired, if there are more tasks than needed
+    bool retireExcessTask();
+    // a task should be added, if there are less tasks than needed
+    bool reserveMissingTask();
+  };
+
+  struct RunningProcessor {
+    core::Processor* processor;
+    utils::ThreadPool* thread_pool;
+    std::shared_ptr<core::ProcessContext> process_context;
+    std::shared_ptr<core::ProcessSessionFactory> session_factory;
+    std::shared_ptr<ConcurrentTasks> concurrent_tasks;
+    ConcurrentTaskAutoscaler::Sample last_sample;
+  };
+
+  void initializeAutoscaling();
+  void executeTask(const RunningProcessor& running_processor);
+  int getMinConcurrentTasks(const RunningProcessor& running_processor) const;
+  int getMaxConcurrentTasks(const RunningProcessor& running_processor) const;
+  bool canIncreaseThreads() const;
+
   std::shared_ptr<core::logging::Logger> logger_ = core::logging::LoggerFactory<ThreadedSchedulingAgent>::getLogger();
 
-  std::set<utils::Identifier> processors_running_;  // Set just for easy usage
+  std::map<utils::Identifier, RunningProcessor> processors_running_;
+  // upper bound of the concurrent tasks set by autoscaling, 0 means the number of threads of the processor's thread pool
+  uint32_t autoscaling_max_concurrent_tasks_ = 0;
+  std::unique_ptr<utils::CallBackTimer> autoscaling_timer_;
 };
 
 }  // namespace org::apache::nifi::minifi
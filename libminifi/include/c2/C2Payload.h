@@ -51,7 +51,8 @@ enum class DescribeOperand : uint8_t {
   configuration,
   manifest,
   jstack,
-  corecomponentstate
+  corecomponentstate,
+  provenance
 };
 
 enum class UpdateOperand : uint8_t {
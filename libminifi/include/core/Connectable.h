@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
@@ -128,6 +129,11 @@ class Connectable : public CoreComponent {
 
   void notifyWork();
 
+  /**
+   * Sets the function notifyWork() calls to wake up the scheduler of this connectable, or clears it when empty
+   */
+  void setWorkNotifier(std::function<void()> work_notifier);
+
   /**
    * Determines if work is available by this connectable
    * @return boolean if work is available.
@@ -182,6 +188,8 @@ class Connectable : public CoreComponent {
   std::atomic<SchedulingStrategy> strategy_;
   // Concurrent condition variable for whether there is incoming work to do
   std::condition_variable work_condition_;
+  // Wakes up the scheduler of an event driven connectable, guarded by work_available_mutex_
+  std::function<void()> work_notifier_;
   // version under which this connectable was created.
   std::shared_ptr<state::FlowIdentifier> connectable_version_;
 
@@ -0,0 +1,85 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
+
+#include "core/RepositoryMetricsSource.h"
+#include "io/InputStream.h"
+
+namespace org::apache::nifi::minifi::core {
+
+/**
+ * Index of the committed content of a content repository by its SHA-256 hash, used to let the claims
+ * with identical content share their storage (nifi.content.repository.deduplication).
+ * The index is kept in memory only, content committed before a restart is not deduplicated against.
+ */
+class ContentHashIndex {
+ public:
+  using Hash = std::array<std::byte, 32>;
+
+  class Hasher {
+   public:
+    Hasher();
+    Hasher(Hasher&&) noexcept;
+    Hasher& operator=(Hasher&&) noexcept;
+    ~Hasher();
+
+    void update(std::span<const std::byte> data);
+    Hash finish();
+
+   private:
+    struct Context;
+    std::unique_ptr<Context> context_;
+  };
+
+  /**
+   * Hashes the stream from its current position, returns std::nullopt if reading the stream failed.
+   */
+  static std::optional<Hash> hash(io::InputStream& stream);
+
+  /**
+   * Returns the content path of the content with the given hash, if there is any.
+   */
+  std::optional<std::string> find(const Hash& hash) const;
+  void add(const Hash& hash, const std::string& content_path);
+  // called when the content is deleted or modified
+  void remove(const std::string& content_path);
+
+  void recordUniqueClaim();
+  void recordDuplicateClaim(uint64_t size);
+  RepositoryMetricsSource::DeduplicationStats getStats() const;
+
+ private:
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, std::string> content_paths_by_hash_;
+  std::unordered_map<std::string, std::string> hashes_by_content_path_;
+  uint64_t checked_claim_count_ = 0;
+  uint64_t deduplicated_claim_count_ = 0;
+  uint64_t bytes_saved_ = 0;
+};
+
+}  // namespace org::apache::nifi::minifi::core
@@ -17,8 +17,10 @@
  */
 #pragma once
 
+#include <filesystem>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -28,6 +30,7 @@
 #include "ResourceClaim.h"
 #include "StreamManager.h"
 #include "ContentSession.h"
+#include "core/ContentHashIndex.h"
 #include "core/RepositoryMetricsSource.h"
 #include "core/Core.h"
 
@@ -53,6 +56,23 @@ class ContentRepository : public core::CoreComponent, public StreamManager<minif
 
   virtual void clearOrphans() = 0;
 
+  /**
+   * Fills the empty claim with the contents of source starting at offset without streaming it through user space.
+   * @return the number of bytes imported, or std::nullopt if the repository cannot do this and the caller has to
+   * copy the data through write() instead
+   */
+  virtual std::optional<uint64_t> importFile(const minifi::ResourceClaim& /*claim*/, const std::filesystem::path& /*source*/, uint64_t /*offset*/, bool /*keep_source*/) {
+    return std::nullopt;
+  }
+
+  /**
+   * Copies size bytes of the claim starting at offset into destination without streaming it through user space.
+   * @return false if the repository cannot do this and the caller has to copy the data through read() instead
+   */
+  virtual bool exportFile(const minifi::ResourceClaim& /*claim*/, uint64_t /*offset*/, uint64_t /*size*/, const std::filesystem::path& /*destination*/) {
+    return false;
+  }
+
   virtual void start() {}
   virtual void stop() {}
 
@@ -62,6 +82,17 @@ class ContentRepository : public core::CoreComponent, public StreamManager<minif
     return getName();
   }
 
+  std::optional<DeduplicationStats> getDeduplicationStats() const override {
+    if (!deduplication_enabled_) {
+      return std::nullopt;
+    }
+    return content_hash_index_.getStats();
+  }
+
+  bool isDeduplicationEnabled() const {
+    return deduplication_enabled_;
+  }
+
  protected:
   void removeFromPurgeList();
   virtual bool removeKey(const std::string& content_path) = 0;
@@ -71,6 +102,10 @@ class ContentRepository : public core::CoreComponent, public StreamManager<minif
   std::mutex purge_list_mutex_;
   std::map<std::string, uint32_t> count_map_;
   std::list<std::string> purge_list_;
+
+  // claims with identical content share their storage, see nifi.content.repository.deduplication
+  bool deduplication_enabled_ = false;
+  ContentHashIndex content_hash_index_;
 };
 
 }  // namespace org::apache::nifi::minifi::core
@@ -18,7 +18,9 @@
 
 #pragma once
 
+#include <filesystem>
 #include <memory>
+#include <optional>
 #include "ResourceClaim.h"
 #include "io/BaseStream.h"
 
@@ -34,6 +36,20 @@ class ContentSession {
 
   virtual std::shared_ptr<io::BaseStream> read(const std::shared_ptr<ResourceClaim>& resource_id) = 0;
 
+  struct ImportedClaim {
+    std::shared_ptr<ResourceClaim> claim;
+    uint64_t size;
+  };
+
+  // kernel-side file transfers, see ContentRepository::importFile and ContentRepository::exportFile
+  virtual std::optional<ImportedClaim> importFile(const std::filesystem::path& /*source*/, uint64_t /*offset*/, bool /*keep_source*/) {
+    return std::nullopt;
+  }
+
+  virtual bool exportFile(const std::shared_ptr<ResourceClaim>& /*resource_id*/, uint64_t /*offset*/, uint64_t /*size*/, const std::filesystem::path& /*destination*/) {
+    return false;
+  }
+
   virtual void commit() = 0;
 
   virtual void rollback() = 0;
@@ -30,7 +30,9 @@
 #include "ResourceClaim.h"
 #include "Connectable.h"
 #include "WeakReference.h"
+#include "utils/CopyOnWrite.h"
 #include "utils/FlatMap.h"
+#include "utils/InternedString.h"
 #include "utils/Export.h"
 
 namespace org::apache::nifi::minifi::core {
@@ -42,7 +44,9 @@ class FlowFile : public CoreComponent, public ReferenceContainer {
   FlowFile();
   FlowFile& operator=(const FlowFile& other);
 
-  using AttributeMap = utils::FlatMap<std::string, std::string>;
+  // attribute keys are interned, so the keys of the flow files share their storage
+  using AttributeKey = utils::InternedString;
+  using AttributeMap = utils::FlatMap<AttributeKey, std::string>;
 
   /**
    * Returns a pointer to this flow file record's
@@ -83,7 +87,12 @@ class FlowFile : public CoreComponent, public ReferenceContainer {
   /**
    * Get lineage identifiers
    */
-  std::vector<utils::Identifier> &getlineageIdentifiers();
+  [[nodiscard]] const std::vector<utils::Identifier>& getlineageIdentifiers() const;
+
+  /**
+   * Appends a lineage identifier
+   */
+  void addLineageIdentifier(const utils::Identifier& lineage_identifier);
 
   /**
    * Returns whether or not this flow file record
@@ -122,8 +131,8 @@ class FlowFile : public CoreComponent, public ReferenceContainer {
    */
   void setLineageStartDate(std::chrono::system_clock::time_point date);
 
-  void setLineageIdentifiers(const std::vector<utils::Identifier>& lineage_Identifiers) {
-    lineage_Identifiers_ = lineage_Identifiers;
+  void setLineageIdentifiers(std::vector<utils::Identifier> lineage_Identifiers) {
+    lineage_Identifiers_.set(std::move(lineage_Identifiers));
   }
   /**
    * Obtains an attribute if it exists. If it does the value is
@@ -156,7 +165,14 @@ class FlowFile : public CoreComponent, public ReferenceContainer {
    * setAttribute, if attribute already there, update it, else, add it
    */
   bool setAttribute(std::string_view key, std::string value) {
-    return attributes_.insert_or_assign(std::string{key}, std::move(value)).second;
+    // the key is only interned if the attribute is new
+    auto [it, inserted] = attributes_.mutate().try_emplace(key);
+    it->second = std::move(value);
+    return inserted;
+  }
+
+  bool setAttribute(const AttributeKey& key, std::string value) {
+    return attributes_.mutate().insert_or_assign(key, std::move(value)).second;
   }
 
   /**
@@ -164,15 +180,25 @@ class FlowFile : public CoreComponent, public ReferenceContainer {
    * @return attributes.
    */
   [[nodiscard]] std::map<std::string, std::string> getAttributes() const {
-    return {attributes_.begin(), attributes_.end()};
+    return {attributes_->begin(), attributes_->end()};
   }
 
   /**
-   * Returns the map of attributes
+   * Returns the map of attributes without copying it
+   * @return attributes.
+   */
+  [[nodiscard]] const AttributeMap& getAttributeMap() const {
+    return *attributes_;
+  }
+
+  /**
+   * Returns the modifiable map of attributes. If the attributes are shared with a snapshot of this flow file,
+   * they are copied first, so the pointer must not be kept after the flow file is handed back to the session.
+   * Use getAttributeMap() for read-only access.
    * @return attributes.
    */
   AttributeMap *getAttributesPtr() {
-    return &attributes_;
+    return &attributes_.mutate();
   }
 
   /**
@@ -194,6 +220,13 @@ class FlowFile : public CoreComponent, public ReferenceContainer {
    */
   [[nodiscard]] uint64_t getSize() const;
 
+  /**
+   * Estimates the memory used by this flow file record, not including its content.
+   * The estimate depends on the attributes and the lineage, which can change after the flow file has been queued,
+   * so the queue caches the value at enqueue time and must not recompute it at dequeue.
+   */
+  [[nodiscard]] size_t getEstimatedMemoryUsage() const;
+
   /**
    * Sets the offset
    * @param offset offset to apply to this record.
@@ -269,16 +302,16 @@ class FlowFile : public CoreComponent, public ReferenceContainer {
   uint64_t offset_;
   // Penalty expiration
   std::chrono::steady_clock::time_point to_be_processed_after_;
-  // Attributes key/values pairs for the flow record
-  AttributeMap attributes_;
+  // Attributes key/values pairs for the flow record, shared with the snapshots of this flow file until modified
+  utils::CopyOnWrite<AttributeMap> attributes_;
   // Pointer to the associated content resource claim
   std::shared_ptr<ResourceClaim> claim_;
   // Pointers to stashed content resource claims
   utils::FlatMap<std::string, std::shared_ptr<ResourceClaim>> stashedContent_;
   // UUID string
   // std::string uuid_str_;
-  // UUID string for all parents
-  std::vector<utils::Identifier> lineage_Identifiers_;
+  // UUID string for all parents, shared with the snapshots of this flow file until modified
+  utils::CopyOnWrite<std::vector<utils::Identifier>> lineage_Identifiers_;
 
   // Orginal connection queue that this flow file was dequeued from
   core::Connectable* connection_ = nullptr;
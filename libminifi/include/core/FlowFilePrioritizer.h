@@ -0,0 +1,93 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+#include "core/FlowFile.h"
+
+namespace org::apache::nifi::minifi::core {
+
+/**
+ * Decides the order in which the flow files of a connection are processed.
+ *
+ * The prioritizer maps each flow file to a priority key, flow files with lower keys are processed first,
+ * flow files with equal keys in the order they became available. The key may only depend on the persisted
+ * state of the flow file (attributes, entry date, size), as it is computed again after a swap-in.
+ */
+class FlowFilePrioritizer {
+ public:
+  virtual ~FlowFilePrioritizer() = default;
+
+  [[nodiscard]] virtual std::string_view getName() const = 0;
+  [[nodiscard]] virtual int64_t getPriorityKey(const FlowFile& flow_file) const = 0;
+
+  /**
+   * Creates a prioritizer from its name, the NiFi class names (e.g. org.apache.nifi.prioritizer.OldestFlowFileFirstPrioritizer) are accepted as well.
+   * @return the prioritizer, or nullptr if the name is unknown
+   */
+  static std::shared_ptr<FlowFilePrioritizer> create(std::string_view name);
+};
+
+class FirstInFirstOutPrioritizer : public FlowFilePrioritizer {
+ public:
+  static constexpr std::string_view Name = "FirstInFirstOutPrioritizer";
+
+  [[nodiscard]] std::string_view getName() const override { return Name; }
+  [[nodiscard]] int64_t getPriorityKey(const FlowFile& /*flow_file*/) const override { return 0; }
+};
+
+class OldestFlowFileFirstPrioritizer : public FlowFilePrioritizer {
+ public:
+  static constexpr std::string_view Name = "OldestFlowFileFirstPrioritizer";
+
+  [[nodiscard]] std::string_view getName() const override { return Name; }
+  [[nodiscard]] int64_t getPriorityKey(const FlowFile& flow_file) const override;
+};
+
+class NewestFlowFileFirstPrioritizer : public FlowFilePrioritizer {
+ public:
+  static constexpr std::string_view Name = "NewestFlowFileFirstPrioritizer";
+
+  [[nodiscard]] std::string_view getName() const override { return Name; }
+  [[nodiscard]] int64_t getPriorityKey(const FlowFile& flow_file) const override;
+};
+
+/**
+ * Processes the flow files with the lowest integer "priority" attribute first,
+ * the ones with a missing or non-integer priority attribute come last.
+ */
+class PriorityAttributePrioritizer : public FlowFilePrioritizer {
+ public:
+  static constexpr std::string_view Name = "PriorityAttributePrioritizer";
+  static constexpr std::string_view PriorityAttribute = "priority";
+
+  [[nodiscard]] std::string_view getName() const override { return Name; }
+  [[nodiscard]] int64_t getPriorityKey(const FlowFile& flow_file) const override;
+};
+
+class SmallestFlowFileFirstPrioritizer : public FlowFilePrioritizer {
+ public:
+  static constexpr std::string_view Name = "SmallestFlowFileFirstPrioritizer";
+
+  [[nodiscard]] std::string_view getName() const override { return Name; }
+  [[nodiscard]] int64_t getPriorityKey(const FlowFile& flow_file) const override;
+};
+
+}  // namespace org::apache::nifi::minifi::core
@@ -18,6 +18,8 @@
 
 #pragma once
 
+#include <filesystem>
+#include <optional>
 #include <unordered_set>
 #include <memory>
 #include "ResourceClaim.h"
@@ -44,6 +46,10 @@ class ForwardingContentSession : public ContentSession {
 
   std::shared_ptr<io::BaseStream> read(const std::shared_ptr<ResourceClaim>& resource_id) override;
 
+  std::optional<ImportedClaim> importFile(const std::filesystem::path& source, uint64_t offset, bool keep_source) override;
+
+  bool exportFile(const std::shared_ptr<ResourceClaim>& resource_id, uint64_t offset, uint64_t size, const std::filesystem::path& destination) override;
+
   void commit() override;
 
   void rollback() override;
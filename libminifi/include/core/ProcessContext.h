@@ -42,6 +42,8 @@
 #include "core/FlowFile.h"
 #include "core/StateStorage.h"
 #include "core/VariableRegistry.h"
+#include "io/CompactEncoding.h"
+#include "provenance/ProvenanceSampling.h"
 #include "utils/file/FileUtils.h"
 #include "utils/PropertyErrors.h"
 
@@ -66,6 +68,7 @@ class ProcessContext : public controller::ControllerServiceLookup, public core::
         processor_node_(processor),
         logger_(logging::LoggerFactory<ProcessContext>::getLogger()),
         configure_(std::make_shared<minifi::Configure>()),
+        provenance_sampling_(std::make_shared<provenance::ProvenanceSampling>()),
         initialized_(false) {
     repo_ = repo;
     state_storage_ = getStateStorage(logger_, controller_service_provider_, nullptr);
@@ -90,6 +93,14 @@ class ProcessContext : public controller::ControllerServiceLookup, public core::
     if (!configure_) {
       configure_ = std::make_shared<minifi::Configure>();
     }
+    provenance_sampling_ = std::make_shared<provenance::ProvenanceSampling>(provenance::ProvenanceSampling::fromConfiguration(*configure_));
+    if (const auto record_format = configure_->get(Configure::nifi_repository_record_format)) {
+      if (const auto parsed_record_format = io::parseRecordFormat(*record_format)) {
+        record_format_ = *parsed_record_format;
+      } else {
+        logger_->log_error("Invalid {} property '{}', writing the records in the compact format", Configure::nifi_repository_record_format, *record_format);
+      }
+    }
   }
 
   // Get Processor associated with the Process Context
@@ -192,6 +203,15 @@ class ProcessContext : public controller::ControllerServiceLookup, public core::
     return repo_;
   }
 
+  std::shared_ptr<const provenance::ProvenanceSampling> getProvenanceSampling() const {
+    return provenance_sampling_;
+  }
+
+  // the format of the flow file and provenance records written by the sessions, see nifi.repository.record.format
+  io::RecordFormat getRecordFormat() const {
+    return record_format_;
+  }
+
   /**
    * Returns a reference to the content repository for the running instance.
    * @return content repository shared pointer.
@@ -408,6 +428,8 @@ class ProcessContext : public controller::ControllerServiceLookup, public core::
   std::shared_ptr<ProcessorNode> processor_node_;
   std::shared_ptr<logging::Logger> logger_;
   std::shared_ptr<Configure> configure_;
+  std::shared_ptr<const provenance::ProvenanceSampling> provenance_sampling_;
+  io::RecordFormat record_format_ = io::RecordFormat::COMPACT;
   bool initialized_;
 };
 
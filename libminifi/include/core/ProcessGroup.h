@@ -145,6 +145,12 @@ class ProcessGroup : public CoreComponent {
                       CronDrivenSchedulingAgent& cronScheduler,
                       const std::function<bool(const Processor*)>& filter = nullptr);
 
+  /**
+   * Assigns the processors of this group and its child groups to thread partitions. A group is assigned to the partition of its
+   * name or id in partition_by_process_group, or to the partition of its parent if it is not listed.
+   */
+  void assignThreadPartitions(const std::map<std::string, std::string>& partition_by_process_group, const std::string& parent_partition = "");
+
   bool isRemoteProcessGroup();
   // set parent process group
   void setParent(ProcessGroup *parent) {
@@ -17,6 +17,7 @@
  */
 #pragma once
 
+#include <filesystem>
 #include <memory>
 #include <string>
 #include <utility>
@@ -29,6 +30,7 @@
 #include <set>
 #include <unordered_map>
 #include <unordered_set>
+#include <limits>
 
 #include "ProcessContext.h"
 #include "FlowFileRecord.h"
@@ -76,6 +78,8 @@ class ProcessSession : public ReferenceContainer {
 
   // Get the FlowFile from the highest priority queue
   virtual std::shared_ptr<core::FlowFile> get();
+  // Get up to max_count FlowFiles from the incoming queues, stopping once their total size reaches max_bytes
+  virtual std::vector<std::shared_ptr<core::FlowFile>> get(size_t max_count, uint64_t max_bytes = std::numeric_limits<uint64_t>::max());
   // Create a new UUID FlowFile with no content resource claim and inherit all attributes from parent
   std::shared_ptr<core::FlowFile> create(const std::shared_ptr<core::FlowFile> &parent = {});
   // Add a FlowFile to the session
@@ -140,6 +144,19 @@ class ProcessSession : public ReferenceContainer {
   bool exportContent(const std::string &destination, const std::string &tmpFileName, const std::shared_ptr<core::FlowFile> &flow,
   bool keepContent);
 
+  /**
+   * Imports the file into the flow file without streaming it through the agent (hard link, reflink or copy_file_range),
+   * if the content repository supports it. The source is not deleted, even if keepSource is false.
+   * @return false if nothing has been imported and the caller has to copy the content
+   */
+  bool tryKernelImport(const std::filesystem::path& source, const std::shared_ptr<core::FlowFile>& flow, bool keepSource = true, uint64_t offset = 0);
+
+  /**
+   * Writes the content of the flow file into destination without streaming it through the agent, if the content repository supports it.
+   * @return false if the caller has to copy the content
+   */
+  bool tryKernelExport(const std::shared_ptr<core::FlowFile>& flow, const std::filesystem::path& destination);
+
   // Stash the content to a key
   void stash(const std::string &key, const std::shared_ptr<core::FlowFile> &flow);
   // Restore content previously stashed to a key
@@ -208,6 +225,10 @@ class ProcessSession : public ReferenceContainer {
 
   // Clone the flow file during transfer to multiple connections for a relationship
   std::shared_ptr<core::FlowFile> cloneDuringTransfer(const std::shared_ptr<core::FlowFile> &parent);
+
+  Connection* pickIncomingConnection() const;
+  void addPolledFlowFile(const std::shared_ptr<core::FlowFile>& flow_file, const std::shared_ptr<state::FlowIdentifier>& flow_version);
+  void removeExpiredFlowFiles(const std::set<std::shared_ptr<core::FlowFile>>& expired);
   // ProcessContext
   std::shared_ptr<ProcessContext> process_context_;
   // Logger
@@ -217,6 +238,9 @@ class ProcessSession : public ReferenceContainer {
 
   std::shared_ptr<ContentSession> content_session_;
 
+  // the flow files are encoded here before being copied to their exactly sized repository buffers
+  std::vector<std::byte> serialization_buffer_;
+
   StateManager* stateManager_;
 
   static std::shared_ptr<utils::IdGenerator> id_generator_;
@@ -136,6 +136,35 @@ class Processor : public Connectable, public ConfigurableComponent, public state
 
   void setMaxConcurrentTasks(uint8_t tasks) override;
 
+  // the range of the concurrent tasks when autoscaling is enabled, the max concurrent tasks is the number of tasks it starts with
+  // 0 means the default: at least 1 task, at most the limit of the scheduling agent
+  void setAutoscalingMinConcurrentTasks(uint8_t tasks) {
+    autoscaling_min_concurrent_tasks_ = tasks;
+  }
+
+  uint8_t getAutoscalingMinConcurrentTasks() const {
+    return autoscaling_min_concurrent_tasks_;
+  }
+
+  void setAutoscalingMaxConcurrentTasks(uint8_t tasks) {
+    autoscaling_max_concurrent_tasks_ = tasks;
+  }
+
+  uint8_t getAutoscalingMaxConcurrentTasks() const {
+    return autoscaling_max_concurrent_tasks_;
+  }
+
+  // name of the thread partition the processor is scheduled on, empty for the default thread pool
+  void setThreadPartition(std::string thread_partition) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    thread_partition_ = std::move(thread_partition);
+  }
+
+  std::string getThreadPartition() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return thread_partition_;
+  }
+
   virtual bool isSingleThreaded() const = 0;
 
   virtual std::string getProcessorType() const = 0;
@@ -207,6 +236,14 @@ class Processor : public Connectable, public ConfigurableComponent, public state
   // Check all incoming connections for work
   bool isWorkAvailable() override;
 
+  // Check that none of the incoming connections has flow files, not even penalized or swapped out ones
+  bool areIncomingConnectionsEmpty();
+
+  // Number of flow files queued in the incoming connections
+  uint64_t getIncomingQueueSize() const;
+
+  bool isIncomingBackpressureThresholdReached() const;
+
   bool isThrottledByBackpressure() const;
 
   Connectable* pickIncomingConnection() override;
@@ -219,6 +256,10 @@ class Processor : public Connectable, public ConfigurableComponent, public state
     return metrics_;
   }
 
+  ProcessorMetrics& getMetrics() const {
+    return *metrics_;
+  }
+
   static constexpr auto DynamicProperties = std::array<DynamicProperty, 0>{};
 
   static constexpr auto OutputAttributes = std::array<OutputAttributeReference, 0>{};
@@ -235,6 +276,8 @@ class Processor : public Connectable, public ConfigurableComponent, public state
 
   std::atomic<uint8_t> active_tasks_;
   std::atomic<bool> _triggerWhenEmpty;
+  std::atomic<uint8_t> autoscaling_min_concurrent_tasks_{0};
+  std::atomic<uint8_t> autoscaling_max_concurrent_tasks_{0};
 
   std::string cron_period_;
   gsl::not_null<std::shared_ptr<ProcessorMetrics>> metrics_;
@@ -242,6 +285,7 @@ class Processor : public Connectable, public ConfigurableComponent, public state
  private:
   mutable std::mutex mutex_;
   std::atomic<std::chrono::steady_clock::time_point> yield_expiration_{};
+  std::string thread_partition_;
 
   static std::mutex& getGraphMutex() {
     static std::mutex mutex{};
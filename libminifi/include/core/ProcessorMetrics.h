@@ -56,6 +56,12 @@ class ProcessorMetrics : public state::response::ResponseNode {
   std::atomic<size_t> iterations{0};
   std::atomic<size_t> transferred_flow_files{0};
   std::atomic<uint64_t> transferred_bytes{0};
+  // total time spent in onTrigger and session commit
+  std::atomic<uint64_t> busy_time_nanoseconds{0};
+  // set by the scheduling agent, changes over time if concurrent task autoscaling is enabled
+  std::atomic<uint32_t> concurrent_tasks{0};
+  std::atomic<uint64_t> concurrent_task_scale_ups{0};
+  std::atomic<uint64_t> concurrent_task_scale_downs{0};
 
  protected:
   template<typename ValueType>
@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <string>
 #include <optional>
 
@@ -30,6 +31,31 @@ class RepositoryMetricsSource {
     uint64_t all_memory_tables_size{};
   };
 
+  struct CommitStats {
+    uint64_t commit_count{};
+    uint64_t write_count{};
+    // the following are calculated over the most recent writes and commits
+    double average_write_batch_size{};
+    uint64_t max_write_batch_size{};
+    std::chrono::duration<double, std::milli> average_commit_latency{};
+    std::chrono::duration<double, std::milli> max_commit_latency{};
+  };
+
+  struct RecoveryStats {
+    bool in_progress{};
+    uint64_t recovered_entry_count{};
+    uint64_t estimated_entry_count{};
+    std::chrono::milliseconds elapsed{};
+    std::chrono::milliseconds estimated_remaining{};
+  };
+
+  struct DeduplicationStats {
+    uint64_t checked_claim_count{};
+    uint64_t deduplicated_claim_count{};
+    double hit_rate{};
+    uint64_t bytes_saved{};
+  };
+
   virtual ~RepositoryMetricsSource() = default;
   virtual uint64_t getRepositorySize() const = 0;
   virtual uint64_t getRepositoryEntryCount() const = 0;
@@ -50,6 +76,18 @@ class RepositoryMetricsSource {
   virtual std::optional<RocksDbStats> getRocksDbStats() const {
     return std::nullopt;
   }
+
+  virtual std::optional<CommitStats> getCommitStats() const {
+    return std::nullopt;
+  }
+
+  virtual std::optional<RecoveryStats> getRecoveryStats() const {
+    return std::nullopt;
+  }
+
+  virtual std::optional<DeduplicationStats> getDeduplicationStats() const {
+    return std::nullopt;
+  }
 };
 
 }  // namespace org::apache::nifi::minifi::core
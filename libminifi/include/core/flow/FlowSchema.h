@@ -33,6 +33,8 @@ struct FlowSchema {
   Keys processor_properties;
   Keys autoterminated_rels;
   Keys max_concurrent_tasks;
+  Keys autoscaling_min_concurrent_tasks;
+  Keys autoscaling_max_concurrent_tasks;
   Keys penalization_period;
   Keys proc_yield_period;
   Keys runduration_nanos;
@@ -41,12 +43,14 @@ struct FlowSchema {
   Keys max_queue_size;
   Keys max_queue_data_size;
   Keys swap_threshold;
+  Keys swap_threshold_memory_size;
   Keys source_id;
   Keys source_name;
   Keys destination_id;
   Keys destination_name;
   Keys flowfile_expiration;
   Keys drop_empty;
+  Keys prioritizers;
   Keys source_relationship;
   Keys source_relationship_list;
 
@@ -79,6 +83,7 @@ struct FlowSchema {
   Keys rpg_output_ports;
   Keys rpg_port_properties;
   Keys rpg_port_target_id;
+  Keys rpg_port_use_compression;
 
   static FlowSchema getDefault();
   static FlowSchema getNiFiFlowJson();
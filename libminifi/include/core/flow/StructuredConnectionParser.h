@@ -22,6 +22,7 @@
 #include <string>
 #include <string_view>
 
+#include "core/FlowFilePrioritizer.h"
 #include "core/ProcessGroup.h"
 #include "core/logging/LoggerFactory.h"
 
@@ -49,10 +50,12 @@ class StructuredConnectionParser {
   [[nodiscard]] uint64_t getWorkQueueSize() const;
   [[nodiscard]] uint64_t getWorkQueueDataSize() const;
   [[nodiscard]] uint64_t getSwapThreshold() const;
+  [[nodiscard]] uint64_t getSwapThresholdMemorySize() const;
   [[nodiscard]] utils::Identifier getSourceUUID() const;
   [[nodiscard]] utils::Identifier getDestinationUUID() const;
   [[nodiscard]] std::chrono::milliseconds getFlowFileExpiration() const;
   [[nodiscard]] bool getDropEmpty() const;
+  [[nodiscard]] std::shared_ptr<core::FlowFilePrioritizer> getPrioritizer() const;
 
  private:
   void addNewRelationshipToConnection(std::string_view relationship_name, minifi::Connection& connection) const;
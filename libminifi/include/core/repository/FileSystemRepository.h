@@ -18,9 +18,15 @@
 
 #pragma once
 
+#include <deque>
+#include <filesystem>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <utility>
 #include <algorithm>
 
@@ -28,11 +34,30 @@
 #include "properties/Configure.h"
 #include "core/logging/LoggerFactory.h"
 #include "utils/file/FileUtils.h"
+#include "utils/Literals.h"
 
 namespace org::apache::nifi::minifi::core::repository {
 
+/**
+ * Stores each resource claim in its own file by default. When segment packing is enabled
+ * (nifi.file.system.content.repository.segment.packing) new claims are appended to shared,
+ * size-capped segment files instead and are addressed by (segment, offset, length).
+ *
+ * Every entry of a segment is prefixed with a header holding the content length, a write
+ * sequence number and the claim name, so the claim index can be rebuilt from the segments
+ * on startup. A segment is deleted once none of its claims is referenced anymore.
+ *
+ * Files are imported and exported by the kernel (hard link, reflink or copy_file_range) where possible,
+ * unless disabled by nifi.file.system.content.repository.zero.copy.
+ *
+ * With deduplication enabled, the claims of a session which have the same content as an earlier claim
+ * are replaced by a hard link to it on commit. Content shared through hard links is copied before appending to it.
+ */
 class FileSystemRepository : public core::ContentRepository {
  public:
+  static constexpr uint64_t DEFAULT_SEGMENT_MAX_SIZE = 8_MiB;
+  static constexpr std::string_view SEGMENT_DIRECTORY_NAME = "segments";
+
   explicit FileSystemRepository(std::string_view name = className<FileSystemRepository>())
     : core::ContentRepository(name),
       logger_(logging::LoggerFactory<FileSystemRepository>::getLogger()) {
@@ -51,24 +76,80 @@ class FileSystemRepository : public core::ContentRepository {
 
   std::shared_ptr<ContentSession> createSession() override;
 
+  std::optional<uint64_t> importFile(const minifi::ResourceClaim& claim, const std::filesystem::path& source, uint64_t offset, bool keep_source) override;
+  bool exportFile(const minifi::ResourceClaim& claim, uint64_t offset, uint64_t size, const std::filesystem::path& destination) override;
+
   void clearOrphans() override;
 
   uint64_t getRepositorySize() const override {
     return utils::file::path_size(directory_);
   }
 
-  uint64_t getRepositoryEntryCount() const override {
-    auto dir_it = std::filesystem::recursive_directory_iterator(directory_, std::filesystem::directory_options::skip_permission_denied);
-    return std::count_if(
-      std::filesystem::begin(dir_it),
-      std::filesystem::end(dir_it),
-      [](auto& entry) { return entry.is_regular_file(); });
+  uint64_t getRepositoryEntryCount() const override;
+
+  bool isSegmentPackingEnabled() const {
+    return segment_packing_enabled_;
+  }
+
+  size_t getSegmentCount() const {
+    std::lock_guard<std::mutex> lock(segment_mutex_);
+    return segments_.size();
   }
 
  protected:
   bool removeKey(const std::string& content_path) override;
 
  private:
+  struct Segment {
+    uint64_t id = 0;
+    std::filesystem::path path;
+    uint64_t size = 0;
+    uint64_t live_claims = 0;
+    bool checked_out = false;
+    bool sealed = false;
+    std::unique_ptr<io::BaseStream> writer;
+  };
+
+  struct PackedClaim {
+    std::shared_ptr<Segment> segment;
+    uint64_t offset;
+    uint64_t length;
+    uint64_t sequence;
+  };
+
+  class SegmentWriteStream;
+  class Session;
+
+  void deduplicate(const minifi::ResourceClaim& claim);
+  bool unshareFile(const std::string& content_path);
+
+  std::shared_ptr<io::BaseStream> writePacked(const minifi::ResourceClaim& claim, bool append);
+  std::shared_ptr<Segment> acquireSegment();
+  void commitPackedClaim(const std::string& content_path, const std::shared_ptr<Segment>& segment, uint64_t offset, uint64_t length, uint64_t sequence);
+  void abortPackedClaim(const std::shared_ptr<Segment>& segment, uint64_t end_offset);
+  // the following two require segment_mutex_ to be held, the returned segment file should be deleted after releasing it
+  std::optional<std::filesystem::path> releaseSegment(const std::shared_ptr<Segment>& segment);
+  std::optional<std::filesystem::path> detachSegmentIfUnused(const std::shared_ptr<Segment>& segment);
+  void deleteSegmentFile(const std::filesystem::path& path);
+  void recoverSegments();
+  void recoverSegment(const std::shared_ptr<Segment>& segment);
+  std::optional<PackedClaim> findPackedClaim(const std::string& content_path) const;
+
+  bool zero_copy_enabled_ = true;
+  bool segment_packing_enabled_ = false;
+  uint64_t segment_max_size_ = DEFAULT_SEGMENT_MAX_SIZE;
+  std::filesystem::path segment_directory_;
+
+  // held while a claim is linked to identical content, and while a claim is unshared before appending to it
+  std::mutex deduplication_mutex_;
+
+  mutable std::mutex segment_mutex_;
+  uint64_t next_segment_id_ = 0;
+  uint64_t next_sequence_ = 0;
+  std::map<uint64_t, std::shared_ptr<Segment>> segments_;
+  std::deque<std::shared_ptr<Segment>> writable_segments_;
+  std::unordered_map<std::string, PackedClaim> packed_claims_;
+
   std::shared_ptr<logging::Logger> logger_;
 };
 
@@ -19,6 +19,7 @@
 #define LIBMINIFI_INCLUDE_CORE_STATE_UPDATECONTROLLER_H_
 
 #include <memory>
+#include <optional>
 #include <utility>
 #include <vector>
 #include <string>
@@ -26,6 +27,7 @@
 #include "utils/ThreadPool.h"
 #include "utils/BackTrace.h"
 #include "io/InputStream.h"
+#include "provenance/ProvenanceQuery.h"
 
 namespace org {
 namespace apache {
@@ -140,6 +142,13 @@ class StateController : public Pausable {
  */
 class StateMonitor : public StateController {
  public:
+  struct ThreadPartitionUtilization {
+    std::string name;
+    int thread_count;
+    // ratio of the time the threads of the partition were running tasks since the previous query, between 0 and 1
+    double utilization;
+  };
+
   ~StateMonitor() override = default;
 
   // Execute callback func on the component. Thread safe, locking mutex_, preventing concurrent flow update
@@ -188,6 +197,21 @@ class StateMonitor : public StateController {
 
   virtual std::map<std::string, std::unique_ptr<io::InputStream>> getDebugInfo() = 0;
 
+  /**
+   * Returns the utilization of the flow thread partitions, including the default one.
+   */
+  virtual std::vector<ThreadPartitionUtilization> getThreadPartitionUtilizations() {
+    return {};
+  }
+
+  /**
+   * Returns the provenance events matching the query, newest first,
+   * or std::nullopt if the provenance repository does not support queries.
+   */
+  virtual std::optional<provenance::ProvenanceQueryResult> queryProvenance(const provenance::ProvenanceQuery& /*query*/) {
+    return std::nullopt;
+  }
+
  protected:
   std::atomic<bool> controller_running_;
 };
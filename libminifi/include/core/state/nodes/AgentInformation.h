@@ -133,6 +133,7 @@ class AgentStatus : public StateMonitorNode {
   SerializedResponseNode serializeRepositories() const;
   SerializedResponseNode serializeUptime() const;
   SerializedResponseNode serializeComponents() const;
+  SerializedResponseNode serializeThreadPartitions() const;
   static SerializedResponseNode serializeAgentMemoryUsage();
   static SerializedResponseNode serializeAgentCPUUsage();
   static SerializedResponseNode serializeResourceConsumption();
@@ -57,9 +57,7 @@ class QueueMetrics : public ResponseNode {
 
   std::vector<SerializedResponseNode> serialize() override;
 
-  std::vector<PublishedMetric> calculateMetrics() override {
-    return connection_store_.calculateConnectionMetrics("QueueMetrics");
-  }
+  std::vector<PublishedMetric> calculateMetrics() override;
 
  private:
   ConnectionStore connection_store_;
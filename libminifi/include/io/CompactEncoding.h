@@ -0,0 +1,145 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "io/InputStream.h"
+#include "utils/Id.h"
+
+namespace org::apache::nifi::minifi::io {
+
+/**
+ * The compact encoding of the flow file and provenance repository records: integers and lengths are
+ * unsigned LEB128 varints, UUIDs are their 16 raw bytes, and frequent strings, like the common attribute
+ * keys, are replaced by their index in a fixed dictionary.
+ *
+ * Compact records start with COMPACT_RECORD_MARKER and the version of the record format. The records of
+ * the legacy format start with a big endian timestamp or string length, whose first byte is zero, so the
+ * readers can tell the two formats apart by the first byte.
+ */
+inline constexpr uint8_t COMPACT_RECORD_MARKER = 0xFE;
+
+enum class RecordFormat {
+  // fixed width integers, UUIDs as strings and length prefixed strings, the layout written before the compact one
+  LEGACY,
+  COMPACT
+};
+
+// parses the value of nifi.repository.record.format: "legacy" or "compact", case insensitively
+std::optional<RecordFormat> parseRecordFormat(std::string_view format);
+
+/**
+ * The attribute keys encoded by their index. New keys can only be appended, as the index is persisted.
+ */
+inline constexpr std::array<std::string_view, 36> COMMON_ATTRIBUTE_KEYS{
+    "filename", "path", "absolute.path", "uuid", "priority", "mime.type", "discard.reason", "alternate.identifier", "flow.id",
+    "fragment.identifier", "fragment.index", "fragment.count", "segment.original.filename",
+    "file.size", "file.lastModifiedTime", "file.owner", "file.group", "file.permissions", "source.hostname",
+    "invokehttp.request.url", "invokehttp.status.code", "invokehttp.status.message", "invokehttp.tx.id",
+    "s3.bucket", "s3.key", "s3.etag", "s3.version", "kafka.topic", "kafka.partition", "kafka.offset", "kafka.key",
+    "http.method", "http.request.uri", "http.remote.host", "sftp.remote.host", "sftp.remote.port"
+};
+
+/**
+ * Appends the values to a byte buffer, which can be reused for encoding several records.
+ */
+class CompactWriter {
+ public:
+  explicit CompactWriter(std::vector<std::byte>& buffer)
+      : buffer_(buffer) {
+  }
+
+  void writeByte(uint8_t value) {
+    buffer_.push_back(static_cast<std::byte>(value));
+  }
+
+  void writeVarint(uint64_t value);
+
+  void writeTime(std::chrono::system_clock::time_point time_point) {
+    writeVarint(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(time_point.time_since_epoch()).count()));
+  }
+
+  void writeString(std::string_view value);
+
+  // writes the index of the value in the dictionary plus one, or zero followed by the value if it is not in the dictionary
+  void writeString(std::string_view value, std::span<const std::string_view> dictionary);
+
+  void writeIdentifier(const utils::Identifier& value);
+
+ private:
+  std::vector<std::byte>& buffer_;
+};
+
+/**
+ * Reads the values written by CompactWriter, every method returns false on malformed or truncated input.
+ */
+class CompactReader {
+ public:
+  explicit CompactReader(InputStream& stream)
+      : stream_(stream) {
+  }
+
+  bool readByte(uint8_t& value) {
+    return stream_.read(value) == 1;
+  }
+
+  bool readVarint(uint64_t& value);
+
+  template<typename Integral>
+  requires (std::is_unsigned_v<Integral> && !std::is_same_v<Integral, uint64_t>)
+  bool readVarint(Integral& value) {
+    uint64_t wide_value = 0;
+    if (!readVarint(wide_value) || wide_value > (std::numeric_limits<Integral>::max)()) {
+      return false;
+    }
+    value = static_cast<Integral>(wide_value);
+    return true;
+  }
+
+  bool readTime(std::chrono::system_clock::time_point& time_point) {
+    uint64_t milliseconds = 0;
+    if (!readVarint(milliseconds)) {
+      return false;
+    }
+    time_point = std::chrono::system_clock::time_point() + std::chrono::milliseconds(milliseconds);
+    return true;
+  }
+
+  bool readString(std::string& value);
+
+  bool readString(std::string& value, std::span<const std::string_view> dictionary);
+
+  bool readIdentifier(utils::Identifier& value);
+
+ private:
+  static constexpr size_t STRING_READ_CHUNK_SIZE = 64 * 1024;
+
+  InputStream& stream_;
+};
+
+}  // namespace org::apache::nifi::minifi::io
@@ -45,6 +45,11 @@ class Configuration : public Properties {
   static constexpr const char *nifi_flow_engine_threads = "nifi.flow.engine.threads";
   static constexpr const char *nifi_flow_engine_alert_period = "nifi.flow.engine.alert.period";
   static constexpr const char *nifi_flow_engine_event_driven_time_slice = "nifi.flow.engine.event.driven.time.slice";
+  static constexpr const char *nifi_flow_engine_thread_partitions = "nifi.flow.engine.thread.partitions";
+  static constexpr const char *nifi_flow_engine_thread_partition_prefix = "nifi.flow.engine.thread.partition.";
+  static constexpr const char *nifi_flow_engine_autoscaling_enabled = "nifi.flow.engine.autoscaling.enabled";
+  static constexpr const char *nifi_flow_engine_autoscaling_interval = "nifi.flow.engine.autoscaling.interval";
+  static constexpr const char *nifi_flow_engine_autoscaling_max_concurrent_tasks = "nifi.flow.engine.autoscaling.max.concurrent.tasks";
   static constexpr const char *nifi_administrative_yield_duration = "nifi.administrative.yield.duration";
   static constexpr const char *nifi_bored_yield_duration = "nifi.bored.yield.duration";
   static constexpr const char *nifi_graceful_shutdown_seconds = "nifi.flowcontroller.graceful.shutdown.period";
@@ -54,7 +59,9 @@ class Configuration : public Properties {
   static constexpr const char *nifi_flow_repository_rocksdb_compression = "nifi.flowfile.repository.rocksdb.compression";
   static constexpr const char *nifi_content_repository_class_name = "nifi.content.repository.class.name";
   static constexpr const char *nifi_content_repository_rocksdb_compression = "nifi.content.repository.rocksdb.compression";
+  static constexpr const char *nifi_content_repository_deduplication = "nifi.content.repository.deduplication";
   static constexpr const char *nifi_provenance_repository_class_name = "nifi.provenance.repository.class.name";
+  static constexpr const char *nifi_repository_record_format = "nifi.repository.record.format";
   static constexpr const char *nifi_volatile_repository_options_flowfile_max_count = "nifi.volatile.repository.options.flowfile.max.count";
   static constexpr const char *nifi_volatile_repository_options_flowfile_max_bytes = "nifi.volatile.repository.options.flowfile.max.bytes";
   static constexpr const char *nifi_volatile_repository_options_provenance_max_count = "nifi.volatile.repository.options.provenance.max.count";
@@ -65,13 +72,21 @@ class Configuration : public Properties {
   static constexpr const char *nifi_provenance_repository_max_storage_size = "nifi.provenance.repository.max.storage.size";
   static constexpr const char *nifi_provenance_repository_max_storage_time = "nifi.provenance.repository.max.storage.time";
   static constexpr const char *nifi_provenance_repository_directory_default = "nifi.provenance.repository.directory.default";
+  static constexpr const char *nifi_provenance_repository_sampling_rates = "nifi.provenance.repository.sampling.rates";
   static constexpr const char *nifi_flowfile_repository_directory_default = "nifi.flowfile.repository.directory.default";
   static constexpr const char *nifi_dbcontent_repository_directory_default = "nifi.database.content.repository.directory.default";
+  static constexpr const char *nifi_file_system_content_repository_segment_packing = "nifi.file.system.content.repository.segment.packing";
+  static constexpr const char *nifi_file_system_content_repository_segment_max_size = "nifi.file.system.content.repository.segment.max.size";
+  static constexpr const char *nifi_file_system_content_repository_zero_copy = "nifi.file.system.content.repository.zero.copy";
 
   // these are internal properties related to the rocksdb backend
   static constexpr const char *nifi_flowfile_repository_rocksdb_compaction_period = "nifi.flowfile.repository.rocksdb.compaction.period";
+  static constexpr const char *nifi_flowfile_repository_rocksdb_commit_mode = "nifi.flowfile.repository.rocksdb.commit.mode";
+  static constexpr const char *nifi_flowfile_repository_rocksdb_sync_writes = "nifi.flowfile.repository.rocksdb.sync.writes";
+  static constexpr const char *nifi_flowfile_repository_recovery_threads = "nifi.flowfile.repository.recovery.threads";
   static constexpr const char *nifi_dbcontent_repository_rocksdb_compaction_period = "nifi.database.content.repository.rocksdb.compaction.period";
   static constexpr const char *nifi_dbcontent_repository_purge_period = "nifi.database.content.repository.purge.period";
+  static constexpr const char *nifi_dbcontent_repository_chunk_size = "nifi.database.content.repository.chunk.size";
 
   static constexpr const char *nifi_remote_input_secure = "nifi.remote.input.secure";
   static constexpr const char *nifi_security_need_ClientAuth = "nifi.security.need.ClientAuth";
@@ -24,8 +24,10 @@
 #include <iostream>
 #include <map>
 #include <memory>
+#include <optional>
 #include <set>
 #include <string>
+#include <string_view>
 #include <thread>
 #include <vector>
 #include "core/Core.h"
@@ -35,6 +37,7 @@
 #include "properties/Configure.h"
 #include "Connection.h"
 #include "FlowFileRecord.h"
+#include "io/CompactEncoding.h"
 #include "core/logging/LoggerFactory.h"
 #include "ResourceClaim.h"
 #include "utils/gsl.h"
@@ -149,6 +152,21 @@ class ProvenanceEventRecord : public core::SerializableComponent {
   };
   static const char *ProvenanceEventTypeStr[REPLAY + 1];
 
+  /**
+   * The standard details of the events reported by the process sessions. They are formatted from the
+   * component id, the flow file UUID and attributes of the event only when they are read or serialized.
+   */
+  enum class DetailsTemplate : uint8_t {
+    // the details are the text set by setDetails
+    TEXT,
+    CREATE,
+    DROP,
+    MODIFY_ATTRIBUTE,
+    REMOVE_ATTRIBUTE,
+    MODIFY_CONTENT,
+    EXPIRE
+  };
+
   ProvenanceEventRecord(ProvenanceEventType event, std::string componentId, std::string componentType);
 
   ProvenanceEventRecord()
@@ -222,12 +240,19 @@ class ProvenanceEventRecord : public core::SerializableComponent {
     return _lineageIdentifiers;
   }
 
-  std::string getDetails() const {
-    return _details;
-  }
+  std::string getDetails() const;
 
   void setDetails(const std::string& details) {
     _details = details;
+    details_template_ = DetailsTemplate::TEXT;
+  }
+
+  /**
+   * @param attribute_key the modified or removed attribute for the MODIFY_ATTRIBUTE and REMOVE_ATTRIBUTE templates
+   */
+  void setDetails(DetailsTemplate details_template, std::string attribute_key = {}) {
+    details_template_ = details_template;
+    details_attribute_key_ = std::move(attribute_key);
   }
 
   std::string getTransitUri() {
@@ -332,10 +357,34 @@ class ProvenanceEventRecord : public core::SerializableComponent {
     }
   }
 
-  bool serialize(io::OutputStream& output_stream) override;
+  // the version of the compact layout, written after the compact record marker
+  static constexpr uint8_t COMPACT_FORMAT_VERSION = 1;
+
+  bool serialize(io::OutputStream& output_stream) override {
+    return serialize(output_stream, io::RecordFormat::COMPACT);
+  }
+  // deserialize reads the records of both formats
+  bool serialize(io::OutputStream& output_stream, io::RecordFormat format);
+  // appends the compact record to the buffer, so that a single buffer can be reused for serializing many events
+  void serialize(std::vector<std::byte>& buffer) const;
   bool deserialize(io::InputStream &input_stream) override;
   bool loadFromRepository(const std::shared_ptr<core::Repository> &repo);
 
+  // The fields the provenance repository indexes the events by
+  struct IndexedFields {
+    utils::Identifier event_id;
+    ProvenanceEventType event_type{};
+    std::chrono::system_clock::time_point event_time{};
+    std::string component_id;
+    utils::Identifier flow_file_uuid;
+  };
+
+  /**
+   * Reads only the indexed fields of a serialized event, the rest of the record is not parsed.
+   * @return std::nullopt if the stream does not contain a serialized event
+   */
+  static std::optional<IndexedFields> readIndexedFields(io::InputStream& input_stream);
+
  protected:
   ProvenanceEventType _eventType;
   // Date at which the event was created
@@ -360,11 +409,17 @@ class ProvenanceEventRecord : public core::SerializableComponent {
   std::vector<utils::Identifier> _parentUuids;
   std::vector<utils::Identifier> _childrenUuids;
   std::string _details;
+  DetailsTemplate details_template_ = DetailsTemplate::TEXT;
+  std::string details_attribute_key_;
   std::string _sourceQueueIdentifier;
   std::string _relationship;
   std::string _alternateIdentifierUri;
 
  private:
+  bool serializeLegacy(io::OutputStream& output_stream);
+  bool deserializeLegacy(io::InputStream& input_stream, uint8_t first_byte);
+  bool deserializeCompact(io::InputStream& input_stream);
+
   // Prevent default copy constructor and assignment operation
   // Only support pass by reference or pointer
   ProvenanceEventRecord(const ProvenanceEventRecord &parent);
@@ -373,13 +428,18 @@ class ProvenanceEventRecord : public core::SerializableComponent {
   static std::shared_ptr<utils::IdGenerator> id_generator_;
 };
 
+class ProvenanceSampling;
+
 class ProvenanceReporter {
  public:
-  ProvenanceReporter(std::shared_ptr<core::Repository> repo, std::string componentId, std::string componentType)
+  ProvenanceReporter(std::shared_ptr<core::Repository> repo, std::string componentId, std::string componentType,
+                     std::shared_ptr<const ProvenanceSampling> sampling = nullptr, io::RecordFormat record_format = io::RecordFormat::COMPACT)
       : logger_(core::logging::LoggerFactory<ProvenanceReporter>::getLogger()) {
     _componentId = componentId;
     _componentType = componentType;
     repo_ = repo;
+    sampling_ = std::move(sampling);
+    record_format_ = record_format;
   }
 
   virtual ~ProvenanceReporter() {
@@ -414,23 +474,21 @@ class ProvenanceReporter {
   void fork(const std::vector<std::shared_ptr<core::FlowFile>>& children, const std::shared_ptr<core::FlowFile>& parent, const std::string& detail, std::chrono::milliseconds processingDuration);
   void expire(const std::shared_ptr<core::FlowFile>& flow, const std::string& detail);
   void drop(const std::shared_ptr<core::FlowFile>& flow, const std::string& reason);
+  // the events reported by the process sessions, with the standard details formatted only when the event is serialized
+  void create(const std::shared_ptr<core::FlowFile>& flow);
+  void modifyAttribute(const std::shared_ptr<core::FlowFile>& flow, std::string_view key);
+  void removeAttribute(const std::shared_ptr<core::FlowFile>& flow, std::string_view key);
+  void modifyContent(const std::shared_ptr<core::FlowFile>& flow, std::chrono::milliseconds processingDuration);
+  void expire(const std::shared_ptr<core::FlowFile>& flow);
+  void drop(const std::shared_ptr<core::FlowFile>& flow);
   void send(const std::shared_ptr<core::FlowFile>& flow, const std::string& transitUri, const std::string& detail, std::chrono::milliseconds processingDuration, bool force);
   void fetch(const std::shared_ptr<core::FlowFile>& flow, const std::string& transitUri, const std::string& detail, std::chrono::milliseconds processingDuration);
   void receive(const std::shared_ptr<core::FlowFile>& flow, const std::string& transitUri,
     const std::string& sourceSystemFlowFileIdentifier, const std::string& detail, std::chrono::milliseconds processingDuration);
 
  protected:
-  std::shared_ptr<ProvenanceEventRecord> allocate(ProvenanceEventRecord::ProvenanceEventType eventType, const std::shared_ptr<core::FlowFile>& flow) {
-    if (repo_->isNoop()) {
-      return nullptr;
-    }
-
-    auto event = std::make_shared<ProvenanceEventRecord>(eventType, _componentId, _componentType);
-    if (event)
-      event->fromFlowFile(flow);
-
-    return event;
-  }
+  // returns nullptr if the event is not recorded, before copying anything from the flow file
+  std::shared_ptr<ProvenanceEventRecord> allocate(ProvenanceEventRecord::ProvenanceEventType eventType, const std::shared_ptr<core::FlowFile>& flow);
 
   std::string _componentId;
   std::string _componentType;
@@ -439,6 +497,10 @@ class ProvenanceReporter {
   std::shared_ptr<core::logging::Logger> logger_;
   std::set<std::shared_ptr<ProvenanceEventRecord>> _events;
   std::shared_ptr<core::Repository> repo_;
+  std::shared_ptr<const ProvenanceSampling> sampling_;
+  io::RecordFormat record_format_;
+  // the events are encoded here before being copied to their exactly sized repository buffers
+  std::vector<std::byte> serialization_buffer_;
 
   // Prevent default copy constructor and assignment operation
   // Only support pass by reference or pointer
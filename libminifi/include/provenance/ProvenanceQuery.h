@@ -0,0 +1,91 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "provenance/Provenance.h"
+#include "utils/expected.h"
+#include "utils/Id.h"
+
+namespace org::apache::nifi::minifi::provenance {
+
+/**
+ * Selects the provenance events matching all of the given criteria, newest first.
+ */
+struct ProvenanceQuery {
+  static constexpr size_t DEFAULT_MAX_RESULTS = 100;
+  // the number of candidate events looked at per requested result, before the query is truncated
+  static constexpr size_t SCANNED_EVENTS_PER_RESULT = 100;
+
+  std::optional<utils::Identifier> flow_file_uuid;
+  std::optional<std::string> component_id;
+  std::optional<ProvenanceEventRecord::ProvenanceEventType> event_type;
+  // inclusive
+  std::optional<std::chrono::system_clock::time_point> start_time;
+  // exclusive
+  std::optional<std::chrono::system_clock::time_point> end_time;
+  size_t max_results = DEFAULT_MAX_RESULTS;
+
+  /**
+   * Creates a query from the arguments of the C2 describe provenance operation, all of them are optional:
+   * flowFileUuid, componentId, eventType (e.g. SEND), startTime and endTime (RFC 3339 or milliseconds since epoch),
+   * maxAge (a time period, e.g. "5 min", it sets the start time) and maxResults.
+   */
+  static nonstd::expected<ProvenanceQuery, std::string> parse(const std::map<std::string, std::string>& arguments);
+
+  /**
+   * Creates a query from the "name=value" arguments separated by '&', used by the controller socket.
+   */
+  static nonstd::expected<ProvenanceQuery, std::string> parse(std::string_view query_string);
+
+  [[nodiscard]] bool matches(const ProvenanceEventRecord& event) const;
+
+  [[nodiscard]] size_t maxScannedEvents() const;
+};
+
+/**
+ * The events matching a query, newest first. If the repository stopped looking for matching events after
+ * ProvenanceQuery::maxScannedEvents() candidates, the result is truncated: there may be more matching events.
+ */
+struct ProvenanceQueryResult {
+  std::vector<std::shared_ptr<ProvenanceEventRecord>> events;
+  bool truncated = false;
+};
+
+/**
+ * Implemented by the provenance repositories which can answer queries without scanning the whole repository.
+ */
+class QueryableProvenanceRepository {
+ public:
+  virtual ~QueryableProvenanceRepository() = default;
+
+  virtual ProvenanceQueryResult query(const ProvenanceQuery& query) = 0;
+};
+
+/**
+ * Serializes the result into a JSON object with an "events" array and a "truncated" flag, used in the responses of the provenance queries.
+ */
+std::string toJson(const ProvenanceQueryResult& result);
+
+}  // namespace org::apache::nifi::minifi::provenance
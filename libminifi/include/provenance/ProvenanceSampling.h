@@ -0,0 +1,58 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <array>
+#include <string>
+#include <string_view>
+
+#include "provenance/Provenance.h"
+#include "properties/Configure.h"
+#include "utils/expected.h"
+
+namespace org::apache::nifi::minifi::provenance {
+
+/**
+ * The ratio of the provenance events recorded per event type, all of them are recorded by default.
+ * The events which are not sampled are not even created.
+ */
+class ProvenanceSampling {
+ public:
+  ProvenanceSampling() {
+    rates_.fill(1.0);
+  }
+
+  /**
+   * Parses a comma separated list of EVENT_TYPE:rate pairs, where the rate is between 0 and 1,
+   * e.g. "ATTRIBUTES_MODIFIED:0.01, ROUTE:0.1".
+   */
+  static nonstd::expected<ProvenanceSampling, std::string> parse(std::string_view rates);
+
+  // logs the invalid configuration and falls back to recording every event
+  static ProvenanceSampling fromConfiguration(const Configure& configuration);
+
+  [[nodiscard]] double getRate(ProvenanceEventRecord::ProvenanceEventType event_type) const {
+    return rates_.at(event_type);
+  }
+
+  [[nodiscard]] bool isSampled(ProvenanceEventRecord::ProvenanceEventType event_type) const;
+
+ private:
+  std::array<double, ProvenanceEventRecord::REPLAY + 1> rates_{};
+};
+
+}  // namespace org::apache::nifi::minifi::provenance
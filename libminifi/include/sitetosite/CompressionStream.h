@@ -0,0 +1,105 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "io/InputStream.h"
+#include "io/OutputStream.h"
+#include "core/logging/Logger.h"
+#include "utils/gsl.h"
+
+namespace org::apache::nifi::minifi::sitetosite {
+
+/**
+ * The framing of the data packets used by NiFi when the GZIP handshake property (RAW) or the
+ * x-nifi-site-to-site-use-compression header (HTTP) is set: the packet is split into chunks of at most 64 KiB,
+ * each chunk is written as "SYNC", the uncompressed size, the compressed size and the zlib deflated data.
+ * The chunks are separated by a 1 byte, the last chunk is followed by a 0 byte.
+ */
+struct CompressionFraming {
+  static constexpr std::array<uint8_t, 4> SyncBytes{'S', 'Y', 'N', 'C'};
+  static constexpr size_t ChunkSize = 64 * 1024;
+  // NiFi uses the fastest compression level, it is a good trade-off for mostly small flow files
+  static constexpr int CompressionLevel = 1;
+  static constexpr uint8_t MoreData = 1;
+  static constexpr uint8_t EndOfData = 0;
+};
+
+/**
+ * Compresses one data packet. close() writes the last chunk and the end of data marker,
+ * it does not close the underlying stream.
+ */
+class CompressionOutputStream : public io::OutputStream {
+ public:
+  explicit CompressionOutputStream(gsl::not_null<io::OutputStream*> output);
+
+  using OutputStream::write;
+  size_t write(const uint8_t* value, size_t len) override;
+
+  void close() override;
+
+  /**
+   * Writes the buffered data and the end of data marker.
+   * @return false if writing to the underlying stream failed at any point
+   */
+  bool finish();
+
+ private:
+  bool compressAndWriteChunk();
+
+  gsl::not_null<io::OutputStream*> output_;
+  std::vector<uint8_t> buffer_;
+  std::vector<uint8_t> compressed_;
+  bool chunk_written_ = false;
+  bool finished_ = false;
+  bool failed_ = false;
+  std::shared_ptr<core::logging::Logger> logger_;
+};
+
+/**
+ * Decompresses one data packet. The chunks are read on demand, the stream is finished as soon as
+ * the last chunk has been consumed, so the underlying stream is never read past the end of the packet.
+ */
+class CompressionInputStream : public io::InputStream {
+ public:
+  explicit CompressionInputStream(gsl::not_null<io::InputStream*> input);
+
+  using InputStream::read;
+  size_t read(std::span<std::byte> out_buffer) override;
+
+  [[nodiscard]] bool isFinished() const {
+    return end_of_data_ && read_position_ == buffer_.size();
+  }
+
+ private:
+  bool readChunk();
+  bool readFully(std::span<std::byte> out_buffer);
+
+  gsl::not_null<io::InputStream*> input_;
+  std::vector<uint8_t> buffer_;
+  std::vector<uint8_t> compressed_;
+  size_t read_position_ = 0;
+  bool end_of_data_ = false;
+  std::shared_ptr<core::logging::Logger> logger_;
+};
+
+}  // namespace org::apache::nifi::minifi::sitetosite
@@ -26,6 +26,7 @@
 #include <mutex>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "core/logging/LoggerFactory.h"
 #include "core/Property.h"
@@ -35,6 +36,7 @@
 #include "utils/BaseHTTPClient.h"
 #include "utils/TimeUtil.h"
 #include "io/NetworkPrioritizer.h"
+#include "sitetosite/CompressionStream.h"
 
 namespace org::apache::nifi::minifi::sitetosite {
 
@@ -113,11 +115,11 @@ class PeerStatus {
     return peer_;
   }
 
-  uint32_t getFlowFileCount() {
+  uint32_t getFlowFileCount() const {
     return flow_file_count_;
   }
 
-  bool getQueryForPeers() {
+  bool getQueryForPeers() const {
     return query_for_peers_;
   }
 
@@ -162,6 +164,7 @@ class SiteToSitePeer : public org::apache::nifi::minifi::io::BaseStream {
 
   explicit SiteToSitePeer(SiteToSitePeer &&ss)
       : stream_(ss.stream_.release()),
+        write_buffer_(std::move(ss.write_buffer_)),
         host_(std::move(ss.host_)),
         port_(std::move(ss.port_)),
         local_network_interface_(std::move(ss.local_network_interface_)),
@@ -272,11 +275,18 @@ class SiteToSitePeer : public org::apache::nifi::minifi::io::BaseStream {
   }
 
   void setStream(std::unique_ptr<org::apache::nifi::minifi::io::BaseStream> stream) {
+    // anything still buffered belongs to the transaction of the replaced stream
+    write_buffer_.clear();
+    compressor_.reset();
+    decompressor_.reset();
     stream_ = nullptr;
     if (stream)
       stream_ = std::move(stream);
   }
 
+  /**
+   * Returns the underlying stream, call flush() before using it directly.
+   */
   org::apache::nifi::minifi::io::BaseStream *getStream() {
     return stream_.get();
   }
@@ -284,13 +294,36 @@ class SiteToSitePeer : public org::apache::nifi::minifi::io::BaseStream {
   using BaseStream::write;
   using BaseStream::read;
 
-  size_t write(const uint8_t* data, size_t len) override {
-    return stream_->write(data, len);
-  }
+  /**
+   * Writes are coalesced in a buffer of WRITE_BUFFER_SIZE bytes, which is flushed when it is full, before every read, on close
+   * and by the client after the responses no reply follows to, so a data packet and its protocol frames leave in a few large writes instead of one write per field.
+   */
+  size_t write(const uint8_t* data, size_t len) override;
 
-  size_t read(std::span<std::byte> data) override {
-    return stream_->read(data);
-  }
+  size_t read(std::span<std::byte> data) override;
+
+  /**
+   * Writes the buffered data to the underlying stream.
+   * @return false if the write failed, the buffered data is dropped in that case
+   */
+  bool flush();
+
+  /**
+   * The data written until finishCompression() is sent as a single compressed data packet (see CompressionFraming).
+   */
+  void startCompression();
+
+  /**
+   * Writes the last compressed chunk of the data packet, does nothing if the compression has not been started.
+   * @return false if writing the compressed data failed
+   */
+  bool finishCompression();
+
+  /**
+   * The next data packet is read as a compressed data packet, the following reads are uncompressed again
+   * once the last chunk of the packet has been consumed.
+   */
+  void startDecompression();
 
   // open connection to the peer
   bool Open();
@@ -305,6 +338,9 @@ class SiteToSitePeer : public org::apache::nifi::minifi::io::BaseStream {
       return *this;
     }
     stream_ = std::move(other.stream_);
+    write_buffer_ = std::move(other.write_buffer_);
+    compressor_.reset();
+    decompressor_.reset();
     host_ = std::move(other.host_);
     port_ = std::move(other.port_);
     local_network_interface_ = std::move(other.local_network_interface_);
@@ -318,9 +354,43 @@ class SiteToSitePeer : public org::apache::nifi::minifi::io::BaseStream {
   SiteToSitePeer(const SiteToSitePeer &parent) = delete;
   SiteToSitePeer &operator=(const SiteToSitePeer &parent) = delete;
 
+  static constexpr size_t WRITE_BUFFER_SIZE = 64 * 1024;
+
  private:
+  /**
+   * The buffered connection without the compression layer, the compression streams write to and read from it.
+   */
+  class ConnectionStream : public org::apache::nifi::minifi::io::BaseStream {
+   public:
+    explicit ConnectionStream(SiteToSitePeer& peer) : peer_(peer) {}
+
+    using BaseStream::write;
+    using BaseStream::read;
+
+    size_t write(const uint8_t* data, size_t len) override {
+      return peer_.writeToConnection(data, len);
+    }
+
+    size_t read(std::span<std::byte> data) override {
+      return peer_.stream_->read(data);
+    }
+
+   private:
+    SiteToSitePeer& peer_;
+  };
+
+  size_t writeToConnection(const uint8_t* data, size_t len);
+
   std::unique_ptr<org::apache::nifi::minifi::io::BaseStream> stream_;
 
+  std::vector<uint8_t> write_buffer_;
+
+  ConnectionStream connection_stream_{*this};
+
+  std::unique_ptr<CompressionOutputStream> compressor_;
+
+  std::unique_ptr<CompressionInputStream> decompressor_;
+
   std::string host_;
 
   uint16_t port_;
@@ -0,0 +1,72 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Peer.h"
+#include "SiteToSite.h"
+
+namespace org::apache::nifi::minifi::sitetosite {
+
+/**
+ * Selects the peer of the next transaction based on the flow file counts reported in the peer list,
+ * the same way NiFi's PeerSelector does: when sending, the peers with fewer queued flow files are
+ * preferred, when receiving, the peers with more queued flow files are preferred.
+ * Not thread safe, the users are expected to synchronize the access.
+ */
+class PeerSelector {
+ public:
+  void setPeers(std::vector<PeerStatus> peers, TransferDirection direction);
+
+  [[nodiscard]] const std::vector<PeerStatus>& getPeers() const {
+    return peers_;
+  }
+
+  [[nodiscard]] bool empty() const {
+    return peers_.empty();
+  }
+
+  /**
+   * @return a randomly selected peer, each peer is selected with the probability of its weight,
+   * or std::nullopt if there are no peers
+   */
+  std::optional<PeerStatus> selectPeer();
+
+  /**
+   * Calculates the probability of selecting each peer, the weights add up to 1.
+   */
+  static std::vector<double> calculateWeights(const std::vector<PeerStatus>& peers, TransferDirection direction);
+
+  /**
+   * The key identifying the connections to the same peer.
+   */
+  static std::string getPeerKey(const std::string& host, uint16_t port) {
+    return host + ":" + std::to_string(port);
+  }
+
+ private:
+  std::vector<PeerStatus> peers_;
+  std::discrete_distribution<size_t> distribution_;
+  std::mt19937 generator_{std::random_device{}()};
+};
+
+}  // namespace org::apache::nifi::minifi::sitetosite
@@ -140,6 +140,17 @@ class SiteToSiteClient : public core::Connectable {
      idle_timeout_ = timeout;
   }
 
+  /**
+   * Sets whether the data packets are compressed, the peer is asked for it during the handshake.
+   */
+  void setUseCompression(bool use_compression) {
+    use_compression_ = use_compression;
+  }
+
+  bool getUseCompression() const {
+    return use_compression_;
+  }
+
   /**
    * Sets the base peer for this interface.
    */
@@ -147,6 +158,13 @@ class SiteToSiteClient : public core::Connectable {
     peer_ = std::move(peer);
   }
 
+  /**
+   * Provides the peer of this client, the client is bound to it for its lifetime.
+   */
+  SiteToSitePeer* getPeer() const {
+    return peer_.get();
+  }
+
   /**
    * Provides a reference to the port identifier
    * @returns port identifier
@@ -234,6 +252,9 @@ class SiteToSiteClient : public core::Connectable {
   // idleTimeout
   std::chrono::milliseconds idle_timeout_{15000};
 
+  // whether the data packets are compressed
+  bool use_compression_{false};
+
   // Peer Connection
   std::unique_ptr<SiteToSitePeer> peer_;
 
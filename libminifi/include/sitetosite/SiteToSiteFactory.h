@@ -53,6 +53,7 @@ static std::unique_ptr<SiteToSiteClient> createRawSocket(const SiteToSiteClientC
   auto ptr = std::unique_ptr<SiteToSiteClient>(new RawSiteToSiteClient(std::move(rsptr)));
   ptr->setPortId(uuid);
   ptr->setSSLContextService(client_configuration.getSecurityContext());
+  ptr->setUseCompression(client_configuration.getUseCompression());
   return ptr;
 }
 
@@ -79,6 +80,7 @@ static std::unique_ptr<SiteToSiteClient> createClient(const SiteToSiteClientConf
         ptr->setPortId(uuid);
         ptr->setPeer(std::move(peer));
         ptr->setIdleTimeout(client_configuration.getIdleTimeout());
+        ptr->setUseCompression(client_configuration.getUseCompression());
         return ptr;
       }
       return nullptr;
@@ -0,0 +1,86 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <utility>
+
+namespace org::apache::nifi::minifi::utils {
+
+/**
+ * A value which is shared between copies until one of them is modified.
+ *
+ * Copying a CopyOnWrite only copies a reference to the (immutable) shared value, mutate() makes a private copy
+ * of the value first if it is shared with another CopyOnWrite. An empty value is not allocated at all.
+ *
+ * The shared value is only read concurrently, but a single CopyOnWrite object must not be used from multiple
+ * threads without synchronization, just like the value it wraps.
+ */
+template<typename T>
+class CopyOnWrite {
+ public:
+  CopyOnWrite() = default;
+
+  explicit CopyOnWrite(T value)
+      : value_(std::make_shared<T>(std::move(value))) {
+  }
+
+  [[nodiscard]] const T& get() const {
+    return value_ ? *value_ : empty();
+  }
+
+  const T& operator*() const {
+    return get();
+  }
+
+  const T* operator->() const {
+    return &get();
+  }
+
+  /**
+   * Returns a reference to the value which is not shared with any other CopyOnWrite object.
+   * The reference is only valid until this object is copied or assigned to.
+   */
+  T& mutate() {
+    if (!value_) {
+      value_ = std::make_shared<T>();
+    } else if (value_.use_count() > 1) {
+      value_ = std::make_shared<T>(std::as_const(*value_));
+    }
+    return *value_;
+  }
+
+  void set(T value) {
+    value_ = std::make_shared<T>(std::move(value));
+  }
+
+  [[nodiscard]] bool isSharedWith(const CopyOnWrite& other) const {
+    return value_ && value_ == other.value_;
+  }
+
+ private:
+  static const T& empty() {
+    static const T empty_value{};
+    return empty_value;
+  }
+
+  std::shared_ptr<T> value_;
+};
+
+}  // namespace org::apache::nifi::minifi::utils
@@ -0,0 +1,109 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <deque>
+#include <functional>
+#include <utility>
+
+#include "utils/MinMaxHeap.h"
+
+namespace org::apache::nifi::minifi::utils {
+
+/**
+ * A MinMaxHeap for items that are mostly pushed in non-decreasing order.
+ * Items pushed with pushBack are appended to a FIFO in constant time as long as they do not compare
+ * less than its last item, every other item goes into a MinMaxHeap. The minimum and the maximum are
+ * then found by comparing the ends of the FIFO to the ends of the heap.
+ */
+template<typename T, typename Comparator = std::less<T>>
+class FifoMinMaxHeap {
+ public:
+  FifoMinMaxHeap() = default;
+
+  explicit FifoMinMaxHeap(Comparator comparator)
+      : heap_(comparator),
+        comparator_(std::move(comparator)) {}
+
+  void clear() {
+    fifo_.clear();
+    heap_.clear();
+  }
+
+  const T& min() const {
+    return minInFifo() ? fifo_.front() : heap_.min();
+  }
+
+  const T& max() const {
+    return maxInFifo() ? fifo_.back() : heap_.max();
+  }
+
+  size_t size() const {
+    return fifo_.size() + heap_.size();
+  }
+
+  bool empty() const {
+    return fifo_.empty() && heap_.empty();
+  }
+
+  void push(T item) {
+    heap_.push(std::move(item));
+  }
+
+  void pushBack(T item) {
+    if (fifo_.empty() || !comparator_(item, fifo_.back())) {
+      fifo_.push_back(std::move(item));
+    } else {
+      heap_.push(std::move(item));
+    }
+  }
+
+  T popMin() {
+    if (minInFifo()) {
+      T min = std::move(fifo_.front());
+      fifo_.pop_front();
+      return min;
+    }
+    return heap_.popMin();
+  }
+
+  T popMax() {
+    if (maxInFifo()) {
+      T max = std::move(fifo_.back());
+      fifo_.pop_back();
+      return max;
+    }
+    return heap_.popMax();
+  }
+
+ private:
+  // on equal items the FIFO is preferred to keep the insertion order
+  bool minInFifo() const {
+    return !fifo_.empty() && (heap_.empty() || !comparator_(heap_.min(), fifo_.front()));
+  }
+
+  bool maxInFifo() const {
+    return !fifo_.empty() && (heap_.empty() || !comparator_(fifo_.back(), heap_.max()));
+  }
+
+  std::deque<T> fifo_;
+  MinMaxHeap<T, Comparator> heap_;
+  Comparator comparator_;
+};
+
+}  // namespace org::apache::nifi::minifi::utils
@@ -213,6 +213,18 @@ class FlatMap{
     return {iterator{data_.begin() + data_.size() - 1}, true};
   }
 
+  // like insert, but the key is only constructed if it is not in the map yet
+  template<typename T, typename... Args>
+  requires std::constructible_from<K, const T&> && std::equality_comparable_with<K, T>
+  std::pair<iterator, bool> try_emplace(const T& key, Args&&... args) {
+    auto it = find(key);
+    if (it != end()) {
+      return {it, false};
+    }
+    data_.emplace_back(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+    return {iterator{data_.begin() + data_.size() - 1}, true};
+  }
+
   template<std::equality_comparable_with<K> T>
   iterator find(const T& key) {
     for (auto it = data_.begin(); it != data_.end(); ++it) {
@@ -17,11 +17,14 @@
 #pragma once
 
 #include <memory>
+#include <unordered_set>
 #include <vector>
 #include <algorithm>
 #include <utility>
 
 #include "core/FlowFile.h"
+#include "core/FlowFilePrioritizer.h"
+#include "FifoMinMaxHeap.h"
 #include "MinMaxHeap.h"
 #include "SwapManager.h"
 #include "TimeUtil.h"
@@ -51,6 +54,20 @@ class FlowFileQueue {
   void setMinSize(size_t min_size);
   void setTargetSize(size_t target_size);
   void setMaxSize(size_t max_size);
+  // the memory based thresholds limit the estimated memory usage of the in-memory flow files (see FlowFile::getEstimatedMemoryUsage)
+  void setMinMemorySize(uint64_t min_memory_size);
+  void setTargetMemorySize(uint64_t target_memory_size);
+  void setMaxMemorySize(uint64_t max_memory_size);
+  /**
+   * Orders the flow files by the given prioritizer instead of their penalty expiration.
+   * Penalized flow files are then held back (and never swapped out) until their penalty expires.
+   * Can only be changed while the queue is empty.
+   */
+  void setPrioritizer(std::shared_ptr<core::FlowFilePrioritizer> prioritizer);
+  // the number of swapped out flow files, including the ones being swapped in
+  size_t swappedCount() const;
+  // the estimated memory usage of the swapped out flow files, had they been kept in memory
+  uint64_t swappedMemorySize() const;
   void clear();
 
  private:
@@ -58,17 +75,46 @@ class FlowFileQueue {
 
   void initiateLoadIfNeeded();
 
+  // the position of a flow file in the queue: flow files are ordered by their priority key,
+  // then by their penalty expiration (which is the time they were pushed, unless they were penalized)
+  struct Order {
+    int64_t priority_key;
+    TimePoint to_be_processed_after;
+
+    auto operator<=>(const Order&) const = default;
+  };
+
+  Order orderOf(const core::FlowFile& flow_file) const;
+
+  static Order orderOf(const SwappedFlowFile& flow_file) {
+    return {flow_file.priority_key, flow_file.to_be_processed_after};
+  }
+
+  void enqueue(value_type element, bool penalized);
+
+  void pushToQueue(value_type element, Order order, bool penalized);
+  value_type popMinFromQueue();
+  value_type popMaxFromQueue();
+
+  void initiateStore(std::vector<value_type> flow_files);
+  // collects the finished store tasks, never waits for the pending ones
+  void processFinishedStoreTasks();
+
+  // moves the penalized flow files whose penalty has expired to the queue, only used with a prioritizer
+  void releasePenalizedFlowFiles();
+
   struct LoadTask {
-    TimePoint min;
-    TimePoint max;
+    Order min;
+    Order max;
     std::future<std::vector<std::shared_ptr<core::FlowFile>>> items;
     size_t count;
+    uint64_t memory_size;
     // flow files that have been pushed into the queue while a
     // load was pending
     std::vector<value_type> intermediate_items;
 
-    LoadTask(TimePoint min, TimePoint max, std::future<std::vector<std::shared_ptr<core::FlowFile>>> items, size_t count)
-      : min(min), max(max), items(std::move(items)), count(count) {}
+    LoadTask(Order min, Order max, std::future<std::vector<std::shared_ptr<core::FlowFile>>> items, size_t count, uint64_t memory_size)
+      : min(min), max(max), items(std::move(items)), count(count), memory_size(memory_size) {}
 
     size_t size() const {
       return count + intermediate_items.size();
@@ -77,17 +123,41 @@ class FlowFileQueue {
 
   bool processLoadTaskWait(std::optional<std::chrono::milliseconds> timeout);
 
+  struct StoreTask {
+    std::future<void> done;
+    std::vector<utils::Identifier> ids;
+
+    StoreTask(std::future<void> done, std::vector<utils::Identifier> ids)
+      : done(std::move(done)), ids(std::move(ids)) {}
+  };
+
   struct FlowFilePenaltyExpirationComparator {
     bool operator()(const value_type& left, const value_type& right) const;
   };
 
+  // the order is computed once, when the flow file enters queue_, so the heap operations do not call the prioritizer
+  // the memory size is the estimate added to queued_memory_size_, the estimate of the flow file may change while it is queued
+  struct QueuedFlowFile {
+    Order order;
+    value_type flow_file;
+    uint64_t memory_size;
+  };
+
+  struct QueuedFlowFileComparator {
+    bool operator()(const QueuedFlowFile& left, const QueuedFlowFile& right) const;
+  };
+
   struct SwappedFlowFileComparator {
     bool operator()(const SwappedFlowFile& left, const SwappedFlowFile& right) const;
   };
 
-  size_t shouldSwapOutCount() const;
+  bool shouldSwapOut() const;
+
+  bool isAboveSwapOutTarget() const;
+
+  bool shouldSwapIn() const;
 
-  size_t shouldSwapInCount() const;
+  bool isBelowSwapInTarget(size_t count, uint64_t memory_size) const;
 
   std::shared_ptr<SwapManager> swap_manager_;
   // a load is initiated if the queue_ shrinks below this threshold
@@ -96,11 +166,28 @@ class FlowFileQueue {
   std::atomic<size_t> target_size_{0};
   // a store is initiated if the queue_ grows beyond this threshold
   std::atomic<size_t> max_size_{0};
+  // the same thresholds for the estimated memory usage of the flow files in queue_
+  std::atomic<uint64_t> min_memory_size_{0};
+  std::atomic<uint64_t> target_memory_size_{0};
+  std::atomic<uint64_t> max_memory_size_{0};
 
   MinMaxHeap<SwappedFlowFile, SwappedFlowFileComparator> swapped_flow_files_;
+  uint64_t swapped_memory_size_{0};
   // the pending swap-in operation (if any)
   std::optional<LoadTask> load_task_;
-  MinMaxHeap<value_type, FlowFilePenaltyExpirationComparator> queue_;
+  // the pending swap-out operations, the swapped flow files are already in swapped_flow_files_
+  std::vector<StoreTask> store_tasks_;
+  // the swapped flow files whose store task has not finished yet, these cannot be loaded
+  std::unordered_set<utils::Identifier> pending_store_ids_;
+  // flow files that are not penalized when pushed have the current time as penalty expiration,
+  // so they arrive in order and are kept in a FIFO, only the penalized ones go into the heap
+  // (or the ones pushed out of order according to the prioritizer)
+  FifoMinMaxHeap<QueuedFlowFile, QueuedFlowFileComparator> queue_;
+  uint64_t queued_memory_size_{0};
+
+  std::shared_ptr<core::FlowFilePrioritizer> prioritizer_;
+  // with a prioritizer, the penalized flow files wait here instead of blocking the head of queue_
+  MinMaxHeap<value_type, FlowFilePenaltyExpirationComparator> penalized_flow_files_;
 
   std::shared_ptr<timeutils::SteadyClock> clock_{timeutils::getClock()};
 
@@ -19,6 +19,9 @@
 #pragma once
 
 #include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
 
 namespace org::apache::nifi::minifi::utils {
 
@@ -27,4 +30,13 @@ inline size_t hash_combine(size_t seed, size_t new_hash) noexcept {
   return seed ^ (new_hash + 0x9e3779b9 + (seed << 6U) + (seed >> 2U));
 }
 
+// allows looking up std::string keys by std::string_view without creating a std::string, use it with std::equal_to<>
+struct TransparentStringHash {
+  using is_transparent = void;
+
+  size_t operator()(std::string_view str) const noexcept {
+    return std::hash<std::string_view>{}(str);
+  }
+};
+
 }  // namespace org::apache::nifi::minifi::utils
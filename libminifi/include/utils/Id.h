@@ -71,6 +71,11 @@ class Identifier {
 
   bool isNil() const;
 
+  // the raw bytes, used by the binary record encodings
+  const Data& getData() const {
+    return data_;
+  }
+
   // Numerous places query the string representation
   // just to then forward the temporary to build logs,
   // streams, or others. Dynamically allocating in these
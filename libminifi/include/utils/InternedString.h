@@ -0,0 +1,118 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+#include "fmt/format.h"
+
+namespace org::apache::nifi::minifi::utils {
+
+/**
+ * An immutable string which shares its storage with every other InternedString of the same value.
+ *
+ * The strings are looked up in a global, sharded table, so that e.g. the attribute keys of the flow files are only stored once.
+ * The entries of the table are never removed, so copying an InternedString of the table does not need reference counting.
+ * The table has a fixed capacity, values which do not fit are stored separately, in the InternedString (and its copies) only.
+ * The empty string is not looked up in the table.
+ */
+class InternedString {
+ public:
+  static constexpr size_t MAX_INTERNED_STRING_COUNT = 4096;
+
+  InternedString();
+  explicit InternedString(std::string_view value);
+
+  [[nodiscard]] const std::string& str() const noexcept {
+    return *value_;
+  }
+
+  operator const std::string&() const noexcept {  // NOLINT
+    return *value_;
+  }
+
+  operator std::string_view() const noexcept {  // NOLINT
+    return *value_;
+  }
+
+  [[nodiscard]] const char* data() const noexcept {
+    return value_->data();
+  }
+
+  [[nodiscard]] const char* c_str() const noexcept {
+    return value_->c_str();
+  }
+
+  [[nodiscard]] size_t size() const noexcept {
+    return value_->size();
+  }
+
+  [[nodiscard]] size_t length() const noexcept {
+    return value_->length();
+  }
+
+  [[nodiscard]] bool empty() const noexcept {
+    return value_->empty();
+  }
+
+  friend bool operator==(const InternedString& lhs, const InternedString& rhs) noexcept {
+    return lhs.value_ == rhs.value_ || *lhs.value_ == *rhs.value_;
+  }
+
+  friend bool operator==(const InternedString& lhs, std::string_view rhs) noexcept {
+    return *lhs.value_ == rhs;
+  }
+
+  friend bool operator<(const InternedString& lhs, const InternedString& rhs) noexcept {
+    return *lhs.value_ < *rhs.value_;
+  }
+
+  friend std::ostream& operator<<(std::ostream& out, const InternedString& str) {
+    return out << *str.value_;
+  }
+
+  /**
+   * Returns the number of strings in the global table
+   */
+  static size_t getInternedStringCount();
+
+ private:
+  std::shared_ptr<const std::string> value_;
+};
+
+}  // namespace org::apache::nifi::minifi::utils
+
+template<>
+struct std::hash<org::apache::nifi::minifi::utils::InternedString> {
+  size_t operator()(const org::apache::nifi::minifi::utils::InternedString& str) const noexcept {
+    return std::hash<std::string_view>{}(str);
+  }
+};
+
+template<>
+struct fmt::formatter<org::apache::nifi::minifi::utils::InternedString> : fmt::formatter<std::string_view> {
+  template<typename FormatContext>
+  auto format(const org::apache::nifi::minifi::utils::InternedString& str, FormatContext& ctx) const {
+    return fmt::formatter<std::string_view>::format(std::string_view{str}, ctx);
+  }
+};
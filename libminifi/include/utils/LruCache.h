@@ -0,0 +1,103 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+#include "utils/gsl.h"
+
+namespace org::apache::nifi::minifi::utils {
+
+/**
+ * A map with a bounded number of entries: when it is full, inserting a new entry evicts the least recently used one.
+ * Not synchronized.
+ */
+template<typename Key, typename Value, typename Hash = std::hash<Key>>
+class LruCache {
+ public:
+  explicit LruCache(size_t capacity)
+      : capacity_(capacity) {
+    gsl_Expects(capacity_ > 0);
+  }
+
+  /**
+   * Returns the value for the key, and marks it as the most recently used one
+   * @return pointer to the value, or nullptr if the key is not in the cache
+   */
+  Value* get(const Key& key) {
+    const auto it = index_.find(key);
+    if (it == index_.end()) {
+      return nullptr;
+    }
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return &it->second->second;
+  }
+
+  /**
+   * Returns the value for the key, creating it with the factory and inserting it as the most recently used entry if it is not in the cache.
+   * The factory may throw, then the cache is not changed.
+   */
+  template<typename Factory>
+  Value& getOrCreate(const Key& key, Factory&& factory) {
+    if (auto* value = get(key)) {
+      return *value;
+    }
+    return put(key, std::invoke(std::forward<Factory>(factory)));
+  }
+
+  Value& put(const Key& key, Value value) {
+    if (const auto it = index_.find(key); it != index_.end()) {
+      it->second->second = std::move(value);
+      entries_.splice(entries_.begin(), entries_, it->second);
+      return it->second->second;
+    }
+    if (entries_.size() >= capacity_) {
+      index_.erase(entries_.back().first);
+      entries_.pop_back();
+    }
+    entries_.emplace_front(key, std::move(value));
+    index_.emplace(key, entries_.begin());
+    return entries_.front().second;
+  }
+
+  [[nodiscard]] size_t size() const {
+    return entries_.size();
+  }
+
+  [[nodiscard]] size_t capacity() const {
+    return capacity_;
+  }
+
+  void clear() {
+    index_.clear();
+    entries_.clear();
+  }
+
+ private:
+  using Entries = std::list<std::pair<Key, Value>>;
+
+  size_t capacity_;
+  // most recently used first
+  Entries entries_;
+  std::unordered_map<Key, typename Entries::iterator, Hash> index_;
+};
+
+}  // namespace org::apache::nifi::minifi::utils
@@ -31,6 +31,11 @@ namespace org::apache::nifi::minifi::utils {
 template<typename T, typename Comparator = std::less<T>>
 class MinMaxHeap {
  public:
+  MinMaxHeap() = default;
+
+  explicit MinMaxHeap(Comparator comparator)
+      : data_(std::move(comparator)) {}
+
   void clear() {
     data_.clear();
   }
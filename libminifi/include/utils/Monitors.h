@@ -25,8 +25,8 @@ namespace org::apache::nifi::minifi::utils {
 
 class TaskRescheduleInfo {
  public:
-  TaskRescheduleInfo(bool result, std::chrono::steady_clock::time_point next_execution_time)
-    : next_execution_time_(next_execution_time), finished_(result) {}
+  TaskRescheduleInfo(bool result, std::chrono::steady_clock::time_point next_execution_time, bool wait_for_notification = false)
+    : next_execution_time_(next_execution_time), finished_(result), wait_for_notification_(wait_for_notification) {}
 
   static TaskRescheduleInfo Done() {
     return {true, std::chrono::steady_clock::time_point::min()};
@@ -44,6 +44,13 @@ class TaskRescheduleInfo {
     return {false, std::chrono::steady_clock::time_point::min()};
   }
 
+  /**
+   * The task is not run again until it is woken up by the notifier of the thread pool, see ThreadPool::createNotifier
+   */
+  static TaskRescheduleInfo RetryWhenNotified() {
+    return {false, std::chrono::steady_clock::time_point::max(), true};
+  }
+
   [[nodiscard]] std::chrono::steady_clock::time_point getNextExecutionTime() const {
     return next_execution_time_;
   }
@@ -52,9 +59,14 @@ class TaskRescheduleInfo {
     return finished_;
   }
 
+  [[nodiscard]] bool isWaitingForNotification() const {
+    return wait_for_notification_;
+  }
+
  private:
   std::chrono::steady_clock::time_point next_execution_time_;
   bool finished_;
+  bool wait_for_notification_;
 };
 
 
@@ -17,8 +17,10 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <optional>
 #include <system_error>
+#include <vector>
 
 struct sockaddr;
 
@@ -56,4 +58,17 @@ extern std::string resolve_common_identifiers(const std::string &id);
 std::optional<std::string> getHostName();
 std::optional<double> getSystemLoadAverage();
 
+/// Parses a list of CPU numbers and ranges in the format of the Linux cpuset lists, e.g. "0-3,8,10-11"
+/// Returns the sorted, unique CPU numbers, or nullopt if the list is invalid
+std::optional<std::vector<unsigned>> parseCpuList(std::string_view cpu_list);
+
+/// Returns the CPUs of a NUMA node, or an empty list if the node does not exist or NUMA is not supported on this platform
+std::vector<unsigned> getNumaNodeCpus(unsigned numa_node);
+
+/// Restricts the current thread to the given CPUs, returns false if it is not possible or not supported on this platform
+bool setCurrentThreadCpuAffinity(const std::vector<unsigned>& cpus);
+
+/// Restricts the memory allocations of the current thread to the given NUMA node, returns false if it is not possible or not supported on this platform
+bool setCurrentThreadMemoryNode(unsigned numa_node);
+
 }  // namespace org::apache::nifi::minifi::utils::OsUtils
@@ -0,0 +1,50 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <vector>
+
+#include "io/OutputStream.h"
+#include "utils/Literals.h"
+
+namespace org::apache::nifi::minifi::utils {
+
+struct ParallelRangedFetchSettings {
+  // 1 fetches the ranges one after the other
+  uint64_t max_concurrent_ranges = 1;
+  uint64_t range_size = 8_MiB;
+};
+
+/**
+ * Fetches the byte range [offset, offset + length) of the object, returns std::nullopt on failure.
+ * It is called from several threads at the same time.
+ */
+using RangeFetcher = std::function<std::optional<std::vector<std::byte>>(uint64_t offset, uint64_t length)>;
+
+/**
+ * Splits an object of object_size bytes into ranges of settings.range_size bytes, fetches at most
+ * settings.max_concurrent_ranges of them at the same time and writes them to the output in order.
+ * At most max_concurrent_ranges ranges are held in memory, independently of the size of the object.
+ * @return the number of bytes written, or std::nullopt if fetching or writing any of the ranges failed
+ */
+std::optional<uint64_t> parallelRangedFetch(uint64_t object_size, const ParallelRangedFetchSettings& settings, const RangeFetcher& fetch_range, io::OutputStream& output);
+
+}  // namespace org::apache::nifi::minifi::utils
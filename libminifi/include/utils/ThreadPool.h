@@ -19,13 +19,14 @@
 #include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <functional>
 #include <future>
 #include <iostream>
-#include <map>
 #include <memory>
 #include <mutex>
-#include <queue>
+#include <optional>
 #include <sstream>
 #include <string>
 #include <thread>
@@ -36,6 +37,7 @@
 #include "BackTrace.h"
 #include "MinifiConcurrentQueue.h"
 #include "Monitors.h"
+#include "TimerWheel.h"
 #include "core/expect.h"
 #include "controllers/ThreadManagementService.h"
 #include "core/controller/ControllerService.h"
@@ -86,6 +88,7 @@ class Worker {
     }
 
     next_exec_time_ = result.getNextExecutionTime();
+    wait_for_notification_ = result.isWaitingForNotification();
     return true;
   }
 
@@ -93,6 +96,10 @@ class Worker {
     return next_exec_time_;
   }
 
+  [[nodiscard]] bool isWaitingForNotification() const {
+    return wait_for_notification_;
+  }
+
   [[nodiscard]] std::shared_ptr<std::promise<TaskRescheduleInfo>> getPromise() const { return promise; }
 
   [[nodiscard]] const TaskId &getIdentifier() const {
@@ -102,17 +109,11 @@ class Worker {
  protected:
   TaskId identifier_;
   std::chrono::steady_clock::time_point next_exec_time_;
+  bool wait_for_notification_ = false;
   std::function<TaskRescheduleInfo()> task;
   std::shared_ptr<std::promise<TaskRescheduleInfo>> promise;
 };
 
-class DelayedTaskComparator {
- public:
-  bool operator()(Worker &a, Worker &b) {
-    return a.getNextExecutionTime() > b.getNextExecutionTime();
-  }
-};
-
 class WorkerThread {
  public:
   explicit WorkerThread(std::thread thread, const std::string &name = "NamelessWorker")
@@ -125,6 +126,8 @@ class WorkerThread {
         name_(name) {
   }
   std::atomic<bool> is_running_;
+  // the start of the running task, or of the part of its run which has not been added to the busy time of the pool yet; 0 if no task is running
+  std::atomic<std::chrono::steady_clock::duration::rep> task_run_start_{0};
   std::thread thread_;
   std::string name_;
 };
@@ -133,7 +136,9 @@ class WorkerThread {
  * Thread pool
  * Purpose: Provides a thread pool with basic functionality similar to
  * ThreadPoolExecutor
- * Design: Locked control over a manager thread that controls the worker threads
+ * Design: Locked control over a manager thread that controls the worker threads.
+ * Every worker thread has its own run queue, and steals tasks from the other queues when its own is empty.
+ * Tasks to be run later wait in a timer wheel, which is managed by the delayed scheduler thread.
  */
 class ThreadPool {
  public:
@@ -179,21 +184,28 @@ class ThreadPool {
    * Returns true if a task is running.
    */
   bool isTaskRunning(const TaskId &identifier) {
-    std::unique_lock<std::mutex> lock(worker_queue_mutex_);
-    const auto iter = task_status_.find(identifier);
-    if (iter == task_status_.end())
+    std::lock_guard<std::mutex> lock(task_states_mutex_);
+    const auto iter = task_states_.find(identifier);
+    if (iter == task_states_.end())
       return false;
-    return iter->second;
+    return iter->second->enabled;
   }
 
   bool isRunning() const {
     return running_.load();
   }
 
+  /**
+   * Returns a function which wakes up a task with the provided identifier that is waiting for a notification
+   * (see TaskRescheduleInfo::RetryWhenNotified). If none of them is waiting, the next one to wait is run again immediately.
+   * The function can be called from any thread, and outlive the thread pool.
+   */
+  std::function<void()> createNotifier(const TaskId &identifier);
+
   std::vector<BackTrace> getTraces() {
     std::vector<BackTrace> traces;
     std::lock_guard<std::recursive_mutex> lock(manager_mutex_);
-    std::unique_lock<std::mutex> wlock(worker_queue_mutex_);
+    std::unique_lock<std::mutex> wlock(thread_queue_mutex_);
     // while we may be checking if running, we don't want to
     // use the threads outside of the manager mutex's lock -- therefore we will
     // obtain a lock so we can keep the threads in memory
@@ -231,6 +243,34 @@ class ThreadPool {
       start();
   }
 
+  /**
+   * Restricts the worker threads to the given CPUs, an empty list lets them run on any CPU.
+   * If a NUMA node is given, the memory allocations of the worker threads are also bound to it.
+   * Like setMaxConcurrentTasks, it restarts the thread pool if it is running.
+   */
+  void setAffinity(std::vector<unsigned> cpus, std::optional<unsigned> numa_node = std::nullopt) {
+    std::lock_guard<std::recursive_mutex> lock(manager_mutex_);
+    bool was_running = running_;
+    if (was_running) {
+      shutdown();
+    }
+    cpu_affinity_ = std::move(cpus);
+    numa_node_ = numa_node;
+    if (was_running)
+      start();
+  }
+
+  int getMaxConcurrentTasks() const {
+    return max_worker_threads_;
+  }
+
+  /**
+   * Returns the ratio of the time the worker threads spent running tasks and the time they were available, between 0 and 1.
+   * It is measured since the previous call, but calls less than a second apart return the previous measurement,
+   * so that multiple metrics consumers see consistent values.
+   */
+  double getUtilization();
+
   void setControllerServiceProvider(core::controller::ControllerServiceProvider* controller_service_provider) {
     std::lock_guard<std::recursive_mutex> lock(manager_mutex_);
     bool was_running = running_;
@@ -246,6 +286,39 @@ class ThreadPool {
   std::shared_ptr<controllers::ThreadManagementService> createThreadManager() const;
 
  protected:
+  struct ScheduledTask;
+
+  /**
+   * State shared by the workers of a TaskId, so that running a task does not need to look up its identifier.
+   * stopTasks() starts a new generation, the workers of the earlier generations are dropped instead of being run.
+   */
+  struct TaskState {
+    std::atomic<bool> enabled{false};
+    std::atomic<uint64_t> generation{0};
+    std::atomic<uint32_t> running_count{0};
+
+    // tasks waiting for a notification, and the pool they are woken up into, which is reset on shutdown
+    std::mutex parked_tasks_mutex;
+    std::vector<ScheduledTask> parked_tasks;
+    bool notified = false;
+    ThreadPool* pool = nullptr;
+  };
+
+  struct ScheduledTask {
+    Worker worker;
+    std::shared_ptr<TaskState> state;
+    uint64_t generation = 0;
+
+    [[nodiscard]] bool isCurrent() const {
+      return state->generation == generation;
+    }
+  };
+
+  struct RunQueue {
+    std::mutex mutex;
+    std::deque<ScheduledTask> tasks;
+  };
+
   std::thread createThread(std::function<void()> &&functor) {
     return std::thread([ functor ]() mutable {
       functor();
@@ -256,11 +329,14 @@ class ThreadPool {
    * Drain will notify tasks to stop following notification
    */
   void drain() {
-    worker_queue_.stop();
+    {
+      std::lock_guard<std::mutex> lock(work_available_mutex_);
+      work_available_.notify_all();
+    }
     while (current_workers_ > 0) {
       // The sleeping workers were waken up and stopped, but we have to wait
-      // the ones that actually worked on something when the queue was stopped.
-      // Stopping the queue guarantees that they don't get any new task.
+      // the ones that actually worked on something when the pool was stopped.
+      // Stopping the pool guarantees that they don't get any new task.
       std::this_thread::sleep_for(std::chrono::milliseconds(1));
     }
   }
@@ -269,29 +345,59 @@ class ThreadPool {
   int max_worker_threads_;
   std::atomic<int> current_workers_;
   std::vector<std::shared_ptr<WorkerThread>> thread_queue_;
+  std::mutex thread_queue_mutex_;
   std::thread manager_thread_;
   std::thread delayed_scheduler_thread_;
   std::atomic<bool> adjust_threads_;
   std::atomic<bool> running_;
+  std::atomic<bool> paused_;
   core::controller::ControllerServiceProvider* controller_service_provider_;
   std::shared_ptr<controllers::ThreadManagementService> thread_manager_;
   ConcurrentQueue<std::shared_ptr<WorkerThread>> deceased_thread_queue_;
-  ConditionConcurrentQueue<Worker> worker_queue_;
-  std::priority_queue<Worker, std::vector<Worker>, DelayedTaskComparator> delayed_worker_queue_;
-  std::mutex worker_queue_mutex_;
+
+  // one per worker thread, resized only by start(), when there are no worker threads
+  std::vector<std::unique_ptr<RunQueue>> run_queues_;
+  std::atomic<size_t> next_run_queue_;
+  std::atomic<size_t> queued_task_count_;
+  std::atomic<size_t> sleeping_worker_count_;
+  std::mutex work_available_mutex_;
+  std::condition_variable work_available_;
+
+  TimerWheel<ScheduledTask> delayed_tasks_;
+  std::mutex delayed_tasks_mutex_;
   std::condition_variable delayed_task_available_;
-  std::map<TaskId, bool> task_status_;
+
+  std::unordered_map<TaskId, std::shared_ptr<TaskState>> task_states_;
+  std::mutex task_states_mutex_;
+  std::mutex task_run_complete_mutex_;
+  std::condition_variable task_run_complete_;
+
   std::recursive_mutex manager_mutex_;
   std::string name_;
-  std::unordered_map<TaskId, uint32_t> running_task_count_by_id_;
-  std::condition_variable task_run_complete_;
+  std::vector<unsigned> cpu_affinity_;
+  std::optional<unsigned> numa_node_;
+
+  // total time spent running tasks, and its value at the previous utilization query
+  // the time of a running task is added when it completes, or up to the query when the utilization is queried
+  std::atomic<std::chrono::steady_clock::duration::rep> busy_time_{0};
+  std::mutex utilization_mutex_;
+  std::chrono::steady_clock::time_point utilization_collection_start_ = std::chrono::steady_clock::now();
+  std::chrono::steady_clock::duration::rep utilization_collection_start_busy_time_ = 0;
+  double last_utilization_ = 0.0;
 
   std::shared_ptr<core::logging::Logger> logger_;
 
 
   void manageWorkers();
-  void run_tasks(const std::shared_ptr<WorkerThread>& thread);
+  void run_tasks(const std::shared_ptr<WorkerThread>& thread, size_t run_queue_index);
   void manage_delayed_queue();
+  void resizeRunQueues(size_t run_queue_count);
+  void enqueue(ScheduledTask&& task, std::optional<size_t> run_queue_index = std::nullopt);
+  bool dequeue(size_t run_queue_index, ScheduledTask& task);
+  void waitForWork();
+  void finishRun(const ScheduledTask& task);
+  void park(ScheduledTask&& task);
+  std::shared_ptr<TaskState> getTaskState(const std::lock_guard<std::mutex>& task_states_lock, const TaskId& identifier);
 };
 
 }  // namespace org::apache::nifi::minifi::utils
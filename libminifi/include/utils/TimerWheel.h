@@ -0,0 +1,191 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "utils/gsl.h"
+
+namespace org::apache::nifi::minifi::utils {
+
+/**
+ * Hashed timer wheel: values are put into the slot of their deadline's tick (modulo the number of slots), so adding
+ * a value is O(1) and expiring only visits the slots of the ticks which elapsed since the last expiration.
+ * Values further in the future than one revolution of the wheel share the slots, they are kept until their deadline.
+ * Not synchronized.
+ */
+template<typename T, typename Clock = std::chrono::steady_clock>
+class TimerWheel {
+ public:
+  using time_point = typename Clock::time_point;
+  using duration = typename Clock::duration;
+
+  explicit TimerWheel(duration tick = std::chrono::milliseconds(1), size_t slot_count = 1024, time_point start = Clock::now())
+      : tick_(tick),
+        slots_(slot_count),
+        current_tick_(toTick(start)) {
+    gsl_Expects(tick_ > duration::zero() && slot_count > 0);
+  }
+
+  void add(time_point deadline, T value) {
+    // the slots of already elapsed ticks are only visited again after a full revolution
+    const auto tick = std::max(toTick(deadline), current_tick_);
+    auto& slot = slots_[tick % slots_.size()];
+    slot.entries.emplace_back(deadline, std::move(value));
+    if (!slot.earliest_deadline || deadline < *slot.earliest_deadline) {
+      slot.earliest_deadline = deadline;
+    }
+    if (!next_deadline_ || deadline < *next_deadline_) {
+      next_deadline_ = deadline;
+    }
+    ++size_;
+  }
+
+  /**
+   * Removes the values whose deadline is not later than now, and passes them to the consumer in no particular order.
+   */
+  template<typename Consumer>
+  void expire(time_point now, Consumer&& consumer) {
+    if (!next_deadline_ || now < *next_deadline_) {
+      return;
+    }
+    const auto now_tick = std::max(toTick(now), current_tick_);
+    const auto elapsed_slot_count = std::min<uint64_t>(now_tick - current_tick_ + 1, slots_.size());
+    for (uint64_t tick = current_tick_; tick < current_tick_ + elapsed_slot_count; ++tick) {
+      auto& slot = slots_[tick % slots_.size()];
+      if (!slot.earliest_deadline || now < *slot.earliest_deadline) {
+        continue;
+      }
+      slot.earliest_deadline.reset();
+      auto kept_end = slot.entries.begin();
+      for (auto& entry : slot.entries) {
+        if (entry.first <= now) {
+          consumer(std::move(entry.second));
+          --size_;
+          continue;
+        }
+        if (!slot.earliest_deadline || entry.first < *slot.earliest_deadline) {
+          slot.earliest_deadline = entry.first;
+        }
+        if (&*kept_end != &entry) {
+          *kept_end = std::move(entry);
+        }
+        ++kept_end;
+      }
+      slot.entries.erase(kept_end, slot.entries.end());
+    }
+    current_tick_ = now_tick;
+    updateNextDeadline();
+  }
+
+  /**
+   * Removes the values matching the predicate, without calling any consumer.
+   * @return the number of removed values
+   */
+  template<typename Predicate>
+  size_t removeIf(Predicate&& predicate) {
+    size_t removed_count = 0;
+    // every entry is visited anyway, so the next deadline is collected in the same pass
+    next_deadline_.reset();
+    for (auto& slot : slots_) {
+      const auto removed = std::remove_if(slot.entries.begin(), slot.entries.end(), [&](const auto& entry) { return predicate(entry.second); });
+      removed_count += gsl::narrow<size_t>(std::distance(removed, slot.entries.end()));
+      slot.entries.erase(removed, slot.entries.end());
+      slot.earliest_deadline.reset();
+      for (const auto& entry : slot.entries) {
+        if (!slot.earliest_deadline || entry.first < *slot.earliest_deadline) {
+          slot.earliest_deadline = entry.first;
+        }
+      }
+      if (slot.earliest_deadline && (!next_deadline_ || *slot.earliest_deadline < *next_deadline_)) {
+        next_deadline_ = slot.earliest_deadline;
+      }
+    }
+    size_ -= removed_count;
+    return removed_count;
+  }
+
+  /**
+   * @return the earliest deadline of the contained values, or nullopt if the wheel is empty
+   */
+  [[nodiscard]] std::optional<time_point> nextDeadline() const {
+    return next_deadline_;
+  }
+
+  [[nodiscard]] size_t size() const {
+    return size_;
+  }
+
+  [[nodiscard]] bool empty() const {
+    return size_ == 0;
+  }
+
+  void clear() {
+    for (auto& slot : slots_) {
+      slot.entries.clear();
+      slot.earliest_deadline.reset();
+    }
+    next_deadline_.reset();
+    size_ = 0;
+  }
+
+ private:
+  struct Slot {
+    std::vector<std::pair<time_point, T>> entries;
+    std::optional<time_point> earliest_deadline;
+  };
+
+  [[nodiscard]] uint64_t toTick(time_point time) const {
+    return gsl::narrow_cast<uint64_t>(std::max(time.time_since_epoch(), duration::zero()) / tick_);
+  }
+
+  // Only called after expiring, when the earliest deadline has been removed. The remaining values are not due before
+  // current_tick_, so walking the slots from current_tick_, the first slot whose earliest deadline falls into the tick
+  // being visited holds the earliest deadline; all the slots are only visited if every value is more than a revolution away.
+  void updateNextDeadline() {
+    next_deadline_.reset();
+    if (size_ == 0) {
+      return;
+    }
+    for (uint64_t tick = current_tick_; tick < current_tick_ + slots_.size(); ++tick) {
+      const auto& slot = slots_[tick % slots_.size()];
+      if (!slot.earliest_deadline) {
+        continue;
+      }
+      if (toTick(*slot.earliest_deadline) <= tick) {
+        next_deadline_ = slot.earliest_deadline;
+        return;
+      }
+      if (!next_deadline_ || *slot.earliest_deadline < *next_deadline_) {
+        next_deadline_ = slot.earliest_deadline;
+      }
+    }
+  }
+
+  duration tick_;
+  std::vector<Slot> slots_;
+  uint64_t current_tick_;
+  std::optional<time_point> next_deadline_;
+  size_t size_ = 0;
+};
+
+}  // namespace org::apache::nifi::minifi::utils
@@ -434,6 +434,15 @@ inline std::string get_content(const std::filesystem::path& file_name) {
 
 bool contains(const std::filesystem::path& file_path, std::string_view text_to_search);
 
+/**
+ * Copies size bytes starting at offset of source into destination (created or truncated) inside the kernel,
+ * using a FICLONE reflink for whole-file copies and copy_file_range(2) otherwise.
+ * Fails with std::errc::operation_not_supported on platforms without these system calls. Any error
+ * (e.g. EXDEV for files on different filesystems) leaves it to the caller to fall back to a buffered copy.
+ * @return the number of bytes copied, which is less than size if source is shorter
+ */
+nonstd::expected<uint64_t, std::error_code> copy_file_range(const std::filesystem::path& source, uint64_t offset, uint64_t size, const std::filesystem::path& destination);
+
 
 inline std::optional<std::string> get_file_owner(const std::filesystem::path& file_path) {
 #ifndef WIN32
@@ -32,6 +32,14 @@ class FileWriterCallback {
   int64_t operator()(const std::shared_ptr<io::InputStream>& stream);
   bool commit();
 
+  // the content can also be written into the temporary file directly, in which case setWriteSucceeded() has to be called before commit()
+  const std::filesystem::path& getTempPath() const {
+    return temp_path_;
+  }
+
+  void setWriteSucceeded() {
+    write_succeeded_ = true;
+  }
 
  private:
   bool write_succeeded_ = false;
@@ -154,6 +154,16 @@ class AsioSocketConnection : public io::BaseStream {
   }
 #endif
 
+  // the site to site connections are kept open between the transactions, keep-alive detects the ones the peer has dropped
+  template<typename SocketType>
+  void enableKeepAlive(SocketType& socket) {
+    asio::error_code err;
+    socket.set_option(asio::socket_base::keep_alive(true), err);
+    if (err) {
+      logger_->log_warn("Failed to enable keep-alive on the connection to host '{}' on port '{}': '{}'", socket_data_.host, socket_data_.port, err.message());
+    }
+  }
+
   bool connectTcpSocketOverSsl();
   bool connectTcpSocket();
 
@@ -0,0 +1,66 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "ConcurrentTaskAutoscaler.h"
+
+#include <algorithm>
+
+namespace org::apache::nifi::minifi {
+
+ConcurrentTaskAutoscaler::Sample ConcurrentTaskAutoscaler::Sample::of(const core::Processor& processor, std::chrono::steady_clock::time_point time) {
+  return {
+    .time = time,
+    .queued_flow_files = processor.getIncomingQueueSize(),
+    .incoming_queue_full = processor.isIncomingBackpressureThresholdReached(),
+    .outgoing_queue_full = processor.flowFilesOutGoingFull(),
+    .busy_time = std::chrono::nanoseconds(processor.getMetrics().busy_time_nanoseconds.load())
+  };
+}
+
+ConcurrentTaskAutoscaler::Decision ConcurrentTaskAutoscaler::decide(const Sample& previous, const Sample& current, int task_count, int min_task_count, int max_task_count) {
+  max_task_count = std::max(min_task_count, max_task_count);
+  if (task_count < min_task_count) {
+    return {min_task_count, "below the minimum number of tasks"};
+  }
+  if (task_count > max_task_count) {
+    return {max_task_count, "above the maximum number of tasks"};
+  }
+
+  if (current.outgoing_queue_full) {
+    // more tasks would only fill the outgoing connections faster
+    if (task_count > min_task_count) {
+      return {task_count - 1, "an outgoing connection is backpressured"};
+    }
+    return {task_count, {}};
+  }
+
+  const auto interval = current.time - previous.time;
+  if (interval <= std::chrono::steady_clock::duration::zero() || task_count <= 0) {
+    return {task_count, {}};
+  }
+  const double busy_ratio = std::chrono::duration<double>(current.busy_time - previous.busy_time) / (std::chrono::duration<double>(interval) * task_count);
+
+  const bool backlogged = current.queued_flow_files > 0 && (current.incoming_queue_full || current.queued_flow_files > previous.queued_flow_files);
+  if (backlogged && busy_ratio >= SATURATED_BUSY_RATIO && task_count < max_task_count) {
+    return {task_count + 1, "the incoming connections are backlogged and the tasks are busy"};
+  }
+  if (current.queued_flow_files == 0 && busy_ratio < IDLE_BUSY_RATIO && task_count > min_task_count) {
+    return {task_count - 1, "the incoming connections are empty and the tasks are mostly idle"};
+  }
+  return {task_count, {}};
+}
+
+}  // namespace org::apache::nifi::minifi
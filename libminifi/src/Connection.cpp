@@ -141,7 +141,25 @@ void Connection::multiPut(std::vector<std::shared_ptr<core::FlowFile>>& flows) {
 
 std::shared_ptr<core::FlowFile> Connection::poll(std::set<std::shared_ptr<core::FlowFile>> &expiredFlowRecords) {
   std::lock_guard<std::mutex> lock(mutex_);
+  return pollLocked(expiredFlowRecords);
+}
+
+std::vector<std::shared_ptr<core::FlowFile>> Connection::pollBatch(size_t max_count, uint64_t max_bytes, std::set<std::shared_ptr<core::FlowFile>> &expiredFlowRecords) {
+  std::vector<std::shared_ptr<core::FlowFile>> flow_files;
+  uint64_t total_size = 0;
+  std::lock_guard<std::mutex> lock(mutex_);
+  while (flow_files.size() < max_count && total_size < max_bytes) {
+    auto item = pollLocked(expiredFlowRecords);
+    if (!item) {
+      break;
+    }
+    total_size += item->getSize();
+    flow_files.push_back(std::move(item));
+  }
+  return flow_files;
+}
 
+std::shared_ptr<core::FlowFile> Connection::pollLocked(std::set<std::shared_ptr<core::FlowFile>> &expiredFlowRecords) {
   while (queue_.isWorkAvailable()) {
     std::optional<std::shared_ptr<core::FlowFile>> opt_item = queue_.tryPop();
     if (!opt_item) {
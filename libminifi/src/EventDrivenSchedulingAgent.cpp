@@ -32,15 +32,29 @@ void EventDrivenSchedulingAgent::schedule(core::Processor* processor) {
   if (!processor->hasIncomingConnections()) {
     throw Exception(PROCESS_SCHEDULE_EXCEPTION, "EventDrivenSchedulingAgent cannot schedule processor without incoming connection!");
   }
+  // new flow files in the incoming connections wake up the tasks of the processor waiting for work
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    processor->setWorkNotifier(getThreadPool(*processor).createNotifier(processor->getUUIDStr()));
+  }
   ThreadedSchedulingAgent::schedule(processor);
 }
 
+void EventDrivenSchedulingAgent::unschedule(core::Processor* processor) {
+  ThreadedSchedulingAgent::unschedule(processor);
+  processor->setWorkNotifier(nullptr);
+}
+
 utils::TaskRescheduleInfo EventDrivenSchedulingAgent::run(core::Processor* processor, const std::shared_ptr<core::ProcessContext> &processContext,
                                          const std::shared_ptr<core::ProcessSessionFactory> &sessionFactory) {
   if (this->running_) {
     auto start_time = std::chrono::steady_clock::now();
     // trigger processor until it has work to do, but no more than the configured nifi.flow.engine.event.driven.time.slice
     while (processor->isRunning() && (std::chrono::steady_clock::now() - start_time < time_slice_)) {
+      if (!processor->getTriggerWhenEmpty() && processor->hasIncomingConnections() && processor->areIncomingConnectionsEmpty()) {
+        // only new flow files can bring work, the connections notify the thread pool when they arrive
+        return utils::TaskRescheduleInfo::RetryWhenNotified();
+      }
       this->onTrigger(processor, processContext, sessionFactory);
       if (processor->isYield()) {
         return utils::TaskRescheduleInfo::RetryAfter(processor->getYieldExpirationTime());
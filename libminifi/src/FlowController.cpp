@@ -21,6 +21,7 @@
 #include <map>
 #include <chrono>
 #include <future>
+#include <iterator>
 #include <thread>
 #include <utility>
 #include <memory>
@@ -44,6 +45,7 @@
 #include "core/ThreadedRepository.h"
 #include "c2/C2MetricsPublisher.h"
 #include "c2/ControllerSocketMetricsPublisher.h"
+#include "provenance/ProvenanceQuery.h"
 
 namespace org::apache::nifi::minifi {
 
@@ -177,6 +179,9 @@ int16_t FlowController::stop() {
     event_scheduler_->stop();
     cron_scheduler_->stop();
     thread_pool_.shutdown();
+    for (auto& [name, pool] : thread_partition_pools_) {
+      pool->shutdown();
+    }
     /* STOP! Before you change it, consider the following:
      * -Stopping the schedulers doesn't actually quit the onTrigger functions of processors
      * -They only guarantee that the processors are not scheduled anymore
@@ -279,12 +284,21 @@ void FlowController::load(bool reload) {
     thread_pool_.setMaxConcurrentTasks(configuration_->getInt(Configure::nifi_flow_engine_threads, 5));
     thread_pool_.setControllerServiceProvider(this);
     thread_pool_.start();
+    loadThreadPartitions();
   }
 
   conditionalReloadScheduler<TimerDrivenSchedulingAgent>(timer_scheduler_, !timer_scheduler_ || reload);
   conditionalReloadScheduler<EventDrivenSchedulingAgent>(event_scheduler_, !event_scheduler_ || reload);
   conditionalReloadScheduler<CronDrivenSchedulingAgent>(cron_scheduler_, !cron_scheduler_ || reload);
 
+  std::map<std::string, utils::ThreadPool*> thread_partition_pools;
+  for (const auto& partition : thread_partitions_) {
+    thread_partition_pools.emplace(partition.name, thread_partition_pools_.at(partition.name).get());
+  }
+  timer_scheduler_->setThreadPartitionPools(thread_partition_pools);
+  event_scheduler_->setThreadPartitionPools(thread_partition_pools);
+  cron_scheduler_->setThreadPartitionPools(thread_partition_pools);
+
   logger_->log_info("Loaded controller service provider");
 
   /*
@@ -305,6 +319,23 @@ void FlowController::load(bool reload) {
   initialized_ = true;
 }
 
+void FlowController::loadThreadPartitions() {
+  for (auto& [name, pool] : thread_partition_pools_) {
+    pool->shutdown();
+  }
+  thread_partitions_ = ThreadPartition::fromConfiguration(*configuration_);
+  for (const auto& partition : thread_partitions_) {
+    auto& pool = thread_partition_pools_[partition.name];
+    if (!pool) {
+      pool = std::make_unique<utils::ThreadPool>(partition.thread_count, this, "Flowcontroller threadpool " + partition.name);
+    }
+    pool->setMaxConcurrentTasks(partition.thread_count);
+    pool->setAffinity(partition.cpus, partition.numa_node);
+    pool->setControllerServiceProvider(this);
+    pool->start();
+  }
+}
+
 void FlowController::loadFlowRepo() {
   if (this->flow_file_repo_ != nullptr) {
     logger_->log_debug("Getting connection map");
@@ -336,6 +367,14 @@ int16_t FlowController::start() {
     event_scheduler_->start();
     cron_scheduler_->start();
 
+    std::map<std::string, std::string> partition_by_process_group;
+    for (const auto& partition : thread_partitions_) {
+      for (const auto& process_group : partition.process_groups) {
+        partition_by_process_group.emplace(process_group, partition.name);
+      }
+    }
+    root_wrapper_.assignThreadPartitions(partition_by_process_group);
+
     // watch out, this might immediately start the processors
     // as the thread_pool_ is started in load()
     if (root_wrapper_.startProcessing(*timer_scheduler_, *event_scheduler_, *cron_scheduler_)) {
@@ -348,6 +387,9 @@ int16_t FlowController::start() {
     provenance_repo_->start();
     flow_file_repo_->start();
     thread_pool_.start();
+    for (const auto& partition : thread_partitions_) {
+      thread_partition_pools_.at(partition.name)->start();
+    }
     logger_->log_info("Started Flow Controller");
   }
   return 0;
@@ -362,6 +404,9 @@ int16_t FlowController::pause() {
 
   logger_->log_info("Pausing Flow Controller");
   thread_pool_.pause();
+  for (const auto& partition : thread_partitions_) {
+    thread_partition_pools_.at(partition.name)->pause();
+  }
   return 0;
 }
 
@@ -374,6 +419,9 @@ int16_t FlowController::resume() {
 
   logger_->log_info("Resuming Flow Controller");
   thread_pool_.resume();
+  for (const auto& partition : thread_partitions_) {
+    thread_partition_pools_.at(partition.name)->resume();
+  }
   return 0;
 }
 
@@ -458,6 +506,10 @@ uint64_t FlowController::getUptime() {
 
 std::vector<BackTrace> FlowController::getTraces() {
   std::vector<BackTrace> traces{thread_pool_.getTraces()};
+  for (const auto& partition : thread_partitions_) {
+    auto partition_traces = thread_partition_pools_.at(partition.name)->getTraces();
+    std::move(partition_traces.begin(), partition_traces.end(), std::back_inserter(traces));
+  }
   if (auto provenance_repo = std::dynamic_pointer_cast<core::ThreadedRepository>(provenance_repo_)) {
     auto prov_repo_trace = provenance_repo->getTraces();
     traces.emplace_back(std::move(prov_repo_trace));
@@ -486,6 +538,25 @@ std::map<std::string, std::unique_ptr<io::InputStream>> FlowController::getDebug
   return debug_info;
 }
 
+std::vector<state::StateMonitor::ThreadPartitionUtilization> FlowController::getThreadPartitionUtilizations() {
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  std::vector<ThreadPartitionUtilization> utilizations;
+  utilizations.push_back({"default", thread_pool_.getMaxConcurrentTasks(), thread_pool_.getUtilization()});
+  for (const auto& partition : thread_partitions_) {
+    auto& pool = *thread_partition_pools_.at(partition.name);
+    utilizations.push_back({partition.name, pool.getMaxConcurrentTasks(), pool.getUtilization()});
+  }
+  return utilizations;
+}
+
+std::optional<provenance::ProvenanceQueryResult> FlowController::queryProvenance(const provenance::ProvenanceQuery& query) {
+  auto queryable_repository = std::dynamic_pointer_cast<provenance::QueryableProvenanceRepository>(provenance_repo_);
+  if (!queryable_repository) {
+    return std::nullopt;
+  }
+  return queryable_repository->query(query);
+}
+
 std::unique_ptr<core::ProcessGroup> FlowController::updateFromPayload(const std::string& url, const std::string& config_payload, const std::optional<std::string>& flow_id) {
   auto root = flow_configuration_->updateFromPayload(url, config_payload, flow_id);
   // prepare to accept the new controller service provider from flow_configuration_
@@ -26,6 +26,7 @@
 #include <string>
 #include <iostream>
 #include <fstream>
+#include <array>
 #include <cinttypes>
 #include "FlowFileRecord.h"
 #include "core/logging/LoggerConfiguration.h"
@@ -66,7 +67,38 @@ std::shared_ptr<FlowFileRecord> FlowFileRecord::DeSerialize(const std::string& k
   return record;
 }
 
-bool FlowFileRecord::Serialize(io::OutputStream &outStream) {
+bool FlowFileRecord::Serialize(io::OutputStream &outStream, io::RecordFormat format) {
+  if (format == io::RecordFormat::LEGACY) {
+    return SerializeLegacy(outStream);
+  }
+  std::vector<std::byte> buffer;
+  Serialize(buffer);
+  return outStream.write(buffer) == buffer.size();
+}
+
+void FlowFileRecord::Serialize(std::vector<std::byte>& buffer) const {
+  io::CompactWriter writer(buffer);
+  writer.writeByte(io::COMPACT_RECORD_MARKER);
+  writer.writeByte(COMPACT_FORMAT_VERSION);
+  writer.writeTime(event_time_);
+  writer.writeTime(entry_date_);
+  writer.writeTime(lineage_start_date_);
+  writer.writeIdentifier(uuid_);
+  writer.writeIdentifier(connection_ ? connection_->getUUID() : utils::Identifier{});
+  writer.writeVarint(attributes_->size());
+  for (const auto& [key, value] : *attributes_) {
+    writer.writeString(key, io::COMMON_ATTRIBUTE_KEYS);
+    writer.writeString(value);
+  }
+  // the claims of the content repository are stored by their id, the others by their full path
+  const auto claim_id = claim_ ? claim_->getClaimId() : std::nullopt;
+  writer.writeByte(claim_id ? uint8_t{1} : uint8_t{0});
+  writer.writeString(claim_id ? *claim_id : claim_ ? std::string_view{claim_->getContentFullPath()} : std::string_view{});
+  writer.writeVarint(size_);
+  writer.writeVarint(offset_);
+}
+
+bool FlowFileRecord::SerializeLegacy(io::OutputStream &outStream) {
   {
     uint64_t event_time_ms = std::chrono::duration_cast<std::chrono::milliseconds>(event_time_.time_since_epoch()).count();
     const auto ret = outStream.write(event_time_ms);
@@ -106,14 +138,14 @@ bool FlowFileRecord::Serialize(io::OutputStream &outStream) {
   }
   // write flow attributes
   {
-    const auto numAttributes = gsl::narrow<uint32_t>(attributes_.size());
+    const auto numAttributes = gsl::narrow<uint32_t>(attributes_->size());
     const auto ret = outStream.write(numAttributes);
     if (ret != 4) {
       return false;
     }
   }
 
-  for (auto& itAttribute : attributes_) {
+  for (const auto& itAttribute : *attributes_) {
     {
       const auto ret = outStream.write(itAttribute.first, true);
       if (ret == 0 || io::isError(ret)) {
@@ -174,14 +206,69 @@ bool FlowFileRecord::Persist(const std::shared_ptr<core::Repository>& flowReposi
 }
 
 std::shared_ptr<FlowFileRecord> FlowFileRecord::DeSerialize(io::InputStream& inStream, const std::shared_ptr<core::ContentRepository>& content_repo, utils::Identifier& container) {
+  uint8_t first_byte = 0;
+  if (inStream.read(first_byte) != 1) {
+    return {};
+  }
+  if (first_byte == io::COMPACT_RECORD_MARKER) {
+    return DeSerializeCompact(inStream, content_repo, container);
+  }
+  return DeSerializeLegacy(inStream, first_byte, content_repo, container);
+}
+
+std::shared_ptr<FlowFileRecord> FlowFileRecord::DeSerializeCompact(io::InputStream& inStream, const std::shared_ptr<core::ContentRepository>& content_repo, utils::Identifier& container) {
+  io::CompactReader reader(inStream);
+  uint8_t version = 0;
+  if (!reader.readByte(version) || version != COMPACT_FORMAT_VERSION) {
+    logger_->log_error("Unsupported FlowFile record format version {}", version);
+    return {};
+  }
+
+  auto file = std::make_shared<FlowFileRecord>();
+  if (!reader.readTime(file->event_time_) || !reader.readTime(file->entry_date_) || !reader.readTime(file->lineage_start_date_)
+      || !reader.readIdentifier(file->uuid_) || !reader.readIdentifier(container)) {
+    return {};
+  }
+
+  uint32_t numAttributes = 0;
+  if (!reader.readVarint(numAttributes)) {
+    return {};
+  }
+  auto& attributes = file->attributes_.mutate();
+  for (uint32_t i = 0; i < numAttributes; i++) {
+    std::string key;
+    std::string value;
+    if (!reader.readString(key, io::COMMON_ATTRIBUTE_KEYS) || !reader.readString(value)) {
+      return {};
+    }
+    attributes[std::move(key)] = std::move(value);
+  }
+
+  uint8_t is_claim_id = 0;
+  std::string content_path;
+  if (!reader.readByte(is_claim_id) || !reader.readString(content_path) || !reader.readVarint(file->size_) || !reader.readVarint(file->offset_)) {
+    return {};
+  }
+
+  file->claim_ = std::make_shared<ResourceClaim>(is_claim_id ? ResourceClaim::getContentFullPathFromClaimId(content_repo, content_path) : content_path, content_repo);
+  return file;
+}
+
+std::shared_ptr<FlowFileRecord> FlowFileRecord::DeSerializeLegacy(io::InputStream& inStream, uint8_t first_byte, const std::shared_ptr<core::ContentRepository>& content_repo,
+    utils::Identifier& container) {
   auto file = std::make_shared<FlowFileRecord>();
 
   {
-    uint64_t event_time_in_ms;
-    const auto ret = inStream.read(event_time_in_ms);
-    if (ret != 8) {
+    // the first byte of the big endian event time has already been read to detect the format
+    std::array<uint8_t, 7> remaining_bytes{};
+    const auto ret = inStream.read(std::as_writable_bytes(std::span(remaining_bytes)));
+    if (ret != remaining_bytes.size()) {
       return {};
     }
+    uint64_t event_time_in_ms = first_byte;
+    for (const auto byte : remaining_bytes) {
+      event_time_in_ms = (event_time_in_ms << 8) | byte;
+    }
     file->event_time_ = std::chrono::system_clock::time_point() + std::chrono::milliseconds(event_time_in_ms);
   }
 
@@ -241,7 +328,7 @@ std::shared_ptr<FlowFileRecord> FlowFileRecord::DeSerialize(io::InputStream& inS
         return {};
       }
     }
-    file->attributes_[key] = value;
+    file->attributes_.mutate()[key] = value;
   }
 
   std::string content_full_path;
@@ -20,6 +20,7 @@
 
 #include "RemoteProcessorGroupPort.h"
 
+#include <algorithm>
 #include <memory>
 #include <iostream>
 #include <vector>
@@ -47,58 +48,109 @@ namespace org::apache::nifi::minifi {
 const char *RemoteProcessorGroupPort::RPG_SSL_CONTEXT_SERVICE_NAME = "RemoteProcessorGroupPortSSLContextService";
 
 std::unique_ptr<sitetosite::SiteToSiteClient> RemoteProcessorGroupPort::getNextProtocol(bool create = true) {
-  std::unique_ptr<sitetosite::SiteToSiteClient> nextProtocol = nullptr;
-  if (!available_protocols_.try_dequeue(nextProtocol)) {
-    if (create) {
-      // create
-      if (bypass_rest_api_) {
-        if (!nifi_instances_.empty()) {
-          auto rpg = nifi_instances_.front();
-          auto host = rpg.host_;
+  std::shared_ptr<sitetosite::Peer> peer;
+  if (bypass_rest_api_) {
+    if (nifi_instances_.empty()) {
+      return nullptr;
+    }
+    auto rpg = nifi_instances_.front();
+    auto host = rpg.host_;
 #ifdef WIN32
-          if ("localhost" == host) {
-            host = org::apache::nifi::minifi::utils::net::getMyHostName();
-          }
+    if ("localhost" == host) {
+      host = org::apache::nifi::minifi::utils::net::getMyHostName();
+    }
 #endif
-          sitetosite::SiteToSiteClientConfiguration config(std::make_shared<sitetosite::Peer>(protocol_uuid_, host, rpg.port_, ssl_service != nullptr), this->getInterface(),
-                                                           client_type_);
-          config.setHTTPProxy(this->proxy_);
-          config.setIdleTimeout(idle_timeout_);
-          nextProtocol = sitetosite::createClient(config);
-        }
-      } else if (peer_index_ >= 0) {
-        std::lock_guard<std::mutex> lock(peer_mutex_);
-        logger_->log_debug("Creating client from peer {}", peer_index_.load());
-        sitetosite::SiteToSiteClientConfiguration config(peers_[this->peer_index_].getPeer(), local_network_interface_, client_type_);
-        config.setSecurityContext(ssl_service);
-        peer_index_++;
-        if (peer_index_ >= static_cast<int>(peers_.size())) {
-          peer_index_ = 0;
-        }
-        config.setHTTPProxy(this->proxy_);
-        config.setIdleTimeout(idle_timeout_);
-        nextProtocol = sitetosite::createClient(config);
-      } else {
-        logger_->log_debug("Refreshing the peer list since there are none configured.");
-        refreshPeerList();
-      }
+    peer = std::make_shared<sitetosite::Peer>(protocol_uuid_, host, rpg.port_, ssl_service != nullptr);
+  } else {
+    std::unique_lock<std::mutex> lock(peer_mutex_);
+    if (peer_selector_.empty()) {
+      lock.unlock();
+      logger_->log_debug("Refreshing the peer list since there are none configured.");
+      refreshPeerList();
+      return nullptr;
+    }
+    if (!nifi_instances_.empty() && std::chrono::steady_clock::now() - last_peer_refresh_ > PEER_REFRESH_INTERVAL) {
+      lock.unlock();
+      logger_->log_debug("Refreshing the peer list to update the flow file counts of the peers");
+      refreshPeerList();
+      lock.lock();
+    }
+    peer = peer_selector_.selectPeer()->getPeer();
+  }
+
+  const auto peer_key = sitetosite::PeerSelector::getPeerKey(peer->getHost(), peer->getPort());
+  if (auto idle_client = takeIdleClient(peer_key)) {
+    logger_->log_debug("Reusing the connection to peer {}", peer_key);
+    return idle_client;
+  }
+  if (!create) {
+    return nullptr;
+  }
+
+  logger_->log_debug("Creating client for peer {}", peer_key);
+  sitetosite::SiteToSiteClientConfiguration config(peer, local_network_interface_, client_type_);
+  if (!bypass_rest_api_) {
+    config.setSecurityContext(ssl_service);
+  }
+  config.setHTTPProxy(this->proxy_);
+  config.setIdleTimeout(idle_timeout_);
+  config.setUseCompression(use_compression_);
+  return sitetosite::createClient(config);
+}
+
+std::unique_ptr<sitetosite::SiteToSiteClient> RemoteProcessorGroupPort::takeIdleClient(const std::string& peer_key) {
+  std::deque<IdleClient> expired_clients;  // closed after releasing the lock
+  std::lock_guard<std::mutex> lock(idle_clients_mutex_);
+  auto it = idle_clients_.find(peer_key);
+  if (it == idle_clients_.end()) {
+    return nullptr;
+  }
+  auto& clients = it->second;
+  // the most recently used connection is the least likely to have been closed by the peer
+  const auto now = std::chrono::steady_clock::now();
+  while (!clients.empty()) {
+    auto idle_client = std::move(clients.back());
+    clients.pop_back();
+    if (now - idle_client.idle_since < idle_timeout_) {
+      return std::move(idle_client.client);
     }
+    expired_clients.push_back(std::move(idle_client));
   }
-  logger_->log_debug("Obtained protocol from available_protocols_");
-  return nextProtocol;
+  if (!expired_clients.empty()) {
+    logger_->log_debug("Closing {} connections to peer {} idle for longer than {} ms", expired_clients.size(), peer_key, idle_timeout_.count());
+  }
+  return nullptr;
 }
 
 void RemoteProcessorGroupPort::returnProtocol(std::unique_ptr<sitetosite::SiteToSiteClient> return_protocol) {
-  auto count = peers_.size();
-  if (max_concurrent_tasks_ > count)
-    count = max_concurrent_tasks_;
-  if (available_protocols_.size_approx() >= count) {
-    logger_->log_debug("not enqueueing protocol {}", getUUIDStr());
+  if (!return_protocol || !return_protocol->getPeer()) {
+    return;
+  }
+  const auto peer_key = sitetosite::PeerSelector::getPeerKey(return_protocol->getPeer()->getHostName(), return_protocol->getPeer()->getPort());
+  // the buffered frames would not be sent while the client is idle
+  if (!return_protocol->getPeer()->flush()) {
+    logger_->log_debug("closing the connection of {} to peer {}, its buffered data could not be sent", getUUIDStr(), peer_key);
+    return;
+  }
+  const size_t max_idle_clients = std::max<size_t>(max_concurrent_tasks_, 1);
+  std::lock_guard<std::mutex> lock(idle_clients_mutex_);
+  auto& clients = idle_clients_[peer_key];
+  if (clients.size() >= max_idle_clients) {
+    logger_->log_debug("not keeping the connection of {} to peer {} alive, there are {} idle connections", getUUIDStr(), peer_key, clients.size());
     // let the memory be freed
     return;
   }
-  logger_->log_debug("enqueueing protocol {}, have a total of {}", getUUIDStr(), available_protocols_.size_approx());
-  available_protocols_.enqueue(std::move(return_protocol));
+  logger_->log_debug("keeping the connection of {} to peer {} alive, have a total of {}", getUUIDStr(), peer_key, clients.size() + 1);
+  clients.push_back(IdleClient{std::move(return_protocol), std::chrono::steady_clock::now()});
+}
+
+void RemoteProcessorGroupPort::removeIdleClientsOfUnknownPeers() {
+  std::lock_guard<std::mutex> lock(idle_clients_mutex_);
+  std::erase_if(idle_clients_, [this](const auto& peer_and_clients) {
+    return std::none_of(peer_selector_.getPeers().begin(), peer_selector_.getPeers().end(), [&peer_and_clients](const sitetosite::PeerStatus& peer_status) {
+      return sitetosite::PeerSelector::getPeerKey(peer_status.getPeer()->getHost(), peer_status.getPeer()->getPort()) == peer_and_clients.first;
+    });
+  });
 }
 
 void RemoteProcessorGroupPort::initialize() {
@@ -137,18 +189,17 @@ void RemoteProcessorGroupPort::onSchedule(core::ProcessContext& context, core::P
       idle_timeout_ = core::TimePeriodValue(std::string(*idleTimeout.default_value)).getMilliseconds();
     }
   }
+  use_compression_ = context.getProperty<bool>(useCompression).value_or(false);
 
-  std::lock_guard<std::mutex> lock(peer_mutex_);
   if (!nifi_instances_.empty()) {
     refreshPeerList();
-    if (!peers_.empty())
-      peer_index_ = 0;
   }
+  std::lock_guard<std::mutex> lock(peer_mutex_);
   /**
    * If at this point we have no peers and HTTP support is disabled this means
    * we must rely on the configured host/port
    */
-  if (peers_.empty() && is_http_disabled()) {
+  if (peer_selector_.empty() && is_http_disabled()) {
     std::string host;
     std::string portStr;
     int configured_port = -1;
@@ -164,27 +215,8 @@ void RemoteProcessorGroupPort::onSchedule(core::ProcessContext& context, core::P
       throw(Exception(SITE2SITE_EXCEPTION, "HTTPClient not resolvable. No peers configured or any port specific hostname and port -- cannot schedule"));
     }
   }
-  // populate the site2site protocol for load balancing between them
-  if (!peers_.empty()) {
-    auto count = peers_.size();
-    if (max_concurrent_tasks_ > count)
-      count = max_concurrent_tasks_;
-    for (uint32_t i = 0; i < count; i++) {
-      std::unique_ptr<sitetosite::SiteToSiteClient> nextProtocol = nullptr;
-      sitetosite::SiteToSiteClientConfiguration config(peers_[this->peer_index_].getPeer(), this->getInterface(), client_type_);
-      config.setSecurityContext(ssl_service);
-      peer_index_++;
-      if (peer_index_ >= static_cast<int>(peers_.size())) {
-        peer_index_ = 0;
-      }
-      logger_->log_trace("Creating client");
-      config.setHTTPProxy(this->proxy_);
-      config.setIdleTimeout(idle_timeout_);
-      nextProtocol = sitetosite::createClient(config);
-      logger_->log_trace("Created client, moving into available protocols");
-      returnProtocol(std::move(nextProtocol));
-    }
-  } else {
+  // the clients are created on demand, connected to the peers selected by their load
+  if (!bypass_rest_api_ && peer_selector_.empty()) {
     // we don't have any peers
     logger_->log_error("No peers selected during scheduling");
   }
@@ -196,10 +228,9 @@ void RemoteProcessorGroupPort::notifyStop() {
   // we use the latch
   while (count.getCount() > 0) {
   }
-  std::unique_ptr<sitetosite::SiteToSiteClient> nextProtocol = nullptr;
-  while (available_protocols_.try_dequeue(nextProtocol)) {
-    // clear all protocols now
-  }
+  std::lock_guard<std::mutex> lock(idle_clients_mutex_);
+  // clear all protocols now
+  idle_clients_.clear();
 }
 
 void RemoteProcessorGroupPort::onTrigger(core::ProcessContext& context, core::ProcessSession& session) {
@@ -352,14 +383,23 @@ std::pair<std::string, int> RemoteProcessorGroupPort::refreshRemoteSite2SiteInfo
 }
 
 void RemoteProcessorGroupPort::refreshPeerList() {
+  // the triggers keep selecting from the previous peer list while one of them fetches the new one
+  std::unique_lock<std::mutex> refresh_lock(peer_refresh_mutex_, std::try_to_lock);
+  if (!refresh_lock.owns_lock()) {
+    logger_->log_debug("The peer list is already being refreshed");
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(peer_mutex_);
+    // an unreachable NiFi instance is retried with the next periodic refresh instead of on every trigger
+    last_peer_refresh_ = std::chrono::steady_clock::now();
+  }
   auto connection = refreshRemoteSite2SiteInfo();
   if (connection.second == -1) {
     logger_->log_debug("No port configured");
     return;
   }
 
-  this->peers_.clear();
-
   std::unique_ptr<sitetosite::SiteToSiteClient> protocol;
   sitetosite::SiteToSiteClientConfiguration config(std::make_shared<sitetosite::Peer>(protocol_uuid_, connection.first, connection.second, ssl_service != nullptr),
                                                    this->getInterface(), client_type_);
@@ -368,13 +408,21 @@ void RemoteProcessorGroupPort::refreshPeerList() {
   config.setIdleTimeout(idle_timeout_);
   protocol = sitetosite::createClient(config);
 
+  std::vector<sitetosite::PeerStatus> peers;
   if (protocol)
-    protocol->getPeerList(peers_);
+    protocol->getPeerList(peers);
 
-  logger_->log_info("Have {} peers", peers_.size());
-
-  if (!peers_.empty())
-    peer_index_ = 0;
+  logger_->log_info("Have {} peers", peers.size());
+  std::lock_guard<std::mutex> lock(peer_mutex_);
+  if (peers.empty() && !peer_selector_.empty()) {
+    logger_->log_warn("Could not refresh the peer list, keeping the previous {} peers", peer_selector_.getPeers().size());
+    return;
+  }
+  for (const auto& peer : peers) {
+    logger_->log_debug("Peer {}:{} reported {} flow files", peer.getPeer()->getHost(), peer.getPeer()->getPort(), peer.getFlowFileCount());
+  }
+  peer_selector_.setPeers(std::move(peers), direction_);
+  removeIdleClientsOfUnknownPeers();
 }
 
 }  // namespace org::apache::nifi::minifi
@@ -38,14 +38,7 @@ void setDefaultDirectory(std::string path) {
 }
 
 ResourceClaim::ResourceClaim(std::shared_ptr<core::StreamManager<ResourceClaim>> claim_manager)
-    : _contentFullPath([&] {
-        auto contentDirectory = claim_manager->getStoragePath();
-        if (contentDirectory.empty())
-          contentDirectory = default_directory_path;
-
-        // Create the full content path for the content
-        return contentDirectory + "/" + non_repeating_string_generator_.generate();
-      }()),
+    : _contentFullPath(getContentDirectory(claim_manager.get()) + "/" + non_repeating_string_generator_.generate()),
       claim_manager_(std::move(claim_manager)),
       logger_(core::logging::LoggerFactory<ResourceClaim>::getLogger()) {
   if (claim_manager_) increaseFlowFileRecordOwnedCount();
@@ -63,4 +56,24 @@ ResourceClaim::~ResourceClaim() {
   if (claim_manager_) decreaseFlowFileRecordOwnedCount();
 }
 
+std::string ResourceClaim::getContentDirectory(const core::StreamManager<ResourceClaim>* claim_manager) {
+  auto contentDirectory = claim_manager ? claim_manager->getStoragePath() : std::string{};
+  if (contentDirectory.empty())
+    contentDirectory = default_directory_path;
+  return contentDirectory;
+}
+
+std::optional<std::string_view> ResourceClaim::getClaimId() const {
+  const auto contentDirectory = getContentDirectory(claim_manager_.get());
+  std::string_view path = _contentFullPath;
+  if (path.size() <= contentDirectory.size() || !path.starts_with(contentDirectory) || path[contentDirectory.size()] != '/') {
+    return std::nullopt;
+  }
+  return path.substr(contentDirectory.size() + 1);
+}
+
+ResourceClaim::Path ResourceClaim::getContentFullPathFromClaimId(const std::shared_ptr<core::StreamManager<ResourceClaim>>& claim_manager, std::string_view claim_id) {
+  return getContentDirectory(claim_manager.get()) + "/" + std::string{claim_id};
+}
+
 }  // namespace org::apache::nifi::minifi
@@ -109,6 +109,12 @@ void RootProcessGroupWrapper::getFlowFileContainers(std::map<std::string, core::
   }
 }
 
+void RootProcessGroupWrapper::assignThreadPartitions(const std::map<std::string, std::string>& partition_by_process_group) {
+  if (root_) {
+    root_->assignThreadPartitions(partition_by_process_group);
+  }
+}
+
 bool RootProcessGroupWrapper::startProcessing(TimerDrivenSchedulingAgent& timer_scheduler,
                            EventDrivenSchedulingAgent& event_scheduler,
                            CronDrivenSchedulingAgent& cron_scheduler) {
@@ -90,6 +90,18 @@ nonstd::expected<void, std::exception_ptr> SchedulingAgent::onTrigger(core::Proc
   return {};
 }
 
+utils::ThreadPool& SchedulingAgent::getThreadPool(const core::Processor& processor) {
+  const auto thread_partition = processor.getThreadPartition();
+  if (thread_partition.empty()) {
+    return thread_pool_;
+  }
+  if (const auto it = thread_partition_pools_.find(thread_partition); it != thread_partition_pools_.end()) {
+    return *it->second;
+  }
+  logger_->log_warn("Unknown thread partition {} of processor {}, scheduling it on the default thread pool", thread_partition, processor.getName());
+  return thread_pool_;
+}
+
 void SchedulingAgent::watchDogFunc() {
   std::lock_guard<std::mutex> lock(watchdog_mtx_);
   auto now = std::chrono::steady_clock::now();
@@ -0,0 +1,106 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "ThreadPartition.h"
+
+#include <algorithm>
+#include <optional>
+#include <set>
+
+#include "core/logging/LoggerFactory.h"
+#include "utils/OsUtils.h"
+#include "utils/StringUtils.h"
+#include "utils/ValueParser.h"
+
+namespace org::apache::nifi::minifi {
+
+namespace {
+std::string partitionProperty(const std::string& partition_name, const char* property) {
+  return std::string(Configure::nifi_flow_engine_thread_partition_prefix) + partition_name + "." + property;
+}
+}  // namespace
+
+std::vector<ThreadPartition> ThreadPartition::fromConfiguration(const Configure& configuration) {
+  static const auto logger = core::logging::LoggerFactory<ThreadPartition>::getLogger();
+  std::vector<ThreadPartition> partitions;
+  const auto partition_names = configuration.get(Configure::nifi_flow_engine_thread_partitions);
+  if (!partition_names) {
+    return partitions;
+  }
+  std::set<std::string> assigned_process_groups;
+  for (auto& name : utils::StringUtils::splitAndTrimRemovingEmpty(*partition_names, ",")) {
+    if (std::any_of(partitions.begin(), partitions.end(), [&](const auto& partition) { return partition.name == name; })) {
+      logger->log_error("Thread partition {} is listed more than once", name);
+      continue;
+    }
+    ThreadPartition partition;
+    partition.name = std::move(name);
+
+    if (const auto cpu_list = configuration.get(partitionProperty(partition.name, "cpus"))) {
+      const auto cpus = utils::OsUtils::parseCpuList(*cpu_list);
+      if (!cpus) {
+        logger->log_error("Invalid CPU list of thread partition {}: {}", partition.name, *cpu_list);
+        continue;
+      }
+      partition.cpus = *cpus;
+    } else if (const auto numa_node_str = configuration.get(partitionProperty(partition.name, "numa.node"))) {
+      const auto numa_node = utils::toNumber<uint32_t>(*numa_node_str);
+      if (!numa_node) {
+        logger->log_error("Invalid NUMA node of thread partition {}: {}", partition.name, *numa_node_str);
+        continue;
+      }
+      partition.cpus = utils::OsUtils::getNumaNodeCpus(*numa_node);
+      if (partition.cpus.empty()) {
+        logger->log_warn("Could not determine the CPUs of NUMA node {}, the threads of partition {} are not pinned", *numa_node, partition.name);
+      } else {
+        partition.numa_node = *numa_node;
+      }
+    }
+
+    if (const auto thread_count_str = configuration.get(partitionProperty(partition.name, "threads"))) {
+      const auto thread_count = utils::toNumber<int>(*thread_count_str);
+      if (!thread_count || *thread_count <= 0) {
+        logger->log_error("Invalid thread count of thread partition {}: {}", partition.name, *thread_count_str);
+        continue;
+      }
+      partition.thread_count = *thread_count;
+    } else if (!partition.cpus.empty()) {
+      partition.thread_count = gsl::narrow<int>(partition.cpus.size());
+    } else {
+      partition.thread_count = configuration.getInt(Configure::nifi_flow_engine_threads, 5);
+    }
+
+    if (const auto process_groups = configuration.get(partitionProperty(partition.name, "process.groups"))) {
+      for (auto& process_group : utils::StringUtils::splitAndTrimRemovingEmpty(*process_groups, ",")) {
+        if (!assigned_process_groups.insert(process_group).second) {
+          logger->log_error("Process group {} is assigned to more than one thread partition, keeping the first assignment", process_group);
+          continue;
+        }
+        partition.process_groups.push_back(std::move(process_group));
+      }
+    }
+    if (partition.process_groups.empty()) {
+      logger->log_warn("No process groups are assigned to thread partition {}", partition.name);
+    }
+
+    logger->log_info("Thread partition {}: {} threads on {} CPUs", partition.name, partition.thread_count,
+        partition.cpus.empty() ? std::string("all") : std::to_string(partition.cpus.size()));
+    partitions.push_back(std::move(partition));
+  }
+  return partitions;
+}
+
+}  // namespace org::apache::nifi::minifi
@@ -35,6 +35,8 @@
 #include "core/ProcessContext.h"
 #include "core/ProcessContextBuilder.h"
 #include "core/ProcessSessionFactory.h"
+#include "controllers/ThreadManagementService.h"
+#include "utils/StringUtils.h"
 #include "utils/ValueParser.h"
 
 using namespace std::literals::chrono_literals;
@@ -70,7 +72,8 @@ void ThreadedSchedulingAgent::schedule(core::Processor* processor) {
     return;
   }
 
-  if (thread_pool_.isTaskRunning(processor->getUUIDStr())) {
+  auto& thread_pool = getThreadPool(*processor);
+  if (thread_pool.isTaskRunning(processor->getUUIDStr())) {
     logger_->log_warn("Can not schedule threads for processor {} because there are existing threads running", processor->getName());
     return;
   }
@@ -88,30 +91,140 @@ void ThreadedSchedulingAgent::schedule(core::Processor* processor) {
 
   processor->onScheduleSharedPtr(process_context, session_factory);
 
-  std::vector<std::thread *> threads;
+  RunningProcessor running_processor{
+    .processor = processor,
+    .thread_pool = &thread_pool,
+    .process_context = process_context,
+    .session_factory = session_factory,
+    .concurrent_tasks = std::make_shared<ConcurrentTasks>(),
+    .last_sample = ConcurrentTaskAutoscaler::Sample::of(*processor)
+  };
+  running_processor.concurrent_tasks->target_count = processor->getMaxConcurrentTasks();
+  while (running_processor.concurrent_tasks->reserveMissingTask()) {
+    executeTask(running_processor);
+  }
+  processor->getMetrics().concurrent_tasks = processor->getMaxConcurrentTasks();
+  logger_->log_debug("Scheduled thread {} concurrent workers for for process {}", processor->getMaxConcurrentTasks(), processor->getName());
+  processors_running_.insert_or_assign(processor->getUUID(), std::move(running_processor));
+}
 
-  ThreadedSchedulingAgent *agent = this;
-  for (int i = 0; i < processor->getMaxConcurrentTasks(); i++) {
-    // reference the disable function from serviceNode
-    processor->incrementActiveTasks();
+void ThreadedSchedulingAgent::executeTask(const RunningProcessor& running_processor) {
+  auto* processor = running_processor.processor;
+  // reference the disable function from serviceNode
+  processor->incrementActiveTasks();
 
-    std::function<utils::TaskRescheduleInfo()> f_ex = [agent, processor, process_context, session_factory] () {
-      return agent->run(processor, process_context, session_factory);
-    };
+  std::function<utils::TaskRescheduleInfo()> f_ex = [agent = this, processor, process_context = running_processor.process_context,
+      session_factory = running_processor.session_factory, concurrent_tasks = running_processor.concurrent_tasks] () {
+    if (concurrent_tasks->retireExcessTask()) {
+      processor->decrementActiveTask();
+      return utils::TaskRescheduleInfo::Done();
+    }
+    return agent->run(processor, process_context, session_factory);
+  };
 
-    std::future<utils::TaskRescheduleInfo> future;
-    thread_pool_.execute(utils::Worker{f_ex, processor->getUUIDStr()}, future);
+  std::future<utils::TaskRescheduleInfo> future;
+  running_processor.thread_pool->execute(utils::Worker{f_ex, processor->getUUIDStr()}, future);
+}
+
+bool ThreadedSchedulingAgent::ConcurrentTasks::retireExcessTask() {
+  int running = running_count.load();
+  while (running > target_count.load()) {
+    if (running_count.compare_exchange_weak(running, running - 1)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool ThreadedSchedulingAgent::ConcurrentTasks::reserveMissingTask() {
+  int running = running_count.load();
+  while (running < target_count.load()) {
+    if (running_count.compare_exchange_weak(running, running + 1)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void ThreadedSchedulingAgent::initializeAutoscaling() {
+  const bool enabled = configure_->get(Configure::nifi_flow_engine_autoscaling_enabled)
+      | utils::andThen(utils::StringUtils::toBool)
+      | utils::valueOrElse([] { return false; });
+  if (!enabled) {
+    return;
+  }
+  autoscaling_max_concurrent_tasks_ = configure_->get(Configure::nifi_flow_engine_autoscaling_max_concurrent_tasks)
+      | utils::andThen(utils::toNumber<uint32_t>)
+      | utils::valueOrElse([] { return uint32_t{0}; });
+  const auto interval = configure_->get(Configure::nifi_flow_engine_autoscaling_interval)
+      | utils::andThen(utils::timeutils::StringToDuration<std::chrono::milliseconds>)
+      | utils::valueOrElse([] { return std::chrono::milliseconds(5s); });
+  autoscaling_timer_ = std::make_unique<utils::CallBackTimer>(interval, [this] { autoscale(); });
+  autoscaling_timer_->start();
+}
+
+int ThreadedSchedulingAgent::getMinConcurrentTasks(const RunningProcessor& running_processor) const {
+  const int min_task_count = std::max(int{running_processor.processor->getAutoscalingMinConcurrentTasks()}, 1);
+  return std::min(min_task_count, getMaxConcurrentTasks(running_processor));
+}
+
+int ThreadedSchedulingAgent::getMaxConcurrentTasks(const RunningProcessor& running_processor) const {
+  if (running_processor.processor->isSingleThreaded()) {
+    return 1;
+  }
+  int max_task_count = running_processor.thread_pool->getMaxConcurrentTasks();
+  if (const int processor_max_task_count = running_processor.processor->getAutoscalingMaxConcurrentTasks(); processor_max_task_count > 0) {
+    max_task_count = std::min(processor_max_task_count, max_task_count);
+  } else if (autoscaling_max_concurrent_tasks_ > 0) {
+    max_task_count = std::min(gsl::narrow<int>(autoscaling_max_concurrent_tasks_), max_task_count);
+  }
+  return max_task_count;
+}
+
+bool ThreadedSchedulingAgent::canIncreaseThreads() const {
+  auto thread_manager = std::dynamic_pointer_cast<controllers::ThreadManagementService>(controller_service_provider_->getControllerService("ThreadPoolManager"));
+  return !thread_manager || thread_manager->canIncrease();
+}
+
+void ThreadedSchedulingAgent::autoscale() {
+  if (!running_) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  const bool can_increase_threads = canIncreaseThreads();
+  for (auto& [processor_id, running_processor] : processors_running_) {
+    auto* processor = running_processor.processor;
+    const auto sample = ConcurrentTaskAutoscaler::Sample::of(*processor);
+    const int task_count = running_processor.concurrent_tasks->target_count;
+    const auto decision = ConcurrentTaskAutoscaler::decide(running_processor.last_sample, sample, task_count,
+        getMinConcurrentTasks(running_processor), getMaxConcurrentTasks(running_processor));
+    running_processor.last_sample = sample;
+    if (decision.task_count == task_count || (decision.task_count > task_count && !can_increase_threads)) {
+      continue;
+    }
+
+    logger_->log_info("Changing the concurrent tasks of processor {} from {} to {}, because {}", processor->getName(), task_count, decision.task_count, decision.reason);
+    auto& metrics = processor->getMetrics();
+    metrics.concurrent_tasks = decision.task_count;
+    if (decision.task_count > task_count) {
+      ++metrics.concurrent_task_scale_ups;
+    } else {
+      ++metrics.concurrent_task_scale_downs;
+    }
+    // excess tasks retire when they are run next time
+    running_processor.concurrent_tasks->target_count = decision.task_count;
+    while (running_processor.concurrent_tasks->reserveMissingTask()) {
+      executeTask(running_processor);
+    }
   }
-  logger_->log_debug("Scheduled thread {} concurrent workers for for process {}", processor->getMaxConcurrentTasks(), processor->getName());
-  processors_running_.insert(processor->getUUID());
 }
 
 void ThreadedSchedulingAgent::stop() {
   SchedulingAgent::stop();
   std::lock_guard<std::mutex> lock(mutex_);
-  for (const auto& processor_id : processors_running_) {
+  for (const auto& [processor_id, running_processor] : processors_running_) {
     logger_->log_error("SchedulingAgent is stopped before processor was unscheduled: {}", processor_id.to_string());
-    thread_pool_.stopTasks(processor_id.to_string());
+    running_processor.thread_pool->stopTasks(processor_id.to_string());
   }
 }
 
@@ -124,9 +237,14 @@ void ThreadedSchedulingAgent::unschedule(core::Processor* processor) {
     return;
   }
 
-  thread_pool_.stopTasks(processor->getUUIDStr());
+  if (const auto it = processors_running_.find(processor->getUUID()); it != processors_running_.end()) {
+    it->second.thread_pool->stopTasks(processor->getUUIDStr());
+  } else {
+    getThreadPool(*processor).stopTasks(processor->getUUIDStr());
+  }
 
   processor->clearActiveTask();
+  processor->getMetrics().concurrent_tasks = 0;
 
   processor->setScheduledState(core::STOPPED);
 
@@ -45,6 +45,7 @@
 #include "io/StreamPipe.h"
 #include "utils/Id.h"
 #include "c2/C2Utils.h"
+#include "provenance/ProvenanceQuery.h"
 
 using namespace std::literals::chrono_literals;
 
@@ -585,6 +586,51 @@ void C2Agent::handle_describe(const C2ContentResponse &resp) {
       enqueue_c2_response(std::move(response));
       break;
     }
+    case DescribeOperand::provenance: {
+      std::map<std::string, std::string> arguments;
+      for (const auto& [name, value] : resp.operation_arguments) {
+        arguments[name] = value.to_string();
+      }
+      const auto query = provenance::ProvenanceQuery::parse(arguments);
+      const auto result = query ? update_sink_->queryProvenance(*query) : std::nullopt;
+      if (!result) {
+        C2Payload response(Operation::acknowledge, state::UpdateState::NOT_APPLIED, resp.ident, true);
+        response.setRawData(query ? std::string{"The provenance repository does not support queries"} : query.error());
+        enqueue_c2_response(std::move(response));
+        break;
+      }
+      C2Payload response(Operation::acknowledge, resp.ident, true);
+      response.setLabel("provenance");
+      C2ContentResponse truncated(Operation::acknowledge);
+      truncated.name = "provenanceTruncated";
+      truncated.operation_arguments["provenanceTruncated"] = std::string{result->truncated ? "true" : "false"};
+      response.addContent(std::move(truncated));
+      C2Payload events_payload(Operation::acknowledge, resp.ident, true);
+      events_payload.setLabel("provenance");
+      for (const auto& event : result->events) {
+        C2Payload event_payload(Operation::acknowledge, resp.ident, true);
+        event_payload.setLabel(event->getEventId().to_string());
+        const auto event_time = std::chrono::duration_cast<std::chrono::milliseconds>(event->getEventTime().time_since_epoch());
+        for (const auto& [name, value] : std::initializer_list<std::pair<std::string, std::string>>{
+            {"eventType", std::string{magic_enum::enum_name(event->getEventType())}},
+            {"eventTime", std::to_string(event_time.count())},
+            {"componentId", event->getComponentId()},
+            {"componentType", event->getComponentType()},
+            {"flowFileUuid", event->getFlowFileUuid().to_string()},
+            {"fileSize", std::to_string(event->getFileSize())},
+            {"details", event->getDetails()},
+            {"transitUri", event->getTransitUri()}}) {
+          C2ContentResponse entry(Operation::acknowledge);
+          entry.name = name;
+          entry.operation_arguments[name] = value;
+          event_payload.addContent(std::move(entry));
+        }
+        events_payload.addPayload(std::move(event_payload));
+      }
+      response.addPayload(std::move(events_payload));
+      enqueue_c2_response(std::move(response));
+      break;
+    }
   }
 }
 
@@ -32,6 +32,7 @@
 #include "asio/detached.hpp"
 #include "utils/net/AsioSocketUtils.h"
 #include "c2/C2Utils.h"
+#include "provenance/ProvenanceQuery.h"
 
 namespace org::apache::nifi::minifi::c2 {
 
@@ -357,6 +358,27 @@ void ControllerSocketProtocol::writeJstackResponse(io::BaseStream &stream) {
   stream.write(resp.getBuffer());
 }
 
+void ControllerSocketProtocol::writeProvenanceResponse(io::BaseStream &stream) {
+  std::string query_string;
+  if (io::isError(stream.read(query_string))) {
+    logger_->log_error("Connection broke");
+    return;
+  }
+  io::BufferStream resp;
+  auto op = static_cast<uint8_t>(Operation::describe);
+  resp.write(&op, 1);
+  const auto query = provenance::ProvenanceQuery::parse(query_string);
+  const auto result = query ? update_sink_.queryProvenance(*query) : std::nullopt;
+  if (result) {
+    resp.write(true);
+    resp.write(provenance::toJson(*result), true);
+  } else {
+    resp.write(false);
+    resp.write(query ? std::string{"The provenance repository does not support queries"} : query.error(), true);
+  }
+  stream.write(resp.getBuffer());
+}
+
 void ControllerSocketProtocol::handleDescribe(io::BaseStream &stream) {
   std::string what;
   const auto size = stream.read(what);
@@ -376,6 +398,8 @@ void ControllerSocketProtocol::handleDescribe(io::BaseStream &stream) {
     writeManifestResponse(stream);
   } else if (what == "jstack") {
     writeJstackResponse(stream);
+  } else if (what == "provenance") {
+    writeProvenanceResponse(stream);
   } else {
     logger_->log_error("Unknown C2 describe parameter: {}", what);
   }
@@ -122,6 +122,17 @@ void Connectable::notifyWork() {
       work_condition_.notify_one();
     }
   }
+
+  // the scheduler is woken up even if the new flow files are penalized, as it only waits while the incoming connections are empty
+  std::lock_guard<std::mutex> lock(work_available_mutex_);
+  if (work_notifier_) {
+    work_notifier_();
+  }
+}
+
+void Connectable::setWorkNotifier(std::function<void()> work_notifier) {
+  std::lock_guard<std::mutex> lock(work_available_mutex_);
+  work_notifier_ = std::move(work_notifier);
 }
 
 std::set<Connectable*> Connectable::getOutGoingConnections(const std::string &relationship) {
@@ -0,0 +1,128 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "core/ContentHashIndex.h"
+
+#include <openssl/evp.h>
+
+#include <utility>
+#include <vector>
+
+#include "io/Stream.h"
+
+namespace org::apache::nifi::minifi::core {
+
+namespace {
+std::string toKey(const ContentHashIndex::Hash& hash) {
+  return {reinterpret_cast<const char*>(hash.data()), hash.size()};
+}
+}  // namespace
+
+struct ContentHashIndex::Hasher::Context {
+  Context() : ctx(EVP_MD_CTX_new()) {
+    EVP_DigestInit_ex(ctx, EVP_sha256(), nullptr);
+  }
+  Context(const Context&) = delete;
+  Context& operator=(const Context&) = delete;
+  ~Context() {
+    EVP_MD_CTX_free(ctx);
+  }
+
+  EVP_MD_CTX* ctx;
+};
+
+ContentHashIndex::Hasher::Hasher() : context_(std::make_unique<Context>()) {}
+ContentHashIndex::Hasher::Hasher(Hasher&&) noexcept = default;
+ContentHashIndex::Hasher& ContentHashIndex::Hasher::operator=(Hasher&&) noexcept = default;
+ContentHashIndex::Hasher::~Hasher() = default;
+
+void ContentHashIndex::Hasher::update(std::span<const std::byte> data) {
+  EVP_DigestUpdate(context_->ctx, data.data(), data.size());
+}
+
+ContentHashIndex::Hash ContentHashIndex::Hasher::finish() {
+  static_assert(std::tuple_size_v<Hash> == 32, "the hash has to fit a SHA-256 digest");
+  Hash digest{};
+  EVP_DigestFinal_ex(context_->ctx, reinterpret_cast<unsigned char*>(digest.data()), nullptr);
+  return digest;
+}
+
+std::optional<ContentHashIndex::Hash> ContentHashIndex::hash(io::InputStream& stream) {
+  Hasher hasher;
+  std::vector<std::byte> buffer(64 * 1024);
+  while (true) {
+    const auto ret = stream.read(buffer);
+    if (io::isError(ret)) {
+      return std::nullopt;
+    }
+    if (ret == 0) {
+      break;
+    }
+    hasher.update(std::span(buffer).first(ret));
+  }
+  return hasher.finish();
+}
+
+std::optional<std::string> ContentHashIndex::find(const Hash& hash) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (auto it = content_paths_by_hash_.find(toKey(hash)); it != content_paths_by_hash_.end()) {
+    return it->second;
+  }
+  return std::nullopt;
+}
+
+void ContentHashIndex::add(const Hash& hash, const std::string& content_path) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto key = toKey(hash);
+  if (auto [it, inserted] = content_paths_by_hash_.try_emplace(key, content_path); !inserted) {
+    hashes_by_content_path_.erase(std::exchange(it->second, content_path));
+  }
+  hashes_by_content_path_[content_path] = std::move(key);
+}
+
+void ContentHashIndex::remove(const std::string& content_path) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (auto it = hashes_by_content_path_.find(content_path); it != hashes_by_content_path_.end()) {
+    content_paths_by_hash_.erase(it->second);
+    hashes_by_content_path_.erase(it);
+  }
+}
+
+void ContentHashIndex::recordUniqueClaim() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++checked_claim_count_;
+}
+
+void ContentHashIndex::recordDuplicateClaim(uint64_t size) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++checked_claim_count_;
+  ++deduplicated_claim_count_;
+  bytes_saved_ += size;
+}
+
+RepositoryMetricsSource::DeduplicationStats ContentHashIndex::getStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return {
+    .checked_claim_count = checked_claim_count_,
+    .deduplicated_claim_count = deduplicated_claim_count_,
+    .hit_rate = checked_claim_count_ == 0 ? 0.0 : static_cast<double>(deduplicated_claim_count_) / static_cast<double>(checked_claim_count_),
+    .bytes_saved = bytes_saved_
+  };
+}
+
+}  // namespace org::apache::nifi::minifi::core
@@ -135,8 +135,12 @@ std::chrono::system_clock::time_point FlowFile::getlineageStartDate() const {
   return lineage_start_date_;
 }
 
-std::vector<utils::Identifier> &FlowFile::getlineageIdentifiers() {
-  return lineage_Identifiers_;
+const std::vector<utils::Identifier>& FlowFile::getlineageIdentifiers() const {
+  return *lineage_Identifiers_;
+}
+
+void FlowFile::addLineageIdentifier(const utils::Identifier& lineage_identifier) {
+  lineage_Identifiers_.mutate().push_back(lineage_identifier);
 }
 
 bool FlowFile::getAttribute(std::string_view key, std::string& value) const {
@@ -149,8 +153,8 @@ bool FlowFile::getAttribute(std::string_view key, std::string& value) const {
 }
 
 std::optional<std::string> FlowFile::getAttribute(std::string_view key) const {
-  auto it = attributes_.find(key);
-  if (it != attributes_.end()) {
+  auto it = attributes_->find(key);
+  if (it != attributes_->end()) {
     return it->second;
   }
   return std::nullopt;
@@ -160,38 +164,46 @@ std::optional<std::string> FlowFile::getAttribute(std::string_view key) const {
 uint64_t FlowFile::getSize() const {
   return size_;
 }
+
+size_t FlowFile::getEstimatedMemoryUsage() const {
+  size_t memory_usage = sizeof(FlowFile);
+  // the attribute keys are interned, so only the values are owned by the flow file
+  for (const auto& [key, value] : *attributes_) {
+    memory_usage += sizeof(AttributeMap::value_type) + value.size();
+  }
+  memory_usage += lineage_Identifiers_->size() * sizeof(utils::Identifier);
+  return memory_usage;
+}
 // ! Get Offset
 uint64_t FlowFile::getOffset() const {
   return offset_;
 }
 
 bool FlowFile::removeAttribute(std::string_view key) {
-  auto it = attributes_.find(key);
-  if (it != attributes_.end()) {
-    attributes_.erase(it);
-    return true;
-  } else {
+  // only copy the shared attributes if they are going to change
+  if (!attributes_->contains(key)) {
     return false;
   }
+  auto& attributes = attributes_.mutate();
+  attributes.erase(attributes.find(key));
+  return true;
 }
 
 bool FlowFile::updateAttribute(std::string_view key, const std::string& value) {
-  auto it = attributes_.find(key);
-  if (it != attributes_.end()) {
-    it->second = value;
-    return true;
-  } else {
+  if (!attributes_->contains(key)) {
     return false;
   }
+  attributes_.mutate().find(key)->second = value;
+  return true;
 }
 
 bool FlowFile::addAttribute(std::string_view key, const std::string& value) {
-  auto it = attributes_.find(key);
-  if (it != attributes_.end()) {
+  auto it = attributes_->find(key);
+  if (it != attributes_->end()) {
     // attribute already there in the map
     return false;
   } else {
-    attributes_[key] = value;
+    attributes_.mutate()[key] = value;
     return true;
   }
 }
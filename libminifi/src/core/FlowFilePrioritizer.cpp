@@ -0,0 +1,78 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "core/FlowFilePrioritizer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <string>
+
+#include "utils/ValueParser.h"
+
+namespace org::apache::nifi::minifi::core {
+
+namespace {
+int64_t entryDateKey(const FlowFile& flow_file) {
+  // the entry date is persisted with millisecond precision, the key has to be the same after a swap-in
+  return std::chrono::duration_cast<std::chrono::milliseconds>(flow_file.getEntryDate().time_since_epoch()).count();
+}
+}  // namespace
+
+std::shared_ptr<FlowFilePrioritizer> FlowFilePrioritizer::create(std::string_view name) {
+  if (const auto last_dot = name.rfind('.'); last_dot != std::string_view::npos) {
+    name.remove_prefix(last_dot + 1);
+  }
+  if (name == FirstInFirstOutPrioritizer::Name) {
+    return std::make_shared<FirstInFirstOutPrioritizer>();
+  }
+  if (name == OldestFlowFileFirstPrioritizer::Name) {
+    return std::make_shared<OldestFlowFileFirstPrioritizer>();
+  }
+  if (name == NewestFlowFileFirstPrioritizer::Name) {
+    return std::make_shared<NewestFlowFileFirstPrioritizer>();
+  }
+  if (name == PriorityAttributePrioritizer::Name) {
+    return std::make_shared<PriorityAttributePrioritizer>();
+  }
+  if (name == SmallestFlowFileFirstPrioritizer::Name) {
+    return std::make_shared<SmallestFlowFileFirstPrioritizer>();
+  }
+  return nullptr;
+}
+
+int64_t OldestFlowFileFirstPrioritizer::getPriorityKey(const FlowFile& flow_file) const {
+  return entryDateKey(flow_file);
+}
+
+int64_t NewestFlowFileFirstPrioritizer::getPriorityKey(const FlowFile& flow_file) const {
+  return -entryDateKey(flow_file);
+}
+
+int64_t PriorityAttributePrioritizer::getPriorityKey(const FlowFile& flow_file) const {
+  const auto priority = flow_file.getAttribute(PriorityAttribute);
+  if (!priority) {
+    return std::numeric_limits<int64_t>::max();
+  }
+  return utils::toNumber<int64_t>(*priority).value_or(std::numeric_limits<int64_t>::max());
+}
+
+int64_t SmallestFlowFileFirstPrioritizer::getPriorityKey(const FlowFile& flow_file) const {
+  return static_cast<int64_t>(std::min<uint64_t>(flow_file.getSize(), std::numeric_limits<int64_t>::max()));
+}
+
+}  // namespace org::apache::nifi::minifi::core
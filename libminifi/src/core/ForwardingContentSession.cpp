@@ -18,7 +18,9 @@
 
 #include "core/ForwardingContentSession.h"
 
+#include <filesystem>
 #include <memory>
+#include <optional>
 
 #include "core/ContentRepository.h"
 #include "ResourceClaim.h"
@@ -50,6 +52,20 @@ std::shared_ptr<io::BaseStream> ForwardingContentSession::read(const std::shared
   return repository_->read(*resource_id);
 }
 
+auto ForwardingContentSession::importFile(const std::filesystem::path& source, uint64_t offset, bool keep_source) -> std::optional<ImportedClaim> {
+  auto claim = std::make_shared<ResourceClaim>(repository_);
+  const auto size = repository_->importFile(*claim, source, offset, keep_source);
+  if (!size) {
+    return std::nullopt;
+  }
+  created_claims_.insert(claim);
+  return ImportedClaim{.claim = std::move(claim), .size = *size};
+}
+
+bool ForwardingContentSession::exportFile(const std::shared_ptr<ResourceClaim>& resource_id, uint64_t offset, uint64_t size, const std::filesystem::path& destination) {
+  return repository_->exportFile(*resource_id, offset, size, destination);
+}
+
 void ForwardingContentSession::commit() {
   created_claims_.clear();
 }
@@ -198,6 +198,22 @@ void ProcessGroup::startProcessing(TimerDrivenSchedulingAgent& timeScheduler, Ev
   }
 }
 
+void ProcessGroup::assignThreadPartitions(const std::map<std::string, std::string>& partition_by_process_group, const std::string& parent_partition) {
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  auto partition = parent_partition;
+  if (const auto it = partition_by_process_group.find(getUUIDStr()); it != partition_by_process_group.end()) {
+    partition = it->second;
+  } else if (const auto it = partition_by_process_group.find(getName()); it != partition_by_process_group.end()) {
+    partition = it->second;
+  }
+  for (const auto& processor : processors_) {
+    processor->setThreadPartition(partition);
+  }
+  for (const auto& child_group : child_process_groups_) {
+    child_group->assignThreadPartitions(partition_by_process_group, partition);
+  }
+}
+
 void ProcessGroup::stopProcessing(TimerDrivenSchedulingAgent& timeScheduler, EventDrivenSchedulingAgent& eventScheduler,
                                   CronDrivenSchedulingAgent& cronScheduler, const std::function<bool(const Processor*)>& filter) {
   std::lock_guard<std::recursive_mutex> lock(mutex_);
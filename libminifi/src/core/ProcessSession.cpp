@@ -23,6 +23,7 @@
 #include <chrono>
 #include <cinttypes>
 #include <ctime>
+#include <filesystem>
 #include <iostream>
 #include <map>
 #include <memory>
@@ -68,7 +69,8 @@ ProcessSession::ProcessSession(std::shared_ptr<ProcessContext> processContext)
           stateManager_(process_context_->hasStateManager() ? process_context_->getStateManager() : nullptr) {
   logger_->log_trace("ProcessSession created for {}", process_context_->getProcessorNode()->getName());
   auto repo = process_context_->getProvenanceRepository();
-  provenance_report_ = std::make_shared<provenance::ProvenanceReporter>(repo, process_context_->getProcessorNode()->getName(), process_context_->getProcessorNode()->getName());
+  provenance_report_ = std::make_shared<provenance::ProvenanceReporter>(repo, process_context_->getProcessorNode()->getName(), process_context_->getProcessorNode()->getName(),
+      process_context_->getProvenanceSampling(), process_context_->getRecordFormat());
   content_session_ = process_context_->getContentRepository()->createSession();
 
   if (stateManager_ && !stateManager_->beginTransaction()) {
@@ -101,7 +103,7 @@ std::shared_ptr<core::FlowFile> ProcessSession::create(const std::shared_ptr<cor
 
   if (parent) {
     // Copy attributes
-    for (const auto& attribute : parent->getAttributes()) {
+    for (const auto& attribute : parent->getAttributeMap()) {
       if (attribute.first == SpecialFlowAttribute::ALTERNATE_IDENTIFIER || attribute.first == SpecialFlowAttribute::DISCARD_REASON || attribute.first == SpecialFlowAttribute::UUID) {
         // Do not copy special attributes from parent
         continue;
@@ -110,15 +112,13 @@ std::shared_ptr<core::FlowFile> ProcessSession::create(const std::shared_ptr<cor
     }
     record->setLineageStartDate(parent->getlineageStartDate());
     record->setLineageIdentifiers(parent->getlineageIdentifiers());
-    parent->getlineageIdentifiers().push_back(parent->getUUID());
+    parent->addLineageIdentifier(parent->getUUID());
   }
 
   utils::Identifier uuid = record->getUUID();
   added_flowfiles_[uuid].flow_file = record;
   logger_->log_debug("Create FlowFile with UUID {}", record->getUUIDStr());
-  std::stringstream details;
-  details << process_context_->getProcessorNode()->getName() << " creates flow record " << record->getUUIDStr();
-  provenance_report_->create(record, details.str());
+  provenance_report_->create(record);
 
   return record;
 }
@@ -149,7 +149,7 @@ std::shared_ptr<core::FlowFile> ProcessSession::cloneDuringTransfer(const std::s
   this->cloned_flowfiles_.push_back(record);
   logger_->log_debug("Clone FlowFile with UUID {} during transfer", record->getUUIDStr());
   // Copy attributes
-  for (const auto& attribute : parent->getAttributes()) {
+  for (const auto& attribute : parent->getAttributeMap()) {
     if (attribute.first == SpecialFlowAttribute::ALTERNATE_IDENTIFIER
         || attribute.first == SpecialFlowAttribute::DISCARD_REASON
         || attribute.first == SpecialFlowAttribute::UUID) {
@@ -160,7 +160,7 @@ std::shared_ptr<core::FlowFile> ProcessSession::cloneDuringTransfer(const std::s
   }
   record->setLineageStartDate(parent->getlineageStartDate());
   record->setLineageIdentifiers(parent->getlineageIdentifiers());
-  record->getlineageIdentifiers().push_back(parent->getUUID());
+  record->addLineageIdentifier(parent->getUUID());
 
   // Copy Resource Claim
   std::shared_ptr<ResourceClaim> parent_claim = parent->getResourceClaim();
@@ -198,22 +198,17 @@ void ProcessSession::remove(const std::shared_ptr<core::FlowFile> &flow) {
   logger_->log_trace("Removing flow file with UUID: {}", flow->getUUIDStr());
   flow->setDeleted(true);
   deleted_flowfiles_.push_back(flow);
-  std::string reason = process_context_->getProcessorNode()->getName() + " drop flow record " + flow->getUUIDStr();
-  provenance_report_->drop(flow, reason);
+  provenance_report_->drop(flow);
 }
 
 void ProcessSession::putAttribute(const std::shared_ptr<core::FlowFile>& flow, std::string_view key, const std::string& value) {
   flow->setAttribute(key, value);
-  std::stringstream details;
-  details << process_context_->getProcessorNode()->getName() << " modify flow record " << flow->getUUIDStr() << " attribute " << key << ":" << value;
-  provenance_report_->modifyAttributes(flow, details.str());
+  provenance_report_->modifyAttribute(flow, key);
 }
 
 void ProcessSession::removeAttribute(const std::shared_ptr<core::FlowFile>& flow, std::string_view key) {
   flow->removeAttribute(key);
-  std::stringstream details;
-  details << process_context_->getProcessorNode()->getName() << " remove flow record " << flow->getUUIDStr() << " attribute " << key;
-  provenance_report_->modifyAttributes(flow, details.str());
+  provenance_report_->removeAttribute(flow, key);
 }
 
 void ProcessSession::penalize(const std::shared_ptr<core::FlowFile> &flow) {
@@ -256,9 +251,8 @@ void ProcessSession::write(const std::shared_ptr<core::FlowFile> &flow, const io
     flow->setResourceClaim(claim);
 
     stream->close();
-    std::string details = process_context_->getProcessorNode()->getName() + " modify flow record content " + flow->getUUIDStr();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start_time);
-    provenance_report_->modifyContent(flow, details, duration);
+    provenance_report_->modifyContent(flow, duration);
   } catch (const std::exception& exception) {
     logger_->log_debug("Caught Exception during process session write, type: {}, what: {}", typeid(exception).name(), exception.what());
     throw;
@@ -307,10 +301,8 @@ void ProcessSession::append(const std::shared_ptr<core::FlowFile> &flow, const i
     }
     flow->setSize(flow_file_size + (stream->size() - stream_size_before_callback));
 
-    std::stringstream details;
-    details << process_context_->getProcessorNode()->getName() << " modify flow record content " << flow->getUUIDStr();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start_time);
-    provenance_report_->modifyContent(flow, details.str(), duration);
+    provenance_report_->modifyContent(flow, duration);
   } catch (const std::exception& exception) {
     logger_->log_debug("Caught Exception during process session append, type: {}, what: {}", typeid(exception).name(), exception.what());
     throw;
@@ -471,10 +463,8 @@ void ProcessSession::importFrom(io::InputStream &stream, const std::shared_ptr<c
         flow->getOffset(), flow->getSize(), flow->getResourceClaim()->getContentFullPath(), flow->getUUIDStr());
 
     content_stream->close();
-    std::stringstream details;
-    details << process_context_->getProcessorNode()->getName() << " modify flow record content " << flow->getUUIDStr();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start_time);
-    provenance_report_->modifyContent(flow, details.str(), duration);
+    provenance_report_->modifyContent(flow, duration);
   } catch (const std::exception& exception) {
     logger_->log_debug("Caught Exception during ProcessSession::importFrom, type: {}, what: {}", typeid(exception).name(), exception.what());
     throw;
@@ -485,6 +475,13 @@ void ProcessSession::importFrom(io::InputStream &stream, const std::shared_ptr<c
 }
 
 void ProcessSession::import(const std::string& source, const std::shared_ptr<FlowFile> &flow, bool keepSource, uint64_t offset) {
+  if (tryKernelImport(source, flow, keepSource, offset)) {
+    if (!keepSource) {
+      (void)std::remove(source.c_str());
+    }
+    return;
+  }
+
   std::shared_ptr<ResourceClaim> claim = content_session_->create();
   size_t size = getpagesize();
   std::vector<uint8_t> charBuffer(size);
@@ -536,10 +533,8 @@ void ProcessSession::import(const std::string& source, const std::shared_ptr<Flo
         if (!keepSource) {
           (void)std::remove(source.c_str());
         }
-        std::stringstream details;
-        details << process_context_->getProcessorNode()->getName() << " modify flow record content " << flow->getUUIDStr();
         auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start_time);
-        provenance_report_->modifyContent(flow, details.str(), duration);
+        provenance_report_->modifyContent(flow, duration);
       } else {
         stream->close();
         input.close();
@@ -634,9 +629,8 @@ void ProcessSession::import(const std::string& source, std::vector<std::shared_p
         logger_->log_debug("Import offset {} length {} into content {}, FlowFile UUID {}",
             flowFile->getOffset(), flowFile->getSize(), flowFile->getResourceClaim()->getContentFullPath(), flowFile->getUUIDStr());
         stream->close();
-        std::string details = process_context_->getProcessorNode()->getName() + " modify flow record content " + flowFile->getUUIDStr();
         auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start_time);
-        provenance_report_->modifyContent(flowFile, details, duration);
+        provenance_report_->modifyContent(flowFile, duration);
         flows.push_back(flowFile);
 
         /* Reset these to start processing the next FlowFile with a clean slate */
@@ -686,6 +680,18 @@ void ProcessSession::import(const std::string& source, std::vector<std::shared_p
 bool ProcessSession::exportContent(const std::string &destination, const std::string &tmpFile, const std::shared_ptr<core::FlowFile> &flow, bool /*keepContent*/) {
   logger_->log_debug("Exporting content of {} to {}", flow->getUUIDStr(), destination);
 
+  if (tryKernelExport(flow, tmpFile)) {
+    std::error_code rename_error;
+    std::filesystem::rename(tmpFile, destination, rename_error);
+    if (!rename_error) {
+      logger_->log_info("Commit OK.");
+      return true;
+    }
+    logger_->log_error("Commit of {} to {} failed!", flow->getUUIDStr(), destination);
+    std::filesystem::remove(tmpFile, rename_error);
+    return false;
+  }
+
   ProcessSessionReadCallback cb(tmpFile, destination, logger_);
   read(flow, std::ref(cb));
 
@@ -709,6 +715,32 @@ bool ProcessSession::exportContent(const std::string &destination, const std::sh
   return exportContent(destination, tmpFileName, flow, keepContent);
 }
 
+bool ProcessSession::tryKernelImport(const std::filesystem::path& source, const std::shared_ptr<core::FlowFile>& flow, bool keepSource, uint64_t offset) {
+  auto start_time = std::chrono::steady_clock::now();
+  const auto imported = content_session_->importFile(source, offset, keepSource);
+  if (!imported) {
+    return false;
+  }
+  flow->setSize(imported->size);
+  flow->setOffset(0);
+  flow->setResourceClaim(imported->claim);
+
+  logger_->log_debug("Import offset {} length {} into content {} for FlowFile UUID {} by the kernel",
+      flow->getOffset(), flow->getSize(), flow->getResourceClaim()->getContentFullPath(), flow->getUUIDStr());
+
+  auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start_time);
+  provenance_report_->modifyContent(flow, duration);
+  return true;
+}
+
+bool ProcessSession::tryKernelExport(const std::shared_ptr<core::FlowFile>& flow, const std::filesystem::path& destination) {
+  const auto claim = flow->getResourceClaim();
+  if (!claim || flow->getSize() == 0) {
+    return false;
+  }
+  return content_session_->exportFile(claim, flow->getOffset(), flow->getSize(), destination);
+}
+
 void ProcessSession::stash(const std::string &key, const std::shared_ptr<core::FlowFile> &flow) {
   logger_->log_debug("Stashing content from {} to key {}", flow->getUUIDStr(), key);
 
@@ -1014,11 +1046,18 @@ void ProcessSession::persistFlowFilesBeforeTransfer(
   };
 
   // collect serialized flowfiles
+  const auto record_format = process_context_->getRecordFormat();
   forEachFlowFile(Type::Transferred, [&] (auto& ff, auto& /*original*/) {
-    auto stream = std::make_unique<io::BufferStream>();
-    std::static_pointer_cast<FlowFileRecord>(ff)->Serialize(*stream);
+    if (record_format == io::RecordFormat::LEGACY) {
+      auto stream = std::make_unique<io::BufferStream>();
+      std::static_pointer_cast<FlowFileRecord>(ff)->Serialize(*stream, record_format);
+      flowData.emplace_back(ff->getUUIDStr(), std::move(stream));
+      return;
+    }
+    serialization_buffer_.clear();
+    std::static_pointer_cast<FlowFileRecord>(ff)->Serialize(serialization_buffer_);
 
-    flowData.emplace_back(ff->getUUIDStr(), std::move(stream));
+    flowData.emplace_back(ff->getUUIDStr(), std::make_unique<io::BufferStream>(serialization_buffer_));
   });
 
   // increment on behalf of the to be persisted instance
@@ -1072,56 +1111,86 @@ void ProcessSession::ensureNonNullResourceClaim(
   }
 }
 
-std::shared_ptr<core::FlowFile> ProcessSession::get() {
-  const auto first = process_context_->getProcessorNode()->pickIncomingConnection();
-
-  if (first == nullptr) {
+Connection* ProcessSession::pickIncomingConnection() const {
+  const auto incoming = process_context_->getProcessorNode()->pickIncomingConnection();
+  if (incoming == nullptr) {
     logger_->log_trace("Get is null for {}", process_context_->getProcessorNode()->getName());
     return nullptr;
   }
-
-  auto current = dynamic_cast<Connection*>(first);
-  if (!current) {
+  auto connection = dynamic_cast<Connection*>(incoming);
+  if (!connection) {
     logger_->log_error("The incoming connection [{}] of the processor [{}] \"{}\" is not actually a Connection.",
-                       first->getUUIDStr(), process_context_->getProcessorNode()->getUUIDStr(), process_context_->getProcessorNode()->getName());
-    return {};
+                       incoming->getUUIDStr(), process_context_->getProcessorNode()->getUUIDStr(), process_context_->getProcessorNode()->getName());
   }
+  return connection;
+}
 
-  do {
+void ProcessSession::addPolledFlowFile(const std::shared_ptr<core::FlowFile>& flow_file, const std::shared_ptr<state::FlowIdentifier>& flow_version) {
+  // add the flow record to the current process session update map
+  flow_file->setDeleted(false);
+  std::shared_ptr<FlowFile> snapshot = std::make_shared<FlowFileRecord>();
+  *snapshot = *flow_file;
+  logger_->log_debug("Create Snapshot FlowFile with UUID {}", snapshot->getUUIDStr());
+  updated_flowfiles_[flow_file->getUUID()] = {flow_file, snapshot};
+  if (flow_version != nullptr) {
+    flow_file->setAttribute(SpecialFlowAttribute::FLOW_ID, flow_version->getFlowId());
+  }
+}
+
+void ProcessSession::removeExpiredFlowFiles(const std::set<std::shared_ptr<core::FlowFile>>& expired) {
+  for (const auto& record : expired) {
+    provenance_report_->expire(record);
+    // there is no rolling back expired FlowFiles
+    if (record->isStored() && process_context_->getFlowFileRepository()->Delete(record->getUUIDStr())) {
+      record->setStoredToRepository(false);
+    }
+  }
+}
+
+std::shared_ptr<core::FlowFile> ProcessSession::get() {
+  const auto first = pickIncomingConnection();
+  auto current = first;
+  while (current != nullptr) {
     std::set<std::shared_ptr<core::FlowFile> > expired;
     std::shared_ptr<core::FlowFile> ret = current->poll(expired);
-    if (!expired.empty()) {
-      // Remove expired flow record
-      for (const auto& record : expired) {
-        std::stringstream details;
-        details << process_context_->getProcessorNode()->getName() << " expire flow record " << record->getUUIDStr();
-        provenance_report_->expire(record, details.str());
-        // there is no rolling back expired FlowFiles
-        if (record->isStored() && process_context_->getFlowFileRepository()->Delete(record->getUUIDStr())) {
-          record->setStoredToRepository(false);
-        }
-      }
-    }
+    removeExpiredFlowFiles(expired);
     if (ret) {
-      // add the flow record to the current process session update map
-      ret->setDeleted(false);
-      std::shared_ptr<FlowFile> snapshot = std::make_shared<FlowFileRecord>();
-      *snapshot = *ret;
-      logger_->log_debug("Create Snapshot FlowFile with UUID {}", snapshot->getUUIDStr());
-      utils::Identifier uuid = ret->getUUID();
-      updated_flowfiles_[uuid] = {ret, snapshot};
-      auto flow_version = process_context_->getProcessorNode()->getFlowIdentifier();
-      if (flow_version != nullptr) {
-        ret->setAttribute(SpecialFlowAttribute::FLOW_ID, flow_version->getFlowId());
-      }
+      addPolledFlowFile(ret, process_context_->getProcessorNode()->getFlowIdentifier());
       return ret;
     }
-    current = dynamic_cast<Connection*>(process_context_->getProcessorNode()->pickIncomingConnection());
-  } while (current != nullptr && current != first);
+    current = pickIncomingConnection();
+    if (current == first) {
+      break;
+    }
+  }
 
   return nullptr;
 }
 
+std::vector<std::shared_ptr<core::FlowFile>> ProcessSession::get(size_t max_count, uint64_t max_bytes) {
+  std::vector<std::shared_ptr<core::FlowFile>> flow_files;
+  uint64_t total_size = 0;
+  std::set<std::shared_ptr<core::FlowFile>> expired;
+  const auto flow_version = process_context_->getProcessorNode()->getFlowIdentifier();
+  const auto first = pickIncomingConnection();
+  auto current = first;
+  // each incoming connection is drained under a single lock, until the limits are reached
+  while (current != nullptr && flow_files.size() < max_count && total_size < max_bytes) {
+    for (auto& flow_file : current->pollBatch(max_count - flow_files.size(), max_bytes - total_size, expired)) {
+      total_size += flow_file->getSize();
+      addPolledFlowFile(flow_file, flow_version);
+      flow_files.push_back(std::move(flow_file));
+    }
+    current = pickIncomingConnection();
+    if (current == first) {
+      break;
+    }
+  }
+  removeExpiredFlowFiles(expired);
+
+  return flow_files;
+}
+
 void ProcessSession::flushContent() {
   content_session_->commit();
 }
@@ -22,6 +22,7 @@
 #include <ctime>
 #include <cctype>
 
+#include <algorithm>
 #include <memory>
 #include <set>
 #include <string>
@@ -187,12 +188,14 @@ void Processor::onTrigger(const std::shared_ptr<ProcessContext>& context, const
 
   try {
     // Call the virtual trigger function
-    auto start = std::chrono::steady_clock::now();
+    const auto start = std::chrono::steady_clock::now();
     onTriggerSharedPtr(context, session);
-    metrics_->addLastOnTriggerRuntime(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start));
-    start = std::chrono::steady_clock::now();
+    const auto commit_start = std::chrono::steady_clock::now();
+    metrics_->addLastOnTriggerRuntime(std::chrono::duration_cast<std::chrono::milliseconds>(commit_start - start));
     session->commit();
-    metrics_->addLastSessionCommitRuntime(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start));
+    const auto end = std::chrono::steady_clock::now();
+    metrics_->addLastSessionCommitRuntime(std::chrono::duration_cast<std::chrono::milliseconds>(end - commit_start));
+    metrics_->busy_time_nanoseconds += gsl::narrow<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
   } catch (const std::exception& exception) {
     logger_->log_warn("Caught \"{}\" ({}) during Processor::onTrigger of processor: {} ({})",
         exception.what(), typeid(exception).name(), getUUIDStr(), getName());
@@ -230,6 +233,33 @@ bool Processor::isWorkAvailable() {
   return hasWork;
 }
 
+bool Processor::areIncomingConnectionsEmpty() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return std::all_of(incoming_connections_.begin(), incoming_connections_.end(), [](Connectable* conn) {
+    const auto connection = dynamic_cast<Connection*>(conn);
+    return !connection || connection->isEmpty();
+  });
+}
+
+uint64_t Processor::getIncomingQueueSize() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  uint64_t queue_size = 0;
+  for (const auto* conn : incoming_connections_) {
+    if (const auto connection = dynamic_cast<const Connection*>(conn)) {
+      queue_size += connection->getQueueSize();
+    }
+  }
+  return queue_size;
+}
+
+bool Processor::isIncomingBackpressureThresholdReached() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return std::any_of(incoming_connections_.begin(), incoming_connections_.end(), [](const Connectable* conn) {
+    const auto connection = dynamic_cast<const Connection*>(conn);
+    return connection && connection->backpressureThresholdReached();
+  });
+}
+
 // must hold the graphMutex
 void Processor::updateReachability(const std::lock_guard<std::mutex>& graph_lock, bool force) {
   bool didChange = force;
@@ -50,7 +50,10 @@ std::vector<state::response::SerializedResponseNode> ProcessorMetrics::serialize
       {.name = "AverageSessionCommitRunTime", .value = static_cast<uint64_t>(getAverageSessionCommitRuntime().count())},
       {.name = "LastSessionCommitRunTime", .value = static_cast<uint64_t>(getLastSessionCommitRuntime().count())},
       {.name = "TransferredFlowFiles", .value = static_cast<uint32_t>(transferred_flow_files.load())},
-      {.name = "TransferredBytes", .value = transferred_bytes.load()}
+      {.name = "TransferredBytes", .value = transferred_bytes.load()},
+      {.name = "ConcurrentTasks", .value = concurrent_tasks.load()},
+      {.name = "ConcurrentTaskScaleUps", .value = concurrent_task_scale_ups.load()},
+      {.name = "ConcurrentTaskScaleDowns", .value = concurrent_task_scale_downs.load()}
     }
   };
 
@@ -79,7 +82,10 @@ std::vector<state::PublishedMetric> ProcessorMetrics::calculateMetrics() {
     {"average_session_commit_runtime_milliseconds", static_cast<double>(getAverageSessionCommitRuntime().count()), getCommonLabels()},
     {"last_session_commit_runtime_milliseconds", static_cast<double>(getLastSessionCommitRuntime().count()), getCommonLabels()},
     {"transferred_flow_files", static_cast<double>(transferred_flow_files.load()), getCommonLabels()},
-    {"transferred_bytes", static_cast<double>(transferred_bytes.load()), getCommonLabels()}
+    {"transferred_bytes", static_cast<double>(transferred_bytes.load()), getCommonLabels()},
+    {"concurrent_tasks", static_cast<double>(concurrent_tasks.load()), getCommonLabels()},
+    {"concurrent_task_scale_ups", static_cast<double>(concurrent_task_scale_ups.load()), getCommonLabels()},
+    {"concurrent_task_scale_downs", static_cast<double>(concurrent_task_scale_downs.load()), getCommonLabels()}
   };
 
   {
@@ -29,6 +29,8 @@ FlowSchema FlowSchema::getDefault() {
       .processor_properties = {"Properties"},
       .autoterminated_rels = {"auto-terminated relationships list"},
       .max_concurrent_tasks = {"max concurrent tasks"},
+      .autoscaling_min_concurrent_tasks = {"autoscaling min concurrent tasks"},
+      .autoscaling_max_concurrent_tasks = {"autoscaling max concurrent tasks"},
       .penalization_period = {"penalization period"},
       .proc_yield_period = {"yield period"},
       .runduration_nanos = {"run duration nanos"},
@@ -37,12 +39,14 @@ FlowSchema FlowSchema::getDefault() {
       .max_queue_size = {"max work queue size"},
       .max_queue_data_size = {"max work queue data size"},
       .swap_threshold = {"swap threshold"},
+      .swap_threshold_memory_size = {"swap threshold memory size"},
       .source_id = {"source id"},
       .source_name = {"source name"},
       .destination_id = {"destination id"},
       .destination_name = {"destination name"},
       .flowfile_expiration = {"flowfile expiration"},
       .drop_empty = {"drop empty"},
+      .prioritizers = {"prioritizers"},
       .source_relationship = {"source relationship name"},
       .source_relationship_list = {"source relationship names"},
 
@@ -75,7 +79,8 @@ FlowSchema FlowSchema::getDefault() {
       .rpg_input_ports = {"Input Ports"},
       .rpg_output_ports = {"Output Ports"},
       .rpg_port_properties = {"Properties"},
-      .rpg_port_target_id = {}
+      .rpg_port_target_id = {},
+      .rpg_port_use_compression = {}
   };
 }
 
@@ -87,6 +92,9 @@ FlowSchema FlowSchema::getNiFiFlowJson() {
       .processor_properties = {"properties"},
       .autoterminated_rels = {"autoTerminatedRelationships"},
       .max_concurrent_tasks = {"concurrentlySchedulableTaskCount"},
+      // not in nifi, like dropEmpty
+      .autoscaling_min_concurrent_tasks = {"autoscalingMinConcurrentTasks"},
+      .autoscaling_max_concurrent_tasks = {"autoscalingMaxConcurrentTasks"},
       .penalization_period = {"penaltyDuration"},
       .proc_yield_period = {"yieldDuration"},
       // TODO(adebreceni): MINIFICPP-2033 since this is unused the mismatch between nano and milli is not an issue
@@ -96,6 +104,7 @@ FlowSchema FlowSchema::getNiFiFlowJson() {
       .max_queue_size = {"backPressureObjectThreshold"},
       .max_queue_data_size = {"backPressureDataSizeThreshold"},
       .swap_threshold = {},
+      .swap_threshold_memory_size = {},
       .source_id = {"source/id"},
       .source_name = {"source/name"},
       .destination_id = {"destination/id"},
@@ -103,6 +112,7 @@ FlowSchema FlowSchema::getNiFiFlowJson() {
       .flowfile_expiration = {"flowFileExpiration"},
       // contrary to nifi we support dropEmpty in flow json as well
       .drop_empty = {"dropEmpty"},
+      .prioritizers = {"prioritizers"},
       .source_relationship = {},
       .source_relationship_list = {"selectedRelationships"},
 
@@ -135,7 +145,8 @@ FlowSchema FlowSchema::getNiFiFlowJson() {
       .rpg_input_ports = {"inputPorts"},
       .rpg_output_ports = {"outputPorts"},
       .rpg_port_properties = {},
-      .rpg_port_target_id = {"targetId"}
+      .rpg_port_target_id = {"targetId"},
+      .rpg_port_use_compression = {"useCompression"}
   };
 }
 
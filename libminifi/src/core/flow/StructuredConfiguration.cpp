@@ -272,6 +272,22 @@ void StructuredConfiguration::parseProcessorNode(const Node& processors_node, co
       processor->setMaxConcurrentTasks(maxConcurrentTasks);
     }
 
+    if (auto tasksNode = procNode[schema_.autoscaling_min_concurrent_tasks]) {
+      uint8_t min_tasks = 0;
+      if (core::Property::StringToInt(tasksNode.getIntegerAsString().value(), min_tasks)) {
+        logger_->log_debug("parseProcessorNode: autoscaling min concurrent tasks => [{}]", min_tasks);
+        processor->setAutoscalingMinConcurrentTasks(min_tasks);
+      }
+    }
+
+    if (auto tasksNode = procNode[schema_.autoscaling_max_concurrent_tasks]) {
+      uint8_t max_tasks = 0;
+      if (core::Property::StringToInt(tasksNode.getIntegerAsString().value(), max_tasks)) {
+        logger_->log_debug("parseProcessorNode: autoscaling max concurrent tasks => [{}]", max_tasks);
+        processor->setAutoscalingMaxConcurrentTasks(max_tasks);
+      }
+    }
+
     if (core::Property::StringToInt(procCfg.runDurationNanos, runDurationNanos)) {
       logger_->log_debug("parseProcessorNode: runDurationNanos => [{}]", runDurationNanos);
       processor->setRunDurationNano(std::chrono::nanoseconds(runDurationNanos));
@@ -551,6 +567,8 @@ void StructuredConfiguration::parseConnection(const Node& connection_node_seq, c
     connection->setBackpressureThresholdCount(connectionParser.getWorkQueueSize());
     connection->setBackpressureThresholdDataSize(connectionParser.getWorkQueueDataSize());
     connection->setSwapThreshold(connectionParser.getSwapThreshold());
+    connection->setSwapThresholdMemorySize(connectionParser.getSwapThresholdMemorySize());
+    connection->setPrioritizer(connectionParser.getPrioritizer());
     connection->setSourceUUID(connectionParser.getSourceUUID());
     connection->setDestinationUUID(connectionParser.getDestinationUUID());
     connection->setFlowExpirationDuration(connectionParser.getFlowFileExpiration());
@@ -600,6 +618,7 @@ void StructuredConfiguration::parseRPGPort(const Node& port_node, core::ProcessG
     parsePropertiesNode(propertiesNode, *port, nameStr);
   } else {
     parsePropertyNodeElement(std::string(minifi::RemoteProcessorGroupPort::portUUID.name), port_node[schema_.rpg_port_target_id], *port);
+    parsePropertyNodeElement(std::string(minifi::RemoteProcessorGroupPort::useCompression.name), port_node[schema_.rpg_port_use_compression], *port);
     validateComponentProperties(*port, nameStr, port_node.getPath());
   }
 
@@ -107,6 +107,20 @@ uint64_t StructuredConnectionParser::getSwapThreshold() const {
   return 0;
 }
 
+uint64_t StructuredConnectionParser::getSwapThresholdMemorySize() const {
+  const flow::Node swap_threshold_memory_size_node = connectionNode_[schema_.swap_threshold_memory_size];
+  if (swap_threshold_memory_size_node) {
+    auto swap_threshold_memory_size_str = swap_threshold_memory_size_node.getIntegerAsString().value();
+    uint64_t swap_threshold_memory_size = 0;
+    if (core::Property::StringToInt(swap_threshold_memory_size_str, swap_threshold_memory_size)) {
+      logger_->log_debug("Setting {} as the swap threshold memory size.", swap_threshold_memory_size);
+      return swap_threshold_memory_size;
+    }
+    logger_->log_error("Invalid swap threshold memory size value: {}.", swap_threshold_memory_size_str);
+  }
+  return 0;
+}
+
 utils::Identifier StructuredConnectionParser::getSourceUUID() const {
   const flow::Node source_id_node = connectionNode_[schema_.source_id];
   if (source_id_node) {
@@ -202,4 +216,32 @@ bool StructuredConnectionParser::getDropEmpty() const {
   return false;
 }
 
+std::shared_ptr<core::FlowFilePrioritizer> StructuredConnectionParser::getPrioritizer() const {
+  const flow::Node prioritizers_node = connectionNode_[schema_.prioritizers];
+  if (!prioritizers_node || prioritizers_node.isNull()) {
+    return nullptr;
+  }
+  std::vector<std::string> prioritizer_names;
+  if (prioritizers_node.isSequence()) {
+    for (const auto& prioritizer_node : prioritizers_node) {
+      prioritizer_names.push_back(prioritizer_node.getString().value());
+    }
+  } else {
+    prioritizer_names = utils::StringUtils::splitAndTrimRemovingEmpty(prioritizers_node.getString().value(), ",");
+  }
+  if (prioritizer_names.empty()) {
+    return nullptr;
+  }
+  if (prioritizer_names.size() > 1) {
+    logger_->log_warn("Connection '{}' has {} prioritizers, only the first one ({}) is used", name_, prioritizer_names.size(), prioritizer_names.front());
+  }
+  auto prioritizer = core::FlowFilePrioritizer::create(prioritizer_names.front());
+  if (!prioritizer) {
+    logger_->log_error("Invalid prioritizer for connection '{}': {}", name_, prioritizer_names.front());
+    throw std::invalid_argument("Invalid prioritizer: " + prioritizer_names.front());
+  }
+  logger_->log_debug("parseConnection: prioritizer => [{}]", prioritizer->getName());
+  return prioritizer;
+}
+
 }  // namespace org::apache::nifi::minifi::core::flow
@@ -17,15 +17,220 @@
  */
 
 #include "core/repository/FileSystemRepository.h"
+#include <algorithm>
+#include <charconv>
+#include <limits>
 #include <memory>
 #include <string>
 #include <filesystem>
+#include <vector>
+#include "io/BufferStream.h"
 #include "io/FileStream.h"
+#include "io/StreamPipe.h"
 #include "utils/file/FileUtils.h"
+#include "utils/OptionalUtils.h"
+#include "utils/StringUtils.h"
 #include "core/ForwardingContentSession.h"
+#include "core/TypedValues.h"
 
 namespace org::apache::nifi::minifi::core::repository {
 
+namespace {
+
+// every segment entry starts with [uint64_t content length][uint64_t sequence][uint16_t name length][name]
+constexpr uint64_t INCOMPLETE_ENTRY_LENGTH = std::numeric_limits<uint64_t>::max();
+constexpr uint64_t ENTRY_HEADER_FIXED_SIZE = sizeof(uint64_t) + sizeof(uint64_t) + sizeof(uint16_t);
+
+class SegmentReadStream : public io::BaseStream {
+ public:
+  SegmentReadStream(const std::filesystem::path& path, uint64_t offset, uint64_t length)
+      : stream_(path, 0, false),
+        offset_(offset),
+        length_(length) {
+    stream_.seek(offset_);
+  }
+
+  void close() override {
+    stream_.close();
+  }
+
+  void seek(size_t offset) override {
+    stream_.seek(offset_ + std::min<uint64_t>(offset, length_));
+  }
+
+  [[nodiscard]] size_t tell() const override {
+    return stream_.tell() - offset_;
+  }
+
+  [[nodiscard]] size_t size() const override {
+    return length_;
+  }
+
+  using BaseStream::read;
+  using BaseStream::write;
+
+  size_t read(std::span<std::byte> buffer) override {
+    const uint64_t remaining = length_ - std::min<uint64_t>(tell(), length_);
+    if (buffer.empty() || remaining == 0) {
+      return 0;
+    }
+    return stream_.read(buffer.subspan(0, std::min<uint64_t>(buffer.size(), remaining)));
+  }
+
+  size_t write(const uint8_t* /*value*/, size_t /*len*/) override {
+    return io::STREAM_ERROR;
+  }
+
+ private:
+  io::FileStream stream_;
+  uint64_t offset_;
+  uint64_t length_;
+};
+
+}  // namespace
+
+/**
+ * Writes a single entry at the end of an exclusively checked out segment. The entry is
+ * registered in the claim index and the segment is handed back to the repository when
+ * the stream is closed.
+ */
+class FileSystemRepository::SegmentWriteStream : public io::BaseStream {
+ public:
+  SegmentWriteStream(std::shared_ptr<FileSystemRepository> repository, std::string content_path, std::shared_ptr<Segment> segment, uint64_t sequence)
+      : repository_(std::move(repository)),
+        content_path_(std::move(content_path)),
+        segment_(std::move(segment)),
+        sequence_(sequence),
+        entry_offset_(segment_->size) {
+    const auto name = std::filesystem::path(content_path_).filename().string();
+    io::BufferStream header;
+    header.write(INCOMPLETE_ENTRY_LENGTH);
+    header.write(sequence_);
+    header.write(name);
+    content_offset_ = entry_offset_ + header.size();
+    segment_->writer->seek(entry_offset_);
+    valid_ = segment_->writer->write(header.getBuffer()) == header.size();
+    if (!valid_) {
+      repository_->logger_->log_error("Failed to write entry header for {} into segment {}", content_path_, segment_->path);
+    }
+  }
+
+  SegmentWriteStream(const SegmentWriteStream&) = delete;
+  SegmentWriteStream(SegmentWriteStream&&) = delete;
+  SegmentWriteStream& operator=(const SegmentWriteStream&) = delete;
+  SegmentWriteStream& operator=(SegmentWriteStream&&) = delete;
+
+  ~SegmentWriteStream() override {
+    close();
+  }
+
+  void close() override {
+    if (closed_) {
+      return;
+    }
+    closed_ = true;
+    if (valid_) {
+      segment_->writer->seek(entry_offset_);
+      valid_ = segment_->writer->write(length_) == sizeof(length_);
+    }
+    if (!valid_) {
+      repository_->abortPackedClaim(segment_, content_offset_ + length_);
+      return;
+    }
+    repository_->commitPackedClaim(content_path_, segment_, content_offset_, length_, sequence_);
+  }
+
+  void seek(size_t offset) override {
+    position_ = std::min<uint64_t>(offset, length_);
+  }
+
+  [[nodiscard]] size_t tell() const override {
+    return position_;
+  }
+
+  [[nodiscard]] size_t size() const override {
+    return length_;
+  }
+
+  using BaseStream::read;
+  using BaseStream::write;
+
+  size_t read(std::span<std::byte> buffer) override {
+    if (!valid_ || closed_) {
+      return io::STREAM_ERROR;
+    }
+    const uint64_t remaining = length_ - position_;
+    if (buffer.empty() || remaining == 0) {
+      return 0;
+    }
+    syncWriterPosition();
+    const auto ret = segment_->writer->read(buffer.subspan(0, std::min<uint64_t>(buffer.size(), remaining)));
+    if (!io::isError(ret)) {
+      position_ += ret;
+    }
+    return ret;
+  }
+
+  size_t write(const uint8_t* value, size_t len) override {
+    if (!valid_ || closed_) {
+      return io::STREAM_ERROR;
+    }
+    if (len == 0) {
+      return 0;
+    }
+    syncWriterPosition();
+    const auto ret = segment_->writer->write(value, len);
+    if (io::isError(ret)) {
+      valid_ = false;
+      return ret;
+    }
+    position_ += ret;
+    length_ = std::max(length_, position_);
+    return ret;
+  }
+
+ private:
+  void syncWriterPosition() {
+    if (segment_->writer->tell() != content_offset_ + position_) {
+      segment_->writer->seek(content_offset_ + position_);
+    }
+  }
+
+  std::shared_ptr<FileSystemRepository> repository_;
+  std::string content_path_;
+  std::shared_ptr<Segment> segment_;
+  uint64_t sequence_;
+  uint64_t entry_offset_;
+  uint64_t content_offset_ = 0;
+  uint64_t position_ = 0;
+  uint64_t length_ = 0;
+  bool valid_ = false;
+  bool closed_ = false;
+};
+
+/**
+ * Deduplicates the content of the claims created in the session on commit.
+ */
+class FileSystemRepository::Session : public ForwardingContentSession {
+ public:
+  explicit Session(std::shared_ptr<FileSystemRepository> repository)
+      : ForwardingContentSession(repository),
+        file_system_repository_(std::move(repository)) {
+  }
+
+  void commit() override {
+    if (file_system_repository_->isDeduplicationEnabled()) {
+      for (const auto& claim : created_claims_) {
+        file_system_repository_->deduplicate(*claim);
+      }
+    }
+    ForwardingContentSession::commit();
+  }
+
+ private:
+  std::shared_ptr<FileSystemRepository> file_system_repository_;
+};
+
 bool FileSystemRepository::initialize(const std::shared_ptr<minifi::Configure>& configuration) {
   std::string directory_str;
   if (configuration->get(Configure::nifi_dbcontent_repository_directory_default, directory_str) && !directory_str.empty()) {
@@ -34,23 +239,86 @@ bool FileSystemRepository::initialize(const std::shared_ptr<minifi::Configure>&
     directory_ = configuration->getHome().string();
   }
   utils::file::create_dir(directory_);
+
+  zero_copy_enabled_ = (configuration->get(Configure::nifi_file_system_content_repository_zero_copy)
+      | utils::andThen(utils::StringUtils::toBool)).value_or(true);
+  segment_packing_enabled_ = (configuration->get(Configure::nifi_file_system_content_repository_segment_packing)
+      | utils::andThen(utils::StringUtils::toBool)).value_or(false);
+  deduplication_enabled_ = (configuration->get(Configure::nifi_content_repository_deduplication)
+      | utils::andThen(utils::StringUtils::toBool)).value_or(false);
+  if (deduplication_enabled_) {
+    logger_->log_info("Content deduplication is enabled, claims with identical content are hard linked in {}", directory_);
+  }
+  segment_max_size_ = DEFAULT_SEGMENT_MAX_SIZE;
+  if (auto segment_max_size_str = configuration->get(Configure::nifi_file_system_content_repository_segment_max_size)) {
+    uint64_t segment_max_size = 0;
+    if (core::DataSizeValue::StringToInt(*segment_max_size_str, segment_max_size) && segment_max_size > 0) {
+      segment_max_size_ = segment_max_size;
+    } else {
+      logger_->log_error("Invalid value '{}' for {}, using default segment size of {} bytes",
+          *segment_max_size_str, Configure::nifi_file_system_content_repository_segment_max_size, DEFAULT_SEGMENT_MAX_SIZE);
+    }
+  }
+  segment_directory_ = std::filesystem::path(directory_) / SEGMENT_DIRECTORY_NAME;
+  if (segment_packing_enabled_) {
+    utils::file::create_dir(segment_directory_);
+    logger_->log_info("Packing content claims into segments of at most {} bytes in {}", segment_max_size_, segment_directory_);
+  }
+  // claims packed during a previous run stay readable even if packing has been disabled since
+  recoverSegments();
   return true;
 }
 
 std::shared_ptr<io::BaseStream> FileSystemRepository::write(const minifi::ResourceClaim& claim, bool append) {
+  if (segment_packing_enabled_ || findPackedClaim(claim.getContentFullPath())) {
+    return writePacked(claim, append);
+  }
+  if (append) {
+    std::lock_guard<std::mutex> lock(deduplication_mutex_);
+    content_hash_index_.remove(claim.getContentFullPath());
+    if (!unshareFile(claim.getContentFullPath())) {
+      return nullptr;
+    }
+  }
   return std::make_shared<io::FileStream>(claim.getContentFullPath(), append);
 }
 
 bool FileSystemRepository::exists(const minifi::ResourceClaim& streamId) {
+  if (findPackedClaim(streamId.getContentFullPath())) {
+    return true;
+  }
   std::ifstream file(streamId.getContentFullPath());
   return file.good();
 }
 
 std::shared_ptr<io::BaseStream> FileSystemRepository::read(const minifi::ResourceClaim& claim) {
+  if (auto packed_claim = findPackedClaim(claim.getContentFullPath())) {
+    return std::make_shared<SegmentReadStream>(packed_claim->segment->path, packed_claim->offset, packed_claim->length);
+  }
   return std::make_shared<io::FileStream>(claim.getContentFullPath(), 0, false);
 }
 
 bool FileSystemRepository::removeKey(const std::string& content_path) {
+  content_hash_index_.remove(content_path);
+  std::optional<std::filesystem::path> unused_segment;
+  {
+    std::lock_guard<std::mutex> lock(segment_mutex_);
+    if (auto it = packed_claims_.find(content_path); it != packed_claims_.end()) {
+      logger_->log_debug("Deleting packed resource {}", content_path);
+      auto segment = it->second.segment;
+      packed_claims_.erase(it);
+      --segment->live_claims;
+      unused_segment = detachSegmentIfUnused(segment);
+      if (!unused_segment) {
+        return true;
+      }
+    }
+  }
+  if (unused_segment) {
+    deleteSegmentFile(*unused_segment);
+    return true;
+  }
+
   logger_->log_debug("Deleting resource {}", content_path);
   std::error_code ec;
   auto result = std::filesystem::exists(content_path, ec);
@@ -71,10 +339,150 @@ bool FileSystemRepository::removeKey(const std::string& content_path) {
 }
 
 std::shared_ptr<ContentSession> FileSystemRepository::createSession() {
-  return std::make_shared<ForwardingContentSession>(sharedFromThis());
+  return std::make_shared<Session>(std::static_pointer_cast<FileSystemRepository>(sharedFromThis()));
+}
+
+void FileSystemRepository::deduplicate(const minifi::ResourceClaim& claim) {
+  const auto content_path = claim.getContentFullPath();
+  // packed claims already share their segment files
+  if (findPackedClaim(content_path)) {
+    return;
+  }
+  std::error_code ec;
+  const auto size = std::filesystem::file_size(content_path, ec);
+  if (ec || size == 0) {
+    return;
+  }
+  io::FileStream stream(content_path, 0, false);
+  const auto hash = ContentHashIndex::hash(stream);
+  stream.close();
+  if (!hash) {
+    logger_->log_warn("Failed to read {} for deduplication", content_path);
+    return;
+  }
+  // an append removes the claim from the index and unshares it under the same lock, so it either sees the link or is not linked to
+  std::lock_guard<std::mutex> lock(deduplication_mutex_);
+  if (std::filesystem::file_size(content_path, ec) != size || ec) {
+    logger_->log_debug("{} has been modified while it was hashed, not deduplicating it", content_path);
+    return;
+  }
+  if (const auto original_path = content_hash_index_.find(*hash); original_path && *original_path != content_path
+      && std::filesystem::file_size(*original_path, ec) == size && !ec) {
+    // the link is created next to the claim, so it replaces the claim atomically
+    const auto link_path = content_path + ".link";
+    std::filesystem::create_hard_link(*original_path, link_path, ec);
+    if (!ec) {
+      std::filesystem::rename(link_path, content_path, ec);
+    }
+    if (!ec) {
+      logger_->log_debug("Replaced {} with a hard link to {} with identical content", content_path, *original_path);
+      content_hash_index_.recordDuplicateClaim(size);
+      return;
+    }
+    logger_->log_debug("Could not hard link {} to {}: {}", content_path, *original_path, ec.message());
+    std::filesystem::remove(link_path, ec);
+  }
+  content_hash_index_.add(*hash, content_path);
+  content_hash_index_.recordUniqueClaim();
+}
+
+bool FileSystemRepository::unshareFile(const std::string& content_path) {
+  std::error_code ec;
+  const auto link_count = std::filesystem::hard_link_count(content_path, ec);
+  if (ec || link_count <= 1) {
+    return true;
+  }
+  // appending in place would modify the content of the other claims (or the imported file) as well
+  const auto copy_path = content_path + ".copy";
+  std::filesystem::copy_file(content_path, copy_path, std::filesystem::copy_options::overwrite_existing, ec);
+  if (!ec) {
+    std::filesystem::rename(copy_path, content_path, ec);
+  }
+  if (ec) {
+    logger_->log_error("Failed to copy the shared content of {} before appending to it: {}", content_path, ec.message());
+    std::filesystem::remove(copy_path, ec);
+    return false;
+  }
+  logger_->log_debug("Copied the shared content of {} before appending to it", content_path);
+  return true;
+}
+
+std::optional<uint64_t> FileSystemRepository::importFile(const minifi::ResourceClaim& claim, const std::filesystem::path& source, uint64_t offset, bool keep_source) {
+  // packed claims can only be written through the segment index
+  if (!zero_copy_enabled_ || segment_packing_enabled_) {
+    return std::nullopt;
+  }
+  const std::filesystem::path destination = claim.getContentFullPath();
+  if (!keep_source && offset == 0) {
+    // the source is going to be deleted, so it can become the content itself if nothing else refers to it
+    std::error_code ec;
+    const auto status = std::filesystem::status(source, ec);
+    const bool linkable = !ec && std::filesystem::is_regular_file(status)
+        && (status.permissions() & std::filesystem::perms::owner_write) != std::filesystem::perms::none
+        && std::filesystem::hard_link_count(source, ec) == 1 && !ec;
+    const auto size = linkable ? std::filesystem::file_size(source, ec) : 0;
+    if (linkable && !ec) {
+      std::filesystem::create_hard_link(source, destination, ec);
+      if (!ec) {
+        logger_->log_debug("Imported {} into {} as a hard link", source, destination);
+        return size;
+      }
+      logger_->log_debug("Could not hard link {} into {}: {}", source, destination, ec.message());
+    }
+  }
+  auto copied = utils::file::copy_file_range(source, offset, std::numeric_limits<uint64_t>::max(), destination);
+  if (!copied) {
+    logger_->log_debug("Kernel-side copy of {} into {} failed ({}), falling back to buffered copy", source, destination, copied.error().message());
+    return std::nullopt;
+  }
+  logger_->log_debug("Imported {} bytes of {} into {} by the kernel", *copied, source, destination);
+  return *copied;
+}
+
+bool FileSystemRepository::exportFile(const minifi::ResourceClaim& claim, uint64_t offset, uint64_t size, const std::filesystem::path& destination) {
+  if (!zero_copy_enabled_) {
+    return false;
+  }
+  std::filesystem::path source = claim.getContentFullPath();
+  if (auto packed_claim = findPackedClaim(claim.getContentFullPath())) {
+    if (offset > packed_claim->length) {
+      return false;
+    }
+    source = packed_claim->segment->path;
+    size = std::min(size, packed_claim->length - offset);
+    offset += packed_claim->offset;
+  }
+  auto copied = utils::file::copy_file_range(source, offset, size, destination);
+  if (!copied || *copied != size) {
+    logger_->log_debug("Kernel-side copy of {} into {} failed ({}), falling back to buffered copy", source, destination,
+        copied ? "source is too short" : copied.error().message());
+    return false;
+  }
+  return true;
 }
 
 void FileSystemRepository::clearOrphans() {
+  std::vector<std::string> packed_paths;
+  {
+    std::lock_guard<std::mutex> lock(segment_mutex_);
+    packed_paths.reserve(packed_claims_.size());
+    for (const auto& [path, packed_claim] : packed_claims_) {
+      packed_paths.push_back(path);
+    }
+  }
+  {
+    std::lock_guard<std::mutex> lock(count_map_mutex_);
+    std::erase_if(packed_paths, [&] (const auto& path) {
+      auto it = count_map_.find(path);
+      return it != count_map_.end() && it->second != 0;
+    });
+  }
+  // a segment is deleted as a whole once its last orphan entry is dropped
+  for (const auto& path : packed_paths) {
+    logger_->log_debug("Deleting orphan packed resource {}", path);
+    removeKey(path);
+  }
+
   utils::file::list_dir(directory_, [&] (auto& /*dir*/, auto& filename) {
     auto path = directory_ +  "/" + filename.string();
     bool is_orphan = false;
@@ -98,4 +506,240 @@ void FileSystemRepository::clearOrphans() {
   }, logger_, false);
 }
 
+uint64_t FileSystemRepository::getRepositoryEntryCount() const {
+  uint64_t entry_count = 0;
+  {
+    std::lock_guard<std::mutex> lock(segment_mutex_);
+    entry_count = packed_claims_.size();
+  }
+  std::error_code ec;
+  auto dir_it = std::filesystem::directory_iterator(directory_, std::filesystem::directory_options::skip_permission_denied, ec);
+  if (ec) {
+    return entry_count;
+  }
+  return entry_count + std::count_if(
+    std::filesystem::begin(dir_it),
+    std::filesystem::end(dir_it),
+    [](auto& entry) { return entry.is_regular_file(); });
+}
+
+std::shared_ptr<io::BaseStream> FileSystemRepository::writePacked(const minifi::ResourceClaim& claim, bool append) {
+  const auto content_path = claim.getContentFullPath();
+  std::optional<PackedClaim> previous_claim;
+  if (append) {
+    previous_claim = findPackedClaim(content_path);
+    if (!previous_claim && utils::file::exists(content_path)) {
+      // claims created before packing was enabled keep living in their own file
+      return std::make_shared<io::FileStream>(content_path, true);
+    }
+  }
+
+  auto segment = acquireSegment();
+  if (!segment) {
+    return nullptr;
+  }
+  uint64_t sequence = 0;
+  {
+    std::lock_guard<std::mutex> lock(segment_mutex_);
+    sequence = next_sequence_++;
+  }
+  auto stream = std::make_shared<SegmentWriteStream>(std::static_pointer_cast<FileSystemRepository>(sharedFromThis()), content_path, std::move(segment), sequence);
+  if (previous_claim) {
+    // committed entries are immutable, appending copies the current content into a new entry that supersedes the old one
+    SegmentReadStream previous_content(previous_claim->segment->path, previous_claim->offset, previous_claim->length);
+    if (internal::pipe(previous_content, *stream) != gsl::narrow<int64_t>(previous_claim->length)) {
+      logger_->log_error("Failed to copy the content of {} for append", content_path);
+      return nullptr;
+    }
+  }
+  return stream;
+}
+
+auto FileSystemRepository::acquireSegment() -> std::shared_ptr<Segment> {
+  std::lock_guard<std::mutex> lock(segment_mutex_);
+  if (!writable_segments_.empty()) {
+    auto segment = writable_segments_.front();
+    writable_segments_.pop_front();
+    segment->checked_out = true;
+    return segment;
+  }
+
+  auto segment = std::make_shared<Segment>();
+  segment->id = next_segment_id_++;
+  segment->path = segment_directory_ / std::to_string(segment->id);
+  {
+    std::ofstream segment_file(segment->path, std::ios::binary);
+    if (!segment_file) {
+      logger_->log_error("Failed to create content segment {}", segment->path);
+      return nullptr;
+    }
+  }
+  segment->writer = std::make_unique<io::FileStream>(segment->path, 0, true);
+  segment->checked_out = true;
+  segments_.emplace(segment->id, segment);
+  logger_->log_debug("Created content segment {}", segment->path);
+  return segment;
+}
+
+void FileSystemRepository::commitPackedClaim(const std::string& content_path, const std::shared_ptr<Segment>& segment, uint64_t offset, uint64_t length, uint64_t sequence) {
+  std::vector<std::filesystem::path> unused_segments;
+  {
+    std::lock_guard<std::mutex> lock(segment_mutex_);
+    segment->size = offset + length;
+    ++segment->live_claims;
+    auto [it, inserted] = packed_claims_.try_emplace(content_path, PackedClaim{segment, offset, length, sequence});
+    if (!inserted) {
+      auto superseded_segment = std::exchange(it->second, PackedClaim{segment, offset, length, sequence}).segment;
+      --superseded_segment->live_claims;
+      if (auto unused_segment = detachSegmentIfUnused(superseded_segment)) {
+        unused_segments.push_back(*unused_segment);
+      }
+    }
+    if (auto unused_segment = releaseSegment(segment)) {
+      unused_segments.push_back(*unused_segment);
+    }
+  }
+  for (const auto& path : unused_segments) {
+    deleteSegmentFile(path);
+  }
+}
+
+void FileSystemRepository::abortPackedClaim(const std::shared_ptr<Segment>& segment, uint64_t end_offset) {
+  std::optional<std::filesystem::path> unused_segment;
+  {
+    std::lock_guard<std::mutex> lock(segment_mutex_);
+    // the tail of the segment may contain a partial entry now, stop appending to it
+    segment->size = std::max(segment->size, end_offset);
+    segment->sealed = true;
+    unused_segment = releaseSegment(segment);
+  }
+  if (unused_segment) {
+    deleteSegmentFile(*unused_segment);
+  }
+}
+
+std::optional<std::filesystem::path> FileSystemRepository::releaseSegment(const std::shared_ptr<Segment>& segment) {
+  segment->checked_out = false;
+  if (segment->size >= segment_max_size_) {
+    segment->sealed = true;
+  }
+  if (!segment->sealed) {
+    writable_segments_.push_back(segment);
+    return std::nullopt;
+  }
+  segment->writer.reset();
+  return detachSegmentIfUnused(segment);
+}
+
+std::optional<std::filesystem::path> FileSystemRepository::detachSegmentIfUnused(const std::shared_ptr<Segment>& segment) {
+  if (!segment->sealed || segment->checked_out || segment->live_claims > 0) {
+    return std::nullopt;
+  }
+  segments_.erase(segment->id);
+  return segment->path;
+}
+
+void FileSystemRepository::deleteSegmentFile(const std::filesystem::path& path) {
+  logger_->log_debug("Deleting unused content segment {}", path);
+  std::error_code ec;
+  if (!std::filesystem::remove(path, ec) && ec) {
+    logger_->log_error("Deleting segment {} from content repository failed with the following error: {}", path, ec.message());
+    std::lock_guard<std::mutex> lock(purge_list_mutex_);
+    purge_list_.push_back(path.string());
+  }
+}
+
+void FileSystemRepository::recoverSegments() {
+  std::vector<std::shared_ptr<Segment>> recovered_segments;
+  if (utils::file::exists(segment_directory_)) {
+    utils::file::list_dir(segment_directory_, [&] (auto& dir, auto& filename) {
+      const auto name = filename.string();
+      uint64_t id = 0;
+      const auto [ptr, ec] = std::from_chars(name.data(), name.data() + name.size(), id);
+      if (ec != std::errc() || ptr != name.data() + name.size()) {
+        logger_->log_warn("Ignoring unexpected file {} in the segment directory", name);
+        return true;
+      }
+      auto segment = std::make_shared<Segment>();
+      segment->id = id;
+      segment->path = dir / filename;
+      // recovered segments are never appended to, a crash may have left a partial entry at their end
+      segment->sealed = true;
+      recovered_segments.push_back(segment);
+      return true;
+    }, logger_, false);
+  }
+  std::sort(recovered_segments.begin(), recovered_segments.end(), [] (const auto& lhs, const auto& rhs) { return lhs->id < rhs->id; });
+
+  std::vector<std::filesystem::path> unused_segments;
+  {
+    std::lock_guard<std::mutex> lock(segment_mutex_);
+    segments_.clear();
+    writable_segments_.clear();
+    packed_claims_.clear();
+    next_segment_id_ = 0;
+    next_sequence_ = 0;
+    for (const auto& segment : recovered_segments) {
+      recoverSegment(segment);
+      segments_.emplace(segment->id, segment);
+      next_segment_id_ = std::max(next_segment_id_, segment->id + 1);
+    }
+    for (const auto& segment : recovered_segments) {
+      if (auto unused_segment = detachSegmentIfUnused(segment)) {
+        unused_segments.push_back(*unused_segment);
+      }
+    }
+    if (!recovered_segments.empty()) {
+      logger_->log_info("Recovered {} packed content claims from {} segments", packed_claims_.size(), segments_.size());
+    }
+  }
+  for (const auto& path : unused_segments) {
+    deleteSegmentFile(path);
+  }
+}
+
+void FileSystemRepository::recoverSegment(const std::shared_ptr<Segment>& segment) {
+  io::FileStream stream(segment->path, 0, false);
+  const uint64_t file_size = stream.size();
+  uint64_t offset = 0;
+  while (offset + ENTRY_HEADER_FIXED_SIZE <= file_size) {
+    stream.seek(offset);
+    uint64_t length = 0;
+    uint64_t sequence = 0;
+    std::string name;
+    if (stream.read(length) != sizeof(length) || stream.read(sequence) != sizeof(sequence) || io::isError(stream.read(name))) {
+      logger_->log_warn("Failed to read entry header at offset {} of segment {}", offset, segment->path);
+      break;
+    }
+    const uint64_t content_offset = offset + ENTRY_HEADER_FIXED_SIZE + name.size();
+    if (length == INCOMPLETE_ENTRY_LENGTH || name.empty() || content_offset + length > file_size) {
+      logger_->log_warn("Segment {} has an incomplete entry at offset {}, ignoring the rest of the segment", segment->path, offset);
+      break;
+    }
+    const auto content_path = directory_ + "/" + name;
+    auto [it, inserted] = packed_claims_.try_emplace(content_path, PackedClaim{segment, content_offset, length, sequence});
+    if (inserted) {
+      ++segment->live_claims;
+    } else if (it->second.sequence < sequence) {
+      --it->second.segment->live_claims;
+      it->second = PackedClaim{segment, content_offset, length, sequence};
+      ++segment->live_claims;
+    }
+    next_sequence_ = std::max(next_sequence_, sequence + 1);
+    offset = content_offset + length;
+  }
+  segment->size = offset;
+}
+
+std::optional<FileSystemRepository::PackedClaim> FileSystemRepository::findPackedClaim(const std::string& content_path) const {
+  std::lock_guard<std::mutex> lock(segment_mutex_);
+  if (packed_claims_.empty()) {
+    return std::nullopt;
+  }
+  if (auto it = packed_claims_.find(content_path); it != packed_claims_.end()) {
+    return it->second;
+  }
+  return std::nullopt;
+}
+
 }  // namespace org::apache::nifi::minifi::core::repository
@@ -213,6 +213,11 @@ std::vector<SerializedResponseNode> AgentStatus::serialize() {
     serialized.push_back(serializedComponents);
   }
 
+  auto serialized_thread_partitions = serializeThreadPartitions();
+  if (!serialized_thread_partitions.empty()) {
+    serialized.push_back(serialized_thread_partitions);
+  }
+
   serialized.push_back(serializeResourceConsumption());
 
   return serialized;
@@ -232,6 +237,13 @@ std::vector<PublishedMetric> AgentStatus::calculateMetrics() {
     });
   }
 
+  if (nullptr != monitor_) {
+    for (const auto& partition : monitor_->getThreadPartitionUtilizations()) {
+      metrics.push_back({"thread_partition_thread_count", static_cast<double>(partition.thread_count), {{"thread_partition", partition.name}, {"metric_class", getName()}}});
+      metrics.push_back({"thread_partition_utilization", partition.utilization, {{"thread_partition", partition.name}, {"metric_class", getName()}}});
+    }
+  }
+
   metrics.push_back({"agent_memory_usage_bytes", static_cast<double>(utils::OsUtils::getCurrentProcessPhysicalMemoryUsage()), {{"metric_class", getName()}}});
 
   double cpu_usage = -1.0;
@@ -283,6 +295,23 @@ SerializedResponseNode AgentStatus::serializeComponents() const {
   return components_node;
 }
 
+SerializedResponseNode AgentStatus::serializeThreadPartitions() const {
+  SerializedResponseNode thread_partitions_node{.name = "threadPartitions", .collapsible = false};
+  if (monitor_ != nullptr) {
+    for (const auto& partition : monitor_->getThreadPartitionUtilizations()) {
+      thread_partitions_node.children.push_back({
+        .name = partition.name,
+        .collapsible = false,
+        .children = {
+          {.name = "threadCount", .value = partition.thread_count},
+          {.name = "utilization", .value = partition.utilization},
+        }
+      });
+    }
+  }
+  return thread_partitions_node;
+}
+
 SerializedResponseNode AgentStatus::serializeAgentMemoryUsage() {
   return {.name = "memoryUsage", .value = utils::OsUtils::getCurrentProcessPhysicalMemoryUsage()};
 }
@@ -31,12 +31,25 @@ std::vector<SerializedResponseNode> QueueMetrics::serialize() {
         {.name = "datasizemax", .value = std::to_string(connection->getBackpressureThresholdDataSize())},
         {.name = "queued", .value = std::to_string(connection->getQueueSize())},
         {.name = "queuedmax", .value = std::to_string(connection->getBackpressureThresholdCount())},
+        {.name = "swapped", .value = std::to_string(connection->getSwappedQueueSize())},
+        {.name = "swappedmemorysize", .value = std::to_string(connection->getSwappedQueueMemorySize())},
       }
     });
   }
   return serialized;
 }
 
+std::vector<PublishedMetric> QueueMetrics::calculateMetrics() {
+  auto metrics = connection_store_.calculateConnectionMetrics("QueueMetrics");
+  for (const auto& [_, connection] : connection_store_.getConnections()) {
+    metrics.push_back({"queue_swapped_size", static_cast<double>(connection->getSwappedQueueSize()),
+      {{"connection_uuid", connection->getUUIDStr()}, {"connection_name", connection->getName()}, {"metric_class", "QueueMetrics"}}});
+    metrics.push_back({"queue_swapped_memory_size", static_cast<double>(connection->getSwappedQueueMemorySize()),
+      {{"connection_uuid", connection->getUUIDStr()}, {"connection_name", connection->getName()}, {"metric_class", "QueueMetrics"}}});
+  }
+  return metrics;
+}
+
 REGISTER_RESOURCE(QueueMetrics, DescriptionOnly);
 
 }  // namespace org::apache::nifi::minifi::state::response
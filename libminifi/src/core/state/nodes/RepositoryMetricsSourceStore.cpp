@@ -50,6 +50,30 @@ std::vector<SerializedResponseNode> RepositoryMetricsSourceStore::serialize() co
       parent.children.push_back({.name = "rocksDbAllMemoryTablesSize", .value = rocksdb_stats->all_memory_tables_size});
     }
 
+    if (auto commit_stats = repo->getCommitStats()) {
+      parent.children.push_back({.name = "commitCount", .value = commit_stats->commit_count});
+      parent.children.push_back({.name = "writeCount", .value = commit_stats->write_count});
+      parent.children.push_back({.name = "averageWriteBatchSize", .value = commit_stats->average_write_batch_size});
+      parent.children.push_back({.name = "maxWriteBatchSize", .value = commit_stats->max_write_batch_size});
+      parent.children.push_back({.name = "averageCommitLatencyMilliseconds", .value = commit_stats->average_commit_latency.count()});
+      parent.children.push_back({.name = "maxCommitLatencyMilliseconds", .value = commit_stats->max_commit_latency.count()});
+    }
+
+    if (auto recovery_stats = repo->getRecoveryStats()) {
+      parent.children.push_back({.name = "recoveryInProgress", .value = recovery_stats->in_progress});
+      parent.children.push_back({.name = "recoveredEntryCount", .value = recovery_stats->recovered_entry_count});
+      parent.children.push_back({.name = "estimatedRecoveryEntryCount", .value = recovery_stats->estimated_entry_count});
+      parent.children.push_back({.name = "recoveryElapsedMilliseconds", .value = static_cast<uint64_t>(recovery_stats->elapsed.count())});
+      parent.children.push_back({.name = "recoveryRemainingMilliseconds", .value = static_cast<uint64_t>(recovery_stats->estimated_remaining.count())});
+    }
+
+    if (auto deduplication_stats = repo->getDeduplicationStats()) {
+      parent.children.push_back({.name = "deduplicationCheckedClaimCount", .value = deduplication_stats->checked_claim_count});
+      parent.children.push_back({.name = "deduplicatedClaimCount", .value = deduplication_stats->deduplicated_claim_count});
+      parent.children.push_back({.name = "deduplicationHitRate", .value = deduplication_stats->hit_rate});
+      parent.children.push_back({.name = "deduplicationBytesSaved", .value = deduplication_stats->bytes_saved});
+    }
+
     serialized.push_back(parent);
   }
   return serialized;
@@ -69,6 +93,36 @@ std::vector<PublishedMetric> RepositoryMetricsSourceStore::calculateMetrics() co
       metrics.push_back({"rocksdb_all_memory_tables_size_bytes", static_cast<double>(rocksdb_stats->all_memory_tables_size),
         {{"metric_class", name_}, {"repository_name", repo->getRepositoryName()}}});
     }
+    if (auto commit_stats = repo->getCommitStats()) {
+      metrics.push_back({"commit_count", static_cast<double>(commit_stats->commit_count), {{"metric_class", name_}, {"repository_name", repo->getRepositoryName()}}});
+      metrics.push_back({"write_count", static_cast<double>(commit_stats->write_count), {{"metric_class", name_}, {"repository_name", repo->getRepositoryName()}}});
+      metrics.push_back({"average_write_batch_size", commit_stats->average_write_batch_size, {{"metric_class", name_}, {"repository_name", repo->getRepositoryName()}}});
+      metrics.push_back({"max_write_batch_size", static_cast<double>(commit_stats->max_write_batch_size), {{"metric_class", name_}, {"repository_name", repo->getRepositoryName()}}});
+      metrics.push_back({"average_commit_latency_milliseconds", commit_stats->average_commit_latency.count(),
+        {{"metric_class", name_}, {"repository_name", repo->getRepositoryName()}}});
+      metrics.push_back({"max_commit_latency_milliseconds", commit_stats->max_commit_latency.count(),
+        {{"metric_class", name_}, {"repository_name", repo->getRepositoryName()}}});
+    }
+    if (auto recovery_stats = repo->getRecoveryStats()) {
+      metrics.push_back({"recovery_in_progress", (recovery_stats->in_progress ? 1.0 : 0.0), {{"metric_class", name_}, {"repository_name", repo->getRepositoryName()}}});
+      metrics.push_back({"recovered_entry_count", static_cast<double>(recovery_stats->recovered_entry_count),
+        {{"metric_class", name_}, {"repository_name", repo->getRepositoryName()}}});
+      metrics.push_back({"estimated_recovery_entry_count", static_cast<double>(recovery_stats->estimated_entry_count),
+        {{"metric_class", name_}, {"repository_name", repo->getRepositoryName()}}});
+      metrics.push_back({"recovery_elapsed_milliseconds", static_cast<double>(recovery_stats->elapsed.count()),
+        {{"metric_class", name_}, {"repository_name", repo->getRepositoryName()}}});
+      metrics.push_back({"recovery_remaining_milliseconds", static_cast<double>(recovery_stats->estimated_remaining.count()),
+        {{"metric_class", name_}, {"repository_name", repo->getRepositoryName()}}});
+    }
+    if (auto deduplication_stats = repo->getDeduplicationStats()) {
+      metrics.push_back({"deduplication_checked_claim_count", static_cast<double>(deduplication_stats->checked_claim_count),
+        {{"metric_class", name_}, {"repository_name", repo->getRepositoryName()}}});
+      metrics.push_back({"deduplicated_claim_count", static_cast<double>(deduplication_stats->deduplicated_claim_count),
+        {{"metric_class", name_}, {"repository_name", repo->getRepositoryName()}}});
+      metrics.push_back({"deduplication_hit_rate", deduplication_stats->hit_rate, {{"metric_class", name_}, {"repository_name", repo->getRepositoryName()}}});
+      metrics.push_back({"deduplication_bytes_saved", static_cast<double>(deduplication_stats->bytes_saved),
+        {{"metric_class", name_}, {"repository_name", repo->getRepositoryName()}}});
+    }
   }
   return metrics;
 }
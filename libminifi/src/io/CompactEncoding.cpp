@@ -0,0 +1,125 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "io/CompactEncoding.h"
+
+#include <algorithm>
+
+#include "utils/StringUtils.h"
+
+namespace org::apache::nifi::minifi::io {
+
+void CompactWriter::writeVarint(uint64_t value) {
+  while (value >= 0x80) {
+    writeByte(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  writeByte(static_cast<uint8_t>(value));
+}
+
+void CompactWriter::writeString(std::string_view value) {
+  writeVarint(value.size());
+  const auto bytes = std::as_bytes(std::span(value));
+  buffer_.insert(buffer_.end(), bytes.begin(), bytes.end());
+}
+
+void CompactWriter::writeString(std::string_view value, std::span<const std::string_view> dictionary) {
+  const auto it = std::find(dictionary.begin(), dictionary.end(), value);
+  if (it != dictionary.end()) {
+    writeVarint(static_cast<uint64_t>(std::distance(dictionary.begin(), it)) + 1);
+    return;
+  }
+  writeVarint(0);
+  writeString(value);
+}
+
+void CompactWriter::writeIdentifier(const utils::Identifier& value) {
+  const auto bytes = std::as_bytes(std::span(value.getData()));
+  buffer_.insert(buffer_.end(), bytes.begin(), bytes.end());
+}
+
+bool CompactReader::readVarint(uint64_t& value) {
+  value = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    uint8_t byte = 0;
+    if (!readByte(byte)) {
+      return false;
+    }
+    // only the lowest bit of the 10th byte fits into 64 bits, a larger value would be silently truncated
+    if (shift == 63 && byte > 1) {
+      return false;
+    }
+    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::optional<RecordFormat> parseRecordFormat(std::string_view format) {
+  if (utils::StringUtils::equalsIgnoreCase(format, "legacy")) {
+    return RecordFormat::LEGACY;
+  } else if (utils::StringUtils::equalsIgnoreCase(format, "compact")) {
+    return RecordFormat::COMPACT;
+  }
+  return std::nullopt;
+}
+
+bool CompactReader::readString(std::string& value) {
+  uint32_t length = 0;
+  if (!readVarint(length)) {
+    return false;
+  }
+  // the length comes from disk, the string only grows by the data actually read, so a corrupt length cannot allocate gigabytes
+  value.clear();
+  while (value.size() < length) {
+    const auto offset = value.size();
+    value.resize(offset + (std::min<size_t>)(length - offset, STRING_READ_CHUNK_SIZE));
+    const auto chunk = std::as_writable_bytes(std::span(value).subspan(offset));
+    if (stream_.read(chunk) != chunk.size()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CompactReader::readString(std::string& value, std::span<const std::string_view> dictionary) {
+  uint64_t index = 0;
+  if (!readVarint(index)) {
+    return false;
+  }
+  if (index == 0) {
+    return readString(value);
+  }
+  if (index > dictionary.size()) {
+    return false;
+  }
+  value = dictionary[index - 1];
+  return true;
+}
+
+bool CompactReader::readIdentifier(utils::Identifier& value) {
+  utils::Identifier::Data data{};
+  if (stream_.read(std::as_writable_bytes(std::span(data))) != data.size()) {
+    return false;
+  }
+  value = data;
+  return true;
+}
+
+}  // namespace org::apache::nifi::minifi::io
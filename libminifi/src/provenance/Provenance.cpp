@@ -17,9 +17,11 @@
  */
 
 #include "provenance/Provenance.h"
+#include "provenance/ProvenanceSampling.h"
 
 #include <cstdint>
 #include <memory>
+#include <span>
 #include <string>
 #include <vector>
 #include <list>
@@ -34,6 +36,28 @@
 
 namespace org::apache::nifi::minifi::provenance {
 
+namespace {
+
+// reads the UUID string of a legacy record, whose first byte has already been read to detect the format
+bool readLegacyIdentifier(io::InputStream& input_stream, uint8_t first_byte, utils::Identifier& uuid) {
+  uint8_t second_byte = 0;
+  if (input_stream.read(second_byte) != 1) {
+    return false;
+  }
+  std::string uuid_str(static_cast<size_t>(first_byte) << 8 | second_byte, '\0');
+  if (!uuid_str.empty() && input_stream.read(std::as_writable_bytes(std::span(uuid_str))) != uuid_str.size()) {
+    return false;
+  }
+  const auto parsed_uuid = utils::Identifier::parse(uuid_str);
+  if (!parsed_uuid) {
+    return false;
+  }
+  uuid = *parsed_uuid;
+  return true;
+}
+
+}  // namespace
+
 std::shared_ptr<utils::IdGenerator> ProvenanceEventRecord::id_generator_ = utils::IdGenerator::getIdGenerator();
 std::shared_ptr<core::logging::Logger> ProvenanceEventRecord::logger_ = core::logging::LoggerFactory<ProvenanceEventRecord>::getLogger();
 
@@ -48,6 +72,29 @@ ProvenanceEventRecord::ProvenanceEventRecord(ProvenanceEventRecord::ProvenanceEv
       _eventTime(std::chrono::system_clock::now()) {
 }
 
+std::string ProvenanceEventRecord::getDetails() const {
+  switch (details_template_) {
+    case DetailsTemplate::TEXT:
+      return _details;
+    case DetailsTemplate::CREATE:
+      return _componentId + " creates flow record " + flow_uuid_.to_string();
+    case DetailsTemplate::DROP:
+      return "Discard reason: " + _componentId + " drop flow record " + flow_uuid_.to_string();
+    case DetailsTemplate::MODIFY_ATTRIBUTE: {
+      const auto attribute = _attributes.find(details_attribute_key_);
+      return _componentId + " modify flow record " + flow_uuid_.to_string() + " attribute " + details_attribute_key_ + ":"
+          + (attribute != _attributes.end() ? attribute->second : std::string{});
+    }
+    case DetailsTemplate::REMOVE_ATTRIBUTE:
+      return _componentId + " remove flow record " + flow_uuid_.to_string() + " attribute " + details_attribute_key_;
+    case DetailsTemplate::MODIFY_CONTENT:
+      return _componentId + " modify flow record content " + flow_uuid_.to_string();
+    case DetailsTemplate::EXPIRE:
+      return _componentId + " expire flow record " + flow_uuid_.to_string();
+  }
+  return _details;
+}
+
 bool ProvenanceEventRecord::loadFromRepository(const std::shared_ptr<core::Repository> &repo) {
   std::string value;
   bool ret = false;
@@ -78,7 +125,57 @@ bool ProvenanceEventRecord::loadFromRepository(const std::shared_ptr<core::Repos
   return ret;
 }
 
-bool ProvenanceEventRecord::serialize(io::OutputStream& output_stream) {
+bool ProvenanceEventRecord::serialize(io::OutputStream& output_stream, io::RecordFormat format) {
+  if (format == io::RecordFormat::LEGACY) {
+    return serializeLegacy(output_stream);
+  }
+  std::vector<std::byte> buffer;
+  serialize(buffer);
+  return output_stream.write(buffer) == buffer.size();
+}
+
+void ProvenanceEventRecord::serialize(std::vector<std::byte>& buffer) const {
+  io::CompactWriter writer(buffer);
+  writer.writeByte(io::COMPACT_RECORD_MARKER);
+  writer.writeByte(COMPACT_FORMAT_VERSION);
+  // the indexed fields come first, in the same order as in the legacy layout, see readIndexedFields
+  writer.writeIdentifier(uuid_);
+  writer.writeVarint(_eventType);
+  writer.writeTime(_eventTime);
+  writer.writeTime(_entryDate);
+  writer.writeVarint(static_cast<uint64_t>(_eventDuration.count()));
+  writer.writeTime(_lineageStartDate);
+  writer.writeString(_componentId);
+  writer.writeString(_componentType);
+  writer.writeIdentifier(flow_uuid_);
+  writer.writeString(getDetails());
+  writer.writeVarint(_attributes.size());
+  for (const auto& [key, value] : _attributes) {
+    writer.writeString(key, io::COMMON_ATTRIBUTE_KEYS);
+    writer.writeString(value);
+  }
+  writer.writeString(_contentFullPath);
+  writer.writeVarint(_size);
+  writer.writeVarint(_offset);
+  writer.writeString(_sourceQueueIdentifier);
+  if (_eventType == ProvenanceEventRecord::FORK || _eventType == ProvenanceEventRecord::CLONE || _eventType == ProvenanceEventRecord::JOIN) {
+    writer.writeVarint(_parentUuids.size());
+    for (const auto& parent_uuid : _parentUuids) {
+      writer.writeIdentifier(parent_uuid);
+    }
+    writer.writeVarint(_childrenUuids.size());
+    for (const auto& child_uuid : _childrenUuids) {
+      writer.writeIdentifier(child_uuid);
+    }
+  } else if (_eventType == ProvenanceEventRecord::SEND || _eventType == ProvenanceEventRecord::FETCH) {
+    writer.writeString(_transitUri);
+  } else if (_eventType == ProvenanceEventRecord::RECEIVE) {
+    writer.writeString(_transitUri);
+    writer.writeString(_sourceSystemFlowFileIdentifier);
+  }
+}
+
+bool ProvenanceEventRecord::serializeLegacy(io::OutputStream& output_stream) {
   {
     const auto ret = output_stream.write(this->uuid_);
     if (ret == 0 || io::isError(ret)) {
@@ -139,7 +236,7 @@ bool ProvenanceEventRecord::serialize(io::OutputStream& output_stream) {
     }
   }
   {
-    const auto ret = output_stream.write(this->_details);
+    const auto ret = output_stream.write(getDetails());
     if (ret == 0 || io::isError(ret)) {
       return false;
     }
@@ -242,11 +339,92 @@ bool ProvenanceEventRecord::serialize(io::OutputStream& output_stream) {
 }
 
 bool ProvenanceEventRecord::deserialize(io::InputStream &input_stream) {
-  {
-    const auto ret = input_stream.read(uuid_);
-    if (ret == 0 || io::isError(ret)) {
+  uint8_t first_byte = 0;
+  if (input_stream.read(first_byte) != 1) {
+    return false;
+  }
+  details_template_ = DetailsTemplate::TEXT;
+  if (first_byte == io::COMPACT_RECORD_MARKER) {
+    return deserializeCompact(input_stream);
+  }
+  return deserializeLegacy(input_stream, first_byte);
+}
+
+bool ProvenanceEventRecord::deserializeCompact(io::InputStream &input_stream) {
+  io::CompactReader reader(input_stream);
+  uint8_t version = 0;
+  if (!reader.readByte(version) || version != COMPACT_FORMAT_VERSION) {
+    logger_->log_error("Unsupported provenance event record format version {}", version);
+    return false;
+  }
+
+  uint32_t event_type = 0;
+  if (!reader.readIdentifier(uuid_) || !reader.readVarint(event_type)) {
+    return false;
+  }
+  if (auto event_type_opt = magic_enum::enum_cast<ProvenanceEventRecord::ProvenanceEventType>(event_type)) {
+    _eventType = *event_type_opt;
+  } else {
+    return false;
+  }
+
+  uint64_t event_duration_ms = 0;
+  if (!reader.readTime(_eventTime) || !reader.readTime(_entryDate) || !reader.readVarint(event_duration_ms) || !reader.readTime(_lineageStartDate)
+      || !reader.readString(_componentId) || !reader.readString(_componentType) || !reader.readIdentifier(flow_uuid_) || !reader.readString(_details)) {
+    return false;
+  }
+  _eventDuration = std::chrono::milliseconds(event_duration_ms);
+
+  uint32_t numAttributes = 0;
+  if (!reader.readVarint(numAttributes)) {
+    return false;
+  }
+  for (uint32_t i = 0; i < numAttributes; i++) {
+    std::string key;
+    std::string value;
+    if (!reader.readString(key, io::COMMON_ATTRIBUTE_KEYS) || !reader.readString(value)) {
+      return false;
+    }
+    _attributes[std::move(key)] = std::move(value);
+  }
+
+  if (!reader.readString(_contentFullPath) || !reader.readVarint(_size) || !reader.readVarint(_offset) || !reader.readString(_sourceQueueIdentifier)) {
+    return false;
+  }
+
+  if (_eventType == ProvenanceEventRecord::FORK || _eventType == ProvenanceEventRecord::CLONE || _eventType == ProvenanceEventRecord::JOIN) {
+    uint32_t number = 0;
+    if (!reader.readVarint(number)) {
+      return false;
+    }
+    for (uint32_t i = 0; i < number; i++) {
+      utils::Identifier parent_uuid;
+      if (!reader.readIdentifier(parent_uuid)) {
+        return false;
+      }
+      addParentUuid(parent_uuid);
+    }
+    if (!reader.readVarint(number)) {
       return false;
     }
+    for (uint32_t i = 0; i < number; i++) {
+      utils::Identifier child_uuid;
+      if (!reader.readIdentifier(child_uuid)) {
+        return false;
+      }
+      addChildUuid(child_uuid);
+    }
+  } else if (_eventType == ProvenanceEventRecord::SEND || _eventType == ProvenanceEventRecord::FETCH) {
+    return reader.readString(_transitUri);
+  } else if (_eventType == ProvenanceEventRecord::RECEIVE) {
+    return reader.readString(_transitUri) && reader.readString(_sourceSystemFlowFileIdentifier);
+  }
+  return true;
+}
+
+bool ProvenanceEventRecord::deserializeLegacy(io::InputStream &input_stream, uint8_t first_byte) {
+  if (!readLegacyIdentifier(input_stream, first_byte, uuid_)) {
+    return false;
   }
 
   uint32_t eventType = 0;
@@ -444,6 +622,81 @@ bool ProvenanceEventRecord::deserialize(io::InputStream &input_stream) {
   return true;
 }
 
+std::optional<ProvenanceEventRecord::IndexedFields> ProvenanceEventRecord::readIndexedFields(io::InputStream& input_stream) {
+  uint8_t first_byte = 0;
+  if (input_stream.read(first_byte) != 1) {
+    return std::nullopt;
+  }
+  IndexedFields fields;
+  if (first_byte == io::COMPACT_RECORD_MARKER) {
+    io::CompactReader reader(input_stream);
+    uint8_t version = 0;
+    uint32_t event_type = 0;
+    uint64_t skipped = 0;
+    std::string component_type;
+    if (!reader.readByte(version) || version != COMPACT_FORMAT_VERSION || !reader.readIdentifier(fields.event_id) || !reader.readVarint(event_type)
+        || !reader.readTime(fields.event_time) || !reader.readVarint(skipped) || !reader.readVarint(skipped) || !reader.readVarint(skipped)
+        || !reader.readString(fields.component_id) || !reader.readString(component_type) || !reader.readIdentifier(fields.flow_file_uuid)) {
+      return std::nullopt;
+    }
+    const auto event_type_opt = magic_enum::enum_cast<ProvenanceEventRecord::ProvenanceEventType>(event_type);
+    if (!event_type_opt) {
+      return std::nullopt;
+    }
+    fields.event_type = *event_type_opt;
+    return fields;
+  }
+
+  if (!readLegacyIdentifier(input_stream, first_byte, fields.event_id)) {
+    return std::nullopt;
+  }
+  {
+    uint32_t event_type = 0;
+    if (input_stream.read(event_type) != 4) {
+      return std::nullopt;
+    }
+    const auto event_type_opt = magic_enum::enum_cast<ProvenanceEventRecord::ProvenanceEventType>(event_type);
+    if (!event_type_opt) {
+      return std::nullopt;
+    }
+    fields.event_type = *event_type_opt;
+  }
+  {
+    uint64_t event_time_in_ms = 0;
+    if (input_stream.read(event_time_in_ms) != 8) {
+      return std::nullopt;
+    }
+    fields.event_time = std::chrono::system_clock::time_point() + std::chrono::milliseconds(event_time_in_ms);
+  }
+  // entry date, event duration and lineage start date
+  for (size_t i = 0; i < 3; ++i) {
+    uint64_t skipped = 0;
+    if (input_stream.read(skipped) != 8) {
+      return std::nullopt;
+    }
+  }
+  {
+    const auto ret = input_stream.read(fields.component_id);
+    if (ret == 0 || io::isError(ret)) {
+      return std::nullopt;
+    }
+  }
+  {
+    std::string component_type;
+    const auto ret = input_stream.read(component_type);
+    if (ret == 0 || io::isError(ret)) {
+      return std::nullopt;
+    }
+  }
+  {
+    const auto ret = input_stream.read(fields.flow_file_uuid);
+    if (ret == 0 || io::isError(ret)) {
+      return std::nullopt;
+    }
+  }
+  return fields;
+}
+
 void ProvenanceReporter::commit() {
   if (repo_->isNoop()) {
     return;
@@ -457,14 +710,30 @@ void ProvenanceReporter::commit() {
   std::vector<std::pair<std::string, std::unique_ptr<io::BufferStream>>> flowData;
 
   for (auto& event : _events) {
-    std::unique_ptr<io::BufferStream> stramptr(new io::BufferStream());
-    event->serialize(*stramptr);
+    if (record_format_ == io::RecordFormat::LEGACY) {
+      auto stream = std::make_unique<io::BufferStream>();
+      event->serialize(*stream, record_format_);
+      flowData.emplace_back(event->getUUIDStr(), std::move(stream));
+      continue;
+    }
+    serialization_buffer_.clear();
+    event->serialize(serialization_buffer_);
 
-    flowData.emplace_back(event->getUUIDStr(), std::move(stramptr));
+    flowData.emplace_back(event->getUUIDStr(), std::make_unique<io::BufferStream>(serialization_buffer_));
   }
   repo_->MultiPut(flowData);
 }
 
+std::shared_ptr<ProvenanceEventRecord> ProvenanceReporter::allocate(ProvenanceEventRecord::ProvenanceEventType eventType, const std::shared_ptr<core::FlowFile>& flow) {
+  if (repo_->isNoop() || (sampling_ && !sampling_->isSampled(eventType))) {
+    return nullptr;
+  }
+
+  auto event = std::make_shared<ProvenanceEventRecord>(eventType, _componentId, _componentType);
+  event->fromFlowFile(flow);
+  return event;
+}
+
 void ProvenanceReporter::create(const std::shared_ptr<core::FlowFile>& flow, const std::string& detail) {
   auto event = allocate(ProvenanceEventRecord::CREATE, flow);
 
@@ -563,6 +832,49 @@ void ProvenanceReporter::drop(const std::shared_ptr<core::FlowFile>& flow, const
   }
 }
 
+void ProvenanceReporter::create(const std::shared_ptr<core::FlowFile>& flow) {
+  if (auto event = allocate(ProvenanceEventRecord::CREATE, flow)) {
+    event->setDetails(ProvenanceEventRecord::DetailsTemplate::CREATE);
+    add(event);
+  }
+}
+
+void ProvenanceReporter::modifyAttribute(const std::shared_ptr<core::FlowFile>& flow, std::string_view key) {
+  if (auto event = allocate(ProvenanceEventRecord::ATTRIBUTES_MODIFIED, flow)) {
+    event->setDetails(ProvenanceEventRecord::DetailsTemplate::MODIFY_ATTRIBUTE, std::string{key});
+    add(event);
+  }
+}
+
+void ProvenanceReporter::removeAttribute(const std::shared_ptr<core::FlowFile>& flow, std::string_view key) {
+  if (auto event = allocate(ProvenanceEventRecord::ATTRIBUTES_MODIFIED, flow)) {
+    event->setDetails(ProvenanceEventRecord::DetailsTemplate::REMOVE_ATTRIBUTE, std::string{key});
+    add(event);
+  }
+}
+
+void ProvenanceReporter::modifyContent(const std::shared_ptr<core::FlowFile>& flow, std::chrono::milliseconds processingDuration) {
+  if (auto event = allocate(ProvenanceEventRecord::CONTENT_MODIFIED, flow)) {
+    event->setDetails(ProvenanceEventRecord::DetailsTemplate::MODIFY_CONTENT);
+    event->setEventDuration(processingDuration);
+    add(event);
+  }
+}
+
+void ProvenanceReporter::expire(const std::shared_ptr<core::FlowFile>& flow) {
+  if (auto event = allocate(ProvenanceEventRecord::EXPIRE, flow)) {
+    event->setDetails(ProvenanceEventRecord::DetailsTemplate::EXPIRE);
+    add(event);
+  }
+}
+
+void ProvenanceReporter::drop(const std::shared_ptr<core::FlowFile>& flow) {
+  if (auto event = allocate(ProvenanceEventRecord::DROP, flow)) {
+    event->setDetails(ProvenanceEventRecord::DetailsTemplate::DROP);
+    add(event);
+  }
+}
+
 void ProvenanceReporter::send(const std::shared_ptr<core::FlowFile>& flow, const std::string& transitUri, const std::string& detail, std::chrono::milliseconds processingDuration, bool force) {
   auto event = allocate(ProvenanceEventRecord::SEND, flow);
 
@@ -573,8 +885,13 @@ void ProvenanceReporter::send(const std::shared_ptr<core::FlowFile>& flow, const
     if (!force) {
       add(event);
     } else {
-      if (!repo_->isFull())
-        repo_->storeElement(event);
+      if (!repo_->isFull()) {
+        io::BufferStream stream;
+        event->serialize(stream, record_format_);
+        if (!repo_->Put(event->getUUIDStr(), reinterpret_cast<const uint8_t*>(stream.getBuffer().data()), stream.size())) {
+          logger_->log_error("Failed to store provenance event {}", event->getUUIDStr());
+        }
+      }
     }
   }
 }
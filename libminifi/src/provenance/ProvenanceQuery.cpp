@@ -0,0 +1,148 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "provenance/ProvenanceQuery.h"
+
+#include <limits>
+
+#include "magic_enum.hpp"
+#include "rapidjson/document.h"
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
+#include "utils/StringUtils.h"
+#include "utils/TimeUtil.h"
+#include "utils/ValueParser.h"
+
+namespace org::apache::nifi::minifi::provenance {
+
+namespace {
+
+std::optional<std::chrono::system_clock::time_point> parseTime(const std::string& value) {
+  if (const auto milliseconds_since_epoch = utils::toNumber<uint64_t>(value)) {
+    return std::chrono::system_clock::time_point{std::chrono::milliseconds{*milliseconds_since_epoch}};
+  }
+  return utils::timeutils::parseRfc3339(value);
+}
+
+int64_t toMilliseconds(std::chrono::system_clock::time_point time_point) {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(time_point.time_since_epoch()).count();
+}
+
+}  // namespace
+
+nonstd::expected<ProvenanceQuery, std::string> ProvenanceQuery::parse(const std::map<std::string, std::string>& arguments) {
+  ProvenanceQuery query;
+  for (const auto& [name, value] : arguments) {
+    if (name == "flowFileUuid") {
+      query.flow_file_uuid = utils::Identifier::parse(value);
+      if (!query.flow_file_uuid) {
+        return nonstd::make_unexpected("Invalid flow file UUID: " + value);
+      }
+    } else if (name == "componentId") {
+      query.component_id = value;
+    } else if (name == "eventType") {
+      query.event_type = magic_enum::enum_cast<ProvenanceEventRecord::ProvenanceEventType>(utils::StringUtils::toUpper(value));
+      if (!query.event_type) {
+        return nonstd::make_unexpected("Invalid provenance event type: " + value);
+      }
+    } else if (name == "startTime" || name == "endTime") {
+      const auto time_point = parseTime(value);
+      if (!time_point) {
+        return nonstd::make_unexpected("Invalid " + name + ": " + value);
+      }
+      (name == "startTime" ? query.start_time : query.end_time) = time_point;
+    } else if (name == "maxAge") {
+      const auto max_age = utils::timeutils::StringToDuration<std::chrono::milliseconds>(value);
+      if (!max_age) {
+        return nonstd::make_unexpected("Invalid maxAge: " + value);
+      }
+      query.start_time = std::chrono::system_clock::now() - *max_age;
+    } else if (name == "maxResults") {
+      const auto max_results = utils::toNumber<uint64_t>(value);
+      if (!max_results || *max_results == 0) {
+        return nonstd::make_unexpected("Invalid maxResults: " + value);
+      }
+      query.max_results = gsl::narrow<size_t>(*max_results);
+    } else {
+      return nonstd::make_unexpected("Unknown provenance query argument: " + name);
+    }
+  }
+  return query;
+}
+
+nonstd::expected<ProvenanceQuery, std::string> ProvenanceQuery::parse(std::string_view query_string) {
+  std::map<std::string, std::string> arguments;
+  for (const auto& argument : utils::StringUtils::splitAndTrimRemovingEmpty(query_string, "&")) {
+    const auto separator = argument.find('=');
+    if (separator == std::string::npos) {
+      return nonstd::make_unexpected("Expected name=value in the provenance query, got: " + argument);
+    }
+    arguments[utils::StringUtils::trim(argument.substr(0, separator))] = utils::StringUtils::trim(argument.substr(separator + 1));
+  }
+  return parse(arguments);
+}
+
+bool ProvenanceQuery::matches(const ProvenanceEventRecord& event) const {
+  return (!flow_file_uuid || event.getFlowFileUuid() == *flow_file_uuid)
+      && (!component_id || event.getComponentId() == *component_id)
+      && (!event_type || event.getEventType() == *event_type)
+      && (!start_time || event.getEventTime() >= *start_time)
+      && (!end_time || event.getEventTime() < *end_time);
+}
+
+size_t ProvenanceQuery::maxScannedEvents() const {
+  if (max_results > (std::numeric_limits<size_t>::max)() / SCANNED_EVENTS_PER_RESULT) {
+    return (std::numeric_limits<size_t>::max)();
+  }
+  return max_results * SCANNED_EVENTS_PER_RESULT;
+}
+
+std::string toJson(const ProvenanceQueryResult& result) {
+  rapidjson::Document document(rapidjson::kObjectType);
+  rapidjson::Value events(rapidjson::kArrayType);
+  auto& alloc = document.GetAllocator();
+  const auto string_value = [&alloc](const std::string& value) {
+    return rapidjson::Value(value.c_str(), gsl::narrow<rapidjson::SizeType>(value.size()), alloc);
+  };
+  for (const auto& event : result.events) {
+    rapidjson::Value json_event(rapidjson::kObjectType);
+    json_event.AddMember("eventId", string_value(event->getEventId().to_string()), alloc);
+    json_event.AddMember("eventType", string_value(std::string{magic_enum::enum_name(event->getEventType())}), alloc);
+    json_event.AddMember("eventTime", toMilliseconds(event->getEventTime()), alloc);
+    json_event.AddMember("eventDuration", static_cast<int64_t>(event->getEventDuration().count()), alloc);
+    json_event.AddMember("componentId", string_value(event->getComponentId()), alloc);
+    json_event.AddMember("componentType", string_value(event->getComponentType()), alloc);
+    json_event.AddMember("flowFileUuid", string_value(event->getFlowFileUuid().to_string()), alloc);
+    json_event.AddMember("fileSize", event->getFileSize(), alloc);
+    json_event.AddMember("details", string_value(event->getDetails()), alloc);
+    json_event.AddMember("transitUri", string_value(event->getTransitUri()), alloc);
+    rapidjson::Value attributes(rapidjson::kObjectType);
+    for (const auto& [name, value] : event->getAttributes()) {
+      attributes.AddMember(string_value(name), string_value(value), alloc);
+    }
+    json_event.AddMember("attributes", attributes, alloc);
+    events.PushBack(json_event, alloc);
+  }
+  document.AddMember("events", events, alloc);
+  document.AddMember("truncated", result.truncated, alloc);
+
+  rapidjson::StringBuffer buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  document.Accept(writer);
+  return {buffer.GetString(), buffer.GetSize()};
+}
+
+}  // namespace org::apache::nifi::minifi::provenance
@@ -0,0 +1,75 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "provenance/ProvenanceSampling.h"
+
+#include <random>
+
+#include "core/logging/LoggerFactory.h"
+#include "magic_enum.hpp"
+#include "utils/StringUtils.h"
+#include "utils/ValueParser.h"
+
+namespace org::apache::nifi::minifi::provenance {
+
+nonstd::expected<ProvenanceSampling, std::string> ProvenanceSampling::parse(std::string_view rates) {
+  ProvenanceSampling sampling;
+  for (const auto& rate_str : utils::StringUtils::splitAndTrimRemovingEmpty(rates, ",")) {
+    const auto separator = rate_str.find(':');
+    if (separator == std::string::npos) {
+      return nonstd::make_unexpected("Expected EVENT_TYPE:rate, got: " + rate_str);
+    }
+    const auto event_type_str = utils::StringUtils::trim(rate_str.substr(0, separator));
+    const auto event_type = magic_enum::enum_cast<ProvenanceEventRecord::ProvenanceEventType>(utils::StringUtils::toUpper(event_type_str));
+    if (!event_type) {
+      return nonstd::make_unexpected("Invalid provenance event type: " + event_type_str);
+    }
+    const auto rate = utils::toNumber<double>(utils::StringUtils::trim(rate_str.substr(separator + 1)));
+    if (!rate || *rate < 0.0 || *rate > 1.0) {
+      return nonstd::make_unexpected("Invalid sampling rate for " + event_type_str + ", expected a number between 0 and 1");
+    }
+    sampling.rates_.at(*event_type) = *rate;
+  }
+  return sampling;
+}
+
+ProvenanceSampling ProvenanceSampling::fromConfiguration(const Configure& configuration) {
+  const auto rates = configuration.get(Configure::nifi_provenance_repository_sampling_rates);
+  if (!rates) {
+    return {};
+  }
+  auto sampling = parse(*rates);
+  if (!sampling) {
+    core::logging::LoggerFactory<ProvenanceSampling>::getLogger()->log_error("Invalid {} property, recording every provenance event: {}",
+        Configure::nifi_provenance_repository_sampling_rates, sampling.error());
+    return {};
+  }
+  return *sampling;
+}
+
+bool ProvenanceSampling::isSampled(ProvenanceEventRecord::ProvenanceEventType event_type) const {
+  const double rate = getRate(event_type);
+  if (rate >= 1.0) {
+    return true;
+  }
+  if (rate <= 0.0) {
+    return false;
+  }
+  thread_local std::minstd_rand generator{std::random_device{}()};
+  return std::uniform_real_distribution<double>{0.0, 1.0}(generator) < rate;
+}
+
+}  // namespace org::apache::nifi::minifi::provenance
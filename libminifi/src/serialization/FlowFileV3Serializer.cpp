@@ -64,7 +64,7 @@ int64_t FlowFileV3Serializer::serialize(const std::shared_ptr<core::FlowFile>& f
     if (ret != sizeof(MAGIC_HEADER)) return -1;
     sum += ret;
   }
-  const auto& attributes = flowFile->getAttributes();
+  const auto& attributes = flowFile->getAttributeMap();
   {
     const auto ret = writeLength(attributes.size(), out);
     if (io::isError(ret)) return -1;
@@ -0,0 +1,181 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "sitetosite/CompressionStream.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include "core/logging/LoggerFactory.h"
+
+namespace org::apache::nifi::minifi::sitetosite {
+
+namespace {
+// protects against allocating huge buffers because of a corrupted chunk header
+constexpr uint32_t MAX_CHUNK_SIZE = 16 * 1024 * 1024;
+}  // namespace
+
+CompressionOutputStream::CompressionOutputStream(gsl::not_null<io::OutputStream*> output)
+    : output_(output),
+      logger_(core::logging::LoggerFactory<CompressionOutputStream>::getLogger()) {
+  buffer_.reserve(CompressionFraming::ChunkSize);
+}
+
+size_t CompressionOutputStream::write(const uint8_t* value, size_t len) {
+  if (finished_ || failed_) {
+    return io::STREAM_ERROR;
+  }
+  if (len == 0) {
+    return 0;
+  }
+  gsl_Expects(value);
+  size_t written = 0;
+  while (written < len) {
+    const size_t to_copy = std::min(len - written, CompressionFraming::ChunkSize - buffer_.size());
+    buffer_.insert(buffer_.end(), value + written, value + written + to_copy);
+    written += to_copy;
+    if (buffer_.size() == CompressionFraming::ChunkSize && !compressAndWriteChunk()) {
+      return io::STREAM_ERROR;
+    }
+  }
+  return len;
+}
+
+void CompressionOutputStream::close() {
+  finish();
+}
+
+bool CompressionOutputStream::finish() {
+  if (finished_) {
+    return !failed_;
+  }
+  finished_ = true;
+  if (failed_ || !compressAndWriteChunk()) {
+    return false;
+  }
+  if (output_->write(CompressionFraming::EndOfData) != 1) {
+    failed_ = true;
+  }
+  return !failed_;
+}
+
+bool CompressionOutputStream::compressAndWriteChunk() {
+  if (buffer_.empty()) {
+    return true;
+  }
+  uLongf compressed_size = compressBound(gsl::narrow<uLong>(buffer_.size()));
+  compressed_.resize(compressed_size);
+  const int result = compress2(compressed_.data(), &compressed_size, buffer_.data(), gsl::narrow<uLong>(buffer_.size()), CompressionFraming::CompressionLevel);
+  if (result != Z_OK) {
+    logger_->log_error("Failed to compress site to site data chunk, zlib error code: {}", result);
+    failed_ = true;
+    return false;
+  }
+
+  if (chunk_written_ && output_->write(CompressionFraming::MoreData) != 1) {
+    failed_ = true;
+    return false;
+  }
+  if (output_->write(CompressionFraming::SyncBytes.data(), CompressionFraming::SyncBytes.size()) != CompressionFraming::SyncBytes.size()
+      || output_->write(gsl::narrow<uint32_t>(buffer_.size())) != 4
+      || output_->write(gsl::narrow<uint32_t>(compressed_size)) != 4
+      || output_->write(compressed_.data(), compressed_size) != compressed_size) {
+    failed_ = true;
+    return false;
+  }
+  chunk_written_ = true;
+  buffer_.clear();
+  return true;
+}
+
+CompressionInputStream::CompressionInputStream(gsl::not_null<io::InputStream*> input)
+    : input_(input),
+      logger_(core::logging::LoggerFactory<CompressionInputStream>::getLogger()) {
+}
+
+size_t CompressionInputStream::read(std::span<std::byte> out_buffer) {
+  size_t read_size = 0;
+  while (read_size < out_buffer.size()) {
+    if (read_position_ == buffer_.size()) {
+      if (end_of_data_) {
+        break;
+      }
+      if (!readChunk()) {
+        return io::STREAM_ERROR;
+      }
+      continue;
+    }
+    const size_t to_copy = std::min(out_buffer.size() - read_size, buffer_.size() - read_position_);
+    std::memcpy(out_buffer.data() + read_size, buffer_.data() + read_position_, to_copy);
+    read_position_ += to_copy;
+    read_size += to_copy;
+  }
+  return read_size;
+}
+
+bool CompressionInputStream::readFully(std::span<std::byte> out_buffer) {
+  size_t read_size = 0;
+  while (read_size < out_buffer.size()) {
+    const auto ret = input_->read(out_buffer.subspan(read_size));
+    if (ret == 0 || io::isError(ret)) {
+      return false;
+    }
+    read_size += ret;
+  }
+  return true;
+}
+
+bool CompressionInputStream::readChunk() {
+  std::array<std::byte, CompressionFraming::SyncBytes.size()> sync_bytes{};
+  if (!readFully(sync_bytes) || std::memcmp(sync_bytes.data(), CompressionFraming::SyncBytes.data(), sync_bytes.size()) != 0) {
+    logger_->log_error("Invalid site to site compressed data chunk, expected the SYNC bytes");
+    return false;
+  }
+  uint32_t uncompressed_size = 0;
+  uint32_t compressed_size = 0;
+  if (input_->read(uncompressed_size) != 4 || input_->read(compressed_size) != 4) {
+    return false;
+  }
+  if (uncompressed_size > MAX_CHUNK_SIZE || compressed_size > MAX_CHUNK_SIZE) {
+    logger_->log_error("Invalid site to site compressed data chunk size {} (compressed {})", uncompressed_size, compressed_size);
+    return false;
+  }
+  compressed_.resize(compressed_size);
+  if (!readFully(as_writable_bytes(std::span(compressed_)))) {
+    return false;
+  }
+  buffer_.resize(uncompressed_size);
+  uLongf decompressed_size = uncompressed_size;
+  const int result = uncompress(buffer_.data(), &decompressed_size, compressed_.data(), compressed_size);
+  if (result != Z_OK || decompressed_size != uncompressed_size) {
+    logger_->log_error("Failed to decompress site to site data chunk, zlib error code: {}", result);
+    return false;
+  }
+  read_position_ = 0;
+
+  uint8_t more_data = 0;
+  if (input_->read(more_data) != 1 || more_data > CompressionFraming::MoreData) {
+    logger_->log_error("Invalid site to site compressed data, expected an end of chunk marker");
+    return false;
+  }
+  end_of_data_ = more_data == CompressionFraming::EndOfData;
+  return true;
+}
+
+}  // namespace org::apache::nifi::minifi::sitetosite
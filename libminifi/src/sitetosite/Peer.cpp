@@ -55,8 +55,75 @@ bool SiteToSitePeer::Open() {
 }
 
 void SiteToSitePeer::Close() {
-  if (stream_ != nullptr)
+  compressor_.reset();
+  decompressor_.reset();
+  if (stream_ != nullptr) {
+    flush();
     stream_->close();
+  }
+}
+
+size_t SiteToSitePeer::write(const uint8_t* data, size_t len) {
+  if (compressor_) {
+    return compressor_->write(data, len);
+  }
+  return writeToConnection(data, len);
+}
+
+size_t SiteToSitePeer::writeToConnection(const uint8_t* data, size_t len) {
+  if (write_buffer_.size() + len > WRITE_BUFFER_SIZE && !flush()) {
+    return io::STREAM_ERROR;
+  }
+  if (len >= WRITE_BUFFER_SIZE) {
+    return stream_->write(data, len);
+  }
+  write_buffer_.insert(write_buffer_.end(), data, data + len);
+  return len;
+}
+
+size_t SiteToSitePeer::read(std::span<std::byte> data) {
+  // the peer only answers after it has received everything we have written
+  if (!flush()) {
+    return io::STREAM_ERROR;
+  }
+  if (decompressor_) {
+    const auto ret = decompressor_->read(data);
+    if (io::isError(ret) || decompressor_->isFinished()) {
+      decompressor_.reset();
+    }
+    return ret;
+  }
+  return stream_->read(data);
+}
+
+bool SiteToSitePeer::flush() {
+  if (write_buffer_.empty()) {
+    return true;
+  }
+  const auto ret = stream_->write(write_buffer_.data(), write_buffer_.size());
+  const bool success = ret == write_buffer_.size();
+  if (!success) {
+    logger_->log_warn("Failed to write {} buffered bytes to {}", write_buffer_.size(), url_);
+  }
+  write_buffer_.clear();
+  return success;
+}
+
+void SiteToSitePeer::startCompression() {
+  compressor_ = std::make_unique<CompressionOutputStream>(gsl::make_not_null(&connection_stream_));
+}
+
+bool SiteToSitePeer::finishCompression() {
+  if (!compressor_) {
+    return true;
+  }
+  const bool success = compressor_->finish();
+  compressor_.reset();
+  return success;
+}
+
+void SiteToSitePeer::startDecompression() {
+  decompressor_ = std::make_unique<CompressionInputStream>(gsl::make_not_null(&connection_stream_));
 }
 
 }  // namespace org::apache::nifi::minifi::sitetosite
@@ -0,0 +1,66 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "sitetosite/PeerSelector.h"
+
+#include <utility>
+
+namespace org::apache::nifi::minifi::sitetosite {
+
+void PeerSelector::setPeers(std::vector<PeerStatus> peers, TransferDirection direction) {
+  const auto weights = calculateWeights(peers, direction);
+  peers_ = std::move(peers);
+  distribution_ = std::discrete_distribution<size_t>(weights.begin(), weights.end());
+}
+
+std::optional<PeerStatus> PeerSelector::selectPeer() {
+  if (peers_.empty()) {
+    return std::nullopt;
+  }
+  return peers_[distribution_(generator_)];
+}
+
+std::vector<double> PeerSelector::calculateWeights(const std::vector<PeerStatus>& peers, TransferDirection direction) {
+  std::vector<double> weights;
+  if (peers.empty()) {
+    return weights;
+  }
+  uint64_t total_flow_file_count = 0;
+  for (const auto& peer : peers) {
+    total_flow_file_count += peer.getFlowFileCount();
+  }
+  const auto peer_count = static_cast<double>(peers.size());
+  weights.reserve(peers.size());
+  for (const auto& peer : peers) {
+    if (total_flow_file_count == 0) {
+      weights.push_back(1.0 / peer_count);
+      continue;
+    }
+    const double share_of_flow_files = static_cast<double>(peer.getFlowFileCount()) / static_cast<double>(total_flow_file_count);
+    if (direction == RECEIVE) {
+      weights.push_back(share_of_flow_files);
+    } else if (peers.size() == 1) {
+      weights.push_back(1.0);
+    } else {
+      // distributes the inverse of the shares, these add up to peer_count - 1
+      weights.push_back((1.0 - share_of_flow_files) / (peer_count - 1.0));
+    }
+  }
+  return weights;
+}
+
+}  // namespace org::apache::nifi::minifi::sitetosite
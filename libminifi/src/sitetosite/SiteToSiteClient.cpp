@@ -88,14 +88,19 @@ int SiteToSiteClient::writeResponse(const std::shared_ptr<Transaction>& /*transa
       return -1;
   }
 
+  int written = 3;
   if (resCode->hasDescription) {
     const auto ret = peer_->write(message);
     if (io::isError(ret)) return -1;
     if (ret == 0) return 0;
-    return 3 + gsl::narrow<int>(ret);
-  } else {
-    return 3;
+    written += gsl::narrow<int>(ret);
   }
+
+  // the peer only flushes its buffer before reads, but no response follows these, the peer waits for them to commit or roll back
+  if ((code == TRANSACTION_FINISHED || code == BAD_CHECKSUM || code == CANCEL_TRANSACTION) && !peer_->flush()) {
+    return -1;
+  }
+  return written;
 }
 
 bool SiteToSiteClient::transferFlowFiles(core::ProcessContext& context, core::ProcessSession& session) {
@@ -424,6 +429,11 @@ int16_t SiteToSiteClient::send(const utils::Identifier& transactionID, DataPacke
       return -1;
     }
   }
+  // only the data packet itself is compressed, the CRC is calculated over the uncompressed data
+  if (use_compression_) {
+    peer_->startCompression();
+  }
+  const auto compression_guard = gsl::finally([this] { peer_->finishCompression(); });
   // start to read the packet
   {
     const auto numAttributes = gsl::narrow<uint32_t>(packet->_attributes.size());
@@ -507,6 +517,11 @@ int16_t SiteToSiteClient::send(const utils::Identifier& transactionID, DataPacke
     }
   }
 
+  if (!peer_->finishCompression()) {
+    logger_->log_debug("Failed to write the compressed data packet!");
+    return -1;
+  }
+
   transaction->current_transfers_++;
   transaction->total_transfers_++;
   transaction->_state = DATA_EXCHANGED;
@@ -579,6 +594,9 @@ bool SiteToSiteClient::receive(const utils::Identifier& transactionID, DataPacke
     return true;
   }
 
+  if (use_compression_) {
+    peer_->startDecompression();
+  }
   // start to read the packet
   uint32_t numAttributes = 0;
   {
@@ -16,6 +16,9 @@
  */
 
 #include "utils/FlowFileQueue.h"
+
+#include <limits>
+
 #include "core/logging/LoggerConfiguration.h"
 
 namespace org::apache::nifi::minifi::utils {
@@ -25,9 +28,13 @@ bool FlowFileQueue::FlowFilePenaltyExpirationComparator::operator()(const value_
   return left->getPenaltyExpiration() < right->getPenaltyExpiration();
 }
 
+bool FlowFileQueue::QueuedFlowFileComparator::operator()(const QueuedFlowFile& left, const QueuedFlowFile& right) const {
+  return left.order < right.order;
+}
+
 bool FlowFileQueue::SwappedFlowFileComparator::operator()(const SwappedFlowFile& left, const SwappedFlowFile& right) const {
-  // a swapped flow file with earlier expiration compares less
-  return left.to_be_processed_after < right.to_be_processed_after;
+  // a swapped flow file with lower priority key or earlier expiration compares less
+  return orderOf(left) < orderOf(right);
 }
 
 FlowFileQueue::FlowFileQueue(std::shared_ptr<SwapManager> swap_manager)
@@ -47,9 +54,11 @@ std::optional<FlowFileQueue::value_type> FlowFileQueue::tryPop(std::chrono::mill
 }
 
 std::optional<FlowFileQueue::value_type> FlowFileQueue::tryPopImpl(std::optional<std::chrono::milliseconds> timeout) {
+  processFinishedStoreTasks();
+  releasePenalizedFlowFiles();
   std::optional<std::shared_ptr<core::FlowFile>> result;
   if (!queue_.empty()) {
-    result = queue_.popMin();
+    result = popMinFromQueue();
     if (processLoadTaskWait(std::chrono::milliseconds{0})) {
       initiateLoadIfNeeded();
     }
@@ -62,7 +71,7 @@ std::optional<FlowFileQueue::value_type> FlowFileQueue::tryPopImpl(std::optional
     }
     if (!queue_.empty()) {
       // load provided items
-      result = queue_.popMin();
+      result = popMinFromQueue();
       initiateLoadIfNeeded();
       return result;
     }
@@ -91,67 +100,146 @@ bool FlowFileQueue::processLoadTaskWait(std::optional<std::chrono::milliseconds>
   size_t intermediate_count = 0;
   for (auto&& item : load_task_->items.get()) {
     ++swapped_in_count;
-    queue_.push(std::move(item));
+    const auto order = orderOf(*item);
+    pushToQueue(std::move(item), order, true);
   }
   for (auto&& intermediate_item : load_task_->intermediate_items) {
     ++intermediate_count;
-    queue_.push(std::move(intermediate_item));
+    const auto order = orderOf(*intermediate_item);
+    pushToQueue(std::move(intermediate_item), order, true);
   }
   load_task_.reset();
   logger_->log_debug("Swapped in '{}' flow files and committed '{}' pending files", swapped_in_count, intermediate_count);
   return true;
 }
 
+FlowFileQueue::Order FlowFileQueue::orderOf(const core::FlowFile& flow_file) const {
+  return {prioritizer_ ? prioritizer_->getPriorityKey(flow_file) : 0, flow_file.getPenaltyExpiration()};
+}
+
 void FlowFileQueue::push(value_type element) {
   // do not allow pushing elements in the past
-  element->setPenaltyExpiration(std::max(element->getPenaltyExpiration(), clock_->now()));
+  const auto now = clock_->now();
+  const bool penalized = element->getPenaltyExpiration() > now;
+  element->setPenaltyExpiration(std::max(element->getPenaltyExpiration(), now));
+
+  releasePenalizedFlowFiles();
+  if (prioritizer_ && penalized) {
+    penalized_flow_files_.push(std::move(element));
+    return;
+  }
+  enqueue(std::move(element), penalized);
+}
+
+void FlowFileQueue::releasePenalizedFlowFiles() {
+  if (penalized_flow_files_.empty()) {
+    return;
+  }
+  const auto now = clock_->now();
+  while (!penalized_flow_files_.empty() && penalized_flow_files_.min()->getPenaltyExpiration() <= now) {
+    enqueue(penalized_flow_files_.popMin(), false);
+  }
+}
 
+void FlowFileQueue::enqueue(value_type element, bool penalized) {
+  const auto order = orderOf(*element);
   std::vector<value_type> flow_files_to_be_swapped_out;
 
   if (load_task_) {
-    if (element->getPenaltyExpiration() <= load_task_->min) {
+    if (order <= load_task_->min) {
       // flow file goes before load_task_
-      queue_.push(std::move(element));
-    } else if (load_task_->max <= element->getPenaltyExpiration()) {
+      pushToQueue(std::move(element), order, penalized);
+    } else if (load_task_->max <= order) {
       // flow file goes after load_task_, i.e. immediately swapped out
       flow_files_to_be_swapped_out.push_back(std::move(element));
     } else {
       // flow file belongs to the same range that is being swapped in
       load_task_->intermediate_items.push_back(std::move(element));
     }
-  } else if (!swapped_flow_files_.empty() && swapped_flow_files_.min().to_be_processed_after < element->getPenaltyExpiration()) {
+  } else if (!swapped_flow_files_.empty() && orderOf(swapped_flow_files_.min()) < order) {
     // flow file goes into the swapped_flow_files_ set, i.e. immediately swapped out
     flow_files_to_be_swapped_out.push_back(std::move(element));
   } else {
-    queue_.push(std::move(element));
+    pushToQueue(std::move(element), order, penalized);
   }
 
-  size_t flow_file_count = shouldSwapOutCount();
-  if (flow_file_count != 0) {
-    if (!load_task_) {
-      // we cannot initiate a queue_ swap while a load_task_ is pending
-      flow_files_to_be_swapped_out.reserve(flow_files_to_be_swapped_out.size() + flow_file_count);
-      for (size_t i = 0; i < flow_file_count; ++i) {
-        flow_files_to_be_swapped_out.push_back(queue_.popMax());
-      }
+  // we cannot initiate a queue_ swap while a load_task_ is pending
+  if (!load_task_ && shouldSwapOut()) {
+    while (!queue_.empty() && isAboveSwapOutTarget()) {
+      flow_files_to_be_swapped_out.push_back(popMaxFromQueue());
     }
   }
   if (!flow_files_to_be_swapped_out.empty()) {
-    for (const auto& flow_file : flow_files_to_be_swapped_out) {
-      swapped_flow_files_.push(SwappedFlowFile{flow_file->getUUID(), flow_file->getPenaltyExpiration()});
+    initiateStore(std::move(flow_files_to_be_swapped_out));
+  }
+}
+
+void FlowFileQueue::initiateStore(std::vector<value_type> flow_files) {
+  processFinishedStoreTasks();
+  std::vector<utils::Identifier> ids;
+  ids.reserve(flow_files.size());
+  for (const auto& flow_file : flow_files) {
+    const auto [priority_key, to_be_processed_after] = orderOf(*flow_file);
+    const auto memory_size = flow_file->getEstimatedMemoryUsage();
+    swapped_flow_files_.push(SwappedFlowFile{flow_file->getUUID(), to_be_processed_after, priority_key, memory_size});
+    swapped_memory_size_ += memory_size;
+    ids.push_back(flow_file->getUUID());
+  }
+  logger_->log_debug("Initiating store of {} flow files", flow_files.size());
+  pending_store_ids_.insert(ids.begin(), ids.end());
+  store_tasks_.emplace_back(swap_manager_->store(std::move(flow_files)), std::move(ids));
+}
+
+void FlowFileQueue::processFinishedStoreTasks() {
+  std::erase_if(store_tasks_, [&](StoreTask& store_task) {
+    if (store_task.done.wait_for(std::chrono::milliseconds{0}) != std::future_status::ready) {
+      return false;
+    }
+    try {
+      store_task.done.get();
+      logger_->log_debug("Stored {} flow files", store_task.ids.size());
+    } catch (const std::exception& ex) {
+      logger_->log_error("Failed to store {} swapped out flow files: {}", store_task.ids.size(), ex.what());
+    }
+    for (const auto& id : store_task.ids) {
+      pending_store_ids_.erase(id);
     }
-    logger_->log_debug("Initiating store of {} flow files", flow_files_to_be_swapped_out.size());
-    swap_manager_->store(std::move(flow_files_to_be_swapped_out));
+    return true;
+  });
+}
+
+void FlowFileQueue::pushToQueue(value_type element, Order order, bool penalized) {
+  const auto memory_size = element->getEstimatedMemoryUsage();
+  queued_memory_size_ += memory_size;
+  if (penalized) {
+    queue_.push(QueuedFlowFile{order, std::move(element), memory_size});
+  } else {
+    queue_.pushBack(QueuedFlowFile{order, std::move(element), memory_size});
   }
 }
 
+FlowFileQueue::value_type FlowFileQueue::popMinFromQueue() {
+  auto element = queue_.popMin();
+  queued_memory_size_ -= element.memory_size;
+  return std::move(element.flow_file);
+}
+
+FlowFileQueue::value_type FlowFileQueue::popMaxFromQueue() {
+  auto element = queue_.popMax();
+  queued_memory_size_ -= element.memory_size;
+  return std::move(element.flow_file);
+}
+
 bool FlowFileQueue::isWorkAvailable() const {
   auto now = clock_->now();
+  if (!penalized_flow_files_.empty() && penalized_flow_files_.min()->getPenaltyExpiration() <= now) {
+    return true;
+  }
   if (!queue_.empty()) {
-    return queue_.min()->getPenaltyExpiration() <= now;
+    return queue_.min().order.to_be_processed_after <= now;
   }
   if (load_task_) {
-    if (load_task_->min > now) {
+    if (load_task_->min.to_be_processed_after > now) {
       return false;
     }
     auto status = load_task_->items.wait_for(std::chrono::milliseconds{0});
@@ -165,36 +253,56 @@ bool FlowFileQueue::empty() const {
 }
 
 size_t FlowFileQueue::size() const {
-  return queue_.size() + (load_task_ ? load_task_->size()  : 0) + swapped_flow_files_.size();
+  return queue_.size() + penalized_flow_files_.size() + (load_task_ ? load_task_->size()  : 0) + swapped_flow_files_.size();
+}
+
+size_t FlowFileQueue::swappedCount() const {
+  return swapped_flow_files_.size() + (load_task_ ? load_task_->count : 0);
+}
+
+uint64_t FlowFileQueue::swappedMemorySize() const {
+  return swapped_memory_size_ + (load_task_ ? load_task_->memory_size : 0);
 }
 
 void FlowFileQueue::clear() {
   queue_.clear();
+  queued_memory_size_ = 0;
+  penalized_flow_files_.clear();
   load_task_.reset();
   swapped_flow_files_.clear();
+  swapped_memory_size_ = 0;
 }
 
 void FlowFileQueue::initiateLoadIfNeeded() {
   if (load_task_) {
     throw std::logic_error("There is already an active load task running");
   }
-  size_t flow_files_count = shouldSwapInCount();
-  if (flow_files_count == 0) {
+  if (!swap_manager_ || swapped_flow_files_.empty() || !shouldSwapIn()) {
     return;
   }
-  logger_->log_debug("Initiating load of {} flow files", flow_files_count);
-  TimePoint min = TimePoint::max();
-  TimePoint max = TimePoint::min();
+  processFinishedStoreTasks();
+  Order min{std::numeric_limits<int64_t>::max(), TimePoint::max()};
+  Order max{std::numeric_limits<int64_t>::min(), TimePoint::min()};
+  uint64_t memory_size = 0;
   std::vector<SwappedFlowFile> flow_files;
-  flow_files.reserve(flow_files_count);
-  for (size_t i = 0; i < flow_files_count; ++i) {
+  // the swap manager may only load the flow files which have been completely stored, we do not wait
+  // for the pending stores here, the load is retried on the next pop once they have finished
+  while (!swapped_flow_files_.empty() && !pending_store_ids_.contains(swapped_flow_files_.min().id)
+      && isBelowSwapInTarget(queue_.size() + flow_files.size(), queued_memory_size_ + memory_size)) {
     SwappedFlowFile flow_file = swapped_flow_files_.popMin();
     // TODO(adebreceni): since we are popping in order, we could elide these std::min and std::max comparisons
-    min = std::min(min, flow_file.to_be_processed_after);
-    max = std::max(max, flow_file.to_be_processed_after);
+    min = std::min(min, orderOf(flow_file));
+    max = std::max(max, orderOf(flow_file));
+    memory_size += flow_file.memory_size;
     flow_files.push_back(flow_file);
   }
-  load_task_ = {min, max, swap_manager_->load(std::move(flow_files)), flow_files_count};
+  if (flow_files.empty()) {
+    return;
+  }
+  swapped_memory_size_ -= memory_size;
+  const size_t flow_files_count = flow_files.size();
+  logger_->log_debug("Initiating load of {} flow files", flow_files_count);
+  load_task_ = {min, max, swap_manager_->load(std::move(flow_files)), flow_files_count, memory_size};
 }
 
 void FlowFileQueue::setMinSize(size_t min_size) {
@@ -209,39 +317,74 @@ void FlowFileQueue::setMaxSize(size_t max_size) {
   max_size_ = max_size;
 }
 
-size_t FlowFileQueue::shouldSwapOutCount() const {
+void FlowFileQueue::setMinMemorySize(uint64_t min_memory_size) {
+  min_memory_size_ = min_memory_size;
+}
+
+void FlowFileQueue::setTargetMemorySize(uint64_t target_memory_size) {
+  target_memory_size_ = target_memory_size;
+}
+
+void FlowFileQueue::setMaxMemorySize(uint64_t max_memory_size) {
+  max_memory_size_ = max_memory_size;
+}
+
+void FlowFileQueue::setPrioritizer(std::shared_ptr<core::FlowFilePrioritizer> prioritizer) {
+  gsl_Expects(empty());
+  prioritizer_ = std::move(prioritizer);
+}
+
+bool FlowFileQueue::shouldSwapOut() const {
   if (!swap_manager_) {
-    return 0;
+    return false;
   }
   // read once for consistent view of a single atomic variable
   size_t max_size = max_size_;
   size_t target_size = target_size_;
+  uint64_t max_memory_size = max_memory_size_;
+  uint64_t target_memory_size = target_memory_size_;
   if (max_size != 0 && target_size != 0
       && max_size < queue_.size() && target_size < queue_.size()) {
-    return queue_.size() - target_size;
+    return true;
   }
-  return 0;
+  return max_memory_size != 0 && target_memory_size != 0
+      && max_memory_size < queued_memory_size_ && target_memory_size < queued_memory_size_;
 }
 
-size_t FlowFileQueue::shouldSwapInCount() const {
-  if (!swap_manager_) {
-    return 0;
-  }
+bool FlowFileQueue::isAboveSwapOutTarget() const {
+  size_t target_size = target_size_;
+  uint64_t target_memory_size = target_memory_size_;
+  return (target_size != 0 && target_size < queue_.size())
+      || (target_memory_size != 0 && target_memory_size < queued_memory_size_);
+}
+
+bool FlowFileQueue::shouldSwapIn() const {
   // read once for consistent view of a single atomic variable
   size_t min_size = min_size_;
   size_t target_size = target_size_;
-  if (min_size == 0 || target_size == 0) {
-    if (!swapped_flow_files_.empty()) {
-      logger_->log_info("Swapping in all the flow files");
-      return swapped_flow_files_.size();
-    }
-    return 0;
+  uint64_t min_memory_size = min_memory_size_;
+  uint64_t target_memory_size = target_memory_size_;
+  const bool count_limited = min_size != 0 && target_size != 0;
+  const bool memory_limited = min_memory_size != 0 && target_memory_size != 0;
+  if (!count_limited && !memory_limited) {
+    logger_->log_info("Swapping in all the flow files");
+    return true;
   }
-  if (queue_.size() < min_size && queue_.size() < target_size) {
-    return std::min(target_size - queue_.size(), swapped_flow_files_.size());
+  // the queue_ has to be below the low watermark of every configured limit
+  if (count_limited && (queue_.size() >= min_size || queue_.size() >= target_size)) {
+    return false;
   }
-  return 0;
+  return !memory_limited || (queued_memory_size_ < min_memory_size && queued_memory_size_ < target_memory_size);
 }
 
+bool FlowFileQueue::isBelowSwapInTarget(size_t count, uint64_t memory_size) const {
+  size_t min_size = min_size_;
+  size_t target_size = target_size_;
+  uint64_t min_memory_size = min_memory_size_;
+  uint64_t target_memory_size = target_memory_size_;
+  const bool count_limited = min_size != 0 && target_size != 0;
+  const bool memory_limited = min_memory_size != 0 && target_memory_size != 0;
+  return (!count_limited || count < target_size) && (!memory_limited || memory_size < target_memory_size);
+}
 
 }  // namespace org::apache::nifi::minifi::utils
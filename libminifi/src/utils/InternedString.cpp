@@ -0,0 +1,121 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/InternedString.h"
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_set>
+
+#include "utils/Hash.h"
+
+namespace org::apache::nifi::minifi::utils {
+
+namespace {
+
+/**
+ * The table is split into shards by the hash of the strings, each with its own lock, so that threads interning
+ * different strings rarely contend. The frequent strings, like the common attribute keys, are found without locking
+ * in a small per-thread cache of the recently interned strings.
+ * The strings are never removed, so the InternedStrings and the caches point to them without reference counting,
+ * and copying them does not touch any shared state.
+ */
+class InternTable {
+ public:
+  std::shared_ptr<const std::string> intern(std::string_view value) {
+    const auto hash = TransparentStringHash{}(value);
+    // direct mapped by the hash, a string replaces the one it collides with
+    thread_local std::array<const std::string*, CACHE_SIZE> cache{};
+    auto& cached = cache[hash % CACHE_SIZE];
+    if (cached && *cached == value) {
+      return unowned(*cached);
+    }
+
+    auto& shard = shards_[hash / CACHE_SIZE % SHARD_COUNT];
+    {
+      std::shared_lock lock(shard.mutex);
+      if (auto it = shard.strings.find(value); it != shard.strings.end()) {
+        cached = &*it;
+        return unowned(*it);
+      }
+    }
+    std::lock_guard lock(shard.mutex);
+    if (auto it = shard.strings.find(value); it == shard.strings.end()) {
+      if (size_.fetch_add(1) >= InternedString::MAX_INTERNED_STRING_COUNT) {
+        --size_;
+        return std::make_shared<const std::string>(value);
+      }
+      // the nodes of the set are not moved on rehashing, so the strings stay where they are
+      cached = &*shard.strings.emplace(value).first;
+    } else {
+      // interned by another thread since the lookup
+      cached = &*it;
+    }
+    return unowned(*cached);
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+  static std::shared_ptr<const std::string> unowned(const std::string& str) {
+    // aliasing an empty shared_ptr: a non-null pointer without a control block
+    return {std::shared_ptr<const void>{}, &str};
+  }
+
+ private:
+  static constexpr size_t SHARD_COUNT = 16;
+  static constexpr size_t CACHE_SIZE = 256;
+
+  struct Shard {
+    std::shared_mutex mutex;
+    std::unordered_set<std::string, TransparentStringHash, std::equal_to<>> strings;
+  };
+
+  std::array<Shard, SHARD_COUNT> shards_;
+  std::atomic<size_t> size_{0};
+};
+
+InternTable& internTable() {
+  // never destroyed, as the InternedStrings of other static objects may still point into it
+  static auto* const table = new InternTable();
+  return *table;
+}
+
+const std::string& emptyString() {
+  static const std::string empty;
+  return empty;
+}
+
+}  // namespace
+
+InternedString::InternedString()
+    : value_(InternTable::unowned(emptyString())) {
+}
+
+InternedString::InternedString(std::string_view value)
+    : value_(value.empty() ? InternTable::unowned(emptyString()) : internTable().intern(value)) {
+}
+
+size_t InternedString::getInternedStringCount() {
+  return internTable().size();
+}
+
+}  // namespace org::apache::nifi::minifi::utils
@@ -18,15 +18,22 @@
 
 #include "utils/OsUtils.h"
 
+#include <algorithm>
+#include <cctype>
 #include <iostream>
 #include <map>
 
 #include "fmt/format.h"
 #include "utils/gsl.h"
+#include "utils/StringUtils.h"
 #include "Exception.h"
 
 #ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
 #include <sys/sysinfo.h>
+#include <unistd.h>
 #include <cstdlib>
 #include <optional>
 #include <sstream>
@@ -351,4 +358,91 @@ std::optional<double> OsUtils::getSystemLoadAverage() {
 #endif
 }
 
+std::optional<std::vector<unsigned>> OsUtils::parseCpuList(std::string_view cpu_list) {
+  // the largest CPU number supported by the Linux kernel (NR_CPUS)
+  constexpr unsigned max_cpu = 8191;
+  const auto parse_cpu = [](const std::string& str) -> std::optional<unsigned> {
+    if (str.empty() || !std::all_of(str.begin(), str.end(), [](char c) { return std::isdigit(static_cast<unsigned char>(c)); })) {
+      return std::nullopt;
+    }
+    try {
+      return gsl::narrow<unsigned>(std::stoul(str));
+    } catch (const std::exception&) {
+      return std::nullopt;
+    }
+  };
+
+  std::vector<unsigned> cpus;
+  for (const auto& range : StringUtils::splitAndTrimRemovingEmpty(cpu_list, ",")) {
+    const auto bounds = StringUtils::splitAndTrim(range, "-");
+    if (bounds.size() > 2) {
+      return std::nullopt;
+    }
+    const auto first = parse_cpu(bounds.front());
+    const auto last = parse_cpu(bounds.back());
+    if (!first || !last || *first > *last || *last > max_cpu) {
+      return std::nullopt;
+    }
+    for (unsigned cpu = *first; cpu <= *last; ++cpu) {
+      cpus.push_back(cpu);
+    }
+  }
+  if (cpus.empty()) {
+    return std::nullopt;
+  }
+  std::sort(cpus.begin(), cpus.end());
+  cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+  return cpus;
+}
+
+std::vector<unsigned> OsUtils::getNumaNodeCpus(unsigned numa_node) {
+#ifdef __linux__
+  std::ifstream cpu_list_file(fmt::format("/sys/devices/system/node/node{}/cpulist", numa_node));
+  std::string cpu_list;
+  if (cpu_list_file && std::getline(cpu_list_file, cpu_list)) {
+    return parseCpuList(cpu_list).value_or(std::vector<unsigned>{});
+  }
+#else
+  (void)numa_node;
+#endif
+  return {};
+}
+
+bool OsUtils::setCurrentThreadCpuAffinity(const std::vector<unsigned>& cpus) {
+#ifdef __linux__
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (const auto cpu : cpus) {
+    if (cpu >= CPU_SETSIZE) {
+      return false;
+    }
+    CPU_SET(cpu, &cpu_set);
+  }
+  return !cpus.empty() && pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) == 0;
+#else
+  (void)cpus;
+  return false;
+#endif
+}
+
+bool OsUtils::setCurrentThreadMemoryNode(unsigned numa_node) {
+#if defined(__linux__) && defined(SYS_set_mempolicy)
+  // the largest NUMA node number supported by the Linux kernel (MAX_NUMNODES - 1)
+  constexpr unsigned max_numa_node = 1023;
+  // MPOL_BIND of linux/mempolicy.h, set_mempolicy is called directly instead of depending on libnuma
+  constexpr int mpol_bind = 2;
+  constexpr unsigned bits_per_word = sizeof(unsigned long) * 8;  // NOLINT(runtime/int)
+  if (numa_node > max_numa_node) {
+    return false;
+  }
+  std::vector<unsigned long> node_mask(numa_node / bits_per_word + 1);  // NOLINT(runtime/int)
+  node_mask[numa_node / bits_per_word] |= 1UL << (numa_node % bits_per_word);
+  // the kernel expects the number of bits in the mask plus one
+  return syscall(SYS_set_mempolicy, mpol_bind, node_mask.data(), node_mask.size() * bits_per_word + 1) == 0;
+#else
+  (void)numa_node;
+  return false;
+#endif
+}
+
 }  // namespace org::apache::nifi::minifi::utils
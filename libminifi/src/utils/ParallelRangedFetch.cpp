@@ -0,0 +1,77 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "utils/ParallelRangedFetch.h"
+
+#include <algorithm>
+#include <deque>
+#include <future>
+
+#include "utils/gsl.h"
+
+namespace org::apache::nifi::minifi::utils {
+
+std::optional<uint64_t> parallelRangedFetch(uint64_t object_size, const ParallelRangedFetchSettings& settings, const RangeFetcher& fetch_range, io::OutputStream& output) {
+  gsl_Expects(settings.range_size > 0);
+  const auto max_concurrent_ranges = (std::max)(settings.max_concurrent_ranges, uint64_t{1});
+
+  // the ranges are written in the order they were started, the futures of std::async block on destruction,
+  // so no fetch outlives this function, not even when writing the output throws
+  std::deque<std::future<std::optional<std::vector<std::byte>>>> ranges_in_flight;
+  std::deque<uint64_t> range_lengths;
+  uint64_t write_size = 0;
+  bool failed = false;
+
+  const auto write_oldest_range = [&] {
+    auto range = ranges_in_flight.front().get();
+    const auto expected_length = range_lengths.front();
+    ranges_in_flight.pop_front();
+    range_lengths.pop_front();
+    if (failed || !range || range->size() != expected_length) {
+      failed = true;
+      return;
+    }
+    const auto ret = output.write(*range);
+    if (io::isError(ret) || ret != range->size()) {
+      failed = true;
+      return;
+    }
+    write_size += ret;
+  };
+
+  for (uint64_t offset = 0; offset < object_size && !failed; ) {
+    while (ranges_in_flight.size() >= max_concurrent_ranges && !failed) {
+      write_oldest_range();
+    }
+    if (failed) {
+      break;
+    }
+    const auto length = (std::min)(settings.range_size, object_size - offset);
+    ranges_in_flight.push_back(std::async(std::launch::async, [&fetch_range, offset, length] { return fetch_range(offset, length); }));
+    range_lengths.push_back(length);
+    offset += length;
+  }
+  while (!ranges_in_flight.empty()) {
+    write_oldest_range();
+  }
+
+  if (failed) {
+    return std::nullopt;
+  }
+  return write_size;
+}
+
+}  // namespace org::apache::nifi::minifi::utils
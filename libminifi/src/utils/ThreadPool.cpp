@@ -17,6 +17,8 @@
 
 #include "utils/ThreadPool.h"
 
+#include "utils/OsUtils.h"
+
 using namespace std::literals::chrono_literals;
 
 namespace org::apache::nifi::minifi::utils {
@@ -27,13 +29,111 @@ ThreadPool::ThreadPool(int max_worker_threads, core::controller::ControllerServi
       current_workers_(0),
       adjust_threads_(false),
       running_(false),
+      paused_(false),
       controller_service_provider_(controller_service_provider),
+      next_run_queue_(0),
+      queued_task_count_(0),
+      sleeping_worker_count_(0),
       name_(std::move(name)),
       logger_(core::logging::LoggerFactory<ThreadPool>::getLogger()) {
+  resizeRunQueues(std::max(max_worker_threads_, 1));
+}
+
+void ThreadPool::resizeRunQueues(size_t run_queue_count) {
+  if (run_queue_count == run_queues_.size()) {
+    return;
+  }
+  std::vector<ScheduledTask> tasks;
+  for (auto& run_queue : run_queues_) {
+    std::move(run_queue->tasks.begin(), run_queue->tasks.end(), std::back_inserter(tasks));
+  }
+  run_queues_.clear();
+  for (size_t i = 0; i < run_queue_count; ++i) {
+    run_queues_.push_back(std::make_unique<RunQueue>());
+  }
+  for (size_t i = 0; i < tasks.size(); ++i) {
+    run_queues_[i % run_queue_count]->tasks.push_back(std::move(tasks[i]));
+  }
+}
+
+void ThreadPool::enqueue(ScheduledTask&& task, std::optional<size_t> run_queue_index) {
+  // tasks submitted from the outside are spread among the run queues, the rest stay with the worker which ran them
+  auto& run_queue = *run_queues_[run_queue_index.value_or(next_run_queue_++) % run_queues_.size()];
+  {
+    std::lock_guard<std::mutex> lock(run_queue.mutex);
+    run_queue.tasks.push_back(std::move(task));
+    // counted under the lock of the run queue like the removals, so that a worker taking the task cannot decrement the count first
+    ++queued_task_count_;
+  }
+  if (sleeping_worker_count_ > 0) {
+    std::lock_guard<std::mutex> lock(work_available_mutex_);
+    work_available_.notify_one();
+  }
 }
 
-void ThreadPool::run_tasks(const std::shared_ptr<WorkerThread>& thread) {
+bool ThreadPool::dequeue(size_t run_queue_index, ScheduledTask& task) {
+  // the worker takes the oldest task of its own queue, but steals the newest one from the others
+  // to keep the queues FIFO for the tasks which are rescheduled immediately
+  for (size_t i = 0; i < run_queues_.size(); ++i) {
+    auto& run_queue = *run_queues_[(run_queue_index + i) % run_queues_.size()];
+    std::lock_guard<std::mutex> lock(run_queue.mutex);
+    if (run_queue.tasks.empty()) {
+      continue;
+    }
+    if (i == 0) {
+      task = std::move(run_queue.tasks.front());
+      run_queue.tasks.pop_front();
+    } else {
+      task = std::move(run_queue.tasks.back());
+      run_queue.tasks.pop_back();
+    }
+    --queued_task_count_;
+    return true;
+  }
+  return false;
+}
+
+void ThreadPool::waitForWork() {
+  std::unique_lock<std::mutex> lock(work_available_mutex_);
+  ++sleeping_worker_count_;
+  work_available_.wait(lock, [this] {
+    return !running_ || thread_reduction_count_ > 0 || (!paused_ && queued_task_count_ > 0);
+  });
+  --sleeping_worker_count_;
+}
+
+void ThreadPool::finishRun(const ScheduledTask& task) {
+  if (--task.state->running_count == 0 && !task.isCurrent()) {
+    // stopTasks() may be waiting for the last run of the task to complete
+    std::lock_guard<std::mutex> lock(task_run_complete_mutex_);
+    task_run_complete_.notify_all();
+  }
+}
+
+void ThreadPool::park(ScheduledTask&& task) {
+  const auto state = task.state;
+  std::lock_guard<std::mutex> lock(state->parked_tasks_mutex);
+  if (!task.isCurrent()) {
+    // the task was stopped while it was running
+    return;
+  }
+  if (state->notified) {
+    // the notification arrived while the task was running, it may have missed the work
+    state->notified = false;
+    enqueue(std::move(task));
+    return;
+  }
+  state->parked_tasks.push_back(std::move(task));
+}
+
+void ThreadPool::run_tasks(const std::shared_ptr<WorkerThread>& thread, size_t run_queue_index) {
   thread->is_running_ = true;
+  if (!cpu_affinity_.empty() && !OsUtils::setCurrentThreadCpuAffinity(cpu_affinity_)) {
+    logger_->log_warn("Could not set the CPU affinity of worker thread {} of thread pool {}", thread->name_, name_);
+  }
+  if (numa_node_ && !OsUtils::setCurrentThreadMemoryNode(*numa_node_)) {
+    logger_->log_warn("Could not bind the memory of worker thread {} of thread pool {} to NUMA node {}", thread->name_, name_, *numa_node_);
+  }
   while (running_.load()) {
     if (UNLIKELY(thread_reduction_count_ > 0)) {
       if (--thread_reduction_count_ >= 0) {
@@ -45,51 +145,43 @@ void ThreadPool::run_tasks(const std::shared_ptr<WorkerThread>& thread) {
       }
     }
 
-    Worker task;
-    if (worker_queue_.dequeueWait(task)) {
-      {
-        std::unique_lock<std::mutex> lock(worker_queue_mutex_);
-        if (!task_status_[task.getIdentifier()]) {
-          continue;
-        } else if (!worker_queue_.isRunning()) {
-          worker_queue_.enqueue(std::move(task));
-          continue;
-        }
-        ++running_task_count_by_id_[task.getIdentifier()];
+    ScheduledTask task;
+    if (paused_ || !dequeue(run_queue_index, task)) {
+      waitForWork();
+      continue;
+    }
+    if (!task.isCurrent()) {
+      // the task was stopped after it had been dequeued
+      continue;
+    }
+    ++task.state->running_count;
+    if (!task.isCurrent()) {
+      finishRun(task);
+      continue;
+    }
+    thread->task_run_start_ = std::chrono::steady_clock::now().time_since_epoch().count();
+    const bool taskRunResult = task.worker.run();
+    // getUtilization may have moved the start forward while the task was running
+    const auto run_start = thread->task_run_start_.exchange(0);
+    busy_time_ += std::chrono::steady_clock::now().time_since_epoch().count() - run_start;
+    finishRun(task);
+    if (taskRunResult) {
+      if (task.worker.isWaitingForNotification()) {
+        park(std::move(task));
+        continue;
       }
-      const bool taskRunResult = task.run();
-      {
-        std::unique_lock<std::mutex> lock(worker_queue_mutex_);
-        auto& count = running_task_count_by_id_[task.getIdentifier()];
-        if (count == 1) {
-          running_task_count_by_id_.erase(task.getIdentifier());
-        } else {
-          --count;
-        }
+      if (task.worker.getNextExecutionTime() <= std::chrono::steady_clock::now()) {
+        // it can be rescheduled again as soon as there is a worker available
+        enqueue(std::move(task), run_queue_index);
+        continue;
       }
-      task_run_complete_.notify_all();
-      if (taskRunResult) {
-        if (task.getNextExecutionTime() <= std::chrono::steady_clock::now()) {
-          // it can be rescheduled again as soon as there is a worker available
-          worker_queue_.enqueue(std::move(task));
-          continue;
-        }
-        // Task will be put to the delayed queue as next exec time is in the future
-        std::unique_lock<std::mutex> lock(worker_queue_mutex_);
-        bool need_to_notify =
-            delayed_worker_queue_.empty() ||
-                task.getNextExecutionTime() < delayed_worker_queue_.top().getNextExecutionTime();
-
-        delayed_worker_queue_.push(std::move(task));
-        if (need_to_notify) {
-          delayed_task_available_.notify_all();
-        }
-      }
-    } else {
-      // The threadpool is running, but the ConcurrentQueue is stopped -> shouldn't happen during normal conditions
-      // Might happen during startup or shutdown for a very short time
-      if (running_.load()) {
-        std::this_thread::sleep_for(1ms);
+      // Task will be put to the delayed queue as next exec time is in the future
+      std::lock_guard<std::mutex> lock(delayed_tasks_mutex_);
+      const auto next_exec_time = task.worker.getNextExecutionTime();
+      const auto next_deadline = delayed_tasks_.nextDeadline();
+      delayed_tasks_.add(next_exec_time, std::move(task));
+      if (!next_deadline || next_exec_time < *next_deadline) {
+        delayed_task_available_.notify_all();
       }
     }
   }
@@ -98,41 +190,102 @@ void ThreadPool::run_tasks(const std::shared_ptr<WorkerThread>& thread) {
 
 void ThreadPool::manage_delayed_queue() {
   while (running_) {
-    std::unique_lock<std::mutex> lock(worker_queue_mutex_);
-
-    // Put the tasks ready to run in the worker queue
-    while (!delayed_worker_queue_.empty() && delayed_worker_queue_.top().getNextExecutionTime() <= std::chrono::steady_clock::now()) {
-      // I'm very sorry for this - committee must has been seriously drunk when the interface of prio queue was submitted.
-      Worker task = std::move(const_cast<Worker&>(delayed_worker_queue_.top()));
-      delayed_worker_queue_.pop();
-      worker_queue_.enqueue(std::move(task));
-    }
-    if (delayed_worker_queue_.empty()) {
-      delayed_task_available_.wait(lock);
-    } else {
-      auto wait_time = delayed_worker_queue_.top().getNextExecutionTime() - std::chrono::steady_clock::now();
+    std::unique_lock<std::mutex> lock(delayed_tasks_mutex_);
+
+    // Put the tasks ready to run in the run queues
+    delayed_tasks_.expire(std::chrono::steady_clock::now(), [this] (ScheduledTask&& task) {
+      enqueue(std::move(task));
+    });
+    if (const auto next_deadline = delayed_tasks_.nextDeadline()) {
+      auto wait_time = *next_deadline - std::chrono::steady_clock::now();
       delayed_task_available_.wait_for(lock, std::max(wait_time, std::chrono::steady_clock::duration(1ms)));
+    } else {
+      delayed_task_available_.wait(lock);
+    }
+  }
+}
+
+std::shared_ptr<ThreadPool::TaskState> ThreadPool::getTaskState(const std::lock_guard<std::mutex>& /*task_states_lock*/, const TaskId& identifier) {
+  auto& state = task_states_[identifier];
+  if (!state) {
+    state = std::make_shared<TaskState>();
+    state->pool = this;
+  }
+  return state;
+}
+
+std::function<void()> ThreadPool::createNotifier(const TaskId &identifier) {
+  std::weak_ptr<TaskState> weak_state;
+  {
+    std::lock_guard<std::mutex> lock(task_states_mutex_);
+    weak_state = getTaskState(lock, identifier);
+  }
+  return [weak_state = std::move(weak_state)] {
+    const auto state = weak_state.lock();
+    if (!state) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(state->parked_tasks_mutex);
+    if (!state->pool) {
+      return;
+    }
+    if (state->parked_tasks.empty()) {
+      state->notified = true;
+      return;
+    }
+    auto task = std::move(state->parked_tasks.back());
+    state->parked_tasks.pop_back();
+    state->pool->enqueue(std::move(task));
+  };
+}
+
+double ThreadPool::getUtilization() {
+  std::lock_guard<std::mutex> lock(utilization_mutex_);
+  const auto now = std::chrono::steady_clock::now();
+  if (now - utilization_collection_start_ < 1s) {
+    return last_utilization_;
+  }
+  {
+    // count the elapsed time of the running tasks, so that long running tasks are not reported only when they complete
+    const auto now_count = now.time_since_epoch().count();
+    std::lock_guard<std::mutex> thread_queue_lock(thread_queue_mutex_);
+    for (const auto& thread : thread_queue_) {
+      auto run_start = thread->task_run_start_.load();
+      while (run_start != 0 && run_start < now_count && !thread->task_run_start_.compare_exchange_weak(run_start, now_count)) {}
+      if (run_start != 0 && run_start < now_count) {
+        busy_time_ += now_count - run_start;
+      }
     }
   }
+  const auto busy_time = busy_time_.load();
+  const auto available_time = (now - utilization_collection_start_).count() * std::max(max_worker_threads_, 1);
+  last_utilization_ = std::clamp(static_cast<double>(busy_time - utilization_collection_start_busy_time_) / static_cast<double>(available_time), 0.0, 1.0);
+  utilization_collection_start_ = now;
+  utilization_collection_start_busy_time_ = busy_time;
+  return last_utilization_;
 }
 
 void ThreadPool::execute(Worker &&task, std::future<utils::TaskRescheduleInfo> &future) {
+  ScheduledTask scheduled_task{std::move(task)};
   {
-    std::unique_lock<std::mutex> lock(worker_queue_mutex_);
-    task_status_[task.getIdentifier()] = true;
+    std::lock_guard<std::mutex> lock(task_states_mutex_);
+    const auto state = getTaskState(lock, scheduled_task.worker.getIdentifier());
+    state->enabled = true;
+    scheduled_task.state = state;
+    scheduled_task.generation = state->generation;
   }
-  future = task.getPromise()->get_future();
-  worker_queue_.enqueue(std::move(task));
+  future = scheduled_task.worker.getPromise()->get_future();
+  enqueue(std::move(scheduled_task));
 }
 
 void ThreadPool::manageWorkers() {
   {
-    std::unique_lock<std::mutex> lock(worker_queue_mutex_);
+    std::unique_lock<std::mutex> lock(thread_queue_mutex_);
     for (int i = 0; i < max_worker_threads_; i++) {
       std::stringstream thread_name;
       thread_name << name_ << " #" << i;
       auto worker_thread = std::make_shared<WorkerThread>(thread_name.str());
-      worker_thread->thread_ = createThread([this, worker_thread] { run_tasks(worker_thread); });
+      worker_thread->thread_ = createThread([this, worker_thread, i] { run_tasks(worker_thread, gsl::narrow<size_t>(i)); });
       thread_queue_.push_back(worker_thread);
       current_workers_++;
     }
@@ -152,20 +305,26 @@ void ThreadPool::manageWorkers() {
           auto max = thread_manager_->getMaxConcurrentTasks();
           auto differential = current_workers_ - max;
           thread_reduction_count_ += differential;
+          std::lock_guard<std::mutex> work_available_lock(work_available_mutex_);
+          work_available_.notify_all();
         } else if (thread_manager_->shouldReduce()) {
-          if (current_workers_ > 1)
+          if (current_workers_ > 1) {
             thread_reduction_count_++;
+            std::lock_guard<std::mutex> work_available_lock(work_available_mutex_);
+            work_available_.notify_one();
+          }
           thread_manager_->reduce();
         } else if (thread_manager_->canIncrease() && max_worker_threads_ > current_workers_) {  // increase slowly
-          std::unique_lock<std::mutex> worker_queue_lock(worker_queue_mutex_);
+          std::unique_lock<std::mutex> thread_queue_lock(thread_queue_mutex_);
           auto worker_thread = std::make_shared<WorkerThread>();
-          worker_thread->thread_ = createThread([this, worker_thread] { run_tasks(worker_thread); });
+          const auto run_queue_index = thread_queue_.size();
+          worker_thread->thread_ = createThread([this, worker_thread, run_queue_index] { run_tasks(worker_thread, run_queue_index); });
           thread_queue_.push_back(worker_thread);
           current_workers_++;
         }
         std::shared_ptr<WorkerThread> thread_ref;
         while (deceased_thread_queue_.tryDequeue(thread_ref)) {
-          std::unique_lock<std::mutex> worker_queue_lock(worker_queue_mutex_);
+          std::unique_lock<std::mutex> thread_queue_lock(thread_queue_mutex_);
           if (thread_ref->thread_.joinable())
             thread_ref->thread_.join();
           thread_queue_.erase(std::remove(thread_queue_.begin(), thread_queue_.end(), thread_ref), thread_queue_.end());
@@ -203,50 +362,63 @@ void ThreadPool::start() {
   if (!running_) {
     thread_manager_ = createThreadManager();
 
+    resizeRunQueues(std::max(max_worker_threads_, 1));
     running_ = true;
-    worker_queue_.start();
+    paused_ = false;
     manager_thread_ = std::thread(&ThreadPool::manageWorkers, this);
 
-    std::lock_guard<std::mutex> quee_lock(worker_queue_mutex_);
+    std::lock_guard<std::mutex> delayed_tasks_lock(delayed_tasks_mutex_);
     delayed_scheduler_thread_ = std::thread(&ThreadPool::manage_delayed_queue, this);
   }
 }
 
 void ThreadPool::stopTasks(const TaskId &identifier) {
-  std::unique_lock<std::mutex> lock(worker_queue_mutex_);
-  task_status_[identifier] = false;
-
-  // remove tasks belonging to identifier from worker_queue_
-  worker_queue_.remove([&] (const Worker& worker) { return worker.getIdentifier() == identifier; });
-
-  // also remove from delayed_worker_queue_
-  decltype(delayed_worker_queue_) new_delayed_worker_queue;
-  while (!delayed_worker_queue_.empty()) {
-    Worker task = std::move(const_cast<Worker&>(delayed_worker_queue_.top()));
-    delayed_worker_queue_.pop();
-    if (task.getIdentifier() != identifier) {
-      new_delayed_worker_queue.push(std::move(task));
-    }
+  std::shared_ptr<TaskState> state;
+  {
+    std::lock_guard<std::mutex> lock(task_states_mutex_);
+    state = getTaskState(lock, identifier);
+    state->enabled = false;
+    ++state->generation;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(state->parked_tasks_mutex);
+    state->parked_tasks.clear();
+    state->notified = false;
+  }
+
+  // remove tasks belonging to identifier from the run queues
+  const auto belongs_to_identifier = [&] (const ScheduledTask& task) { return task.state == state; };
+  for (auto& run_queue : run_queues_) {
+    std::lock_guard<std::mutex> lock(run_queue->mutex);
+    const auto removed = std::remove_if(run_queue->tasks.begin(), run_queue->tasks.end(), belongs_to_identifier);
+    queued_task_count_ -= gsl::narrow<size_t>(std::distance(removed, run_queue->tasks.end()));
+    run_queue->tasks.erase(removed, run_queue->tasks.end());
+  }
+
+  // also remove from the delayed tasks
+  {
+    std::lock_guard<std::mutex> lock(delayed_tasks_mutex_);
+    delayed_tasks_.removeIf(belongs_to_identifier);
   }
-  delayed_worker_queue_ = std::move(new_delayed_worker_queue);
 
   // if tasks are in progress, wait for their completion
+  std::unique_lock<std::mutex> lock(task_run_complete_mutex_);
   task_run_complete_.wait(lock, [&] () {
-    auto iter = running_task_count_by_id_.find(identifier);
-    return iter == running_task_count_by_id_.end() || iter->second == 0;
+    return state->running_count == 0;
   });
 }
 
 void ThreadPool::resume() {
-  if (!worker_queue_.isRunning()) {
-    worker_queue_.start();
+  if (paused_) {
+    paused_ = false;
+    std::lock_guard<std::mutex> lock(work_available_mutex_);
+    work_available_.notify_all();
   }
 }
 
 void ThreadPool::pause() {
-  if (worker_queue_.isRunning()) {
-    worker_queue_.stop();
-  }
+  paused_ = true;
 }
 
 void ThreadPool::shutdown() {
@@ -256,7 +428,15 @@ void ThreadPool::shutdown() {
 
     drain();
 
-    task_status_.clear();
+    {
+      std::lock_guard<std::mutex> task_states_lock(task_states_mutex_);
+      for (const auto& [identifier, state] : task_states_) {
+        std::lock_guard<std::mutex> parked_tasks_lock(state->parked_tasks_mutex);
+        state->parked_tasks.clear();
+        state->pool = nullptr;
+      }
+      task_states_.clear();
+    }
     if (manager_thread_.joinable()) {
       manager_thread_.join();
     }
@@ -265,25 +445,31 @@ void ThreadPool::shutdown() {
       // this lock ensures that the delayed_scheduler_thread_
       // is not between checking the running_ and before the cv_.wait*
       // as then, it would survive the notify_all call
-      std::lock_guard<std::mutex> worker_lock(worker_queue_mutex_);
+      std::lock_guard<std::mutex> delayed_tasks_lock(delayed_tasks_mutex_);
       delayed_task_available_.notify_all();
     }
     if (delayed_scheduler_thread_.joinable()) {
       delayed_scheduler_thread_.join();
     }
 
-    for (const auto &thread : thread_queue_) {
+    std::vector<std::shared_ptr<WorkerThread>> threads;
+    {
+      std::lock_guard<std::mutex> thread_queue_lock(thread_queue_mutex_);
+      threads.swap(thread_queue_);
+    }
+    for (const auto &thread : threads) {
       if (thread->thread_.joinable())
         thread->thread_.join();
     }
 
-    thread_queue_.clear();
     current_workers_ = 0;
-    while (!delayed_worker_queue_.empty()) {
-      delayed_worker_queue_.pop();
-    }
+    delayed_tasks_.clear();
 
-    worker_queue_.clear();
+    for (auto& run_queue : run_queues_) {
+      std::lock_guard<std::mutex> run_queue_lock(run_queue->mutex);
+      run_queue->tasks.clear();
+    }
+    queued_task_count_ = 0;
   }
 }
 
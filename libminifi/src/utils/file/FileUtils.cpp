@@ -29,6 +29,12 @@
 #include "utils/OsUtils.h"
 #endif
 
+#ifdef __linux__
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
 namespace org::apache::nifi::minifi::utils::file {
 
 uint64_t computeChecksum(const std::filesystem::path& file_name, uint64_t up_to_position) {
@@ -70,6 +76,57 @@ bool contains(const std::filesystem::path& file_path, std::string_view text_to_s
   return std::search(view.begin(), view.end(), searcher) != view.end();
 }
 
+nonstd::expected<uint64_t, std::error_code> copy_file_range(const std::filesystem::path& source, uint64_t offset, uint64_t size, const std::filesystem::path& destination) {
+#if defined(__linux__) && defined(SYS_copy_file_range)
+  const auto last_error = [] { return std::error_code{errno, std::generic_category()}; };
+  const int source_fd = ::open(source.c_str(), O_RDONLY | O_CLOEXEC);
+  if (source_fd < 0) {
+    return nonstd::make_unexpected(last_error());
+  }
+  const auto close_source = gsl::finally([source_fd] { ::close(source_fd); });
+  struct stat source_stat = {};
+  if (::fstat(source_fd, &source_stat) != 0) {
+    return nonstd::make_unexpected(last_error());
+  }
+  if (!S_ISREG(source_stat.st_mode)) {
+    return nonstd::make_unexpected(std::make_error_code(std::errc::operation_not_supported));
+  }
+  const int destination_fd = ::open(destination.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+  if (destination_fd < 0) {
+    return nonstd::make_unexpected(last_error());
+  }
+  const auto close_destination = gsl::finally([destination_fd] { ::close(destination_fd); });
+
+  const auto source_size = gsl::narrow<uint64_t>(source_stat.st_size);
+  const uint64_t to_copy = offset < source_size ? std::min(size, source_size - offset) : 0;
+#ifdef FICLONE
+  if (offset == 0 && to_copy == source_size && to_copy > 0 && ::ioctl(destination_fd, FICLONE, source_fd) == 0) {
+    return to_copy;
+  }
+#endif
+  auto source_offset = gsl::narrow<loff_t>(offset);
+  uint64_t copied = 0;
+  while (copied < to_copy) {
+    const size_t chunk = gsl::narrow<size_t>(std::min<uint64_t>(to_copy - copied, 1_GiB));
+    const auto result = ::syscall(SYS_copy_file_range, source_fd, &source_offset, destination_fd, nullptr, chunk, 0U);
+    if (result < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return nonstd::make_unexpected(last_error());
+    }
+    if (result == 0) {
+      break;
+    }
+    copied += gsl::narrow<uint64_t>(result);
+  }
+  return copied;
+#else
+  (void)source; (void)offset; (void)size; (void)destination;
+  return nonstd::make_unexpected(std::make_error_code(std::errc::operation_not_supported));
+#endif
+}
+
 std::chrono::system_clock::time_point to_sys(std::chrono::file_clock::time_point file_time) {
 #if defined(WIN32)
   // workaround for https://github.com/microsoft/STL/issues/2446
@@ -81,6 +81,7 @@ bool AsioSocketConnection::connectTcpSocketOverSsl() {
     logger_->log_error("Connecting to host '{}' on port '{}' failed with the following message: '{}'", socket_data_.host, socket_data_.port, err.message());
     return false;
   }
+  enableKeepAlive(socket.lowest_layer());
   socket.handshake(asio::ssl::stream_base::client, err);
   if (err) {
     logger_->log_error("SSL handshake failed while connecting to host '{}' on port '{}' with the following message: '{}'", socket_data_.host, socket_data_.port, err.message());
@@ -110,6 +111,7 @@ bool AsioSocketConnection::connectTcpSocket() {
     logger_->log_error("Connecting to host '{}' on port '{}' failed with the following message: '{}'", socket_data_.host, socket_data_.port, err.message());
     return false;
   }
+  enableKeepAlive(socket);
   stream_ = std::make_unique<io::AsioStream<asio::ip::tcp::socket>>(std::move(socket));
   return true;
 }
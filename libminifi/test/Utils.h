@@ -21,6 +21,10 @@
 #include <vector>
 #include <memory>
 
+#ifdef __linux__
+#include <sched.h>
+#endif
+
 #include "rapidjson/document.h"
 #include "asio.hpp"
 #include "asio/ssl.hpp"
@@ -223,6 +227,20 @@ inline std::error_code hide_file(const std::filesystem::path& file_name) {
 }
 #endif /* WIN32 */
 
+#ifdef __linux__
+// the test process may be restricted to some of the CPUs, e.g. by taskset or by the cpuset of a container
+inline unsigned getAllowedCpu() {
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  REQUIRE(sched_getaffinity(0, sizeof(cpu_set), &cpu_set) == 0);
+  unsigned cpu = 0;
+  while (!CPU_ISSET(cpu, &cpu_set)) {
+    ++cpu;
+  }
+  return cpu;
+}
+#endif /* __linux__ */
+
 template<typename T>
 concept NetworkingProcessor = std::derived_from<T, minifi::core::Processor>
     && requires(T x) {
@@ -0,0 +1,83 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "../TestBase.h"
+#include "../Catch.h"
+#include "Connection.h"
+#include "FlowFileRecord.h"
+
+namespace {
+
+constexpr size_t FLOW_FILES_PER_THREAD = 10000;
+constexpr size_t BATCH_SIZE = 100;
+
+// every thread puts its flow files into the connection and polls the same number of flow files back
+void transferThroughConnection(minifi::Connection& connection, std::vector<std::shared_ptr<minifi::core::FlowFile>>& flow_files, bool batched) {
+  std::set<std::shared_ptr<minifi::core::FlowFile>> expired;
+  if (batched) {
+    for (size_t offset = 0; offset < flow_files.size(); offset += BATCH_SIZE) {
+      std::vector<std::shared_ptr<minifi::core::FlowFile>> batch;
+      for (size_t i = offset; i < std::min(offset + BATCH_SIZE, flow_files.size()); ++i) {
+        batch.push_back(flow_files[i]);
+      }
+      connection.multiPut(batch);
+      size_t polled = 0;
+      while (polled < batch.size()) {
+        polled += connection.pollBatch(batch.size() - polled, expired).size();
+      }
+    }
+  } else {
+    for (const auto& flow_file : flow_files) {
+      connection.put(flow_file);
+      while (!connection.poll(expired)) {}
+    }
+  }
+}
+
+}  // namespace
+
+TEST_CASE("Connection throughput with concurrent producers and consumers", "[benchmark]") {
+  for (const size_t thread_count : {1, 2, 4, 8, 16, 32, 64}) {
+    minifi::Connection connection(nullptr, nullptr, "benchmark_connection");
+    std::vector<std::vector<std::shared_ptr<minifi::core::FlowFile>>> flow_files(thread_count);
+    for (auto& thread_flow_files : flow_files) {
+      for (size_t i = 0; i < FLOW_FILES_PER_THREAD; ++i) {
+        thread_flow_files.push_back(std::make_shared<minifi::FlowFileRecord>());
+      }
+    }
+
+    for (const bool batched : {false, true}) {
+      BENCHMARK(std::to_string(thread_count) + " threads, " + (batched ? "multiPut/pollBatch" : "put/poll")) {
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < thread_count; ++i) {
+          threads.emplace_back([&, i] { transferThroughConnection(connection, flow_files[i], batched); });
+        }
+        for (auto& thread : threads) {
+          thread.join();
+        }
+        return connection.getQueueSize();
+      };
+    }
+  }
+}
@@ -0,0 +1,97 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "../TestBase.h"
+#include "../Catch.h"
+#include "FlowFileRecord.h"
+
+namespace {
+
+std::atomic<size_t> allocation_count{0};
+
+template<typename F>
+size_t countAllocations(F&& function) {
+  const size_t before = allocation_count.load();
+  std::forward<F>(function)();
+  return allocation_count.load() - before;
+}
+
+std::shared_ptr<minifi::core::FlowFile> createFlowFile(size_t attribute_count) {
+  auto flow_file = std::make_shared<minifi::FlowFileRecord>();
+  for (size_t i = 0; i < attribute_count; ++i) {
+    flow_file->setAttribute("attribute.key." + std::to_string(i), "attribute value which does not fit in the small string buffer " + std::to_string(i));
+  }
+  for (size_t i = 0; i < 3; ++i) {
+    flow_file->addLineageIdentifier(minifi::utils::IdGenerator::getIdGenerator()->generate());
+  }
+  return flow_file;
+}
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+  ++allocation_count;
+  if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
+
+// ProcessSession::get() and ProcessSession::clone() take a snapshot of every flow file they hand out, so the
+// session can restore it on rollback; the snapshot shares the attributes and lineage until the flow file is modified
+TEST_CASE("FlowFile snapshot allocations", "[benchmark]") {
+  for (const size_t attribute_count : {0, 10, 50}) {
+    const auto flow_file = createFlowFile(attribute_count);
+    const std::shared_ptr<minifi::core::FlowFile> snapshot = std::make_shared<minifi::FlowFileRecord>();
+
+    const size_t eager_copy_allocations = countAllocations([&] {
+      // what the snapshot used to copy eagerly
+      minifi::core::FlowFile::AttributeMap attributes = flow_file->getAttributeMap();
+      std::vector<minifi::utils::Identifier> lineage = flow_file->getlineageIdentifiers();
+    });
+    const size_t snapshot_allocations = countAllocations([&] { *snapshot = *flow_file; });
+    const size_t first_modification_allocations = countAllocations([&] { flow_file->setAttribute("attribute.key.0", "modified"); });
+    WARN(attribute_count << " attributes: eager copy " << eager_copy_allocations << " allocations, copy-on-write snapshot "
+        << snapshot_allocations << " allocations, first modification after the snapshot " << first_modification_allocations << " allocations");
+    CHECK(snapshot_allocations == 0);
+
+    BENCHMARK(std::to_string(attribute_count) + " attributes, snapshot of an unmodified flow file") {
+      *snapshot = *flow_file;
+      return snapshot->getAttributeMap().size();
+    };
+    BENCHMARK(std::to_string(attribute_count) + " attributes, snapshot and modification") {
+      *snapshot = *flow_file;
+      flow_file->setAttribute("attribute.key.0", "modified");
+      return flow_file->getAttributeMap().size();
+    };
+  }
+}
@@ -0,0 +1,77 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <array>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "../TestBase.h"
+#include "../Catch.h"
+#include "utils/FlatMap.h"
+#include "utils/InternedString.h"
+
+namespace {
+
+constexpr size_t ITERATION_COUNT = 10000;
+
+// the attributes set on a flow file listed and fetched from a directory, with a few custom ones
+constexpr std::array<std::string_view, 8> ATTRIBUTE_KEYS{
+    "filename", "path", "absolute.path", "file.size", "file.lastModifiedTime", "mime.type", "sensor.id", "sensor.location"
+};
+
+// every thread builds ITERATION_COUNT attribute maps, like the processors creating flow files concurrently
+template<typename Key>
+size_t buildAttributeMaps(size_t thread_count) {
+  std::vector<std::thread> threads;
+  std::vector<size_t> sizes(thread_count);
+  for (size_t i = 0; i < thread_count; ++i) {
+    threads.emplace_back([&size = sizes[i]] {
+      for (size_t iteration = 0; iteration < ITERATION_COUNT; ++iteration) {
+        utils::FlatMap<Key, std::string> attributes;
+        for (const auto key : ATTRIBUTE_KEYS) {
+          attributes.try_emplace(key, "value");
+        }
+        // the flow file is cloned or snapshotted at least once on its way through the flow
+        const auto copy = attributes;
+        size += copy.size();
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  size_t total_size = 0;
+  for (const auto size : sizes) {
+    total_size += size;
+  }
+  return total_size;
+}
+
+}  // namespace
+
+TEST_CASE("Attribute keys created concurrently", "[benchmark]") {
+  for (const size_t thread_count : {1, 4, 16}) {
+    BENCHMARK(std::to_string(thread_count) + " threads, std::string keys") {
+      return buildAttributeMaps<std::string>(thread_count);
+    };
+    BENCHMARK(std::to_string(thread_count) + " threads, interned keys") {
+      return buildAttributeMaps<utils::InternedString>(thread_count);
+    };
+  }
+}
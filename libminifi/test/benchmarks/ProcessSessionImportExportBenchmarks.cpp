@@ -0,0 +1,88 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "../TestBase.h"
+#include "../Catch.h"
+#include "core/ProcessSession.h"
+#include "core/repository/FileSystemRepository.h"
+#include "utils/Literals.h"
+
+namespace {
+
+constexpr size_t SOURCE_FILE_SIZE = 64_MiB;
+
+std::filesystem::path createSourceFile(const std::filesystem::path& dir) {
+  const auto path = dir / "source.bin";
+  std::ofstream file(path, std::ios::binary);
+  const std::vector<char> chunk(1_MiB, 'x');
+  for (size_t written = 0; written < SOURCE_FILE_SIZE; written += chunk.size()) {
+    file.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+  }
+  return path;
+}
+
+}  // namespace
+
+// compares the kernel-side copies of the FileSystemRepository to copying through a buffer
+TEST_CASE("ProcessSession import and export throughput", "[benchmark]") {
+  TestController test_controller;
+  const auto dir = test_controller.createTempDirectory();
+  const auto source = createSourceFile(dir);
+  const auto destination = dir / "exported.bin";
+
+  for (const bool zero_copy : {false, true}) {
+    auto configuration = std::make_shared<minifi::Configure>();
+    configuration->set(minifi::Configure::nifi_dbcontent_repository_directory_default, test_controller.createTempDirectory().string());
+    configuration->set(minifi::Configure::nifi_file_system_content_repository_zero_copy, zero_copy ? "true" : "false");
+    auto plan = test_controller.createPlan(TestController::PlanConfig{
+      .configuration = configuration,
+      .content_repo = std::make_shared<minifi::core::repository::FileSystemRepository>()
+    });
+    plan->addProcessor("DummyProcessor", "dummyProcessor");
+    plan->runNextProcessor();
+    minifi::core::ProcessSession session(plan->getCurrentContext());
+    const std::string mode = zero_copy ? "kernel" : "buffered";
+
+    BENCHMARK_ADVANCED("import 64 MiB, " + mode)(Catch::Benchmark::Chronometer meter) {
+      std::vector<std::shared_ptr<minifi::core::FlowFile>> flow_files;
+      for (int i = 0; i < meter.runs(); ++i) {
+        flow_files.push_back(session.create());
+      }
+      meter.measure([&](int i) {
+        session.import(source.string(), flow_files[i], true);
+      });
+      // drops the imported content
+      flow_files.clear();
+      session.rollback();
+    };
+
+    const auto flow_file = session.create();
+    session.import(source.string(), flow_file, true);
+    REQUIRE(flow_file->getSize() == SOURCE_FILE_SIZE);
+    BENCHMARK("exportContent 64 MiB, " + mode) {
+      return session.exportContent(destination.string(), flow_file, true);
+    };
+    CHECK(std::filesystem::file_size(destination) == SOURCE_FILE_SIZE);
+    session.rollback();
+  }
+}
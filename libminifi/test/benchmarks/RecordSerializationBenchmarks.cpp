@@ -0,0 +1,120 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "../TestBase.h"
+#include "../Catch.h"
+#include "FlowFileRecord.h"
+#include "core/repository/VolatileContentRepository.h"
+#include "io/BufferStream.h"
+#include "provenance/Provenance.h"
+
+namespace provenance = org::apache::nifi::minifi::provenance;
+
+namespace {
+
+// the attributes of a flow file listed and fetched from a directory, with a few custom ones
+std::shared_ptr<minifi::FlowFileRecord> createFlowFile(const std::shared_ptr<minifi::core::ContentRepository>& content_repo) {
+  auto flow_file = std::make_shared<minifi::FlowFileRecord>();
+  flow_file->setAttribute("filename", "sensor_readings_2024_01_01.csv");
+  flow_file->setAttribute("path", "sensors/building_1/");
+  flow_file->setAttribute("absolute.path", "/var/data/sensors/building_1/");
+  flow_file->setAttribute("file.size", "4096");
+  flow_file->setAttribute("file.lastModifiedTime", "2024-01-01T00:00:00Z");
+  flow_file->setAttribute("mime.type", "text/csv");
+  flow_file->setAttribute("sensor.id", "temperature-42");
+  flow_file->setAttribute("sensor.location", "floor 3, room 12");
+  flow_file->setSize(4096);
+  flow_file->setResourceClaim(std::make_shared<minifi::ResourceClaim>(content_repo));
+  return flow_file;
+}
+
+}  // namespace
+
+TEST_CASE("FlowFile record serialization", "[benchmark]") {
+  auto content_repo = std::make_shared<minifi::core::repository::VolatileContentRepository>();
+  REQUIRE(content_repo->initialize(std::make_shared<minifi::Configure>()));
+  const auto flow_file = createFlowFile(content_repo);
+
+  minifi::io::BufferStream legacy;
+  REQUIRE(flow_file->Serialize(legacy, minifi::io::RecordFormat::LEGACY));
+  minifi::io::BufferStream compact;
+  REQUIRE(flow_file->Serialize(compact));
+  WARN("FlowFile record size: legacy " << legacy.size() << " bytes, compact " << compact.size() << " bytes");
+
+  BENCHMARK("legacy serialization into a new stream") {
+    auto stream = std::make_unique<minifi::io::BufferStream>();
+    flow_file->Serialize(*stream, minifi::io::RecordFormat::LEGACY);
+    return stream;
+  };
+  // what ProcessSession::commit does for each flow file
+  std::vector<std::byte> serialization_buffer;
+  BENCHMARK("compact serialization into a reused buffer") {
+    serialization_buffer.clear();
+    flow_file->Serialize(serialization_buffer);
+    return std::make_unique<minifi::io::BufferStream>(serialization_buffer);
+  };
+
+  minifi::utils::Identifier container;
+  BENCHMARK("legacy deserialization") {
+    return minifi::FlowFileRecord::DeSerialize(legacy.getBuffer(), content_repo, container);
+  };
+  BENCHMARK("compact deserialization") {
+    return minifi::FlowFileRecord::DeSerialize(compact.getBuffer(), content_repo, container);
+  };
+}
+
+TEST_CASE("Provenance event record serialization", "[benchmark]") {
+  auto content_repo = std::make_shared<minifi::core::repository::VolatileContentRepository>();
+  REQUIRE(content_repo->initialize(std::make_shared<minifi::Configure>()));
+  provenance::ProvenanceEventRecord event(provenance::ProvenanceEventRecord::SEND, minifi::utils::IdGenerator::getIdGenerator()->generate().to_string(), "PutFile");
+  event.fromFlowFile(createFlowFile(content_repo));
+  event.setTransitUri("file:///var/output/sensor_readings_2024_01_01.csv");
+
+  minifi::io::BufferStream legacy;
+  REQUIRE(event.serialize(legacy, minifi::io::RecordFormat::LEGACY));
+  minifi::io::BufferStream compact;
+  REQUIRE(event.serialize(compact));
+  WARN("Provenance event record size: legacy " << legacy.size() << " bytes, compact " << compact.size() << " bytes");
+
+  BENCHMARK("legacy serialization into a new stream") {
+    auto stream = std::make_unique<minifi::io::BufferStream>();
+    event.serialize(*stream, minifi::io::RecordFormat::LEGACY);
+    return stream;
+  };
+  // what ProvenanceReporter::commit does for each event
+  std::vector<std::byte> serialization_buffer;
+  BENCHMARK("compact serialization into a reused buffer") {
+    serialization_buffer.clear();
+    event.serialize(serialization_buffer);
+    return std::make_unique<minifi::io::BufferStream>(serialization_buffer);
+  };
+
+  BENCHMARK("legacy deserialization") {
+    legacy.seek(0);
+    provenance::ProvenanceEventRecord read_event;
+    return read_event.deserialize(legacy);
+  };
+  BENCHMARK("compact deserialization") {
+    compact.seek(0);
+    provenance::ProvenanceEventRecord read_event;
+    return read_event.deserialize(compact);
+  };
+}
@@ -0,0 +1,152 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <array>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+
+#include "asio.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "../TestBase.h"
+#include "../Catch.h"
+#include "sitetosite/Peer.h"
+#include "sitetosite/RawSocketProtocol.h"
+#include "utils/net/AsioSocketUtils.h"
+
+namespace {
+
+constexpr size_t PACKET_COUNT = 1000;
+constexpr size_t PAYLOAD_SIZE = 4 * 1024;
+
+/**
+ * Stands in for the NiFi instance on the loopback interface: accepts one RAW site to site connection,
+ * answers the handshake and counts the bytes received until the client closes the connection.
+ */
+class StandInSiteToSiteServer {
+ public:
+  StandInSiteToSiteServer()
+      : acceptor_(io_context_, asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), 0)),
+        port_(acceptor_.local_endpoint().port()),
+        server_thread_([this] { serve(); }) {
+  }
+
+  StandInSiteToSiteServer(const StandInSiteToSiteServer&) = delete;
+  StandInSiteToSiteServer& operator=(const StandInSiteToSiteServer&) = delete;
+
+  ~StandInSiteToSiteServer() {
+    if (server_thread_.joinable()) {
+      acceptor_.close();
+      server_thread_.join();
+    }
+  }
+
+  [[nodiscard]] uint16_t getPort() const {
+    return port_;
+  }
+
+  size_t waitForBytesReceived() {
+    server_thread_.join();
+    return bytes_received_;
+  }
+
+ private:
+  void serve() {
+    asio::ip::tcp::socket socket(io_context_);
+    asio::error_code error;
+    acceptor_.accept(socket, error);
+    if (error) {
+      return;
+    }
+    // the answers do not depend on the requests: RESOURCE_OK to the protocol version, PROPERTIES_OK to the handshake, RESOURCE_OK to the codec
+    const std::array<uint8_t, 5> responses{0x14, 'R', 'C', 0x01, 0x14};
+    asio::write(socket, asio::buffer(responses), error);
+    std::array<char, 64 * 1024> buffer{};
+    while (!error) {
+      bytes_received_ += socket.read_some(asio::buffer(buffer), error);
+    }
+  }
+
+  asio::io_context io_context_;
+  asio::ip::tcp::acceptor acceptor_;
+  uint16_t port_;
+  size_t bytes_received_ = 0;
+  std::thread server_thread_;
+};
+
+std::string createPayload(bool compressible) {
+  std::string payload;
+  if (compressible) {
+    for (size_t line = 0; payload.size() < PAYLOAD_SIZE; ++line) {
+      payload += "2024-01-01 12:00:00.000 [INFO] sensor " + std::to_string(line % 16) + " reported value " + std::to_string(line * 7 % 100) + "\n";
+    }
+  } else {
+    std::mt19937 generator(42);  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+    std::uniform_int_distribution<int> distribution(0, 255);
+    while (payload.size() < PAYLOAD_SIZE) {
+      payload += static_cast<char>(distribution(generator));
+    }
+  }
+  payload.resize(PAYLOAD_SIZE);
+  return payload;
+}
+
+// sends PACKET_COUNT data packets in a single transaction, returns the number of bytes the server received
+size_t sendPackets(const std::string& payload, bool use_compression) {
+  StandInSiteToSiteServer server;
+  auto connection = std::make_unique<utils::net::AsioSocketConnection>(utils::net::SocketData{"127.0.0.1", server.getPort(), nullptr});
+  auto peer = std::make_unique<minifi::sitetosite::SiteToSitePeer>(std::move(connection), "127.0.0.1", server.getPort(), "");
+  minifi::sitetosite::RawSiteToSiteClient client(std::move(peer));
+  auto port_id = utils::IdGenerator::getIdGenerator()->generate();
+  client.setPortId(port_id);
+  client.setUseCompression(use_compression);
+  REQUIRE(client.bootstrap());
+
+  auto transaction = client.createTransaction(minifi::sitetosite::SEND);
+  REQUIRE(transaction);
+  const std::map<std::string, std::string> attributes{{"filename", "sensors.log"}, {"path", "/var/log/sensors"}};
+  for (size_t i = 0; i < PACKET_COUNT; ++i) {
+    minifi::sitetosite::DataPacket packet(nullptr, transaction, attributes, payload);
+    REQUIRE(client.send(transaction->getUUID(), &packet, nullptr, nullptr) == 0);
+  }
+  client.tearDown();
+  return server.waitForBytesReceived();
+}
+
+}  // namespace
+
+TEST_CASE("Site to site RAW protocol throughput and bytes on the wire", "[benchmark]") {
+  for (const bool compressible : {true, false}) {
+    const auto payload = createPayload(compressible);
+    const std::string payload_type = compressible ? "text payload" : "random payload";
+
+    for (const bool use_compression : {false, true}) {
+      const std::string mode = use_compression ? "compressed" : "uncompressed";
+      const auto start = std::chrono::steady_clock::now();
+      const auto bytes_on_the_wire = sendPackets(payload, use_compression);
+      const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+      WARN(payload_type << ", " << mode << ": " << bytes_on_the_wire << " bytes on the wire for " << PACKET_COUNT * PAYLOAD_SIZE << " payload bytes, "
+          << static_cast<size_t>(static_cast<double>(PACKET_COUNT * PAYLOAD_SIZE) / elapsed.count() / 1024 / 1024) << " MiB/s");
+
+      BENCHMARK(std::to_string(PACKET_COUNT) + " packets, " + payload_type + ", " + mode) {
+        return sendPackets(payload, use_compression);
+      };
+    }
+  }
+}
@@ -0,0 +1,71 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <string>
+#include <vector>
+
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "../TestBase.h"
+#include "../Catch.h"
+#include "utils/ThreadPool.h"
+
+namespace {
+
+constexpr size_t TASK_COUNT = 100000;
+constexpr size_t RESCHEDULED_TASK_COUNT = 64;
+
+// runs TASK_COUNT tasks in the pool, the tasks either run once or are rescheduled immediately by the pool
+size_t runTasks(utils::ThreadPool& pool, bool rescheduled) {
+  std::atomic<size_t> run_count = 0;
+  const size_t worker_count = rescheduled ? RESCHEDULED_TASK_COUNT : TASK_COUNT;
+  std::vector<std::future<utils::TaskRescheduleInfo>> futures(worker_count);
+  for (size_t i = 0; i < worker_count; ++i) {
+    utils::Worker worker([&run_count, rescheduled] {
+      if (rescheduled && ++run_count < TASK_COUNT) {
+        return utils::TaskRescheduleInfo::RetryImmediately();
+      }
+      return utils::TaskRescheduleInfo::Done();
+    }, "task" + std::to_string(i % 8));
+    pool.execute(std::move(worker), futures[i]);
+  }
+  for (auto& future : futures) {
+    future.wait();
+  }
+  return worker_count;
+}
+
+}  // namespace
+
+TEST_CASE("ThreadPool throughput by the number of worker threads", "[benchmark]") {
+  for (const int thread_count : {1, 2, 4, 8, 16, 32}) {
+    utils::ThreadPool pool(thread_count, nullptr, "BenchmarkPool");
+    pool.start();
+
+    for (const bool rescheduled : {false, true}) {
+      const auto start = std::chrono::steady_clock::now();
+      runTasks(pool, rescheduled);
+      const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+      WARN(thread_count << " threads, " << (rescheduled ? "rescheduled" : "submitted") << " tasks: " << static_cast<size_t>(TASK_COUNT / elapsed.count()) << " tasks/sec");
+
+      BENCHMARK(std::to_string(thread_count) + " threads, " + (rescheduled ? "rescheduled" : "submitted") + " tasks") {
+        return runTasks(pool, rescheduled);
+      };
+    }
+  }
+}
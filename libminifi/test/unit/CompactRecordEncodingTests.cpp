@@ -0,0 +1,183 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "io/BufferStream.h"
+#include "io/CompactEncoding.h"
+#include "FlowFileRecord.h"
+#include "provenance/Provenance.h"
+#include "core/repository/VolatileContentRepository.h"
+#include "../TestBase.h"
+#include "../Catch.h"
+
+namespace provenance = org::apache::nifi::minifi::provenance;
+
+TEST_CASE("Compact encoding round trip", "[compactEncoding]") {
+  std::vector<std::byte> buffer;
+  minifi::io::CompactWriter writer(buffer);
+  writer.writeVarint(0);
+  writer.writeVarint(127);
+  writer.writeVarint(300);
+  writer.writeVarint((std::numeric_limits<uint64_t>::max)());
+  writer.writeString("");
+  writer.writeString("custom value");
+  writer.writeString("filename", minifi::io::COMMON_ATTRIBUTE_KEYS);
+  writer.writeString("custom.key", minifi::io::COMMON_ATTRIBUTE_KEYS);
+  const auto uuid = minifi::utils::IdGenerator::getIdGenerator()->generate();
+  writer.writeIdentifier(uuid);
+  // 1 + 1 + 2 + 10 byte varints, 1 + 13 byte strings, 1 byte dictionary index, 1 + 1 + 10 byte literal key and 16 byte UUID
+  CHECK(buffer.size() == 57);
+
+  minifi::io::BufferStream stream(buffer);
+  minifi::io::CompactReader reader(stream);
+  uint64_t value = 0;
+  REQUIRE(reader.readVarint(value));
+  CHECK(value == 0);
+  REQUIRE(reader.readVarint(value));
+  CHECK(value == 127);
+  uint8_t too_small = 0;
+  CHECK_FALSE(reader.readVarint(too_small));
+  REQUIRE(reader.readVarint(value));
+  CHECK(value == (std::numeric_limits<uint64_t>::max)());
+  std::string str = "not empty";
+  REQUIRE(reader.readString(str));
+  CHECK(str.empty());
+  REQUIRE(reader.readString(str));
+  CHECK(str == "custom value");
+  REQUIRE(reader.readString(str, minifi::io::COMMON_ATTRIBUTE_KEYS));
+  CHECK(str == "filename");
+  REQUIRE(reader.readString(str, minifi::io::COMMON_ATTRIBUTE_KEYS));
+  CHECK(str == "custom.key");
+  minifi::utils::Identifier read_uuid;
+  REQUIRE(reader.readIdentifier(read_uuid));
+  CHECK(read_uuid == uuid);
+  CHECK_FALSE(reader.readVarint(value));
+
+  // a 10 byte varint with more than 64 bits of payload overflows
+  std::vector<std::byte> overflowing(9, std::byte{0xFF});
+  overflowing.push_back(std::byte{0x02});
+  minifi::io::BufferStream overflowing_stream(overflowing);
+  minifi::io::CompactReader overflowing_reader(overflowing_stream);
+  CHECK_FALSE(overflowing_reader.readVarint(value));
+}
+
+TEST_CASE("Compact encoding does not trust the string lengths", "[compactEncoding]") {
+  std::vector<std::byte> buffer;
+  minifi::io::CompactWriter writer(buffer);
+  // a corrupt length of almost 4 GB, followed by a few bytes of data
+  writer.writeVarint((std::numeric_limits<uint32_t>::max)());
+  writer.writeByte('a');
+  writer.writeByte('b');
+
+  minifi::io::BufferStream stream(buffer);
+  minifi::io::CompactReader reader(stream);
+  std::string str;
+  CHECK_FALSE(reader.readString(str));
+  CHECK(str.size() <= 64 * 1024);
+}
+
+TEST_CASE("The record format can be configured", "[compactEncoding]") {
+  CHECK(minifi::io::parseRecordFormat("legacy") == minifi::io::RecordFormat::LEGACY);
+  CHECK(minifi::io::parseRecordFormat("Compact") == minifi::io::RecordFormat::COMPACT);
+  CHECK_FALSE(minifi::io::parseRecordFormat("binary"));
+}
+
+TEST_CASE("FlowFile records can be read in both the legacy and the compact format", "[compactEncoding]") {
+  auto content_repo = std::make_shared<minifi::core::repository::VolatileContentRepository>();
+  REQUIRE(content_repo->initialize(std::make_shared<minifi::Configure>()));
+
+  auto flow_file = std::make_shared<minifi::FlowFileRecord>();
+  flow_file->setAttribute("filename", "data.txt");
+  flow_file->setAttribute("custom.key", "custom value");
+  flow_file->setSize(10);
+  flow_file->setOffset(5);
+  auto claim = std::make_shared<minifi::ResourceClaim>(content_repo);
+  flow_file->setResourceClaim(claim);
+  REQUIRE(claim->getClaimId());
+
+  minifi::io::BufferStream legacy;
+  REQUIRE(flow_file->Serialize(legacy, minifi::io::RecordFormat::LEGACY));
+  minifi::io::BufferStream compact;
+  REQUIRE(flow_file->Serialize(compact));
+  CHECK(compact.size() < legacy.size());
+
+  for (auto* stream : {&legacy, &compact}) {
+    minifi::utils::Identifier container;
+    const auto read_flow_file = minifi::FlowFileRecord::DeSerialize(stream->getBuffer(), content_repo, container);
+    REQUIRE(read_flow_file);
+    CHECK(read_flow_file->getUUID() == flow_file->getUUID());
+    CHECK(read_flow_file->getAttributes() == flow_file->getAttributes());
+    CHECK(read_flow_file->getSize() == 10);
+    CHECK(read_flow_file->getOffset() == 5);
+    CHECK(read_flow_file->getEntryDate() == std::chrono::floor<std::chrono::milliseconds>(flow_file->getEntryDate()));
+    CHECK(read_flow_file->getResourceClaim()->getContentFullPath() == claim->getContentFullPath());
+  }
+
+  // the content outside of the content repository is stored with its full path
+  flow_file->setResourceClaim(std::make_shared<minifi::ResourceClaim>("/elsewhere/content", content_repo));
+  minifi::io::BufferStream external;
+  REQUIRE(flow_file->Serialize(external));
+  minifi::utils::Identifier container;
+  const auto read_flow_file = minifi::FlowFileRecord::DeSerialize(external.getBuffer(), content_repo, container);
+  REQUIRE(read_flow_file);
+  CHECK(read_flow_file->getResourceClaim()->getContentFullPath() == "/elsewhere/content");
+
+  auto truncated = compact.getBuffer();
+  truncated = truncated.subspan(0, truncated.size() - 1);
+  CHECK_FALSE(minifi::FlowFileRecord::DeSerialize(truncated, content_repo, container));
+}
+
+TEST_CASE("Provenance events can be read in both the legacy and the compact format", "[compactEncoding]") {
+  provenance::ProvenanceEventRecord event(provenance::ProvenanceEventRecord::FORK, "processor1", "SplitText");
+  auto flow_file = std::make_shared<minifi::FlowFileRecord>();
+  flow_file->setAttribute("fragment.index", "1");
+  event.fromFlowFile(flow_file);
+  event.setDetails("split");
+  event.addChildUuid(minifi::utils::IdGenerator::getIdGenerator()->generate());
+  event.addChildUuid(minifi::utils::IdGenerator::getIdGenerator()->generate());
+
+  minifi::io::BufferStream legacy;
+  REQUIRE(event.serialize(legacy, minifi::io::RecordFormat::LEGACY));
+  minifi::io::BufferStream compact;
+  REQUIRE(event.serialize(compact));
+  CHECK(compact.size() < legacy.size());
+
+  for (auto* stream : {&legacy, &compact}) {
+    provenance::ProvenanceEventRecord read_event;
+    REQUIRE(read_event.deserialize(*stream));
+    CHECK(read_event.getEventId() == event.getEventId());
+    CHECK(read_event.getEventType() == provenance::ProvenanceEventRecord::FORK);
+    CHECK(read_event.getComponentId() == "processor1");
+    CHECK(read_event.getFlowFileUuid() == flow_file->getUUID());
+    CHECK(read_event.getDetails() == "split");
+    CHECK(read_event.getAttributes() == event.getAttributes());
+    CHECK(read_event.getChildrenUuids() == event.getChildrenUuids());
+
+    stream->seek(0);
+    const auto fields = provenance::ProvenanceEventRecord::readIndexedFields(*stream);
+    REQUIRE(fields);
+    CHECK(fields->event_id == event.getEventId());
+    CHECK(fields->event_type == provenance::ProvenanceEventRecord::FORK);
+    CHECK(fields->event_time == std::chrono::floor<std::chrono::milliseconds>(event.getEventTime()));
+    CHECK(fields->component_id == "processor1");
+    CHECK(fields->flow_file_uuid == flow_file->getUUID());
+  }
+}
@@ -0,0 +1,89 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "ConcurrentTaskAutoscaler.h"
+#include "../TestBase.h"
+#include "../Catch.h"
+
+using namespace std::literals::chrono_literals;
+using minifi::ConcurrentTaskAutoscaler;
+
+namespace {
+const auto start = std::chrono::steady_clock::time_point{} + 1h;
+
+ConcurrentTaskAutoscaler::Sample sampleAfter(std::chrono::steady_clock::duration elapsed, uint64_t queued_flow_files, std::chrono::nanoseconds busy_time,
+    bool incoming_queue_full = false, bool outgoing_queue_full = false) {
+  return {
+    .time = start + elapsed,
+    .queued_flow_files = queued_flow_files,
+    .incoming_queue_full = incoming_queue_full,
+    .outgoing_queue_full = outgoing_queue_full,
+    .busy_time = busy_time
+  };
+}
+}  // namespace
+
+TEST_CASE("Backlogged processors with busy tasks get more tasks", "[ConcurrentTaskAutoscaler]") {
+  const auto previous = sampleAfter(0s, 100, 0s);
+
+  SECTION("The queue is growing") {
+    const auto decision = ConcurrentTaskAutoscaler::decide(previous, sampleAfter(1s, 200, 1900ms), 2, 1, 4);
+    CHECK(decision.task_count == 3);
+    CHECK_FALSE(decision.reason.empty());
+  }
+  SECTION("The incoming connection is full") {
+    CHECK(ConcurrentTaskAutoscaler::decide(previous, sampleAfter(1s, 50, 1900ms, true), 2, 1, 4).task_count == 3);
+  }
+  SECTION("Not above the maximum") {
+    CHECK(ConcurrentTaskAutoscaler::decide(previous, sampleAfter(1s, 200, 3900ms), 4, 1, 4).task_count == 4);
+  }
+  SECTION("Not if the tasks are not busy") {
+    CHECK(ConcurrentTaskAutoscaler::decide(previous, sampleAfter(1s, 200, 500ms), 2, 1, 4).task_count == 2);
+  }
+  SECTION("Not if the queue is shrinking") {
+    CHECK(ConcurrentTaskAutoscaler::decide(previous, sampleAfter(1s, 50, 1900ms), 2, 1, 4).task_count == 2);
+  }
+  SECTION("Not if the output is backpressured") {
+    CHECK(ConcurrentTaskAutoscaler::decide(previous, sampleAfter(1s, 200, 1900ms, true, true), 2, 2, 4).task_count == 2);
+  }
+}
+
+TEST_CASE("Idle processors give back tasks", "[ConcurrentTaskAutoscaler]") {
+  const auto previous = sampleAfter(0s, 10, 0s);
+
+  SECTION("The queue is empty and the tasks are idle") {
+    const auto decision = ConcurrentTaskAutoscaler::decide(previous, sampleAfter(1s, 0, 100ms), 3, 1, 4);
+    CHECK(decision.task_count == 2);
+    CHECK_FALSE(decision.reason.empty());
+  }
+  SECTION("Not below the minimum") {
+    CHECK(ConcurrentTaskAutoscaler::decide(previous, sampleAfter(1s, 0, 0ms), 1, 1, 4).task_count == 1);
+  }
+  SECTION("Not if there are queued flow files") {
+    CHECK(ConcurrentTaskAutoscaler::decide(previous, sampleAfter(1s, 5, 100ms), 3, 1, 4).task_count == 3);
+  }
+  SECTION("The output is backpressured") {
+    CHECK(ConcurrentTaskAutoscaler::decide(previous, sampleAfter(1s, 200, 2900ms, false, true), 3, 1, 4).task_count == 2);
+  }
+}
+
+TEST_CASE("The task count is kept between the bounds", "[ConcurrentTaskAutoscaler]") {
+  const auto previous = sampleAfter(0s, 0, 0s);
+  const auto current = sampleAfter(1s, 0, 500ms);
+  CHECK(ConcurrentTaskAutoscaler::decide(previous, current, 1, 2, 4).task_count == 2);
+  CHECK(ConcurrentTaskAutoscaler::decide(previous, current, 6, 2, 4).task_count == 4);
+  CHECK(ConcurrentTaskAutoscaler::decide(previous, current, 3, 3, 1).task_count == 3);
+}
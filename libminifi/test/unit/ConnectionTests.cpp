@@ -85,6 +85,47 @@ TEST_CASE("Connection::poll() works correctly", "[poll]") {
   }
 }
 
+TEST_CASE("Connection::pollBatch() works correctly", "[poll]") {
+  const auto flow_repo = std::make_shared<TestRepository>();
+  const auto content_repo = std::make_shared<core::repository::VolatileContentRepository>();
+  content_repo->initialize(std::make_shared<minifi::Configure>());
+
+  const auto connection = std::make_shared<minifi::Connection>(flow_repo, content_repo, "test_connection");
+  std::set<std::shared_ptr<core::FlowFile>> expired_flow_files;
+
+  SECTION("when called on an empty Connection, pollBatch() returns no flow files") {
+    REQUIRE(connection->pollBatch(10, expired_flow_files).empty());
+  }
+
+  SECTION("pollBatch() returns at most the requested number of flow files in order, skipping the penalized ones") {
+    std::vector<std::shared_ptr<core::FlowFile>> flow_files;
+    for (int i = 0; i < 5; ++i) {
+      flow_files.push_back(std::make_shared<core::FlowFile>());
+    }
+    const auto penalized_flow_file = std::make_shared<core::FlowFile>();
+    penalized_flow_file->penalize(std::chrono::seconds{10});
+    connection->put(penalized_flow_file);
+    connection->multiPut(flow_files);
+
+    const auto first_batch = connection->pollBatch(3, expired_flow_files);
+    REQUIRE(first_batch == std::vector<std::shared_ptr<core::FlowFile>>{flow_files[0], flow_files[1], flow_files[2]});
+    const auto second_batch = connection->pollBatch(3, expired_flow_files);
+    REQUIRE(second_batch == std::vector<std::shared_ptr<core::FlowFile>>{flow_files[3], flow_files[4]});
+    REQUIRE(connection->pollBatch(3, expired_flow_files).empty());
+    REQUIRE(connection->getQueueSize() == 1);
+    REQUIRE(expired_flow_files.empty());
+  }
+
+  SECTION("expired flow files are not counted in the batch") {
+    connection->setFlowExpirationDuration(1ms);
+    const auto flow_file = std::make_shared<core::FlowFile>();
+    connection->put(flow_file);
+    std::this_thread::sleep_for(std::chrono::milliseconds{2});
+    REQUIRE(connection->pollBatch(10, expired_flow_files).empty());
+    REQUIRE(std::set<std::shared_ptr<core::FlowFile>>{flow_file} == expired_flow_files);
+  }
+}
+
 TEST_CASE("Connection backpressure tests", "[Connection]") {
   const auto flow_repo = std::make_shared<TestRepository>();
   const auto content_repo = std::make_shared<core::repository::VolatileContentRepository>();
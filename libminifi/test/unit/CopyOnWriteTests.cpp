@@ -0,0 +1,55 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string>
+#include <vector>
+
+#include "../TestBase.h"
+#include "../Catch.h"
+#include "utils/CopyOnWrite.h"
+
+TEST_CASE("CopyOnWrite copies are shared until one of them is modified", "[CopyOnWrite]") {
+  utils::CopyOnWrite<std::vector<std::string>> original;
+  CHECK(original->empty());
+
+  original.mutate().push_back("a");
+  auto copy = original;
+  CHECK(copy.isSharedWith(original));
+  CHECK(&copy.get() == &original.get());
+
+  copy.mutate().push_back("b");
+  CHECK_FALSE(copy.isSharedWith(original));
+  CHECK(*original == std::vector<std::string>{"a"});
+  CHECK(*copy == std::vector<std::string>{"a", "b"});
+
+  const auto* value_before = &original.get();
+  original.mutate().push_back("c");
+  CHECK(&original.get() == value_before);
+  CHECK(*original == std::vector<std::string>{"a", "c"});
+}
+
+TEST_CASE("CopyOnWrite values can be replaced", "[CopyOnWrite]") {
+  utils::CopyOnWrite<std::vector<std::string>> original{std::vector<std::string>{"a"}};
+  auto copy = original;
+  copy.set({"b"});
+  CHECK(*original == std::vector<std::string>{"a"});
+  CHECK(*copy == std::vector<std::string>{"b"});
+
+  original = copy;
+  CHECK(original.isSharedWith(copy));
+  CHECK(*original == std::vector<std::string>{"b"});
+}
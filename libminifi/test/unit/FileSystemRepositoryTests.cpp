@@ -158,4 +158,192 @@ TEST_CASE("FileSystemRepository removes non-existing resource file from purge li
   REQUIRE(content_repo->getPurgeList().empty());
 }
 
+TEST_CASE("FileSystemRepository packs claims into shared segment files") {
+  TestController testController;
+  auto dir = testController.createTempDirectory();
+  auto configuration = std::make_shared<org::apache::nifi::minifi::Configure>();
+  configuration->set(minifi::Configure::nifi_dbcontent_repository_directory_default, dir.string());
+  configuration->set(minifi::Configure::nifi_file_system_content_repository_segment_packing, "true");
+  configuration->set(minifi::Configure::nifi_file_system_content_repository_segment_max_size, "1 KB");
+
+  auto content_repo = std::make_shared<core::repository::FileSystemRepository>();
+  REQUIRE(content_repo->initialize(configuration));
+  REQUIRE(content_repo->isSegmentPackingEnabled());
+
+  auto read_content = [&] (const minifi::ResourceClaim& claim) {
+    auto stream = content_repo->read(claim);
+    REQUIRE(stream);
+    std::string content(stream->size(), '\0');
+    REQUIRE(stream->read(as_writable_bytes(std::span(content))) == content.size());
+    return content;
+  };
+
+  std::vector<std::shared_ptr<minifi::ResourceClaim>> claims;
+  for (size_t i = 0; i < 100; ++i) {
+    auto claim = std::make_shared<minifi::ResourceClaim>(content_repo);
+    const std::string content = "content of claim " + std::to_string(i);
+    REQUIRE(content_repo->write(*claim)->write(as_bytes(std::span(content))) == content.size());
+    claims.push_back(claim);
+  }
+
+  const auto segment_count = content_repo->getSegmentCount();
+  CHECK(segment_count > 1);
+  CHECK(segment_count < 100);
+  CHECK(minifi::utils::file::list_dir_all(dir, testController.getLogger()).size() == segment_count);
+  CHECK(content_repo->getRepositoryEntryCount() == 100);
+  for (size_t i = 0; i < claims.size(); ++i) {
+    CHECK(content_repo->exists(*claims[i]));
+    CHECK(read_content(*claims[i]) == "content of claim " + std::to_string(i));
+  }
+
+  SECTION("Appending to a packed claim") {
+    {
+      auto stream = content_repo->write(*claims[42], true);
+      stream->seek(stream->size());
+      stream->write(as_bytes(std::span(std::string_view{", appended"})));
+    }
+    CHECK(read_content(*claims[42]) == "content of claim 42, appended");
+    CHECK(content_repo->getRepositoryEntryCount() == 100);
+  }
+
+  SECTION("Segments are deleted once none of their claims are referenced") {
+    claims.clear();
+    CHECK(content_repo->getRepositoryEntryCount() == 0);
+    CHECK(content_repo->getSegmentCount() <= 1);
+  }
+
+  SECTION("Claims are recovered from the segments on restart") {
+    for (const auto& claim : claims) {
+      // ensure that the content is not deleted during resource claim destruction
+      content_repo->incrementStreamCount(*claim);
+    }
+    const auto kept_path = claims[7]->getContentFullPath();
+    claims.clear();
+
+    content_repo = std::make_shared<core::repository::FileSystemRepository>();
+    REQUIRE(content_repo->initialize(configuration));
+    CHECK(content_repo->getRepositoryEntryCount() == 100);
+
+    minifi::ResourceClaim kept_claim(kept_path, content_repo);
+    content_repo->clearOrphans();
+    CHECK(content_repo->getRepositoryEntryCount() == 1);
+    CHECK(content_repo->getSegmentCount() == 1);
+    CHECK(read_content(kept_claim) == "content of claim 7");
+  }
+}
+
+TEST_CASE("FileSystemRepository imports and exports files by the kernel") {
+  TestController testController;
+  auto dir = testController.createTempDirectory();
+  auto files_dir = testController.createTempDirectory();
+  auto configuration = std::make_shared<org::apache::nifi::minifi::Configure>();
+  configuration->set(minifi::Configure::nifi_dbcontent_repository_directory_default, dir.string());
+  const auto source = files_dir / "source.txt";
+  minifi::utils::putFileToDir(files_dir, "source.txt", "0123456789abcdef");
+
+  auto content_repo = std::make_shared<core::repository::FileSystemRepository>();
+
+  SECTION("Importing a file with an offset") {
+    REQUIRE(content_repo->initialize(configuration));
+    minifi::ResourceClaim claim(content_repo);
+    const auto imported_size = content_repo->importFile(claim, source, 10, true);
+#ifdef __linux__
+    REQUIRE(imported_size == 6);
+    CHECK(minifi::utils::file::get_content(claim.getContentFullPath()) == "abcdef");
+#else
+    CHECK_FALSE(imported_size);
+#endif
+    CHECK(std::filesystem::exists(source));
+  }
+
+  SECTION("A file which is going to be deleted is linked into the repository") {
+    REQUIRE(content_repo->initialize(configuration));
+    minifi::ResourceClaim claim(content_repo);
+    REQUIRE(content_repo->importFile(claim, source, 0, false) == 16);
+    CHECK(std::filesystem::hard_link_count(source) == 2);
+    CHECK(minifi::utils::file::get_content(claim.getContentFullPath()) == "0123456789abcdef");
+  }
+
+#ifdef __linux__
+  SECTION("Exporting part of a standalone claim") {
+    REQUIRE(content_repo->initialize(configuration));
+    minifi::ResourceClaim claim(content_repo);
+    REQUIRE(content_repo->importFile(claim, source, 0, true) == 16);
+    REQUIRE(content_repo->exportFile(claim, 4, 8, files_dir / "exported.txt"));
+    CHECK(minifi::utils::file::get_content(files_dir / "exported.txt") == "456789ab");
+    CHECK_FALSE(content_repo->exportFile(claim, 4, 20, files_dir / "too_long.txt"));
+  }
+
+  SECTION("Exporting a packed claim") {
+    configuration->set(minifi::Configure::nifi_file_system_content_repository_segment_packing, "true");
+    REQUIRE(content_repo->initialize(configuration));
+    minifi::ResourceClaim claim(content_repo);
+    CHECK_FALSE(content_repo->importFile(claim, source, 0, true));
+    const std::string content = "packed content";
+    REQUIRE(content_repo->write(claim)->write(as_bytes(std::span(content))) == content.size());
+    REQUIRE(content_repo->exportFile(claim, 7, 7, files_dir / "exported.txt"));
+    CHECK(minifi::utils::file::get_content(files_dir / "exported.txt") == "content");
+  }
+#endif
+
+  SECTION("Kernel-side transfers can be disabled") {
+    configuration->set(minifi::Configure::nifi_file_system_content_repository_zero_copy, "false");
+    REQUIRE(content_repo->initialize(configuration));
+    minifi::ResourceClaim claim(content_repo);
+    CHECK_FALSE(content_repo->importFile(claim, source, 0, false));
+    CHECK(std::filesystem::hard_link_count(source) == 1);
+    CHECK_FALSE(content_repo->exportFile(claim, 0, 16, files_dir / "exported.txt"));
+  }
+}
+
+TEST_CASE("FileSystemRepository hard links claims with identical content") {
+  TestController testController;
+  auto dir = testController.createTempDirectory();
+  auto configuration = std::make_shared<org::apache::nifi::minifi::Configure>();
+  configuration->set(minifi::Configure::nifi_dbcontent_repository_directory_default, dir.string());
+  configuration->set(minifi::Configure::nifi_content_repository_deduplication, "true");
+
+  auto content_repo = std::make_shared<core::repository::FileSystemRepository>();
+  REQUIRE(content_repo->initialize(configuration));
+  REQUIRE(content_repo->isDeduplicationEnabled());
+
+  auto create_claim = [&] (const std::string& content) {
+    auto session = content_repo->createSession();
+    auto claim = session->create();
+    REQUIRE(session->write(claim)->write(as_bytes(std::span(content))) == content.size());
+    session->commit();
+    return claim;
+  };
+
+  auto first = create_claim("duplicated content");
+  auto second = create_claim("duplicated content");
+  auto unique = create_claim("unique content");
+  CHECK(std::filesystem::hard_link_count(first->getContentFullPath()) == 2);
+  CHECK(std::filesystem::equivalent(first->getContentFullPath(), second->getContentFullPath()));
+  CHECK(std::filesystem::hard_link_count(unique->getContentFullPath()) == 1);
+
+  const auto stats = content_repo->getDeduplicationStats();
+  REQUIRE(stats);
+  CHECK(stats->checked_claim_count == 3);
+  CHECK(stats->deduplicated_claim_count == 1);
+  CHECK(stats->bytes_saved == std::string{"duplicated content"}.size());
+
+  SECTION("Appending to a deduplicated claim does not modify the other claim") {
+    auto session = content_repo->createSession();
+    session->append(second)->write("!");
+    session->commit();
+    CHECK(minifi::utils::file::get_content(second->getContentFullPath()) == "duplicated content!");
+    CHECK(minifi::utils::file::get_content(first->getContentFullPath()) == "duplicated content");
+    CHECK(std::filesystem::hard_link_count(first->getContentFullPath()) == 1);
+  }
+
+  SECTION("Removing a claim keeps the content of the other claim") {
+    const auto first_path = first->getContentFullPath();
+    first.reset();
+    CHECK_FALSE(std::filesystem::exists(first_path));
+    CHECK(minifi::utils::file::get_content(second->getContentFullPath()) == "duplicated content");
+    CHECK(std::filesystem::hard_link_count(second->getContentFullPath()) == 1);
+  }
+}
+
 }  // namespace org::apache::nifi::minifi::test
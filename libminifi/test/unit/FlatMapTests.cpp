@@ -69,3 +69,20 @@ TEST_CASE("FlatMap supports equality based lookups") {
   CHECK(map.find(string_view_key) == homogeneous_lookup_result);
   CHECK(map.find(invalid_string_view_key) != homogeneous_lookup_result);
 }
+
+TEST_CASE("FlatMap try_emplace only inserts missing keys", "[flatmap::try_emplace]") {
+  utils::FlatMap<std::string, std::string> map;
+  map.insert(std::make_pair("alpha", "value"));
+  constexpr std::string_view existing_key = "alpha";
+  constexpr std::string_view new_key = "beta";
+
+  const auto [existing, existing_inserted] = map.try_emplace(existing_key, "other value");
+  CHECK_FALSE(existing_inserted);
+  CHECK(existing->second == "value");
+
+  const auto [inserted, new_inserted] = map.try_emplace(new_key, "new value");
+  CHECK(new_inserted);
+  CHECK(inserted->first == "beta");
+  CHECK(map.at("beta") == "new value");
+  CHECK(map.size() == 2);
+}
@@ -0,0 +1,216 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../TestBase.h"
+#include "../Catch.h"
+#include "core/FlowFilePrioritizer.h"
+#include "utils/FlowFileQueue.h"
+#include "utils/TestUtils.h"
+
+namespace core = minifi::core;
+
+namespace {
+
+class InMemorySwapManager : public minifi::SwapManager {
+ public:
+  std::future<void> store(std::vector<std::shared_ptr<core::FlowFile>> flow_files) override {
+    for (auto& flow_file : flow_files) {
+      stored_flow_files_[flow_file->getUUID()] = std::move(flow_file);
+    }
+    ++store_count_;
+    std::promise<void> stored;
+    stored.set_value();
+    return stored.get_future();
+  }
+
+  std::future<std::vector<std::shared_ptr<core::FlowFile>>> load(std::vector<minifi::SwappedFlowFile> flow_files) override {
+    std::vector<std::shared_ptr<core::FlowFile>> result;
+    for (const auto& swapped_flow_file : flow_files) {
+      auto flow_file = stored_flow_files_.at(swapped_flow_file.id);
+      stored_flow_files_.erase(swapped_flow_file.id);
+      flow_file->setPenaltyExpiration(swapped_flow_file.to_be_processed_after);
+      result.push_back(std::move(flow_file));
+    }
+    std::promise<std::vector<std::shared_ptr<core::FlowFile>>> promise;
+    promise.set_value(std::move(result));
+    return promise.get_future();
+  }
+
+  std::map<minifi::utils::Identifier, std::shared_ptr<core::FlowFile>> stored_flow_files_;
+  size_t store_count_ = 0;
+};
+
+class CountingPrioritizer : public core::PriorityAttributePrioritizer {
+ public:
+  [[nodiscard]] int64_t getPriorityKey(const core::FlowFile& flow_file) const override {
+    ++call_count_;
+    return PriorityAttributePrioritizer::getPriorityKey(flow_file);
+  }
+
+  mutable size_t call_count_ = 0;
+};
+
+std::shared_ptr<core::FlowFile> createFlowFileWithPriority(std::optional<std::string> priority) {
+  auto flow_file = std::make_shared<core::FlowFile>();
+  // the flow file is not penalized according to the (possibly manual) clock of the queue
+  flow_file->setPenaltyExpiration(minifi::utils::timeutils::getClock()->now());
+  if (priority) {
+    flow_file->setAttribute(std::string{core::PriorityAttributePrioritizer::PriorityAttribute}, *priority);
+  }
+  return flow_file;
+}
+
+std::vector<std::string> popPriorities(utils::FlowFileQueue& queue) {
+  std::vector<std::string> priorities;
+  while (queue.isWorkAvailable()) {
+    const auto flow_file = queue.tryPop();
+    if (!flow_file) {
+      // a swap-in has been initiated
+      continue;
+    }
+    priorities.push_back((*flow_file)->getAttribute(std::string{core::PriorityAttributePrioritizer::PriorityAttribute}).value_or("none"));
+  }
+  return priorities;
+}
+
+}  // namespace
+
+TEST_CASE("Prioritizers can be created by their name", "[FlowFilePrioritizer]") {
+  CHECK(core::FlowFilePrioritizer::create("OldestFlowFileFirstPrioritizer")->getName() == core::OldestFlowFileFirstPrioritizer::Name);
+  CHECK(core::FlowFilePrioritizer::create("org.apache.nifi.prioritizer.NewestFlowFileFirstPrioritizer")->getName() == core::NewestFlowFileFirstPrioritizer::Name);
+  CHECK(core::FlowFilePrioritizer::create("org.apache.nifi.prioritizer.PriorityAttributePrioritizer")->getName() == core::PriorityAttributePrioritizer::Name);
+  CHECK(core::FlowFilePrioritizer::create("FirstInFirstOutPrioritizer")->getName() == core::FirstInFirstOutPrioritizer::Name);
+  CHECK(core::FlowFilePrioritizer::create("SmallestFlowFileFirstPrioritizer")->getName() == core::SmallestFlowFileFirstPrioritizer::Name);
+  CHECK_FALSE(core::FlowFilePrioritizer::create("LargestFlowFileFirstPrioritizer"));
+}
+
+TEST_CASE("FlowFileQueue orders the flow files by the prioritizer", "[FlowFilePrioritizer]") {
+  utils::FlowFileQueue queue;
+
+  SECTION("PriorityAttributePrioritizer") {
+    queue.setPrioritizer(std::make_shared<core::PriorityAttributePrioritizer>());
+    for (const auto& priority : std::vector<std::optional<std::string>>{"3", std::nullopt, "1", "abc", "-2", "2"}) {
+      queue.push(createFlowFileWithPriority(priority));
+    }
+    CHECK(popPriorities(queue) == std::vector<std::string>{"-2", "1", "2", "3", "none", "abc"});
+  }
+
+  SECTION("FirstInFirstOutPrioritizer") {
+    queue.setPrioritizer(std::make_shared<core::FirstInFirstOutPrioritizer>());
+    for (const auto& priority : {"3", "1", "2"}) {
+      queue.push(createFlowFileWithPriority(priority));
+    }
+    CHECK(popPriorities(queue) == std::vector<std::string>{"3", "1", "2"});
+  }
+
+  SECTION("SmallestFlowFileFirstPrioritizer") {
+    queue.setPrioritizer(std::make_shared<core::SmallestFlowFileFirstPrioritizer>());
+    for (uint64_t size : {300, 100, 200}) {
+      auto flow_file = createFlowFileWithPriority(std::to_string(size));
+      flow_file->setSize(size);
+      queue.push(std::move(flow_file));
+    }
+    CHECK(popPriorities(queue) == std::vector<std::string>{"100", "200", "300"});
+  }
+
+  SECTION("OldestFlowFileFirstPrioritizer and NewestFlowFileFirstPrioritizer") {
+    // the entry date is set on construction, with millisecond precision
+    const auto older = createFlowFileWithPriority("older");
+    std::this_thread::sleep_for(std::chrono::milliseconds{5});
+    const auto newer = createFlowFileWithPriority("newer");
+
+    SECTION("Oldest first") {
+      queue.setPrioritizer(std::make_shared<core::OldestFlowFileFirstPrioritizer>());
+      queue.push(newer);
+      queue.push(older);
+      CHECK(popPriorities(queue) == std::vector<std::string>{"older", "newer"});
+    }
+    SECTION("Newest first") {
+      queue.setPrioritizer(std::make_shared<core::NewestFlowFileFirstPrioritizer>());
+      queue.push(older);
+      queue.push(newer);
+      CHECK(popPriorities(queue) == std::vector<std::string>{"newer", "older"});
+    }
+  }
+}
+
+TEST_CASE("The priority key of a flow file is computed once when it is queued", "[FlowFilePrioritizer]") {
+  utils::FlowFileQueue queue;
+  const auto prioritizer = std::make_shared<CountingPrioritizer>();
+  queue.setPrioritizer(prioritizer);
+  for (int priority : {17, 3, 12, 8, 1, 19, 5, 14, 10, 6}) {
+    queue.push(createFlowFileWithPriority(std::to_string(priority)));
+  }
+  CHECK(prioritizer->call_count_ == 10);
+
+  CHECK(popPriorities(queue) == std::vector<std::string>{"1", "3", "5", "6", "8", "10", "12", "14", "17", "19"});
+  CHECK(prioritizer->call_count_ == 10);
+}
+
+TEST_CASE("Penalized flow files do not block the prioritized queue", "[FlowFilePrioritizer]") {
+  const auto clock = std::make_shared<minifi::utils::ManualClock>();
+  minifi::utils::timeutils::setClock(clock);
+  utils::FlowFileQueue queue;
+  queue.setPrioritizer(std::make_shared<core::PriorityAttributePrioritizer>());
+
+  auto penalized = createFlowFileWithPriority("1");
+  penalized->setPenaltyExpiration(clock->now() + std::chrono::seconds{10});
+  queue.push(penalized);
+  queue.push(createFlowFileWithPriority("5"));
+  queue.push(createFlowFileWithPriority("3"));
+  CHECK(queue.size() == 3);
+
+  CHECK(popPriorities(queue) == std::vector<std::string>{"3", "5"});
+  CHECK(queue.size() == 1);
+  CHECK_FALSE(queue.isWorkAvailable());
+
+  clock->advance(std::chrono::seconds{10});
+  queue.push(createFlowFileWithPriority("2"));
+  CHECK(popPriorities(queue) == std::vector<std::string>{"1", "2"});
+  CHECK(queue.empty());
+}
+
+TEST_CASE("Swapped flow files keep the order of the prioritizer", "[FlowFilePrioritizer][SwapTest]") {
+  const auto swap_manager = std::make_shared<InMemorySwapManager>();
+  utils::FlowFileQueue queue(swap_manager);
+  queue.setPrioritizer(std::make_shared<core::PriorityAttributePrioritizer>());
+  queue.setMinSize(2);
+  queue.setTargetSize(4);
+  queue.setMaxSize(6);
+
+  for (int priority : {17, 3, 12, 8, 1, 19, 5, 14, 10, 6, 2, 15, 9, 20, 4, 11, 7, 13, 16, 18}) {
+    queue.push(createFlowFileWithPriority(std::to_string(priority)));
+  }
+  CHECK(queue.size() == 20);
+  CHECK(swap_manager->store_count_ > 0);
+  CHECK_FALSE(swap_manager->stored_flow_files_.empty());
+
+  std::vector<std::string> expected;
+  for (int priority = 1; priority <= 20; ++priority) {
+    expected.push_back(std::to_string(priority));
+  }
+  CHECK(popPriorities(queue) == expected);
+  CHECK(queue.empty());
+  CHECK(swap_manager->stored_flow_files_.empty());
+}
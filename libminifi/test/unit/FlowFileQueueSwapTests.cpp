@@ -184,4 +184,98 @@ TEST_CASE_METHOD(SwapTestController, "Popping below min checks if the pending lo
   verifyQueue({70, 80, 90, 100, 110}, {{}}, {});
 }
 
+TEST_CASE_METHOD(SwapTestController, "Pending swap-out does not block push and pop", "[SwapTest8]") {
+  // the stores are never completed unless the test does so, waiting for them would hang the test
+  flow_repo_->delay_store_ = true;
+  setLimits(2, 4, 6);
+  pushAll({50, 20, 30, 60, 10, 40, 28});
+  verifySwapEvents({{Store, {60, 50, 40}}});
+  pushAll({35, 65});
+  verifySwapEvents({{Store, {60, 50, 40}}, {Store, {65}}});
+  verifyQueue({10, 20, 28, 30, 35}, {}, {40, 50, 60, 65});
+  clearSwapEvents();
+
+  clock_->advance(std::chrono::seconds{100});
+  // the swapped flow files are not loaded while their store is pending
+  popAll({10, 20, 28, 30, 35});
+  REQUIRE_FALSE(queue_->impl.tryPop());
+  verifyQueue({}, {}, {40, 50, 60, 65});
+  verifySwapEvents({});
+
+  // the load is retried on the next pop after the stores have finished
+  flow_repo_->completeStores();
+  REQUIRE_FALSE(queue_->impl.tryPop());
+  verifySwapEvents({{Load, {40, 50, 60, 65}}});
+  flow_repo_->load_tasks_[0].complete();
+  popAll({40, 50, 60, 65});
+}
+
+TEST_CASE_METHOD(SwapTestController, "Memory size based thresholds trigger swap-out and swap-in", "[SwapTest9]") {
+  // every flow file has the same attributes, so they have the same estimated memory usage
+  const uint64_t flow_file_memory_size = std::make_shared<minifi::FlowFileRecord>()->getEstimatedMemoryUsage();
+  queue_->impl.setMinMemorySize(2 * flow_file_memory_size);
+  queue_->impl.setTargetMemorySize(4 * flow_file_memory_size);
+  queue_->impl.setMaxMemorySize(6 * flow_file_memory_size);
+
+  pushAll({50, 20, 30, 60, 10, 40});
+  verifySwapEvents({});
+
+  pushAll({28});
+  verifySwapEvents({{Store, {60, 50, 40}}});
+  verifyQueue({10, 20, 28, 30}, {}, {40, 50, 60});
+  REQUIRE(queue_->impl.swappedCount() == 3);
+  REQUIRE(queue_->impl.swappedMemorySize() == 3 * flow_file_memory_size);
+  clearSwapEvents();
+
+  clock_->advance(std::chrono::seconds{100});
+  popAll({10, 20, 28});
+  verifySwapEvents({{Load, {40, 50, 60}}});
+  // the flow files being swapped in are still reported as swapped
+  REQUIRE(queue_->impl.swappedCount() == 3);
+  flow_repo_->load_tasks_[0].complete();
+  popAll({30, 40, 50, 60}, true);
+  REQUIRE(queue_->impl.swappedCount() == 0);
+  REQUIRE(queue_->impl.swappedMemorySize() == 0);
+}
+
+TEST_CASE_METHOD(SwapTestController, "Flow files with large attributes are swapped out before the count threshold is reached", "[SwapTest10]") {
+  setLimits(2, 4, 6);
+  const uint64_t flow_file_memory_size = std::make_shared<minifi::FlowFileRecord>()->getEstimatedMemoryUsage();
+  queue_->impl.setMinMemorySize(flow_file_memory_size * 5);
+  queue_->impl.setTargetMemorySize(flow_file_memory_size * 10);
+  queue_->impl.setMaxMemorySize(flow_file_memory_size * 15);
+
+  pushAll({10, 20});
+  auto large_flow_file = std::static_pointer_cast<core::FlowFile>(std::make_shared<minifi::FlowFileRecord>());
+  large_flow_file->setPenaltyExpiration(Timepoint{std::chrono::seconds{30}});
+  large_flow_file->setAttribute("large", std::string(flow_file_memory_size * 20, 'a'));
+  queue_->push(large_flow_file);
+
+  // the flow file count is below the swap threshold, but the memory usage is not
+  verifySwapEvents({{Store, {30}}});
+  verifyQueue({10, 20}, {}, {30});
+  REQUIRE(queue_->impl.swappedMemorySize() == large_flow_file->getEstimatedMemoryUsage());
+}
+
+TEST_CASE_METHOD(SwapTestController, "The memory size of a flow file is not skewed by changing it while it is queued", "[SwapTest11]") {
+  const uint64_t flow_file_memory_size = std::make_shared<minifi::FlowFileRecord>()->getEstimatedMemoryUsage();
+  queue_->impl.setMinMemorySize(2 * flow_file_memory_size);
+  queue_->impl.setTargetMemorySize(4 * flow_file_memory_size);
+  queue_->impl.setMaxMemorySize(6 * flow_file_memory_size);
+
+  auto flow_file = std::static_pointer_cast<core::FlowFile>(std::make_shared<minifi::FlowFileRecord>());
+  flow_file->setPenaltyExpiration(Timepoint{std::chrono::seconds{10}});
+  queue_->push(flow_file);
+  // the estimated memory usage grows after the flow file has been queued
+  flow_file->setAttribute("large", std::string(flow_file_memory_size * 20, 'a'));
+
+  clock_->advance(std::chrono::seconds{100});
+  popAll({10});
+
+  // the queued memory size is back to zero instead of wrapping around, which would swap out every new flow file
+  pushAll({20, 30, 40});
+  verifySwapEvents({});
+  verifyQueue({20, 30, 40}, {}, {});
+}
+
 }  // namespace org::apache::nifi::minifi::test
@@ -16,7 +16,9 @@
  */
 
 #include <chrono>
+#include <vector>
 #include "FlowFileQueue.h"
+#include "utils/FifoMinMaxHeap.h"
 
 #include "../TestBase.h"
 #include "../Catch.h"
@@ -177,3 +179,49 @@ TEST_CASE("Force pop on FlowFileQueue returns the flow files, whether penalized
   REQUIRE(queue.pop() == penalized_flow_file);
   REQUIRE(queue.empty());
 }
+
+TEST_CASE("Penalized flow files do not change the FIFO order of the non-penalized ones", "[FlowFileQueue][pop]") {
+  utils::FlowFileQueue queue;
+  const auto flow_file_1 = std::make_shared<core::FlowFile>();
+  queue.push(flow_file_1);
+  const auto penalized_flow_file = std::make_shared<core::FlowFile>();
+  penalized_flow_file->penalize(std::chrono::milliseconds{10});
+  queue.push(penalized_flow_file);
+  const auto flow_file_2 = std::make_shared<core::FlowFile>();
+  queue.push(flow_file_2);
+  const auto flow_file_3 = std::make_shared<core::FlowFile>();
+  queue.push(flow_file_3);
+
+  REQUIRE(queue.size() == 4);
+  REQUIRE(queue.pop() == flow_file_1);
+  REQUIRE(queue.pop() == flow_file_2);
+  REQUIRE(queue.pop() == flow_file_3);
+  REQUIRE_FALSE(queue.isWorkAvailable());
+  REQUIRE(utils::verifyEventHappenedInPollTime(std::chrono::seconds{1}, PenaltyHasExpired{penalized_flow_file}, std::chrono::milliseconds{10}));
+  REQUIRE(queue.isWorkAvailable());
+  REQUIRE(queue.pop() == penalized_flow_file);
+  REQUIRE(queue.empty());
+}
+
+TEST_CASE("FifoMinMaxHeap keeps the order of the items pushed in and out of order", "[FifoMinMaxHeap]") {
+  utils::FifoMinMaxHeap<int> heap;
+  for (int item : {1, 3, 3, 7}) {
+    heap.pushBack(item);
+  }
+  // out of order items go into the heap
+  heap.pushBack(2);
+  heap.push(8);
+  heap.push(0);
+
+  REQUIRE(heap.size() == 7);
+  REQUIRE(heap.min() == 0);
+  REQUIRE(heap.max() == 8);
+  REQUIRE(heap.popMax() == 8);
+  REQUIRE(heap.popMax() == 7);
+
+  std::vector<int> popped;
+  while (!heap.empty()) {
+    popped.push_back(heap.popMin());
+  }
+  REQUIRE(popped == std::vector<int>{0, 1, 2, 3, 3});
+}
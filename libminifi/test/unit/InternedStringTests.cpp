@@ -0,0 +1,75 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../TestBase.h"
+#include "../Catch.h"
+#include "utils/InternedString.h"
+#include "FlowFileRecord.h"
+
+TEST_CASE("InternedStrings of the same value share their storage", "[InternedString]") {
+  const utils::InternedString filename{"filename"};
+  const utils::InternedString filename_2{std::string{"file"} + "name"};
+  CHECK(filename == filename_2);
+  CHECK(filename.data() == filename_2.data());
+  CHECK(filename == "filename");
+  CHECK(filename != "path");
+  CHECK(filename.str() == "filename");
+  CHECK(fmt::format("{}", filename) == "filename");
+  CHECK(utils::InternedString{}.empty());
+  CHECK(utils::InternedString{}.data() == utils::InternedString{""}.data());
+}
+
+TEST_CASE("InternedStrings can be created concurrently", "[InternedString]") {
+  std::vector<std::thread> threads;
+  std::vector<std::vector<utils::InternedString>> interned(4);
+  for (auto& strings : interned) {
+    threads.emplace_back([&strings] {
+      for (int i = 0; i < 100; ++i) {
+        strings.emplace_back("concurrent.key." + std::to_string(i));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (const auto& strings : interned) {
+    REQUIRE(strings.size() == 100);
+    for (size_t i = 0; i < strings.size(); ++i) {
+      CHECK(strings[i] == "concurrent.key." + std::to_string(i));
+      CHECK(strings[i].data() == interned[0][i].data());
+    }
+  }
+}
+
+TEST_CASE("The attribute keys of flow files are interned", "[InternedString]") {
+  const auto flow_file_1 = std::make_shared<minifi::FlowFileRecord>();
+  const auto flow_file_2 = std::make_shared<minifi::FlowFileRecord>();
+  flow_file_1->setAttribute("interned.attribute.key", "value 1");
+  flow_file_2->setAttribute(std::string{"interned.attribute.key"}, "value 2");
+
+  const auto& key_1 = flow_file_1->getAttributeMap().find(std::string_view{"interned.attribute.key"})->first;
+  const auto& key_2 = flow_file_2->getAttributeMap().find(std::string_view{"interned.attribute.key"})->first;
+  CHECK(key_1 == "interned.attribute.key");
+  CHECK(key_1.data() == key_2.data());
+  CHECK(flow_file_1->getAttribute("interned.attribute.key") == "value 1");
+  CHECK(flow_file_2->getAttribute("interned.attribute.key") == "value 2");
+}
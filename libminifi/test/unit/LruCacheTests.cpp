@@ -0,0 +1,55 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdexcept>
+#include <string>
+
+#include "../TestBase.h"
+#include "../Catch.h"
+#include "utils/LruCache.h"
+
+TEST_CASE("LruCache evicts the least recently used entry", "[LruCache]") {
+  utils::LruCache<std::string, int> cache{2};
+  cache.put("a", 1);
+  cache.put("b", 2);
+  REQUIRE(cache.get("a"));
+  CHECK(*cache.get("a") == 1);
+
+  cache.put("c", 3);
+  CHECK(cache.size() == 2);
+  CHECK(cache.get("a"));
+  CHECK_FALSE(cache.get("b"));
+  CHECK(cache.get("c"));
+
+  cache.put("a", 4);
+  CHECK(*cache.get("a") == 4);
+  CHECK(cache.size() == 2);
+}
+
+TEST_CASE("LruCache::getOrCreate only creates missing entries", "[LruCache]") {
+  utils::LruCache<std::string, int> cache{2};
+  int created = 0;
+  const auto factory = [&created] { return ++created; };
+  CHECK(cache.getOrCreate("a", factory) == 1);
+  CHECK(cache.getOrCreate("a", factory) == 1);
+  CHECK(cache.getOrCreate("b", factory) == 2);
+  CHECK(created == 2);
+
+  CHECK_THROWS_AS(cache.getOrCreate("c", []() -> int { throw std::runtime_error("failed"); }), std::runtime_error);
+  CHECK(cache.size() == 2);
+  CHECK_FALSE(cache.get("c"));
+}
@@ -70,12 +70,14 @@ TEST_CASE("QueueMetricsTestConnections", "[c2m3]") {
   minifi::state::response::SerializedResponseNode resp = metrics.serialize().at(0);
 
   REQUIRE("testconnection" == resp.name);
-  REQUIRE(4 == resp.children.size());
+  REQUIRE(6 == resp.children.size());
 
   checkSerializedValue(resp.children, "datasize", "0");
   checkSerializedValue(resp.children, "datasizemax", "1024");
   checkSerializedValue(resp.children, "queued", "0");
   checkSerializedValue(resp.children, "queuedmax", "1024");
+  checkSerializedValue(resp.children, "swapped", "0");
+  checkSerializedValue(resp.children, "swappedmemorysize", "0");
 }
 
 TEST_CASE("RepositorymetricsNoRepo", "[c2m4]") {
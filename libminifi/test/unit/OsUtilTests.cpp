@@ -17,9 +17,18 @@
  */
 
 
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
 #include "utils/OsUtils.h"
+#include "utils/gsl.h"
 #include "../TestBase.h"
 #include "../Catch.h"
+#include "../Utils.h"
 
 namespace org::apache::nifi::minifi::test {
 
@@ -44,4 +53,36 @@ TEST_CASE("Test userIdToUsername for well-known SIDs", "[OsUtils]") {
 TEST_CASE("Machine architecture is supported") {
   CHECK(minifi::utils::OsUtils::getMachineArchitecture() != "unknown");
 }
+
+TEST_CASE("CPU lists can be parsed", "[OsUtils]") {
+  using minifi::utils::OsUtils::parseCpuList;
+  CHECK(parseCpuList("0") == std::vector<unsigned>{0});
+  CHECK(parseCpuList("0-3") == std::vector<unsigned>{0, 1, 2, 3});
+  CHECK(parseCpuList("8, 2-3,0 ,3") == std::vector<unsigned>{0, 2, 3, 8});
+  CHECK_FALSE(parseCpuList(""));
+  CHECK_FALSE(parseCpuList("3-1"));
+  CHECK_FALSE(parseCpuList("1-2-3"));
+  CHECK_FALSE(parseCpuList("a"));
+  CHECK_FALSE(parseCpuList("-1"));
+  CHECK_FALSE(parseCpuList("0-100000"));
+}
+
+#ifdef __linux__
+TEST_CASE("The current thread can be pinned to a CPU", "[OsUtils]") {
+  const auto cpu = utils::getAllowedCpu();
+  std::thread thread([cpu] {
+    CHECK(minifi::utils::OsUtils::setCurrentThreadCpuAffinity({cpu}));
+    CHECK(sched_getcpu() == gsl::narrow<int>(cpu));
+  });
+  thread.join();
+  CHECK_FALSE(minifi::utils::OsUtils::setCurrentThreadCpuAffinity({}));
+}
+
+TEST_CASE("The memory of the current thread cannot be bound to a nonexistent NUMA node", "[OsUtils]") {
+  std::thread thread([] {
+    CHECK_FALSE(minifi::utils::OsUtils::setCurrentThreadMemoryNode(4096));
+  });
+  thread.join();
+}
+#endif
 }  // namespace org::apache::nifi::minifi::test
@@ -0,0 +1,137 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../TestBase.h"
+#include "../Catch.h"
+#include "io/BufferStream.h"
+#include "utils/ParallelRangedFetch.h"
+
+namespace {
+
+class RangedObject {
+ public:
+  explicit RangedObject(std::string content) : content_(std::move(content)) {}
+
+  std::optional<std::vector<std::byte>> fetch(uint64_t offset, uint64_t length) {
+    const auto in_flight = ++ranges_in_flight_;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      max_ranges_in_flight_ = std::max(max_ranges_in_flight_, in_flight);
+      requested_ranges_.emplace_back(offset, length);
+    }
+    // later ranges finish first, they still have to be written in order
+    std::this_thread::sleep_for(std::chrono::milliseconds{offset % 3 == 0 ? 20 : 1});
+    --ranges_in_flight_;
+    if (failing_offset_ == offset) {
+      return std::nullopt;
+    }
+    const auto range = std::as_bytes(std::span(content_)).subspan(offset, length);
+    return std::vector<std::byte>(range.begin(), range.end());
+  }
+
+  [[nodiscard]] uint64_t size() const { return content_.size(); }
+  [[nodiscard]] size_t getMaxRangesInFlight() const { return max_ranges_in_flight_; }
+  [[nodiscard]] std::vector<std::pair<uint64_t, uint64_t>> getRequestedRanges() const {
+    auto ranges = requested_ranges_;
+    std::sort(ranges.begin(), ranges.end());
+    return ranges;
+  }
+  void failAtOffset(uint64_t offset) { failing_offset_ = offset; }
+
+ private:
+  std::string content_;
+  std::atomic<size_t> ranges_in_flight_{0};
+  size_t max_ranges_in_flight_ = 0;
+  std::vector<std::pair<uint64_t, uint64_t>> requested_ranges_;
+  std::mutex mutex_;
+  std::optional<uint64_t> failing_offset_;
+};
+
+std::string toString(minifi::io::BufferStream& stream) {
+  const auto buffer = stream.getBuffer();
+  return {reinterpret_cast<const char*>(buffer.data()), buffer.size()};
+}
+
+}  // namespace
+
+TEST_CASE("Parallel ranged fetch writes the ranges in order", "[ParallelRangedFetch]") {
+  RangedObject object("The quick brown fox jumps over the lazy dog");
+  minifi::io::BufferStream output;
+  minifi::utils::ParallelRangedFetchSettings settings;
+  size_t expected_max_in_flight = 1;
+
+  SECTION("One range at a time") {
+    settings.max_concurrent_ranges = 1;
+  }
+  SECTION("Four ranges at a time") {
+    settings.max_concurrent_ranges = 4;
+    expected_max_in_flight = 4;
+  }
+  settings.range_size = 5;
+
+  const auto write_size = minifi::utils::parallelRangedFetch(object.size(), settings,
+      [&](uint64_t offset, uint64_t length) { return object.fetch(offset, length); }, output);
+  REQUIRE(write_size);
+  CHECK(*write_size == object.size());
+  CHECK(toString(output) == "The quick brown fox jumps over the lazy dog");
+  CHECK(object.getMaxRangesInFlight() <= expected_max_in_flight);
+  CHECK(object.getRequestedRanges() == std::vector<std::pair<uint64_t, uint64_t>>{
+      {0, 5}, {5, 5}, {10, 5}, {15, 5}, {20, 5}, {25, 5}, {30, 5}, {35, 5}, {40, 3}});
+}
+
+TEST_CASE("Parallel ranged fetch of an empty object does not fetch anything", "[ParallelRangedFetch]") {
+  RangedObject object("");
+  minifi::io::BufferStream output;
+  const auto write_size = minifi::utils::parallelRangedFetch(0, minifi::utils::ParallelRangedFetchSettings{.max_concurrent_ranges = 4, .range_size = 5},
+      [&](uint64_t offset, uint64_t length) { return object.fetch(offset, length); }, output);
+  REQUIRE(write_size);
+  CHECK(*write_size == 0);
+  CHECK(object.getRequestedRanges().empty());
+}
+
+TEST_CASE("Parallel ranged fetch fails if any of the ranges fails", "[ParallelRangedFetch]") {
+  RangedObject object("The quick brown fox jumps over the lazy dog");
+  object.failAtOffset(15);
+  minifi::io::BufferStream output;
+  const auto write_size = minifi::utils::parallelRangedFetch(object.size(), minifi::utils::ParallelRangedFetchSettings{.max_concurrent_ranges = 2, .range_size = 5},
+      [&](uint64_t offset, uint64_t length) { return object.fetch(offset, length); }, output);
+  CHECK_FALSE(write_size);
+  // no new ranges are started after the failure is noticed
+  CHECK(object.getRequestedRanges().size() < 9);
+  CHECK(toString(output) == "The quick brown");
+}
+
+TEST_CASE("Parallel ranged fetch fails if a range is shorter than requested", "[ParallelRangedFetch]") {
+  const std::string content = "The quick brown fox";
+  minifi::io::BufferStream output;
+  const auto write_size = minifi::utils::parallelRangedFetch(content.size() + 10, minifi::utils::ParallelRangedFetchSettings{.max_concurrent_ranges = 3, .range_size = 8},
+      [&](uint64_t offset, uint64_t length) -> std::optional<std::vector<std::byte>> {
+        const auto range = std::as_bytes(std::span(content)).subspan(std::min<uint64_t>(offset, content.size()));
+        const auto available = range.first(std::min<uint64_t>(length, range.size()));
+        return std::vector<std::byte>(available.begin(), available.end());
+      }, output);
+  CHECK_FALSE(write_size);
+}
@@ -0,0 +1,97 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../TestBase.h"
+#include "../Catch.h"
+#include "catch2/catch_approx.hpp"
+#include "sitetosite/PeerSelector.h"
+
+namespace sitetosite = minifi::sitetosite;
+
+namespace {
+
+std::vector<sitetosite::PeerStatus> createPeers(const std::vector<uint32_t>& flow_file_counts) {
+  std::vector<sitetosite::PeerStatus> peers;
+  uint16_t port = 10000;
+  for (const auto flow_file_count : flow_file_counts) {
+    peers.emplace_back(std::make_shared<sitetosite::Peer>("peer" + std::to_string(port), port), flow_file_count, true);
+    ++port;
+  }
+  return peers;
+}
+
+}  // namespace
+
+TEST_CASE("Peer weights follow the reported flow file counts", "[PeerSelector]") {
+  SECTION("Sending prefers the peers with fewer flow files") {
+    const auto weights = sitetosite::PeerSelector::calculateWeights(createPeers({100, 300, 600}), sitetosite::SEND);
+    REQUIRE(weights.size() == 3);
+    CHECK(weights[0] == Catch::Approx(0.45));
+    CHECK(weights[1] == Catch::Approx(0.35));
+    CHECK(weights[2] == Catch::Approx(0.2));
+  }
+
+  SECTION("Receiving prefers the peers with more flow files") {
+    const auto weights = sitetosite::PeerSelector::calculateWeights(createPeers({100, 300, 600}), sitetosite::RECEIVE);
+    REQUIRE(weights.size() == 3);
+    CHECK(weights[0] == Catch::Approx(0.1));
+    CHECK(weights[1] == Catch::Approx(0.3));
+    CHECK(weights[2] == Catch::Approx(0.6));
+  }
+
+  SECTION("Idle peers are weighted evenly") {
+    for (const auto direction : {sitetosite::SEND, sitetosite::RECEIVE}) {
+      const auto weights = sitetosite::PeerSelector::calculateWeights(createPeers({0, 0, 0, 0}), direction);
+      REQUIRE(weights.size() == 4);
+      for (const auto weight : weights) {
+        CHECK(weight == Catch::Approx(0.25));
+      }
+    }
+  }
+
+  SECTION("A single peer gets all the transactions") {
+    CHECK(sitetosite::PeerSelector::calculateWeights(createPeers({42}), sitetosite::SEND) == std::vector<double>{1.0});
+    CHECK(sitetosite::PeerSelector::calculateWeights(createPeers({42}), sitetosite::RECEIVE) == std::vector<double>{1.0});
+  }
+}
+
+TEST_CASE("PeerSelector selects the peers by their weights", "[PeerSelector]") {
+  sitetosite::PeerSelector selector;
+  CHECK(selector.empty());
+  CHECK_FALSE(selector.selectPeer());
+
+  selector.setPeers(createPeers({0, 1000, 9000}), sitetosite::SEND);
+  REQUIRE_FALSE(selector.empty());
+
+  constexpr int SELECTION_COUNT = 10000;
+  std::map<uint16_t, int> selections;
+  for (int i = 0; i < SELECTION_COUNT; ++i) {
+    const auto peer = selector.selectPeer();
+    REQUIRE(peer);
+    ++selections[peer->getPeer()->getPort()];
+  }
+  // the expected shares are 50%, 45% and 5%
+  CHECK(selections[10000] > SELECTION_COUNT * 4 / 10);
+  CHECK(selections[10001] > SELECTION_COUNT * 35 / 100);
+  CHECK(selections[10002] < SELECTION_COUNT / 10);
+  CHECK(selections[10000] + selections[10001] + selections[10002] == SELECTION_COUNT);
+}
@@ -18,6 +18,7 @@
 #include <array>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "core/ProcessSession.h"
 #include "core/Resource.h"
@@ -27,6 +28,7 @@
 #include "Processor.h"
 #include "core/repository/VolatileFlowFileRepository.h"
 #include "IntegrationTestUtils.h"
+#include "utils/TestUtils.h"
 #include "../Utils.h"
 
 namespace {
@@ -99,6 +101,64 @@ TEST_CASE("ProcessSession::rollback penalizes affected flowfiles", "[rollback]")
   REQUIRE(next_flow_file_to_be_processed == flow_file_3);
 }
 
+TEST_CASE("ProcessSession::rollback restores the attributes and lineage of modified flowfiles", "[rollback]") {
+  Fixture fixture;
+  minifi::core::ProcessSession &process_session = fixture.processSession();
+
+  const auto parent = process_session.create();
+  parent->setAttribute("key", "original");
+  process_session.transfer(parent, Success);
+  process_session.commit();
+
+  const auto flow_file = process_session.get();
+  REQUIRE(flow_file == parent);
+  const auto lineage = flow_file->getlineageIdentifiers();
+  flow_file->setAttribute("key", "modified");
+  flow_file->setAttribute("new_key", "value");
+  const auto child = process_session.create(flow_file);
+  REQUIRE(flow_file->getlineageIdentifiers().size() == lineage.size() + 1);
+
+  process_session.rollback();
+  CHECK(flow_file->getAttribute("key") == "original");
+  CHECK_FALSE(flow_file->getAttribute("new_key"));
+  CHECK(flow_file->getlineageIdentifiers() == lineage);
+}
+
+TEST_CASE("ProcessSession::get can return a batch of flowfiles", "[getbatch]") {
+  Fixture fixture;
+  minifi::core::ProcessSession &process_session = fixture.processSession();
+
+  std::vector<std::shared_ptr<minifi::core::FlowFile>> flow_files;
+  for (int i = 0; i < 5; ++i) {
+    auto flow_file = process_session.create();
+    process_session.writeBuffer(flow_file, std::string_view{"0123456789"});
+    process_session.transfer(flow_file, Success);
+    flow_files.push_back(flow_file);
+  }
+  process_session.commit();
+
+  SECTION("The batch is limited by the flowfile count") {
+    const auto batch = process_session.get(3);
+    REQUIRE(batch == std::vector<std::shared_ptr<minifi::core::FlowFile>>{flow_files[0], flow_files[1], flow_files[2]});
+    REQUIRE(process_session.get(10) == std::vector<std::shared_ptr<minifi::core::FlowFile>>{flow_files[3], flow_files[4]});
+    REQUIRE(process_session.get(10).empty());
+  }
+
+  SECTION("The batch is limited by the total size, including the flowfile which reaches the limit") {
+    const auto batch = process_session.get(10, 15);
+    REQUIRE(batch == std::vector<std::shared_ptr<minifi::core::FlowFile>>{flow_files[0], flow_files[1]});
+    REQUIRE(process_session.get() == flow_files[2]);
+  }
+
+  SECTION("Rolling back returns the whole batch to the queue") {
+    REQUIRE(process_session.get(5).size() == 5);
+    process_session.rollback();
+    for (const auto& flow_file : flow_files) {
+      REQUIRE(flow_file->isPenalized());
+    }
+  }
+}
+
 TEST_CASE("ProcessSession::read reads the flowfile from offset to size", "[readoffsetsize]") {
   ContentRepositoryDependentTests::testReadOnSmallerClonedFlowFiles(std::make_shared<minifi::core::repository::VolatileContentRepository>());
   ContentRepositoryDependentTests::testReadOnSmallerClonedFlowFiles(std::make_shared<minifi::core::repository::FileSystemRepository>());
@@ -129,6 +189,32 @@ TEST_CASE("ProcessSession::read can read zero length flowfiles without crash", "
   ContentRepositoryDependentTests::testReadFromZeroLengthFlowFile(std::make_shared<core::repository::FileSystemRepository>());
 }
 
+TEST_CASE("ProcessSession::import and exportContent work with and without kernel-side copies", "[import][exportContent]") {
+  std::shared_ptr<minifi::core::ContentRepository> content_repo;
+  SECTION("VolatileContentRepository") {
+    content_repo = std::make_shared<core::repository::VolatileContentRepository>();
+  }
+  SECTION("FileSystemRepository") {
+    content_repo = std::make_shared<core::repository::FileSystemRepository>();
+  }
+  Fixture fixture{TestController::PlanConfig{.content_repo = content_repo}};
+  minifi::core::ProcessSession &process_session = fixture.processSession();
+  TestController test_controller;
+  const auto dir = test_controller.createTempDirectory();
+  const auto source = minifi::utils::putFileToDir(dir, "source.txt", "header|payload");
+
+  const auto flow_file = process_session.create();
+  process_session.import(source.string(), flow_file, false, 7);
+  CHECK_FALSE(std::filesystem::exists(source));
+  CHECK(flow_file->getSize() == 7);
+  CHECK(to_string(process_session.readBuffer(flow_file)) == "payload");
+
+  const auto clone = process_session.clone(flow_file, 3, 4);
+  REQUIRE(process_session.exportContent((dir / "exported.txt").string(), clone, true));
+  CHECK(minifi::utils::file::get_content(dir / "exported.txt") == "load");
+  CHECK(minifi::utils::file::list_dir_all(dir, test_controller.getLogger()).size() == 1);
+}
+
 struct VolatileFlowFileRepositoryTestAccessor {
   METHOD_ACCESSOR(flush);
 };
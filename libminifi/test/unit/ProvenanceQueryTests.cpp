@@ -0,0 +1,85 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "provenance/ProvenanceQuery.h"
+#include "io/BufferStream.h"
+#include "../TestBase.h"
+#include "../Catch.h"
+
+using namespace std::literals::chrono_literals;
+namespace provenance = org::apache::nifi::minifi::provenance;
+
+TEST_CASE("Provenance queries can be parsed from query strings", "[provenanceQuery]") {
+  const auto flow_file_uuid = minifi::utils::IdGenerator::getIdGenerator()->generate();
+  const auto query = provenance::ProvenanceQuery::parse("flowFileUuid=" + flow_file_uuid.to_string()
+      + " & componentId=processor1&eventType=send&startTime=1000&endTime=2024-01-01T00:00:00Z&maxResults=10");
+  REQUIRE(query);
+  CHECK(query->flow_file_uuid == flow_file_uuid);
+  CHECK(query->component_id == "processor1");
+  CHECK(query->event_type == provenance::ProvenanceEventRecord::SEND);
+  CHECK(query->start_time == std::chrono::system_clock::time_point{1s});
+  CHECK(query->end_time == minifi::utils::timeutils::parseRfc3339("2024-01-01T00:00:00Z"));
+  CHECK(query->max_results == 10);
+
+  const auto default_query = provenance::ProvenanceQuery::parse("");
+  REQUIRE(default_query);
+  CHECK_FALSE(default_query->component_id);
+  CHECK(default_query->max_results == provenance::ProvenanceQuery::DEFAULT_MAX_RESULTS);
+
+  CHECK_FALSE(provenance::ProvenanceQuery::parse("flowFileUuid=not-a-uuid"));
+  CHECK_FALSE(provenance::ProvenanceQuery::parse("eventType=UNKNOWN"));
+  CHECK_FALSE(provenance::ProvenanceQuery::parse("maxResults=0"));
+  CHECK_FALSE(provenance::ProvenanceQuery::parse("startTime=yesterday"));
+  CHECK_FALSE(provenance::ProvenanceQuery::parse("color=blue"));
+  CHECK_FALSE(provenance::ProvenanceQuery::parse("componentId"));
+}
+
+TEST_CASE("Provenance queries match the events by all criteria", "[provenanceQuery]") {
+  provenance::ProvenanceEventRecord event(provenance::ProvenanceEventRecord::CREATE, "processor1", "GenerateFlowFile");
+
+  provenance::ProvenanceQuery query;
+  CHECK(query.matches(event));
+  query.component_id = "processor1";
+  CHECK(query.matches(event));
+  query.event_type = provenance::ProvenanceEventRecord::SEND;
+  CHECK_FALSE(query.matches(event));
+  query.event_type = provenance::ProvenanceEventRecord::CREATE;
+  query.start_time = event.getEventTime() + 1ms;
+  CHECK_FALSE(query.matches(event));
+  query.start_time = event.getEventTime();
+  query.end_time = event.getEventTime();
+  CHECK_FALSE(query.matches(event));
+  query.end_time = event.getEventTime() + 1ms;
+  CHECK(query.matches(event));
+}
+
+TEST_CASE("The indexed fields can be read from a serialized provenance event", "[provenanceQuery]") {
+  provenance::ProvenanceEventRecord event(provenance::ProvenanceEventRecord::FETCH, "processor1", "FetchFile");
+  minifi::io::BufferStream stream;
+  REQUIRE(event.serialize(stream));
+
+  const auto fields = provenance::ProvenanceEventRecord::readIndexedFields(stream);
+  REQUIRE(fields);
+  CHECK(fields->event_id == event.getEventId());
+  CHECK(fields->event_type == provenance::ProvenanceEventRecord::FETCH);
+  CHECK(fields->event_time == std::chrono::floor<std::chrono::milliseconds>(event.getEventTime()));
+  CHECK(fields->component_id == "processor1");
+  CHECK(fields->flow_file_uuid == event.getFlowFileUuid());
+
+  minifi::io::BufferStream garbage(std::string("not a provenance event"));
+  CHECK_FALSE(provenance::ProvenanceEventRecord::readIndexedFields(garbage));
+}
@@ -0,0 +1,64 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "provenance/ProvenanceSampling.h"
+#include "FlowFileRecord.h"
+#include "ProvenanceTestHelper.h"
+#include "../TestBase.h"
+#include "../Catch.h"
+
+namespace provenance = org::apache::nifi::minifi::provenance;
+
+TEST_CASE("Provenance sampling rates can be parsed", "[provenanceSampling]") {
+  const auto sampling = provenance::ProvenanceSampling::parse("attributes_modified:0.01, ROUTE : 0.5,DROP:0");
+  REQUIRE(sampling);
+  CHECK(sampling->getRate(provenance::ProvenanceEventRecord::ATTRIBUTES_MODIFIED) == Approx(0.01));
+  CHECK(sampling->getRate(provenance::ProvenanceEventRecord::ROUTE) == Approx(0.5));
+  CHECK(sampling->getRate(provenance::ProvenanceEventRecord::DROP) == 0.0);
+  CHECK(sampling->getRate(provenance::ProvenanceEventRecord::SEND) == 1.0);
+
+  CHECK(provenance::ProvenanceSampling::parse(""));
+  CHECK_FALSE(provenance::ProvenanceSampling::parse("ROUTE"));
+  CHECK_FALSE(provenance::ProvenanceSampling::parse("UNKNOWN:0.5"));
+  CHECK_FALSE(provenance::ProvenanceSampling::parse("ROUTE:often"));
+  CHECK_FALSE(provenance::ProvenanceSampling::parse("ROUTE:1.5"));
+  CHECK_FALSE(provenance::ProvenanceSampling::parse("ROUTE:-0.1"));
+}
+
+TEST_CASE("Invalid provenance sampling configuration records every event", "[provenanceSampling]") {
+  auto configuration = std::make_shared<minifi::Configure>();
+  configuration->set(minifi::Configure::nifi_provenance_repository_sampling_rates, "ROUTE:2");
+  const auto sampling = provenance::ProvenanceSampling::fromConfiguration(*configuration);
+  CHECK(sampling.getRate(provenance::ProvenanceEventRecord::ROUTE) == 1.0);
+}
+
+TEST_CASE("Events which are not sampled are not reported", "[provenanceSampling]") {
+  auto repository = std::make_shared<TestRepository>();
+  auto sampling = provenance::ProvenanceSampling::parse("ATTRIBUTES_MODIFIED:0, CONTENT_MODIFIED:1");
+  REQUIRE(sampling);
+  provenance::ProvenanceReporter reporter(repository, "processor1", "UpdateAttribute",
+      std::make_shared<const provenance::ProvenanceSampling>(*sampling));
+
+  auto flow_file = std::make_shared<minifi::FlowFileRecord>();
+  reporter.modifyAttribute(flow_file, "filename");
+  reporter.removeAttribute(flow_file, "path");
+  CHECK(reporter.getEvents().empty());
+
+  reporter.modifyContent(flow_file, std::chrono::milliseconds{5});
+  REQUIRE(reporter.getEvents().size() == 1);
+  CHECK((*reporter.getEvents().begin())->getEventType() == provenance::ProvenanceEventRecord::CONTENT_MODIFIED);
+}
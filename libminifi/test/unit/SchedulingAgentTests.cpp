@@ -126,6 +126,62 @@ TEST_CASE_METHOD(SchedulingAgentTestFixture, "EventDrivenSchedulingAgent") {
   CHECK(count_num_after_two_schedule > count_num_after_one_schedule+100);
 }
 
+TEST_CASE_METHOD(SchedulingAgentTestFixture, "EventDrivenSchedulingAgent waits for a notification while the incoming connections are empty") {
+  auto connection = std::make_shared<minifi::Connection>(test_repo_, content_repo_, "incoming");
+  connection->setDestinationUUID(count_proc_->getUUID());
+  connection->setDestination(count_proc_.get());
+  count_proc_->setScheduledState(core::STOPPED);
+  REQUIRE(count_proc_->addConnection(connection.get()));
+  count_proc_->setScheduledState(core::RUNNING);
+  count_proc_->setSchedulingStrategy(core::EVENT_DRIVEN);
+
+  auto event_driven_agent = std::make_shared<EventDrivenSchedulingAgent>(gsl::make_not_null(controller_services_provider_.get()), test_repo_, test_repo_, content_repo_, configuration_, thread_pool_);
+  event_driven_agent->start();
+  auto task_reschedule_info = event_driven_agent->run(count_proc_.get(), context_, factory_);
+  CHECK(!task_reschedule_info.isFinished());
+  CHECK(task_reschedule_info.isWaitingForNotification());
+  CHECK(count_proc_->getNumberOfTriggers() == 0);
+
+  size_t notification_count = 0;
+  count_proc_->setWorkNotifier([&notification_count] { ++notification_count; });
+  connection->put(std::make_shared<minifi::FlowFileRecord>());
+  CHECK(notification_count == 1);
+  count_proc_->setWorkNotifier(nullptr);
+}
+
+TEST_CASE_METHOD(SchedulingAgentTestFixture, "Autoscaling gives back the tasks of an idle processor") {
+  configuration_->set(minifi::Configure::nifi_flow_engine_autoscaling_enabled, "true");
+  // the test triggers the autoscaling itself
+  configuration_->set(minifi::Configure::nifi_flow_engine_autoscaling_interval, "1 h");
+  count_proc_->setSchedulingPeriod(1h);
+  count_proc_->setMaxConcurrentTasks(2);
+  int expected_task_count = 1;
+  SECTION("The default minimum is a single task") {
+  }
+  SECTION("The minimum can be set for the processor") {
+    count_proc_->setAutoscalingMinConcurrentTasks(2);
+    expected_task_count = 2;
+  }
+
+  auto timer_driven_agent = std::make_shared<TimerDrivenSchedulingAgent>(gsl::make_not_null(controller_services_provider_.get()), test_repo_, test_repo_, content_repo_, configuration_, thread_pool_);
+  timer_driven_agent->start();
+  timer_driven_agent->schedule(count_proc_.get());
+  // the processor starts with the configured number of tasks
+  CHECK(count_proc_->getMetrics().concurrent_tasks == 2);
+
+  // the processor has no incoming flow files and its tasks do not run, it is idle
+  for (int i = 0; i < 3; ++i) {
+    std::this_thread::sleep_for(10ms);
+    timer_driven_agent->autoscale();
+  }
+  CHECK(count_proc_->getMetrics().concurrent_tasks == expected_task_count);
+  CHECK(count_proc_->getMetrics().concurrent_task_scale_downs == 2 - expected_task_count);
+  CHECK(count_proc_->getMetrics().concurrent_task_scale_ups == 0);
+
+  timer_driven_agent->unschedule(count_proc_.get());
+  timer_driven_agent->stop();
+}
+
 TEST_CASE_METHOD(SchedulingAgentTestFixture, "Cron Driven every year") {
   count_proc_->setCronPeriod("0 0 0 1 1 ?");
   auto cron_driven_agent = std::make_shared<CronDrivenSchedulingAgent>(gsl::make_not_null(controller_services_provider_.get()), test_repo_, test_repo_, content_repo_, configuration_, thread_pool_);
@@ -17,12 +17,15 @@
  */
 
 #include <algorithm>
+#include <array>
 #include <map>
 #include <memory>
 #include <string>
 #include <utility>
 
 #include "io/BaseStream.h"
+#include "io/CRCStream.h"
+#include "sitetosite/CompressionStream.h"
 #include "sitetosite/Peer.h"
 #include "sitetosite/RawSocketProtocol.h"
 #include "../TestBase.h"
@@ -63,6 +66,24 @@ void sunny_path_bootstrap(const std::unique_ptr<SiteToSiteResponder>& collector)
   collector->push_response(resp_code);
 }
 
+void verify_bootstrap_requests(SiteToSiteResponder& collector, const std::string& use_gzip) {
+  REQUIRE(collector.get_next_client_bytes(4) == "NiFi");
+  REQUIRE(collector.get_next_client_string() == "SocketFlowFileProtocol");
+  collector.get_next_client_value<uint32_t>();  // protocol version
+  collector.get_next_client_string();  // communication identifier
+  REQUIRE(collector.get_next_client_string() == "nifi://fake_host:65433");
+  REQUIRE(collector.get_next_client_value<uint32_t>() == 3);  // number of handshake properties
+  REQUIRE(collector.get_next_client_string() == "GZIP");
+  REQUIRE(collector.get_next_client_string() == use_gzip);
+  REQUIRE(collector.get_next_client_string() == "PORT_IDENTIFIER");
+  REQUIRE(utils::StringUtils::equalsIgnoreCase(collector.get_next_client_string(), "c56a4180-65aa-42ec-a945-5fd21dec0538"));
+  REQUIRE(collector.get_next_client_string() == "REQUEST_EXPIRATION_MILLIS");
+  REQUIRE(collector.get_next_client_string() == "30000");
+  REQUIRE(collector.get_next_client_string() == "NEGOTIATE_FLOWFILE_CODEC");
+  REQUIRE(collector.get_next_client_string() == "StandardFlowFileCodec");
+  collector.get_next_client_value<uint32_t>();  // codec version
+}
+
 TEST_CASE("TestSiteToSiteVerifySend", "[S2S3]") {
   auto collector = std::make_unique<SiteToSiteResponder>();
   auto collector_ptr = collector.get();
@@ -70,6 +91,7 @@ TEST_CASE("TestSiteToSiteVerifySend", "[S2S3]") {
   sunny_path_bootstrap(collector);
 
   auto peer = std::make_unique<minifi::sitetosite::SiteToSitePeer>(std::move(collector), "fake_host", 65433, "");
+  auto peer_ptr = peer.get();
 
   minifi::sitetosite::RawSiteToSiteClient protocol(std::move(peer));
 
@@ -79,32 +101,7 @@ TEST_CASE("TestSiteToSiteVerifySend", "[S2S3]") {
 
   REQUIRE(true == protocol.bootstrap());
 
-  REQUIRE(collector_ptr->get_next_client_response() == "NiFi");
-  collector_ptr->get_next_client_response();
-  REQUIRE(collector_ptr->get_next_client_response() == "SocketFlowFileProtocol");
-  collector_ptr->get_next_client_response();
-  collector_ptr->get_next_client_response();
-  collector_ptr->get_next_client_response();
-  collector_ptr->get_next_client_response();
-  REQUIRE(collector_ptr->get_next_client_response() == "nifi://fake_host:65433");
-  collector_ptr->get_next_client_response();
-  collector_ptr->get_next_client_response();
-  REQUIRE(collector_ptr->get_next_client_response() == "GZIP");
-  collector_ptr->get_next_client_response();
-  REQUIRE(collector_ptr->get_next_client_response() == "false");
-  collector_ptr->get_next_client_response();
-  REQUIRE(collector_ptr->get_next_client_response() == "PORT_IDENTIFIER");
-  collector_ptr->get_next_client_response();
-  REQUIRE(utils::StringUtils::equalsIgnoreCase(collector_ptr->get_next_client_response(), "c56a4180-65aa-42ec-a945-5fd21dec0538"));
-  collector_ptr->get_next_client_response();
-  REQUIRE(collector_ptr->get_next_client_response() == "REQUEST_EXPIRATION_MILLIS");
-  collector_ptr->get_next_client_response();
-  REQUIRE(collector_ptr->get_next_client_response() == "30000");
-  collector_ptr->get_next_client_response();
-  REQUIRE(collector_ptr->get_next_client_response() == "NEGOTIATE_FLOWFILE_CODEC");
-  collector_ptr->get_next_client_response();
-  REQUIRE(collector_ptr->get_next_client_response() == "StandardFlowFileCodec");
-  collector_ptr->get_next_client_response();  // codec version
+  verify_bootstrap_requests(*collector_ptr, "false");
 
   // start to send the stuff
   // Create the transaction
@@ -113,16 +110,151 @@ TEST_CASE("TestSiteToSiteVerifySend", "[S2S3]") {
   transaction = protocol.createTransaction(minifi::sitetosite::SEND);
   REQUIRE(transaction);
   auto transactionID = transaction->getUUID();
-  collector_ptr->get_next_client_response();
-  REQUIRE(collector_ptr->get_next_client_response() == "SEND_FLOWFILES");
   std::map<std::string, std::string> attributes;
   std::shared_ptr<logging::Logger> logger = nullptr;
   minifi::sitetosite::DataPacket packet(logger, transaction, attributes, payload);
   REQUIRE(protocol.send(transactionID, &packet, nullptr, nullptr) == 0);
-  collector_ptr->get_next_client_response();
-  collector_ptr->get_next_client_response();
-  std::string rx_payload = collector_ptr->get_next_client_response();
+  REQUIRE(peer_ptr->flush());
+  REQUIRE(collector_ptr->get_next_client_string() == "SEND_FLOWFILES");
+  REQUIRE(collector_ptr->get_next_client_value<uint32_t>() == 0);  // number of attributes
+  REQUIRE(collector_ptr->get_next_client_value<uint64_t>() == payload.size());
+  std::string rx_payload = collector_ptr->get_next_client_bytes(payload.size());
   REQUIRE(payload == rx_payload);
+
+  // the magic bytes, one write for each negotiation step and one for the transaction, instead of one write per field
+  REQUIRE(collector_ptr->get_client_write_count() == 5);
+}
+
+TEST_CASE("TestSiteToSiteVerifySendWithCompression", "[S2S5]") {
+  auto collector = std::make_unique<SiteToSiteResponder>();
+  auto collector_ptr = collector.get();
+
+  sunny_path_bootstrap(collector);
+
+  auto peer = std::make_unique<minifi::sitetosite::SiteToSitePeer>(std::move(collector), "fake_host", 65433, "");
+  auto peer_ptr = peer.get();
+
+  minifi::sitetosite::RawSiteToSiteClient protocol(std::move(peer));
+  utils::Identifier fakeUUID = utils::Identifier::parse("C56A4180-65AA-42EC-A945-5FD21DEC0538").value();
+  protocol.setPortId(fakeUUID);
+  protocol.setUseCompression(true);
+
+  REQUIRE(true == protocol.bootstrap());
+
+  verify_bootstrap_requests(*collector_ptr, "true");
+
+  auto transaction = protocol.createTransaction(minifi::sitetosite::SEND);
+  REQUIRE(transaction);
+  // spans more than one compressed chunk
+  std::string payload;
+  for (size_t i = 0; payload.size() < 3 * minifi::sitetosite::CompressionFraming::ChunkSize; ++i) {
+    payload += "Test MiNiFi payload " + std::to_string(i % 100) + "\n";
+  }
+  std::map<std::string, std::string> attributes{{"filename", "payload.txt"}};
+  minifi::sitetosite::DataPacket packet(nullptr, transaction, attributes, payload);
+  REQUIRE(protocol.send(transaction->getUUID(), &packet, nullptr, nullptr) == 0);
+  REQUIRE(peer_ptr->flush());
+  REQUIRE(collector_ptr->get_next_client_string() == "SEND_FLOWFILES");
+
+  auto& client_data = collector_ptr->get_client_data();
+  const size_t packet_start = client_data.tell();
+  minifi::sitetosite::CompressionInputStream decompressed(gsl::make_not_null(&client_data));
+  uint32_t number_of_attributes = 0;
+  REQUIRE(decompressed.read(number_of_attributes) == 4);
+  REQUIRE(number_of_attributes == 1);
+  std::string key;
+  std::string value;
+  REQUIRE_FALSE(minifi::io::isError(decompressed.read(key, true)));
+  REQUIRE_FALSE(minifi::io::isError(decompressed.read(value, true)));
+  CHECK(key == "filename");
+  CHECK(value == "payload.txt");
+  uint64_t length = 0;
+  REQUIRE(decompressed.read(length) == 8);
+  REQUIRE(length == payload.size());
+  std::string rx_payload(payload.size(), '\0');
+  REQUIRE(decompressed.read(as_writable_bytes(std::span(rx_payload))) == payload.size());
+  CHECK(payload == rx_payload);
+  CHECK(decompressed.isFinished());
+
+  // the whole packet has been consumed, and it is much smaller on the wire than the payload
+  CHECK(client_data.tell() == client_data.size());
+  CHECK(client_data.size() - packet_start < payload.size() / 10);
+  // the CRC is calculated over the uncompressed data
+  minifi::io::BufferStream uncompressed;
+  minifi::io::CRCStream<minifi::io::BufferStream> crc_stream(gsl::make_not_null(&uncompressed));
+  crc_stream.write(number_of_attributes);
+  crc_stream.write(key, true);
+  crc_stream.write(value, true);
+  crc_stream.write(length);
+  crc_stream.write(reinterpret_cast<const uint8_t*>(payload.data()), payload.size());
+  CHECK(transaction->getCRC() == crc_stream.getCRC());
+}
+
+TEST_CASE("TestSiteToSiteFlushesTransactionFinished", "[S2S7]") {
+  auto collector = std::make_unique<SiteToSiteResponder>();
+  auto collector_ptr = collector.get();
+
+  sunny_path_bootstrap(collector);
+  collector->push_response(std::string{'R', 'C', static_cast<char>(minifi::sitetosite::MORE_DATA)});
+
+  auto peer = std::make_unique<minifi::sitetosite::SiteToSitePeer>(std::move(collector), "fake_host", 65433, "");
+
+  minifi::sitetosite::RawSiteToSiteClient protocol(std::move(peer));
+  protocol.setPortId(utils::Identifier::parse("C56A4180-65AA-42EC-A945-5FD21DEC0538").value());
+
+  REQUIRE(true == protocol.bootstrap());
+  verify_bootstrap_requests(*collector_ptr, "false");
+
+  auto transaction = protocol.createTransaction(minifi::sitetosite::RECEIVE);
+  REQUIRE(transaction);
+  REQUIRE(collector_ptr->get_next_client_string() == "RECEIVE_FLOWFILES");
+
+  // a flow file has been received and confirmed
+  transaction->current_transfers_ = 1;
+  transaction->total_transfers_ = 1;
+  transaction->_state = minifi::sitetosite::TRANSACTION_CONFIRMED;
+
+  REQUIRE(protocol.complete(transaction->getUUID()));
+  // nothing is read after TRANSACTION_FINISHED, so it has to be on the wire when complete() returns
+  REQUIRE(collector_ptr->get_next_client_bytes(3) == std::string{'R', 'C', static_cast<char>(minifi::sitetosite::TRANSACTION_FINISHED)});
+}
+
+TEST_CASE("Site to site compression streams", "[S2S6]") {
+  const auto data_size = GENERATE(size_t{1}, size_t{1000}, minifi::sitetosite::CompressionFraming::ChunkSize, 5 * minifi::sitetosite::CompressionFraming::ChunkSize / 2);
+  std::string data;
+  while (data.size() < data_size) {
+    data += std::to_string(data.size()) + ",";
+  }
+  data.resize(data_size);
+
+  minifi::io::BufferStream wire;
+  {
+    minifi::sitetosite::CompressionOutputStream compressed(gsl::make_not_null(&wire));
+    // written in pieces, which do not align with the chunks
+    for (size_t offset = 0; offset < data.size(); offset += 777) {
+      const auto piece_size = std::min<size_t>(777, data.size() - offset);
+      REQUIRE(compressed.write(reinterpret_cast<const uint8_t*>(data.data()) + offset, piece_size) == piece_size);
+    }
+    REQUIRE(compressed.finish());
+  }
+  // followed by uncompressed data, which must not be consumed by the decompression
+  wire.write(std::string("trailer"));
+
+  const auto wire_data = wire.getBuffer();
+  REQUIRE(wire_data.size() > 4);
+  CHECK(std::string(reinterpret_cast<const char*>(wire_data.data()), 4) == "SYNC");
+
+  minifi::sitetosite::CompressionInputStream decompressed(gsl::make_not_null(&wire));
+  std::string rx_data(data.size(), '\0');
+  REQUIRE(decompressed.read(as_writable_bytes(std::span(rx_data))) == data.size());
+  CHECK(data == rx_data);
+  CHECK(decompressed.isFinished());
+  std::array<std::byte, 1> after_end{};
+  CHECK(decompressed.read(after_end) == 0);
+
+  std::string trailer;
+  wire.read(trailer);
+  CHECK(trailer == "trailer");
 }
 
 TEST_CASE("TestSiteToSiteVerifyNegotiationFail", "[S2S4]") {
@@ -18,7 +18,7 @@
 #pragma once
 
 #include <string>
-#include <queue>
+#include <span>
 #include "io/BufferStream.h"
 #include "core/Core.h"
 #include "utils/gsl.h"
@@ -31,7 +31,8 @@ namespace minifi = org::apache::nifi::minifi;
 class SiteToSiteResponder : public minifi::io::BaseStream {
  private:
   minifi::io::BufferStream server_responses_;
-  std::queue<std::string> client_responses_;
+  minifi::io::BufferStream client_data_;
+  size_t client_write_count_ = 0;
 
  public:
   SiteToSiteResponder() = default;
@@ -45,14 +46,38 @@ class SiteToSiteResponder : public minifi::io::BaseStream {
   }
 
   size_t write(const uint8_t *value, size_t size) override {
-    client_responses_.push(std::string(reinterpret_cast<const char*>(value), size));
-    return size;
+    ++client_write_count_;
+    return client_data_.write(value, size);
   }
 
-  std::string get_next_client_response() {
-    std::string ret = client_responses_.front();
-    client_responses_.pop();
-    return ret;
+  /**
+   * The peer coalesces the frames it writes, so the client data is read back field by field.
+   */
+  minifi::io::BufferStream& get_client_data() {
+    return client_data_;
+  }
+
+  std::string get_next_client_string(bool widen = false) {
+    std::string value;
+    client_data_.read(value, widen);
+    return value;
+  }
+
+  template<typename Integral>
+  Integral get_next_client_value() {
+    Integral value{};
+    client_data_.read(value);
+    return value;
+  }
+
+  std::string get_next_client_bytes(size_t size) {
+    std::string value(size, '\0');
+    value.resize(client_data_.read(as_writable_bytes(std::span(value))));
+    return value;
+  }
+
+  size_t get_client_write_count() const {
+    return client_write_count_;
   }
 
   /**
@@ -55,7 +55,7 @@ struct SwapEvent {
 
 class SwappingFlowFileTestRepo : public TestFlowRepository, public minifi::SwapManager {
  public:
-  void store(std::vector<std::shared_ptr<core::FlowFile>> flow_files) override {
+  std::future<void> store(std::vector<std::shared_ptr<core::FlowFile>> flow_files) override {
     std::vector<minifi::SwappedFlowFile> ids;
     for (const auto& ff : flow_files) {
       ids.push_back(minifi::SwappedFlowFile{ff->getUUID(), ff->getPenaltyExpiration()});
@@ -64,6 +64,15 @@ class SwappingFlowFileTestRepo : public TestFlowRepository, public minifi::SwapM
       Put(ff->getUUIDStr().c_str(), reinterpret_cast<const uint8_t*>(output.getBuffer().data()), output.size());
     }
     swap_events_.push_back({Store, ids});
+    std::promise<void> stored;
+    auto future = stored.get_future();
+    if (delay_store_) {
+      // simulates a slow store, the flow files are only stored once the test completes the task
+      store_tasks_.push_back(std::move(stored));
+    } else {
+      stored.set_value();
+    }
+    return future;
   }
 
   std::future<std::vector<std::shared_ptr<core::FlowFile>>> load(std::vector<minifi::SwappedFlowFile> flow_files) override {
@@ -92,6 +101,15 @@ class SwappingFlowFileTestRepo : public TestFlowRepository, public minifi::SwapM
     }
   };
 
+  void completeStores() {
+    for (auto& store_task : store_tasks_) {
+      store_task.set_value();
+    }
+    store_tasks_.clear();
+  }
+
+  bool delay_store_{false};
+  std::vector<std::promise<void>> store_tasks_;
   std::vector<LoadTask> load_tasks_;
   std::vector<SwapEvent> swap_events_;
 };
@@ -130,7 +148,7 @@ struct VerifiedQueue {
     REQUIRE(live_copy.size() == live.size());
     for (auto sec : live) {
       auto min = live_copy.popMin();
-      REQUIRE(min->getPenaltyExpiration() == Timepoint{std::chrono::seconds{sec}});
+      REQUIRE(min.flow_file->getPenaltyExpiration() == Timepoint{std::chrono::seconds{sec}});
     }
 
     // check inter ffs
@@ -200,6 +218,7 @@ class SwapTestController : public TestController {
     for (auto& pattern : events) {
       REQUIRE(pattern.kind == flow_repo_->swap_events_[idx].kind);
       flow_repo_->swap_events_[idx].verifyTimes(pattern.seconds);
+      ++idx;
     }
   }
 
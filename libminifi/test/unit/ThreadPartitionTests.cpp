@@ -0,0 +1,100 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ThreadPartition.h"
+#include "core/ProcessGroup.h"
+#include "../DummyProcessor.h"
+#include "../TestBase.h"
+#include "../Catch.h"
+
+using minifi::ThreadPartition;
+
+TEST_CASE("Thread partitions are read from the configuration", "[ThreadPartition]") {
+  minifi::Configure configuration;
+  configuration.set(minifi::Configure::nifi_flow_engine_threads, "3");
+  configuration.set(minifi::Configure::nifi_flow_engine_thread_partitions, "ingest, analytics,unpinned");
+  configuration.set("nifi.flow.engine.thread.partition.ingest.cpus", "0-1,4");
+  configuration.set("nifi.flow.engine.thread.partition.ingest.process.groups", "Ingest");
+  configuration.set("nifi.flow.engine.thread.partition.analytics.cpus", "2");
+  configuration.set("nifi.flow.engine.thread.partition.analytics.threads", "4");
+  configuration.set("nifi.flow.engine.thread.partition.analytics.process.groups", "Analytics, Reporting");
+
+  const auto partitions = ThreadPartition::fromConfiguration(configuration);
+
+  REQUIRE(partitions.size() == 3);
+  CHECK(partitions[0].name == "ingest");
+  CHECK(partitions[0].cpus == std::vector<unsigned>{0, 1, 4});
+  CHECK_FALSE(partitions[0].numa_node);
+  CHECK(partitions[0].thread_count == 3);
+  CHECK(partitions[0].process_groups == std::vector<std::string>{"Ingest"});
+  CHECK(partitions[1].name == "analytics");
+  CHECK(partitions[1].cpus == std::vector<unsigned>{2});
+  CHECK(partitions[1].thread_count == 4);
+  CHECK(partitions[1].process_groups == std::vector<std::string>{"Analytics", "Reporting"});
+  CHECK(partitions[2].name == "unpinned");
+  CHECK(partitions[2].cpus.empty());
+  CHECK(partitions[2].thread_count == 3);
+  CHECK(partitions[2].process_groups.empty());
+}
+
+TEST_CASE("Invalid thread partitions are skipped", "[ThreadPartition]") {
+  minifi::Configure configuration;
+  configuration.set(minifi::Configure::nifi_flow_engine_thread_partitions, "bad_cpus,bad_threads,good,good");
+  configuration.set("nifi.flow.engine.thread.partition.bad_cpus.cpus", "3-1");
+  configuration.set("nifi.flow.engine.thread.partition.bad_cpus.process.groups", "A");
+  configuration.set("nifi.flow.engine.thread.partition.bad_threads.threads", "0");
+  configuration.set("nifi.flow.engine.thread.partition.bad_threads.process.groups", "A");
+  configuration.set("nifi.flow.engine.thread.partition.good.process.groups", "A");
+
+  const auto partitions = ThreadPartition::fromConfiguration(configuration);
+
+  REQUIRE(partitions.size() == 1);
+  CHECK(partitions[0].name == "good");
+  CHECK(partitions[0].process_groups == std::vector<std::string>{"A"});
+}
+
+TEST_CASE("Process groups inherit the thread partition of their parent", "[ThreadPartition]") {
+  core::ProcessGroup root(core::ProcessGroupType::ROOT_PROCESS_GROUP, "root");
+  auto* root_processor = std::get<0>(root.addProcessor(std::make_unique<minifi::test::DummyProcessor>("root_processor")));
+
+  auto ingest = std::make_unique<core::ProcessGroup>(core::ProcessGroupType::SIMPLE_PROCESS_GROUP, "Ingest");
+  auto* ingest_processor = std::get<0>(ingest->addProcessor(std::make_unique<minifi::test::DummyProcessor>("ingest_processor")));
+  auto ingest_child = std::make_unique<core::ProcessGroup>(core::ProcessGroupType::SIMPLE_PROCESS_GROUP, "IngestChild");
+  auto* ingest_child_processor = std::get<0>(ingest_child->addProcessor(std::make_unique<minifi::test::DummyProcessor>("ingest_child_processor")));
+  auto analytics = std::make_unique<core::ProcessGroup>(core::ProcessGroupType::SIMPLE_PROCESS_GROUP, "Analytics");
+  const auto analytics_id = analytics->getUUIDStr();
+  auto* analytics_processor = std::get<0>(analytics->addProcessor(std::make_unique<minifi::test::DummyProcessor>("analytics_processor")));
+  ingest->addProcessGroup(std::move(analytics));
+  ingest->addProcessGroup(std::move(ingest_child));
+  root.addProcessGroup(std::move(ingest));
+
+  root.assignThreadPartitions({{"Ingest", "ingest"}, {analytics_id, "analytics"}});
+
+  CHECK(root_processor->getThreadPartition().empty());
+  CHECK(ingest_processor->getThreadPartition() == "ingest");
+  CHECK(ingest_child_processor->getThreadPartition() == "ingest");
+  CHECK(analytics_processor->getThreadPartition() == "analytics");
+
+  root.assignThreadPartitions({});
+
+  CHECK(ingest_processor->getThreadPartition().empty());
+  CHECK(analytics_processor->getThreadPartition().empty());
+}
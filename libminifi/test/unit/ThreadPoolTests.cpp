@@ -19,9 +19,17 @@
 #include <utility>
 #include <future>
 #include <memory>
+#include <vector>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
 #include "../TestBase.h"
 #include "../Catch.h"
+#include "../Utils.h"
 #include "utils/ThreadPool.h"
+#include "utils/IntegrationTestUtils.h"
 
 using namespace std::literals::chrono_literals;
 
@@ -74,3 +82,154 @@ TEST_CASE("Worker wait time should be relative to the last run") {
   REQUIRE(worker_execution_time_points.size() == 2);
   CHECK(worker_execution_time_points[1] - worker_execution_time_points[0] >= wait_time_between_tasks);
 }
+
+TEST_CASE("Stopped tasks are not run again, and can be executed again later", "[ThreadPool]") {
+  utils::ThreadPool pool(4);
+  pool.start();
+  std::atomic<int> run_count = 0;
+  std::vector<std::future<utils::TaskRescheduleInfo>> futures(4);
+  for (size_t i = 0; i < 2; ++i) {
+    pool.execute(utils::Worker([&run_count] { ++run_count; return utils::TaskRescheduleInfo::RetryImmediately(); }, "immediate"), futures[i]);
+  }
+  for (size_t i = 2; i < futures.size(); ++i) {
+    pool.execute(utils::Worker([&run_count] { ++run_count; return utils::TaskRescheduleInfo::RetryIn(5ms); }, "delayed"), futures[i]);
+  }
+  REQUIRE(utils::verifyEventHappenedInPollTime(1s, [&run_count] { return run_count > 10; }));
+  CHECK(pool.isTaskRunning("immediate"));
+
+  pool.stopTasks("immediate");
+  pool.stopTasks("delayed");
+  CHECK_FALSE(pool.isTaskRunning("immediate"));
+  CHECK_FALSE(pool.isTaskRunning("delayed"));
+  const int run_count_after_stop = run_count;
+  std::this_thread::sleep_for(20ms);
+  CHECK(run_count == run_count_after_stop);
+
+  std::future<utils::TaskRescheduleInfo> future;
+  pool.execute(utils::Worker([] { return utils::TaskRescheduleInfo::Done(); }, "immediate"), future);
+  CHECK(future.get().isFinished());
+}
+
+TEST_CASE("Paused thread pool does not run tasks until resumed", "[ThreadPool]") {
+  utils::ThreadPool pool(2);
+  pool.start();
+  pool.pause();
+  std::future<utils::TaskRescheduleInfo> future;
+  pool.execute(utils::Worker([] { return utils::TaskRescheduleInfo::Done(); }, "id"), future);
+  CHECK(future.wait_for(20ms) == std::future_status::timeout);
+  pool.resume();
+  CHECK(future.get().isFinished());
+}
+
+TEST_CASE("Tasks waiting for a notification are run again when notified", "[ThreadPool]") {
+  utils::ThreadPool pool(2);
+  pool.start();
+  const auto notify = pool.createNotifier("id");
+  std::atomic<int> run_count = 0;
+  std::future<utils::TaskRescheduleInfo> future;
+  pool.execute(utils::Worker([&run_count] {
+    if (++run_count < 3) {
+      return utils::TaskRescheduleInfo::RetryWhenNotified();
+    }
+    return utils::TaskRescheduleInfo::Done();
+  }, "id"), future);
+
+  REQUIRE(utils::verifyEventHappenedInPollTime(1s, [&run_count] { return run_count == 1; }));
+  CHECK(future.wait_for(20ms) == std::future_status::timeout);
+  CHECK(run_count == 1);
+
+  notify();
+  REQUIRE(utils::verifyEventHappenedInPollTime(1s, [&run_count] { return run_count == 2; }));
+  CHECK(future.wait_for(20ms) == std::future_status::timeout);
+
+  notify();
+  CHECK(future.get().isFinished());
+  CHECK(run_count == 3);
+}
+
+TEST_CASE("A notification arriving while the task runs is not lost", "[ThreadPool]") {
+  utils::ThreadPool pool(1);
+  pool.start();
+  const auto notify = pool.createNotifier("id");
+  std::atomic<int> run_count = 0;
+  std::future<utils::TaskRescheduleInfo> future;
+  pool.execute(utils::Worker([&run_count, &notify] {
+    if (++run_count == 1) {
+      notify();
+      return utils::TaskRescheduleInfo::RetryWhenNotified();
+    }
+    return utils::TaskRescheduleInfo::Done();
+  }, "id"), future);
+  CHECK(future.get().isFinished());
+  CHECK(run_count == 2);
+}
+
+TEST_CASE("Notifiers can outlive the thread pool", "[ThreadPool]") {
+  std::function<void()> notify;
+  {
+    utils::ThreadPool pool(1);
+    pool.start();
+    notify = pool.createNotifier("id");
+    std::future<utils::TaskRescheduleInfo> future;
+    pool.execute(utils::Worker([] { return utils::TaskRescheduleInfo::RetryWhenNotified(); }, "id"), future);
+    std::this_thread::sleep_for(10ms);
+  }
+  notify();
+}
+
+TEST_CASE("The utilization of the thread pool is measured", "[ThreadPool]") {
+  utils::ThreadPool pool(1);
+  pool.start();
+  std::future<utils::TaskRescheduleInfo> future;
+  pool.execute(utils::Worker([] {
+    std::this_thread::sleep_for(1100ms);
+    return utils::TaskRescheduleInfo::Done();
+  }, "id"), future);
+  REQUIRE(future.get().isFinished());
+  const auto busy_utilization = pool.getUtilization();
+  CHECK(busy_utilization > 0.5);
+  CHECK(busy_utilization <= 1.0);
+  // calls within a second return the same measurement
+  CHECK(pool.getUtilization() == busy_utilization);
+
+  std::this_thread::sleep_for(1100ms);
+  CHECK(pool.getUtilization() < 0.5);
+}
+
+TEST_CASE("The utilization of the thread pool includes the running tasks", "[ThreadPool]") {
+  utils::ThreadPool pool(1);
+  pool.start();
+  std::promise<void> release;
+  std::future<utils::TaskRescheduleInfo> future;
+  pool.execute(utils::Worker([released = release.get_future().share()] {
+    released.wait();
+    return utils::TaskRescheduleInfo::Done();
+  }, "id"), future);
+  std::this_thread::sleep_for(1100ms);
+  CHECK(pool.getUtilization() > 0.5);
+
+  // the time counted while the task was running is not counted again when it completes
+  release.set_value();
+  REQUIRE(future.get().isFinished());
+  std::this_thread::sleep_for(1100ms);
+  CHECK(pool.getUtilization() < 0.5);
+}
+
+#ifdef __linux__
+TEST_CASE("The worker threads can be pinned to CPUs", "[ThreadPool]") {
+  const auto cpu = minifi::test::utils::getAllowedCpu();
+  utils::ThreadPool pool(2);
+  pool.setAffinity({cpu});
+  pool.start();
+  std::future<utils::TaskRescheduleInfo> future;
+  std::atomic<bool> pinned = false;
+  pool.execute(utils::Worker([&pinned, cpu] {
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    pinned = sched_getaffinity(0, sizeof(cpu_set), &cpu_set) == 0 && CPU_COUNT(&cpu_set) == 1 && CPU_ISSET(cpu, &cpu_set);
+    return utils::TaskRescheduleInfo::Done();
+  }, "id"), future);
+  REQUIRE(future.get().isFinished());
+  CHECK(pinned);
+}
+#endif
@@ -0,0 +1,114 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include "../TestBase.h"
+#include "../Catch.h"
+#include "utils/TimerWheel.h"
+
+using namespace std::literals::chrono_literals;
+
+namespace {
+
+using TimerWheel = utils::TimerWheel<int>;
+
+std::vector<int> expire(TimerWheel& wheel, TimerWheel::time_point now) {
+  std::vector<int> expired;
+  wheel.expire(now, [&expired](int value) { expired.push_back(value); });
+  std::sort(expired.begin(), expired.end());
+  return expired;
+}
+
+}  // namespace
+
+TEST_CASE("TimerWheel expires the values whose deadline has passed", "[TimerWheel]") {
+  const TimerWheel::time_point start{1h};
+  TimerWheel wheel{1ms, 16, start};
+  wheel.add(start + 5ms, 5);
+  wheel.add(start + 2ms, 2);
+  wheel.add(start + 2ms, 3);
+  // further than a revolution of the wheel, shares the slot with the value of 5ms
+  wheel.add(start + 21ms, 21);
+  CHECK(wheel.size() == 4);
+  CHECK(wheel.nextDeadline() == start + 2ms);
+
+  CHECK(expire(wheel, start + 1ms).empty());
+  CHECK(expire(wheel, start + 2ms) == std::vector<int>{2, 3});
+  CHECK(wheel.nextDeadline() == start + 5ms);
+  CHECK(expire(wheel, start + 10ms) == std::vector<int>{5});
+  CHECK(wheel.nextDeadline() == start + 21ms);
+  CHECK(expire(wheel, start + 20ms).empty());
+  CHECK(expire(wheel, start + 100ms) == std::vector<int>{21});
+  CHECK(wheel.empty());
+  CHECK_FALSE(wheel.nextDeadline());
+}
+
+TEST_CASE("TimerWheel expires values added with a deadline in the past at the next expiration", "[TimerWheel]") {
+  const TimerWheel::time_point start{1h};
+  TimerWheel wheel{1ms, 16, start};
+  wheel.add(start + 10ms, 10);
+  CHECK(expire(wheel, start + 10ms) == std::vector<int>{10});
+
+  wheel.add(start + 3ms, 3);
+  CHECK(wheel.nextDeadline() == start + 3ms);
+  CHECK(expire(wheel, start + 11ms) == std::vector<int>{3});
+}
+
+TEST_CASE("TimerWheel finds the next deadline among the values of later revolutions", "[TimerWheel]") {
+  const TimerWheel::time_point start{1h};
+  TimerWheel wheel{1ms, 16, start};
+  wheel.add(start + 3ms, 3);
+  // the slots of 20ms and 35ms are visited before the one of 9ms when walking from 3ms
+  wheel.add(start + 20ms, 20);
+  wheel.add(start + 35ms, 35);
+  wheel.add(start + 9ms, 9);
+
+  CHECK(expire(wheel, start + 3ms) == std::vector<int>{3});
+  CHECK(wheel.nextDeadline() == start + 9ms);
+  CHECK(expire(wheel, start + 9ms) == std::vector<int>{9});
+  CHECK(wheel.nextDeadline() == start + 20ms);
+  CHECK(expire(wheel, start + 20ms) == std::vector<int>{20});
+  CHECK(wheel.nextDeadline() == start + 35ms);
+
+  // every remaining value is more than a revolution away
+  wheel.add(start + 100ms, 100);
+  wheel.add(start + 70ms, 70);
+  CHECK(expire(wheel, start + 35ms) == std::vector<int>{35});
+  CHECK(wheel.nextDeadline() == start + 70ms);
+}
+
+TEST_CASE("TimerWheel can remove values before their deadline", "[TimerWheel]") {
+  const TimerWheel::time_point start{1h};
+  TimerWheel wheel{1ms, 16, start};
+  for (int i = 1; i <= 40; ++i) {
+    wheel.add(start + std::chrono::milliseconds(i), i);
+  }
+  CHECK(wheel.removeIf([](int value) { return value % 2 == 1 || value == 2; }) == 21);
+  CHECK(wheel.size() == 19);
+  CHECK(wheel.nextDeadline() == start + 4ms);
+
+  const auto expired = expire(wheel, start + 40ms);
+  CHECK(expired.size() == 19);
+  CHECK(std::all_of(expired.begin(), expired.end(), [](int value) { return value % 2 == 0 && value != 2; }));
+
+  wheel.add(start + 50ms, 50);
+  wheel.clear();
+  CHECK(wheel.empty());
+  CHECK(expire(wheel, start + 1min).empty());
+}
@@ -448,6 +448,7 @@ int delete_custom_processor(const char * name);
  * @param ffr flow file to be transfered
  * @param ps processor session the transfer happens within
  * @param relationship name of the relationship ("success" and "failure" are supported currently)
+ * The attributes set on the flow file record are applied to the flow file before it is transferred
  * @return 0 on success, -1 otherwise (didn't exist)
  **/
 int transfer_to_relationship(flow_file_record * ffr, processor_session * ps, const char * relationship);
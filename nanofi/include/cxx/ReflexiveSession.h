@@ -24,6 +24,7 @@
 #include <atomic>
 #include <algorithm>
 #include <set>
+#include <limits>
 
 #include "core/ProcessSession.h"
 
@@ -41,6 +42,14 @@ class ReflexiveSession : public ProcessSession{
     return prevff;
   }
 
+  std::vector<std::shared_ptr<core::FlowFile>> get(size_t max_count, uint64_t /*max_bytes*/ = std::numeric_limits<uint64_t>::max()) override {
+    std::vector<std::shared_ptr<core::FlowFile>> flow_files;
+    if (max_count > 0 && ff) {
+      flow_files.push_back(get());
+    }
+    return flow_files;
+  }
+
   void add(const std::shared_ptr<core::FlowFile> &flow) override {
     ff = flow;
   }
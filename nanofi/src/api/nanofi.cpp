@@ -354,10 +354,8 @@ void free_flowfile(flow_file_record *ff) {
     }
     delete content_repo_ptr;
   }
-  if (ff->ffp == nullptr) {
-    auto map = static_cast<AttributeMap*>(ff->attributes);
-    delete map;
-  } else {
+  delete static_cast<AttributeMap*>(ff->attributes);
+  if (ff->ffp != nullptr) {
     auto ff_sptr = reinterpret_cast<std::shared_ptr<core::FlowFile>*>(ff->ffp);
     delete ff_sptr;
   }
@@ -377,7 +375,7 @@ int8_t add_attribute(flow_file_record *ff, const char *key, void *value, size_t
   NULL_CHECK(-1, ff, key, value);
   NULL_CHECK(-1, ff->attributes);
   auto attribute_map = static_cast<AttributeMap*>(ff->attributes);
-  const auto& ret = attribute_map->insert(std::pair<std::string, std::string>(key, std::string(static_cast<char*>(value), size)));
+  const auto& ret = attribute_map->insert({core::FlowFile::AttributeKey{key}, std::string(static_cast<char*>(value), size)});
   return ret.second ? 0 : -1;
 }
 
@@ -392,7 +390,7 @@ void update_attribute(flow_file_record *ff, const char *key, void *value, size_t
   NULL_CHECK(, ff, key);
   NULL_CHECK(, ff->attributes);
   auto attribute_map = static_cast<AttributeMap*>(ff->attributes);
-  (*attribute_map)[key] = std::string(static_cast<char*>(value), size);
+  (*attribute_map)[std::string_view{key}] = std::string(static_cast<char*>(value), size);
 }
 
 /*
@@ -406,7 +404,7 @@ int8_t get_attribute(const flow_file_record * ff, attribute * caller_attribute)
   NULL_CHECK(-1, ff, caller_attribute);
   NULL_CHECK(-1, ff->attributes, caller_attribute->key);
   auto attribute_map = static_cast<AttributeMap*>(ff->attributes);
-  auto find = attribute_map->find(caller_attribute->key);
+  auto find = attribute_map->find(std::string_view{caller_attribute->key});
   if (find != attribute_map->end()) {
     caller_attribute->value = static_cast<void*>(const_cast<char*>(find->second.data()));
     caller_attribute->value_size = find->second.size();
@@ -449,7 +447,7 @@ int8_t remove_attribute(flow_file_record *ff, const char *key) {
   NULL_CHECK(-1, ff, key);
   NULL_CHECK(-1, ff->attributes);
   auto attribute_map = static_cast<AttributeMap*>(ff->attributes);
-  return gsl::narrow<int8_t>(attribute_map->erase(key)) - 1;  // erase by key returns the number of elements removed (0 or 1)
+  return gsl::narrow<int8_t>(attribute_map->erase(std::string_view{key})) - 1;  // erase by key returns the number of elements removed (0 or 1)
 }
 
 int get_content(const flow_file_record* ff, uint8_t* target, int size) {
@@ -641,7 +639,8 @@ flow_file_record* flowfile_to_record(std::shared_ptr<core::FlowFile> ff, const s
   auto path = claim->getContentFullPath();
   auto ffr = create_ff_object_na(path.c_str(), path.length(), ff->getSize());
   ffr->ffp = static_cast<void*>(new std::shared_ptr<core::FlowFile>(ff));
-  ffr->attributes = ff->getAttributesPtr();
+  // the attribute map of the flow file is shared with its snapshots, a pointer into it could dangle, so the record gets its own copy
+  ffr->attributes = new AttributeMap(ff->getAttributeMap());
   auto content_repo_ptr = static_cast<std::shared_ptr<minifi::core::ContentRepository>*>(ffr->crp);
   *content_repo_ptr = crp;
   return ffr;
@@ -792,6 +791,10 @@ int transfer_to_relationship(flow_file_record * ffr, processor_session * ps, con
     return -1;
   }
   auto ff_sptr = reinterpret_cast<std::shared_ptr<core::FlowFile>*>(ffr->ffp);
+  // the record has its own copy of the attributes, the changes made through it are applied to the flow file
+  if (ffr->attributes) {
+    *(*ff_sptr)->getAttributesPtr() = *static_cast<AttributeMap*>(ffr->attributes);
+  }
   ps->transfer(*ff_sptr, core::Relationship(relationship, "desc"));
   return 0;
 }
@@ -441,6 +441,13 @@ TEST_CASE("Test custom processor", "[TestCutomProcessor]") {
 
   REQUIRE(record != nullptr);
 
+  // the attribute added to the flow file record by the custom processor is kept when it is transferred
+  attribute custom_attr;
+  custom_attr.key = "custom attribute";
+  custom_attr.value_size = 0;
+  REQUIRE(get_attribute(record, &custom_attr) == 0);
+  REQUIRE(std::string(static_cast<const char*>(custom_attr.value), custom_attr.value_size) == "custom value");
+
   free_nanofi_instance(instance);
   free_flow(test_flow);
   free_flowfile(record);